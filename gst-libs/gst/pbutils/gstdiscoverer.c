@@ -38,6 +38,18 @@
  * By default this will use the GLib default main context unless you have
  * set a custom context using g_main_context_push_thread_default().
  *
+ * In non-blocking mode several URIs can be discovered in parallel by setting
+ * the #GstDiscoverer:max-concurrency property before calling
+ * gst_discoverer_start().
+ *
+ * Results for local files can be kept in a cache on disk by setting the
+ * #GstDiscoverer:cache-file property, in which case files that did not change
+ * since they were last discovered are not analyzed again.
+ *
+ * Setting the #GstDiscoverer:parse-only property avoids decoding streams
+ * whose demuxer or parser already provides all the information, which is
+ * considerably cheaper for most files.
+ *
  * All the information is returned in a #GstDiscovererInfo structure.
  */
 
@@ -49,6 +61,7 @@
 #include <gst/audio/audio.h>
 
 #include <string.h>
+#include <glib/gstdio.h>
 
 #include "pbutils.h"
 #include "pbutils-private.h"
@@ -78,6 +91,46 @@ typedef struct
   gulong probe_id;
 } PrivateStream;
 
+/* Identifies a version of a local file */
+typedef struct
+{
+  guint64 size;
+  guint64 mtime;
+  guint64 inode;
+} FileIdentity;
+
+typedef struct
+{
+  gchar *uri;
+  FileIdentity identity;
+  /* as returned by gst_discoverer_info_to_variant() */
+  GVariant *info;
+  /* in DiscovererCache.lru, data points to the entry */
+  GList link;
+} CacheEntry;
+
+/* Cache of discovered results, shared between a discoverer and its workers.
+ * Entries loaded from the cache file reference the memory-mapped file
+ * directly, and the file is only ever replaced atomically so that mapping
+ * stays valid. */
+typedef struct
+{
+  gint refcount;
+  GMutex lock;
+
+  gchar *filename;
+  guint max_entries;
+
+  /* uri -> CacheEntry */
+  GHashTable *entries;
+  /* most recently used first */
+  GQueue lru;
+  gboolean dirty;
+
+  guint64 hits;
+  guint64 misses;
+} DiscovererCache;
+
 struct _GstDiscovererPrivate
 {
   gboolean async;
@@ -130,18 +183,315 @@ struct _GstDiscovererPrivate
   /* reusable queries */
   GstQuery *seeking_query;
 
+  /* maximum number of URIs discovered in parallel in async mode */
+  guint max_concurrency;
+
+  /* only plug decoders for streams with incomplete caps */
+  gboolean parse_only;
+
+  /* Worker discoverers, each with its own pipeline, used in async mode when
+   * max_concurrency > 1, and the ones among them that are not busy */
+  GPtrArray *workers;
+  GQueue idle_workers;
+
+  /* result cache, NULL if disabled */
+  DiscovererCache *cache;
+  gchar *cache_file;
+  guint cache_max_entries;
+
+  /* identity of the current URI, if it can be cached */
+  gboolean current_cacheable;
+  FileIdentity current_identity;
+  /* TRUE if current_info was taken from the cache */
+  gboolean current_cached;
+
   /* Handler ids for various callbacks */
   gulong pad_added_id;
   gulong pad_remove_id;
   gulong no_more_pads_id;
   gulong source_chg_id;
   gulong element_added_id;
+  gulong autoplug_continue_id;
   gulong bus_cb_id;
 };
 
 #define DISCO_LOCK(dc) g_mutex_lock (&dc->priv->lock);
 #define DISCO_UNLOCK(dc) g_mutex_unlock (&dc->priv->lock);
 
+#define CACHE_VERSION 1
+#define CACHE_VARIANT_TYPE "(ua(stttv))"
+
+static void
+cache_entry_free (CacheEntry * entry)
+{
+  g_free (entry->uri);
+  g_variant_unref (entry->info);
+  g_slice_free (CacheEntry, entry);
+}
+
+/* Must be called with the cache lock */
+static void
+cache_remove_locked (DiscovererCache * cache, CacheEntry * entry)
+{
+  g_queue_unlink (&cache->lru, &entry->link);
+  g_hash_table_remove (cache->entries, entry->uri);
+}
+
+/* Must be called with the cache lock */
+static void
+cache_insert_locked (DiscovererCache * cache, CacheEntry * entry)
+{
+  CacheEntry *old;
+
+  old = g_hash_table_lookup (cache->entries, entry->uri);
+  if (old)
+    cache_remove_locked (cache, old);
+
+  entry->link.data = entry;
+  g_queue_push_head_link (&cache->lru, &entry->link);
+  g_hash_table_insert (cache->entries, entry->uri, entry);
+
+  while (cache->lru.length > cache->max_entries)
+    cache_remove_locked (cache, cache->lru.tail->data);
+}
+
+static void
+cache_load (DiscovererCache * cache)
+{
+  GMappedFile *file;
+  GError *err = NULL;
+  GVariant *store, *entries, *child;
+  GVariantIter iter;
+  GBytes *bytes;
+  guint32 version;
+
+  file = g_mapped_file_new (cache->filename, FALSE, &err);
+  if (file == NULL) {
+    GST_DEBUG ("Not loading cache: %s", err->message);
+    g_clear_error (&err);
+    return;
+  }
+
+  bytes = g_mapped_file_get_bytes (file);
+  g_mapped_file_unref (file);
+  store = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE
+          (CACHE_VARIANT_TYPE), bytes, FALSE));
+  g_bytes_unref (bytes);
+
+  g_variant_get (store, "(u@a(stttv))", &version, &entries);
+  if (version != CACHE_VERSION) {
+    GST_WARNING ("Ignoring cache %s with version %u", cache->filename,
+        version);
+    goto done;
+  }
+
+  g_variant_iter_init (&iter, entries);
+  while ((child = g_variant_iter_next_value (&iter))) {
+    CacheEntry *entry = g_slice_new0 (CacheEntry);
+
+    g_variant_get (child, "(sttt@v)", &entry->uri, &entry->identity.size,
+        &entry->identity.mtime, &entry->identity.inode, &entry->info);
+    g_variant_unref (child);
+
+    /* entries are stored most recently used first */
+    if (g_hash_table_contains (cache->entries, entry->uri)) {
+      cache_entry_free (entry);
+      continue;
+    }
+    entry->link.data = entry;
+    g_queue_push_tail_link (&cache->lru, &entry->link);
+    g_hash_table_insert (cache->entries, entry->uri, entry);
+  }
+
+  while (cache->lru.length > cache->max_entries)
+    cache_remove_locked (cache, cache->lru.tail->data);
+
+  GST_DEBUG ("Loaded %u entries from %s", cache->lru.length, cache->filename);
+
+done:
+  g_variant_unref (entries);
+  g_variant_unref (store);
+}
+
+static void
+cache_flush (DiscovererCache * cache)
+{
+  GVariantBuilder builder;
+  GVariant *store;
+  GError *err = NULL;
+  GList *l;
+
+  g_mutex_lock (&cache->lock);
+  if (!cache->dirty)
+    goto done;
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a(stttv)"));
+  for (l = cache->lru.head; l; l = l->next) {
+    CacheEntry *entry = l->data;
+
+    g_variant_builder_add (&builder, "(sttt@v)", entry->uri,
+        entry->identity.size, entry->identity.mtime, entry->identity.inode,
+        entry->info);
+  }
+  store = g_variant_ref_sink (g_variant_new ("(u@a(stttv))", CACHE_VERSION,
+          g_variant_builder_end (&builder)));
+
+  /* Writes a temporary file and renames it, so readers never see a partial
+   * cache and mappings of the previous file stay valid */
+  if (g_file_set_contents (cache->filename, g_variant_get_data (store),
+          g_variant_get_size (store), &err)) {
+    GST_DEBUG ("Wrote %u entries to %s", cache->lru.length, cache->filename);
+    cache->dirty = FALSE;
+  } else {
+    GST_WARNING ("Could not write cache: %s", err->message);
+    g_clear_error (&err);
+  }
+  g_variant_unref (store);
+
+done:
+  g_mutex_unlock (&cache->lock);
+}
+
+static DiscovererCache *
+cache_new (const gchar * filename, guint max_entries)
+{
+  DiscovererCache *cache = g_slice_new0 (DiscovererCache);
+
+  cache->refcount = 1;
+  g_mutex_init (&cache->lock);
+  cache->filename = g_strdup (filename);
+  cache->max_entries = max_entries;
+  cache->entries = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+      (GDestroyNotify) cache_entry_free);
+  g_queue_init (&cache->lru);
+
+  cache_load (cache);
+
+  return cache;
+}
+
+static DiscovererCache *
+cache_ref (DiscovererCache * cache)
+{
+  g_atomic_int_inc (&cache->refcount);
+  return cache;
+}
+
+static void
+cache_unref (DiscovererCache * cache)
+{
+  if (!g_atomic_int_dec_and_test (&cache->refcount))
+    return;
+
+  cache_flush (cache);
+
+  /* entries are owned by the hash table, their links by the entries */
+  g_hash_table_destroy (cache->entries);
+  g_free (cache->filename);
+  g_mutex_clear (&cache->lock);
+  g_slice_free (DiscovererCache, cache);
+}
+
+static void
+cache_set_max_entries (DiscovererCache * cache, guint max_entries)
+{
+  g_mutex_lock (&cache->lock);
+  cache->max_entries = max_entries;
+  while (cache->lru.length > cache->max_entries) {
+    cache_remove_locked (cache, cache->lru.tail->data);
+    cache->dirty = TRUE;
+  }
+  g_mutex_unlock (&cache->lock);
+}
+
+static gboolean
+get_file_identity (const gchar * uri, FileIdentity * identity)
+{
+  GStatBuf st;
+  gchar *filename;
+  gint res;
+
+  filename = g_filename_from_uri (uri, NULL, NULL);
+  if (filename == NULL)
+    return FALSE;
+
+  res = g_stat (filename, &st);
+  g_free (filename);
+  if (res != 0)
+    return FALSE;
+
+  identity->size = st.st_size;
+  identity->mtime = st.st_mtime;
+  identity->inode = st.st_ino;
+
+  return TRUE;
+}
+
+/* Looks up @uri in the cache and remembers its identity, so the result can be
+ * stored afterwards if it was not cached */
+static GstDiscovererInfo *
+discoverer_cache_lookup (GstDiscoverer * dc, const gchar * uri)
+{
+  DiscovererCache *cache = dc->priv->cache;
+  FileIdentity *identity = &dc->priv->current_identity;
+  CacheEntry *entry;
+  GVariant *variant = NULL;
+  GstDiscovererInfo *info;
+
+  dc->priv->current_cacheable = get_file_identity (uri, identity);
+  if (!dc->priv->current_cacheable)
+    return NULL;
+
+  g_mutex_lock (&cache->lock);
+  entry = g_hash_table_lookup (cache->entries, uri);
+  if (entry && memcmp (&entry->identity, identity, sizeof (*identity)) != 0) {
+    GST_DEBUG ("Cached result for %s is outdated", uri);
+    cache_remove_locked (cache, entry);
+    cache->dirty = TRUE;
+    entry = NULL;
+  }
+  if (entry) {
+    g_queue_unlink (&cache->lru, &entry->link);
+    g_queue_push_head_link (&cache->lru, &entry->link);
+    variant = g_variant_ref (entry->info);
+    cache->hits++;
+  } else {
+    cache->misses++;
+  }
+  g_mutex_unlock (&cache->lock);
+
+  if (variant == NULL)
+    return NULL;
+
+  info = gst_discoverer_info_from_variant (variant);
+  g_variant_unref (variant);
+
+  return info;
+}
+
+static void
+discoverer_cache_store (GstDiscoverer * dc, GstDiscovererInfo * info)
+{
+  DiscovererCache *cache = dc->priv->cache;
+  CacheEntry *entry;
+
+  /* only complete results can be serialized, and failures might be
+   * transient */
+  if (info->result != GST_DISCOVERER_OK || info->stream_info == NULL)
+    return;
+
+  entry = g_slice_new0 (CacheEntry);
+  entry->uri = g_strdup (info->uri);
+  entry->identity = dc->priv->current_identity;
+  entry->info = g_variant_ref_sink (gst_discoverer_info_to_variant (info,
+          GST_DISCOVERER_SERIALIZE_ALL));
+
+  g_mutex_lock (&cache->lock);
+  cache_insert_locked (cache, entry);
+  cache->dirty = TRUE;
+  g_mutex_unlock (&cache->lock);
+}
+
 static void
 _do_init (void)
 {
@@ -170,17 +520,27 @@ enum
 };
 
 #define DEFAULT_PROP_TIMEOUT 15 * GST_SECOND
+#define DEFAULT_PROP_MAX_CONCURRENCY 1
+#define DEFAULT_PROP_CACHE_FILE NULL
+#define DEFAULT_PROP_CACHE_MAX_ENTRIES 100000
+#define DEFAULT_PROP_PARSE_ONLY FALSE
 
 enum
 {
   PROP_0,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_MAX_CONCURRENCY,
+  PROP_CACHE_FILE,
+  PROP_CACHE_MAX_ENTRIES,
+  PROP_PARSE_ONLY
 };
 
 static guint gst_discoverer_signals[LAST_SIGNAL] = { 0 };
 
 static void gst_discoverer_set_timeout (GstDiscoverer * dc,
     GstClockTime timeout);
+static void gst_discoverer_set_cache_file (GstDiscoverer * dc,
+    const gchar * filename);
 static gboolean async_timeout_cb (GstDiscoverer * dc);
 
 static void discoverer_bus_cb (GstBus * bus, GstMessage * msg,
@@ -193,6 +553,8 @@ static void uridecodebin_no_more_pads_cb (GstElement * uridecodebin,
     GstDiscoverer * dc);
 static void uridecodebin_source_changed_cb (GstElement * uridecodebin,
     GParamSpec * pspec, GstDiscoverer * dc);
+static gboolean uridecodebin_autoplug_continue_cb (GstElement * uridecodebin,
+    GstPad * pad, GstCaps * caps, GstDiscoverer * dc);
 
 static void gst_discoverer_dispose (GObject * dc);
 static void gst_discoverer_finalize (GObject * dc);
@@ -227,6 +589,82 @@ gst_discoverer_class_init (GstDiscovererClass * klass)
           GST_SECOND, 3600 * GST_SECOND, DEFAULT_PROP_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDiscoverer:max-concurrency:
+   *
+   * The maximum number of URIs that are discovered in parallel in
+   * asynchronous mode. Each of them is handled by its own pipeline, which is
+   * reused for the following URIs. The #GstDiscoverer::discovered signal is
+   * still emitted once per URI, but not necessarily in the order in which
+   * the URIs were added, and the #GstDiscoverer:timeout applies to each URI
+   * individually.
+   *
+   * Changes only take effect on the next call to gst_discoverer_start().
+   * Synchronous discovery with gst_discoverer_discover_uri() is not affected.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_CONCURRENCY,
+      g_param_spec_uint ("max-concurrency", "Max concurrency",
+          "Maximum number of URIs discovered in parallel in async mode",
+          1, G_MAXUINT, DEFAULT_PROP_MAX_CONCURRENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDiscoverer:cache-file:
+   *
+   * Path of a file in which successful results for local files are cached.
+   * A cached result is used instead of analyzing the file again as long as
+   * the size, modification time and inode of the file did not change. Note
+   * that a cached #GstDiscovererInfo only contains what
+   * gst_discoverer_info_to_variant() serializes, so no #GstToc.
+   *
+   * The file is loaded when this property is set and written back when the
+   * discoverer is stopped or disposed. Set to %NULL to disable the cache.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_CACHE_FILE,
+      g_param_spec_string ("cache-file", "Cache file",
+          "File in which discovered results are cached (NULL = disabled)",
+          DEFAULT_PROP_CACHE_FILE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDiscoverer:cache-max-entries:
+   *
+   * The maximum number of results kept in the #GstDiscoverer:cache-file. The
+   * least recently used ones are dropped first.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_CACHE_MAX_ENTRIES,
+      g_param_spec_uint ("cache-max-entries", "Cache max entries",
+          "Maximum number of results kept in the cache", 1, G_MAXUINT,
+          DEFAULT_PROP_CACHE_MAX_ENTRIES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDiscoverer:parse-only:
+   *
+   * If %TRUE, streams are not decoded if the caps produced by their demuxer
+   * or parser already contain the sample rate and number of channels, or
+   * the width and height. Decoders are then only instantiated for streams
+   * whose caps are incomplete.
+   *
+   * This saves loading codec libraries and decoding the first frames, but
+   * the caps of the resulting #GstDiscovererStreamInfo are the encoded ones,
+   * and information only known after decoding (like the sample format of
+   * raw audio) is not available for those streams.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_PARSE_ONLY,
+      g_param_spec_boolean ("parse-only", "Parse only",
+          "Only decode streams for which the parsed caps are incomplete",
+          DEFAULT_PROP_PARSE_ONLY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* signals */
   /**
    * GstDiscoverer::finished:
@@ -313,7 +751,11 @@ gst_discoverer_init (GstDiscoverer * dc)
   dc->priv = gst_discoverer_get_instance_private (dc);
 
   dc->priv->timeout = DEFAULT_PROP_TIMEOUT;
+  dc->priv->max_concurrency = DEFAULT_PROP_MAX_CONCURRENCY;
+  dc->priv->cache_max_entries = DEFAULT_PROP_CACHE_MAX_ENTRIES;
+  dc->priv->parse_only = DEFAULT_PROP_PARSE_ONLY;
   dc->priv->async = FALSE;
+  g_queue_init (&dc->priv->idle_workers);
 
   g_mutex_init (&dc->priv->lock);
 
@@ -347,6 +789,9 @@ gst_discoverer_init (GstDiscoverer * dc)
   dc->priv->source_chg_id =
       g_signal_connect_object (dc->priv->uridecodebin, "notify::source",
       G_CALLBACK (uridecodebin_source_changed_cb), dc, 0);
+  dc->priv->autoplug_continue_id =
+      g_signal_connect_object (dc->priv->uridecodebin, "autoplug-continue",
+      G_CALLBACK (uridecodebin_autoplug_continue_cb), dc, 0);
 
   GST_LOG_OBJECT (dc, "Getting pipeline bus");
   dc->priv->bus = gst_pipeline_get_bus ((GstPipeline *) dc->priv->pipeline);
@@ -408,6 +853,8 @@ gst_discoverer_dispose (GObject * obj)
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->no_more_pads_id);
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->source_chg_id);
     DISCONNECT_SIGNAL (dc->priv->uridecodebin, dc->priv->element_added_id);
+    DISCONNECT_SIGNAL (dc->priv->uridecodebin,
+        dc->priv->autoplug_continue_id);
     DISCONNECT_SIGNAL (dc->priv->bus, dc->priv->bus_cb_id);
 
     /* pipeline was set to NULL in _reset */
@@ -427,6 +874,11 @@ gst_discoverer_dispose (GObject * obj)
     dc->priv->seeking_query = NULL;
   }
 
+  if (dc->priv->cache) {
+    cache_unref (dc->priv->cache);
+    dc->priv->cache = NULL;
+  }
+
   G_OBJECT_CLASS (gst_discoverer_parent_class)->dispose (obj);
 }
 
@@ -436,6 +888,7 @@ gst_discoverer_finalize (GObject * obj)
   GstDiscoverer *dc = (GstDiscoverer *) obj;
 
   g_mutex_clear (&dc->priv->lock);
+  g_free (dc->priv->cache_file);
 
   G_OBJECT_CLASS (gst_discoverer_parent_class)->finalize (obj);
 }
@@ -450,6 +903,26 @@ gst_discoverer_set_property (GObject * object, guint prop_id,
     case PROP_TIMEOUT:
       gst_discoverer_set_timeout (dc, g_value_get_uint64 (value));
       break;
+    case PROP_MAX_CONCURRENCY:
+      DISCO_LOCK (dc);
+      dc->priv->max_concurrency = g_value_get_uint (value);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_CACHE_FILE:
+      gst_discoverer_set_cache_file (dc, g_value_get_string (value));
+      break;
+    case PROP_CACHE_MAX_ENTRIES:
+      DISCO_LOCK (dc);
+      dc->priv->cache_max_entries = g_value_get_uint (value);
+      if (dc->priv->cache)
+        cache_set_max_entries (dc->priv->cache, dc->priv->cache_max_entries);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_PARSE_ONLY:
+      DISCO_LOCK (dc);
+      dc->priv->parse_only = g_value_get_boolean (value);
+      DISCO_UNLOCK (dc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -468,6 +941,26 @@ gst_discoverer_get_property (GObject * object, guint prop_id,
       g_value_set_uint64 (value, dc->priv->timeout);
       DISCO_UNLOCK (dc);
       break;
+    case PROP_MAX_CONCURRENCY:
+      DISCO_LOCK (dc);
+      g_value_set_uint (value, dc->priv->max_concurrency);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_CACHE_FILE:
+      DISCO_LOCK (dc);
+      g_value_set_string (value, dc->priv->cache_file);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_CACHE_MAX_ENTRIES:
+      DISCO_LOCK (dc);
+      g_value_set_uint (value, dc->priv->cache_max_entries);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_PARSE_ONLY:
+      DISCO_LOCK (dc);
+      g_value_set_boolean (value, dc->priv->parse_only);
+      DISCO_UNLOCK (dc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -482,7 +975,42 @@ gst_discoverer_set_timeout (GstDiscoverer * dc, GstClockTime timeout)
   /* FIXME : update current pending timeout if we're running */
   DISCO_LOCK (dc);
   dc->priv->timeout = timeout;
+  if (dc->priv->workers) {
+    guint i;
+
+    for (i = 0; i < dc->priv->workers->len; i++)
+      g_object_set (g_ptr_array_index (dc->priv->workers, i), "timeout",
+          timeout, NULL);
+  }
+  DISCO_UNLOCK (dc);
+}
+
+static void
+gst_discoverer_set_cache_file (GstDiscoverer * dc, const gchar * filename)
+{
+  DiscovererCache *old_cache;
+
+  GST_DEBUG_OBJECT (dc, "cache file : %s", GST_STR_NULL (filename));
+
+  DISCO_LOCK (dc);
+  old_cache = dc->priv->cache;
+  g_free (dc->priv->cache_file);
+  dc->priv->cache_file = g_strdup (filename);
+  dc->priv->cache = NULL;
   DISCO_UNLOCK (dc);
+
+  /* written back before the new one is loaded, in case it's the same file */
+  if (old_cache)
+    cache_unref (old_cache);
+
+  if (filename) {
+    DiscovererCache *cache;
+
+    cache = cache_new (filename, dc->priv->cache_max_entries);
+    DISCO_LOCK (dc);
+    dc->priv->cache = cache;
+    DISCO_UNLOCK (dc);
+  }
 }
 
 static GstPadProbeReturn
@@ -615,6 +1143,60 @@ uridecodebin_source_changed_cb (GstElement * uridecodebin,
   gst_object_unref (src);
 }
 
+/* TRUE if @caps contain everything collect_information() extracts from
+ * decoded audio and video caps */
+static gboolean
+caps_are_complete (const GstCaps * caps)
+{
+  GstStructure *s;
+  const gchar *name;
+
+  if (!gst_caps_is_fixed (caps))
+    return FALSE;
+
+  s = gst_caps_get_structure (caps, 0);
+  name = gst_structure_get_name (s);
+
+  if (g_str_has_prefix (name, "audio/"))
+    return gst_structure_has_field (s, "rate") &&
+        gst_structure_has_field (s, "channels");
+
+  if (g_str_has_prefix (name, "video/") || g_str_has_prefix (name, "image/"))
+    return gst_structure_has_field (s, "width") &&
+        gst_structure_has_field (s, "height");
+
+  return FALSE;
+}
+
+static gboolean
+uridecodebin_autoplug_continue_cb (GstElement * uridecodebin, GstPad * pad,
+    GstCaps * caps, GstDiscoverer * dc)
+{
+  GstElement *parent;
+  const gchar *klass;
+  gboolean stop;
+
+  if (!dc->priv->parse_only || !caps_are_complete (caps))
+    return TRUE;
+
+  /* Only trust the caps of demuxers and parsers, typefind results are often
+   * incomplete or not framed and need a parser for the duration */
+  parent = gst_pad_get_parent_element (pad);
+  if (parent == NULL)
+    return TRUE;
+
+  klass = gst_element_class_get_metadata (GST_ELEMENT_GET_CLASS (parent),
+      GST_ELEMENT_METADATA_KLASS);
+  stop = klass != NULL && (strstr (klass, "Demux") || strstr (klass, "Parse"))
+      && !strstr (klass, "Decoder");
+  gst_object_unref (parent);
+
+  if (stop)
+    GST_DEBUG_OBJECT (dc, "Not decoding %" GST_PTR_FORMAT, caps);
+
+  return !stop;
+}
+
 static void
 uridecodebin_pad_added_cb (GstElement * uridecodebin, GstPad * pad,
     GstDiscoverer * dc)
@@ -1419,6 +2001,10 @@ discoverer_collect (GstDiscoverer * dc)
     }
   }
 
+  if (dc->priv->cache && dc->priv->current_cacheable &&
+      !dc->priv->current_cached)
+    discoverer_cache_store (dc, dc->priv->current_info);
+
   if (dc->priv->async) {
     GST_DEBUG ("Emitting 'discoverered'");
     g_signal_emit (dc, gst_discoverer_signals[SIGNAL_DISCOVERED], 0,
@@ -1454,8 +2040,12 @@ handle_current_async (GstDiscoverer * dc)
     get_async_cb,
   };
 
-  /* Attach a timeout to the main context */
-  source = g_timeout_source_new (dc->priv->timeout / GST_MSECOND);
+  /* Attach a timeout to the main context, or report a cached result right
+   * away */
+  if (dc->priv->current_cached)
+    source = g_idle_source_new ();
+  else
+    source = g_timeout_source_new (dc->priv->timeout / GST_MSECOND);
   g_source_set_callback_indirect (source, g_object_ref (dc), &cb_funcs);
   dc->priv->timeoutid = g_source_attach (source, dc->priv->ctx);
   g_source_unref (source);
@@ -1642,6 +2232,9 @@ handle_current_sync (GstDiscoverer * dc)
   GstMessage *msg;
   gboolean done = FALSE;
 
+  if (dc->priv->current_cached)
+    return;
+
   timer = g_timer_new ();
   g_timer_start (timer);
 
@@ -1675,16 +2268,30 @@ static void
 _setup_locked (GstDiscoverer * dc)
 {
   GstStateChangeReturn ret;
+  gchar *uri;
 
   GST_DEBUG ("Setting up");
 
   /* Pop URI off the pending URI list */
-  dc->priv->current_info =
-      (GstDiscovererInfo *) g_object_new (GST_TYPE_DISCOVERER_INFO, NULL);
-  dc->priv->current_info->uri = (gchar *) dc->priv->pending_uris->data;
+  uri = (gchar *) dc->priv->pending_uris->data;
   dc->priv->pending_uris =
       g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
 
+  if (dc->priv->cache)
+    dc->priv->current_info = discoverer_cache_lookup (dc, uri);
+
+  if (dc->priv->current_info) {
+    GST_DEBUG ("Using cached result for %s", uri);
+    g_free (dc->priv->current_info->uri);
+    dc->priv->current_info->uri = uri;
+    dc->priv->current_cached = TRUE;
+    return;
+  }
+
+  dc->priv->current_info =
+      (GstDiscovererInfo *) g_object_new (GST_TYPE_DISCOVERER_INFO, NULL);
+  dc->priv->current_info->uri = uri;
+
   /* set uri on uridecodebin */
   g_object_set (dc->priv->uridecodebin, "uri", dc->priv->current_info->uri,
       NULL);
@@ -1754,6 +2361,8 @@ discoverer_cleanup (GstDiscoverer * dc)
   dc->priv->target_state = GST_STATE_NULL;
   dc->priv->no_more_pads = FALSE;
   dc->priv->cleanup = FALSE;
+  dc->priv->current_cacheable = FALSE;
+  dc->priv->current_cached = FALSE;
 
 
   /* Try popping the next uri */
@@ -1795,8 +2404,10 @@ async_timeout_cb (GstDiscoverer * dc)
 {
   if (!g_source_is_destroyed (g_main_current_source ())) {
     dc->priv->timeoutid = 0;
-    GST_DEBUG ("Setting result to TIMEOUT");
-    dc->priv->current_info->result = GST_DISCOVERER_TIMEOUT;
+    if (!dc->priv->current_cached) {
+      GST_DEBUG ("Setting result to TIMEOUT");
+      dc->priv->current_info->result = GST_DISCOVERER_TIMEOUT;
+    }
     dc->priv->processing = FALSE;
     discoverer_collect (dc);
     discoverer_cleanup (dc);
@@ -1847,6 +2458,160 @@ beach:
   return res;
 }
 
+/* Worker pool for parallel discovery in async mode.
+ *
+ * Each worker is a GstDiscoverer of its own, running asynchronously on the
+ * same main context. Workers are handed one URI at a time and their results
+ * are forwarded, so the per-URI signals and timeouts stay exactly the same
+ * as without the pool. */
+
+static void
+worker_discovered_cb (GstDiscoverer * worker, GstDiscovererInfo * info,
+    GError * err, GstDiscoverer * dc)
+{
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_DISCOVERED], 0, info, err);
+}
+
+static void
+worker_source_setup_cb (GstDiscoverer * worker, GstElement * source,
+    GstDiscoverer * dc)
+{
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_SOURCE_SETUP], 0, source);
+}
+
+/* Must be called with the lock */
+static gboolean
+pool_is_idle_locked (GstDiscoverer * dc)
+{
+  return g_queue_get_length (&dc->priv->idle_workers) == dc->priv->workers->len;
+}
+
+/* Hands pending URIs to idle workers until either runs out */
+static void
+pool_dispatch (GstDiscoverer * dc)
+{
+  GstDiscoverer *worker;
+  gchar *uri;
+
+  DISCO_LOCK (dc);
+  while (dc->priv->pending_uris && !g_queue_is_empty (&dc->priv->idle_workers)) {
+    worker = g_queue_pop_head (&dc->priv->idle_workers);
+    uri = (gchar *) dc->priv->pending_uris->data;
+    dc->priv->pending_uris =
+        g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
+    DISCO_UNLOCK (dc);
+
+    GST_DEBUG_OBJECT (dc, "Handing %s to worker %" GST_PTR_FORMAT, uri, worker);
+    gst_discoverer_discover_uri_async (worker, uri);
+    g_free (uri);
+
+    DISCO_LOCK (dc);
+  }
+  DISCO_UNLOCK (dc);
+}
+
+/* Emitted by a worker after each URI, since it never has more than one */
+static void
+worker_finished_cb (GstDiscoverer * worker, GstDiscoverer * dc)
+{
+  gboolean done;
+
+  DISCO_LOCK (dc);
+  g_queue_push_tail (&dc->priv->idle_workers, worker);
+  done = dc->priv->pending_uris == NULL && pool_is_idle_locked (dc);
+  DISCO_UNLOCK (dc);
+
+  if (done)
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_FINISHED], 0);
+  else
+    pool_dispatch (dc);
+}
+
+static void
+pool_add_uri (GstDiscoverer * dc, const gchar * uri)
+{
+  gboolean starting = FALSE;
+
+  DISCO_LOCK (dc);
+  if (dc->priv->workers)
+    starting = dc->priv->pending_uris == NULL && pool_is_idle_locked (dc);
+  dc->priv->pending_uris =
+      g_list_append (dc->priv->pending_uris, g_strdup (uri));
+  DISCO_UNLOCK (dc);
+
+  /* Not started yet, the URI will be picked up by gst_discoverer_start() */
+  if (dc->priv->workers == NULL)
+    return;
+
+  if (starting)
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_STARTING], 0);
+  pool_dispatch (dc);
+}
+
+static void
+pool_start (GstDiscoverer * dc)
+{
+  GstDiscoverer *worker;
+  gboolean starting;
+  guint i;
+
+  GST_DEBUG_OBJECT (dc, "Starting %u workers", dc->priv->max_concurrency);
+
+  dc->priv->workers = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < dc->priv->max_concurrency; i++) {
+    worker = gst_discoverer_new (dc->priv->timeout, NULL);
+    if (G_UNLIKELY (worker == NULL))
+      break;
+
+    worker->priv->parse_only = dc->priv->parse_only;
+    if (dc->priv->cache)
+      worker->priv->cache = cache_ref (dc->priv->cache);
+
+    g_signal_connect (worker, "discovered",
+        G_CALLBACK (worker_discovered_cb), dc);
+    g_signal_connect (worker, "source-setup",
+        G_CALLBACK (worker_source_setup_cb), dc);
+    g_signal_connect (worker, "finished", G_CALLBACK (worker_finished_cb), dc);
+    gst_discoverer_start (worker);
+
+    DISCO_LOCK (dc);
+    g_ptr_array_add (dc->priv->workers, worker);
+    g_queue_push_tail (&dc->priv->idle_workers, worker);
+    DISCO_UNLOCK (dc);
+  }
+
+  DISCO_LOCK (dc);
+  starting = dc->priv->pending_uris != NULL;
+  DISCO_UNLOCK (dc);
+
+  if (starting) {
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_STARTING], 0);
+    pool_dispatch (dc);
+  }
+}
+
+static void
+pool_stop (GstDiscoverer * dc)
+{
+  GstDiscoverer *worker;
+  GPtrArray *workers;
+  guint i;
+
+  DISCO_LOCK (dc);
+  workers = dc->priv->workers;
+  dc->priv->workers = NULL;
+  g_queue_clear (&dc->priv->idle_workers);
+  DISCO_UNLOCK (dc);
+
+  for (i = 0; i < workers->len; i++) {
+    worker = g_ptr_array_index (workers, i);
+    g_signal_handlers_disconnect_by_data (worker, dc);
+    gst_discoverer_stop (worker);
+  }
+  g_ptr_array_free (workers, TRUE);
+}
+
 /* Serializing code */
 
 static GVariant *
@@ -2202,7 +2967,10 @@ gst_discoverer_start (GstDiscoverer * discoverer)
   g_source_unref (source);
   discoverer->priv->ctx = g_main_context_ref (ctx);
 
-  start_discovering (discoverer);
+  if (discoverer->priv->max_concurrency > 1)
+    pool_start (discoverer);
+  else
+    start_discovering (discoverer);
   GST_DEBUG_OBJECT (discoverer, "Started");
 }
 
@@ -2240,6 +3008,12 @@ gst_discoverer_stop (GstDiscoverer * discoverer)
   discoverer->priv->running = FALSE;
   DISCO_UNLOCK (discoverer);
 
+  if (discoverer->priv->workers)
+    pool_stop (discoverer);
+
+  if (discoverer->priv->cache)
+    cache_flush (discoverer->priv->cache);
+
   /* Remove timeout handler */
   if (discoverer->priv->timeoutid) {
     g_source_remove (discoverer->priv->timeoutid);
@@ -2287,6 +3061,11 @@ gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
 
   GST_DEBUG_OBJECT (discoverer, "uri : %s", uri);
 
+  if (discoverer->priv->workers || discoverer->priv->max_concurrency > 1) {
+    pool_add_uri (discoverer, uri);
+    return TRUE;
+  }
+
   DISCO_LOCK (discoverer);
   can_run = (discoverer->priv->pending_uris == NULL);
   discoverer->priv->pending_uris =
@@ -2363,6 +3142,48 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer, const gchar * uri,
   return info;
 }
 
+/**
+ * gst_discoverer_get_cache_stats:
+ * @discoverer: A #GstDiscoverer
+ *
+ * Returns statistics about the result cache configured with the
+ * #GstDiscoverer:cache-file property, in a structure named
+ * "application/x-discoverer-cache-stats" with the fields "entries" and
+ * "max-entries" (#G_TYPE_UINT), and "hits" and "misses" (#G_TYPE_UINT64).
+ * Lookups for URIs that are not local files are not counted.
+ *
+ * Returns: (transfer full) (nullable): the cache statistics, or %NULL if no
+ * cache is configured.
+ *
+ * Since: 1.16
+ */
+GstStructure *
+gst_discoverer_get_cache_stats (GstDiscoverer * discoverer)
+{
+  DiscovererCache *cache;
+  GstStructure *stats;
+
+  g_return_val_if_fail (GST_IS_DISCOVERER (discoverer), NULL);
+
+  DISCO_LOCK (discoverer);
+  cache = discoverer->priv->cache;
+  if (cache == NULL) {
+    DISCO_UNLOCK (discoverer);
+    return NULL;
+  }
+
+  g_mutex_lock (&cache->lock);
+  stats = gst_structure_new ("application/x-discoverer-cache-stats",
+      "entries", G_TYPE_UINT, cache->lru.length,
+      "max-entries", G_TYPE_UINT, cache->max_entries,
+      "hits", G_TYPE_UINT64, cache->hits,
+      "misses", G_TYPE_UINT64, cache->misses, NULL);
+  g_mutex_unlock (&cache->lock);
+  DISCO_UNLOCK (discoverer);
+
+  return stats;
+}
+
 /**
  * gst_discoverer_new:
  * @timeout: timeout per file, in nanoseconds. Allowed are values between
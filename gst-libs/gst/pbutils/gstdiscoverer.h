@@ -410,6 +410,11 @@ gst_discoverer_discover_uri (GstDiscoverer * discoverer,
 			     const gchar * uri,
 			     GError ** err);
 
+/* Result cache */
+
+GST_PBUTILS_API
+GstStructure * gst_discoverer_get_cache_stats (GstDiscoverer * discoverer);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstDiscoverer, gst_object_unref)
 #endif
@@ -1274,11 +1274,14 @@ fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
       if (size == 0)
         break;
 
-      /* try to read more bytes */
-      r = fill_raw_bytes (conn, in, sizeof (in), block, err);
+      /* try to read more bytes, only block until we have some output. A
+       * complete short message would otherwise wait for more data forever */
+      r = fill_raw_bytes (conn, in, sizeof (in), block && out == 0, err);
       if (r <= 0) {
         if (out == 0)
           out = r;
+        else
+          g_clear_error (err);
         break;
       }
 
@@ -1294,6 +1297,29 @@ fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
   return out;
 }
 
+/* convert the result @r and @err of a failed read or write to a
+ * #GstRTSPResult */
+static GstRTSPResult
+stream_error (gint r, GError ** err)
+{
+  if (G_UNLIKELY (r == 0))
+    return GST_RTSP_EEOF;
+
+  GST_DEBUG ("%s", (*err)->message);
+  if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_clear_error (err);
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
+    g_clear_error (err);
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
+    g_clear_error (err);
+    return GST_RTSP_ETIMEOUT;
+  }
+  g_clear_error (err);
+  return GST_RTSP_ESYS;
+}
+
 static GstRTSPResult
 read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
     gboolean block)
@@ -1310,32 +1336,101 @@ read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
   while (left) {
     r = fill_bytes (conn, &buffer[*idx], left, block, &err);
     if (G_UNLIKELY (r <= 0))
-      goto error;
+      return stream_error (r, &err);
 
     left -= r;
     *idx += r;
   }
   return GST_RTSP_OK;
+}
+
+/* Write the data in @vectors to @stream, starting at @offset bytes into the
+ * data. @offset is updated with the amount of written bytes, also when
+ * GST_RTSP_EINTR is returned because the write would block. @vectors is
+ * modified. */
+static GstRTSPResult
+writev_bytes (GOutputStream * stream, GOutputVector * vectors, guint n_vectors,
+    gsize * offset, gboolean block, GCancellable * cancellable)
+{
+  GError *err = NULL;
+  gsize skip = *offset;
+
+  /* skip what was written already */
+  while (n_vectors > 0 && skip >= vectors->size) {
+    skip -= vectors->size;
+    vectors++;
+    n_vectors--;
+  }
+  if (n_vectors > 0) {
+    vectors->buffer = (const guint8 *) vectors->buffer + skip;
+    vectors->size -= skip;
+  }
+
+  while (n_vectors > 0) {
+    gsize written;
+#if GLIB_CHECK_VERSION(2, 60, 0)
+    if (block) {
+      if (!g_output_stream_writev (stream, vectors, n_vectors, &written,
+              cancellable, &err))
+        goto error;
+    } else {
+      GPollableReturn ret;
+
+      ret = g_pollable_output_stream_writev_nonblocking
+          (G_POLLABLE_OUTPUT_STREAM (stream), vectors, n_vectors, &written,
+          cancellable, &err);
+      if (ret == G_POLLABLE_RETURN_WOULD_BLOCK)
+        return GST_RTSP_EINTR;
+      else if (ret == G_POLLABLE_RETURN_FAILED)
+        goto error;
+    }
+#else
+    {
+      guint8 *data;
+      gsize size = 0, pos = 0;
+      gssize r;
+      guint i;
+
+      /* no vectored writes, still write all the data with one call */
+      for (i = 0; i < n_vectors; i++)
+        size += vectors[i].size;
+      data = g_malloc (size);
+      for (i = 0; i < n_vectors; i++) {
+        memcpy (data + pos, vectors[i].buffer, vectors[i].size);
+        pos += vectors[i].size;
+      }
+
+      if (block)
+        r = g_output_stream_write (stream, data, size, cancellable, &err);
+      else
+        r = g_pollable_output_stream_write_nonblocking (G_POLLABLE_OUTPUT_STREAM
+            (stream), data, size, cancellable, &err);
+      g_free (data);
+
+      if (G_UNLIKELY (r < 0))
+        goto error;
+      written = r;
+    }
+#endif
+    *offset += written;
+
+    /* advance to the first vector that was not completely written */
+    while (n_vectors > 0 && written >= vectors->size) {
+      written -= vectors->size;
+      vectors++;
+      n_vectors--;
+    }
+    if (n_vectors > 0) {
+      vectors->buffer = (const guint8 *) vectors->buffer + written;
+      vectors->size -= written;
+    }
+  }
+  return GST_RTSP_OK;
 
   /* ERRORS */
 error:
   {
-    if (G_UNLIKELY (r == 0))
-      return GST_RTSP_EEOF;
-
-    GST_DEBUG ("%s", err->message);
-    if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
-      g_clear_error (&err);
-      return GST_RTSP_ETIMEOUT;
-    }
-    g_clear_error (&err);
-    return GST_RTSP_ESYS;
+    return stream_error (-1, &err);
   }
 }
 
@@ -1647,6 +1742,200 @@ no_message:
   }
 }
 
+/* a message prepared for a vectored write, the body of data messages is
+ * not copied */
+typedef struct
+{
+  GString *str;                 /* serialized message, NULL for data */
+  guint8 data_header[4];        /* interleaved data header */
+  const guint8 *body;
+  guint body_size;
+} GstRTSPSerializedMessage;
+
+static gboolean
+serialize_message (GstRTSPConnection * conn, GstRTSPMessage * message,
+    GstRTSPSerializedMessage * serialized)
+{
+  memset (serialized, 0, sizeof (GstRTSPSerializedMessage));
+
+  if (message->type == GST_RTSP_MESSAGE_DATA) {
+    serialized->data_header[0] = '$';
+    serialized->data_header[1] = message->type_data.data.channel;
+    serialized->data_header[2] = (message->body_size >> 8) & 0xff;
+    serialized->data_header[3] = message->body_size & 0xff;
+    serialized->body = message->body;
+    serialized->body_size = message->body_size;
+    return TRUE;
+  }
+
+  serialized->str = message_to_string (conn, message);
+
+  return serialized->str != NULL;
+}
+
+static void
+serialized_message_clear (GstRTSPSerializedMessage * serialized)
+{
+  if (serialized->str)
+    g_string_free (serialized->str, TRUE);
+}
+
+/* serialize @n_messages @messages into @serialized and point @vectors, which
+ * needs room for 2 vectors per message, to the data. Returns the number of
+ * used vectors or -1 when a message could not be serialized. */
+static gint
+serialize_messages (GstRTSPConnection * conn, GstRTSPMessage * messages,
+    guint n_messages, GstRTSPSerializedMessage * serialized,
+    GOutputVector * vectors, gsize * total)
+{
+  gint n_vectors = 0;
+  guint i;
+
+  *total = 0;
+  for (i = 0; i < n_messages; i++) {
+    if (G_UNLIKELY (!serialize_message (conn, &messages[i], &serialized[i])))
+      goto no_message;
+
+    if (serialized[i].str) {
+      vectors[n_vectors].buffer = serialized[i].str->str;
+      vectors[n_vectors].size = serialized[i].str->len;
+      *total += vectors[n_vectors++].size;
+    } else {
+      vectors[n_vectors].buffer = serialized[i].data_header;
+      vectors[n_vectors].size = 4;
+      *total += vectors[n_vectors++].size;
+      if (serialized[i].body_size > 0) {
+        vectors[n_vectors].buffer = serialized[i].body;
+        vectors[n_vectors].size = serialized[i].body_size;
+        *total += vectors[n_vectors++].size;
+      }
+    }
+  }
+  return n_vectors;
+
+  /* ERRORS */
+no_message:
+  {
+    while (i-- > 0)
+      serialized_message_clear (&serialized[i]);
+    return -1;
+  }
+}
+
+/* copy the data in @vectors to a new buffer, leaving out the first @offset
+ * bytes */
+static guint8 *
+vectors_to_data (GOutputVector * vectors, guint n_vectors, gsize offset,
+    gsize * size)
+{
+  guint8 *data;
+  gsize pos = 0;
+  guint i;
+
+  *size = 0;
+  for (i = 0; i < n_vectors; i++)
+    *size += vectors[i].size;
+  *size -= offset;
+
+  data = g_malloc (*size);
+  for (i = 0; i < n_vectors; i++) {
+    gsize vsize = vectors[i].size;
+    const guint8 *vdata = vectors[i].buffer;
+
+    if (offset >= vsize) {
+      offset -= vsize;
+      continue;
+    }
+    memcpy (data + pos, vdata + offset, vsize - offset);
+    pos += vsize - offset;
+    offset = 0;
+  }
+  return data;
+}
+
+/**
+ * gst_rtsp_connection_send_messages:
+ * @conn: a #GstRTSPConnection
+ * @messages: (array length=n_messages): the messages to send
+ * @n_messages: the number of messages to send
+ * @timeout: a timeout value or %NULL
+ *
+ * Attempt to send @messages to the connected @conn, blocking up to
+ * the specified @timeout. @timeout can be %NULL, in which case this function
+ * might block forever.
+ *
+ * The messages are written with as few system calls as possible and the
+ * bodies of data messages are written without copying them.
+ *
+ * This function can be cancelled with gst_rtsp_connection_flush().
+ *
+ * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_connection_send_messages (GstRTSPConnection * conn,
+    GstRTSPMessage * messages, guint n_messages, GTimeVal * timeout)
+{
+  GstRTSPSerializedMessage *serialized;
+  GOutputVector *vectors;
+  GstRTSPResult res;
+  GstClockTime to;
+  gsize total, offset = 0;
+  gint n_vectors;
+  guint i;
+
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (messages != NULL || n_messages == 0, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->output_stream != NULL, GST_RTSP_EINVAL);
+
+  if (n_messages == 0)
+    return GST_RTSP_OK;
+
+  serialized = g_new (GstRTSPSerializedMessage, n_messages);
+  vectors = g_new (GOutputVector, 2 * n_messages);
+
+  n_vectors = serialize_messages (conn, messages, n_messages, serialized,
+      vectors, &total);
+  if (G_UNLIKELY (n_vectors < 0))
+    goto no_message;
+
+  to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+  g_socket_set_timeout (conn->write_socket, (to + GST_SECOND - 1) / GST_SECOND);
+  if (conn->tunneled) {
+    gchar *data, *str;
+    guint idx = 0;
+
+    /* the tunnel needs all data base64 encoded, do it in one go */
+    data = (gchar *) vectors_to_data (vectors, n_vectors, 0, &total);
+    str = g_base64_encode ((const guchar *) data, total);
+    g_free (data);
+    res = write_bytes (conn->output_stream, (const guint8 *) str, &idx,
+        strlen (str), TRUE, conn->cancellable);
+    g_free (str);
+  } else {
+    res = writev_bytes (conn->output_stream, vectors, n_vectors, &offset, TRUE,
+        conn->cancellable);
+  }
+  g_socket_set_timeout (conn->write_socket, 0);
+
+  for (i = 0; i < n_messages; i++)
+    serialized_message_clear (&serialized[i]);
+  g_free (serialized);
+  g_free (vectors);
+
+  return res;
+
+no_message:
+  {
+    g_free (serialized);
+    g_free (vectors);
+    g_warning ("Wrong message");
+    return GST_RTSP_EINVAL;
+  }
+}
+
 static GstRTSPResult
 parse_string (gchar * dest, gint size, gchar ** src)
 {
@@ -1811,6 +2100,9 @@ parse_request_line (guint8 * buffer, GstRTSPMessage * msg)
   return res;
 }
 
+static void parse_header_value (GstRTSPMessage * msg, GstRTSPHeaderField field,
+    const gchar * field_name, gchar * value);
+
 /* parsing lines means reading a Key: Value pair */
 static GstRTSPResult
 parse_line (guint8 * buffer, GstRTSPMessage * msg)
@@ -1836,6 +2128,23 @@ parse_line (guint8 * buffer, GstRTSPMessage * msg)
   if (field == GST_RTSP_HDR_INVALID)
     field_name = line;
 
+  parse_header_value (msg, field, field_name, value);
+
+  return GST_RTSP_OK;
+
+  /* ERRORS */
+parse_error:
+  {
+    return GST_RTSP_EPARSE;
+  }
+}
+
+/* add the (possibly comma separated) values in @value as headers @field or
+ * @field_name to @msg. @value is modified in place. */
+static void
+parse_header_value (GstRTSPMessage * msg, GstRTSPHeaderField field,
+    const gchar * field_name, gchar * value)
+{
   /* split up the value in multiple key:value pairs if it contains comma(s) */
   while (*value != '\0') {
     gchar *next_value;
@@ -1931,14 +2240,6 @@ parse_line (guint8 * buffer, GstRTSPMessage * msg)
 
     value = next_value;
   }
-
-  return GST_RTSP_OK;
-
-  /* ERRORS */
-parse_error:
-  {
-    return GST_RTSP_EPARSE;
-  }
 }
 
 /* convert all consecutive whitespace to a single space */
@@ -1960,6 +2261,54 @@ normalize_line (guint8 * buffer)
   }
 }
 
+/* save the tunnel session and the session id of a received message of @type
+ * in @conn for further use */
+static void
+remember_message_state (GstRTSPConnection * conn, GstRTSPMsgType type,
+    const gchar * session_cookie, const gchar * session_id)
+{
+  /* save the tunnel session in the connection */
+  if (type == GST_RTSP_MESSAGE_HTTP_REQUEST &&
+      !conn->manual_http &&
+      conn->tstate == TUNNEL_STATE_NONE && session_cookie != NULL) {
+    strncpy (conn->tunnelid, session_cookie, TUNNELID_LEN);
+    conn->tunnelid[TUNNELID_LEN - 1] = '\0';
+    conn->tunneled = TRUE;
+  }
+
+  /* save session id in the connection for further use */
+  if (type == GST_RTSP_MESSAGE_RESPONSE && session_id != NULL) {
+    gint maxlen, i;
+
+    maxlen = sizeof (conn->session_id) - 1;
+    /* the sessionid can have attributes marked with ;
+     * Make sure we strip them */
+    for (i = 0; session_id[i] != '\0'; i++) {
+      if (session_id[i] == ';') {
+        maxlen = i;
+        /* parse timeout */
+        do {
+          i++;
+        } while (g_ascii_isspace (session_id[i]));
+        if (g_str_has_prefix (&session_id[i], "timeout=")) {
+          gint to;
+
+          /* if we parsed something valid, configure */
+          if ((to = atoi (&session_id[i + 8])) > 0)
+            conn->timeout = to;
+        }
+        break;
+      }
+    }
+
+    /* make sure to not overflow */
+    if (conn->remember_session_id) {
+      strncpy (conn->session_id, session_id, maxlen);
+      conn->session_id[maxlen] = '\0';
+    }
+  }
+}
+
 /* returns:
  *  GST_RTSP_OK when a complete message was read.
  *  GST_RTSP_EEOF: when the read socket is closed
@@ -2098,8 +2447,8 @@ build_next (GstRTSPBuilder * builder, GstRTSPMessage * message,
       }
       case STATE_END:
       {
-        gchar *session_cookie;
-        gchar *session_id;
+        gchar *session_cookie = NULL;
+        gchar *session_id = NULL;
 
         conn->may_cancel = TRUE;
 
@@ -2109,50 +2458,16 @@ build_next (GstRTSPBuilder * builder, GstRTSPMessage * message,
           goto done;
         }
 
-        /* save the tunnel session in the connection */
-        if (message->type == GST_RTSP_MESSAGE_HTTP_REQUEST &&
-            !conn->manual_http &&
-            conn->tstate == TUNNEL_STATE_NONE &&
-            gst_rtsp_message_get_header (message, GST_RTSP_HDR_X_SESSIONCOOKIE,
-                &session_cookie, 0) == GST_RTSP_OK) {
-          strncpy (conn->tunnelid, session_cookie, TUNNELID_LEN);
-          conn->tunnelid[TUNNELID_LEN - 1] = '\0';
-          conn->tunneled = TRUE;
-        }
+        if (message->type == GST_RTSP_MESSAGE_HTTP_REQUEST)
+          gst_rtsp_message_get_header (message, GST_RTSP_HDR_X_SESSIONCOOKIE,
+              &session_cookie, 0);
+        else if (message->type == GST_RTSP_MESSAGE_RESPONSE)
+          gst_rtsp_message_get_header (message, GST_RTSP_HDR_SESSION,
+              &session_id, 0);
 
-        /* save session id in the connection for further use */
-        if (message->type == GST_RTSP_MESSAGE_RESPONSE &&
-            gst_rtsp_message_get_header (message, GST_RTSP_HDR_SESSION,
-                &session_id, 0) == GST_RTSP_OK) {
-          gint maxlen, i;
-
-          maxlen = sizeof (conn->session_id) - 1;
-          /* the sessionid can have attributes marked with ;
-           * Make sure we strip them */
-          for (i = 0; session_id[i] != '\0'; i++) {
-            if (session_id[i] == ';') {
-              maxlen = i;
-              /* parse timeout */
-              do {
-                i++;
-              } while (g_ascii_isspace (session_id[i]));
-              if (g_str_has_prefix (&session_id[i], "timeout=")) {
-                gint to;
-
-                /* if we parsed something valid, configure */
-                if ((to = atoi (&session_id[i + 8])) > 0)
-                  conn->timeout = to;
-              }
-              break;
-            }
-          }
+        remember_message_state (conn, message->type, session_cookie,
+            session_id);
 
-          /* make sure to not overflow */
-          if (conn->remember_session_id) {
-            strncpy (conn->session_id, session_id, maxlen);
-            conn->session_id[maxlen] = '\0';
-          }
-        }
         res = builder->status;
         goto done;
       }
@@ -2206,137 +2521,1061 @@ gst_rtsp_connection_read (GstRTSPConnection * conn, guint8 * data, guint size,
 
   offset = 0;
 
-  /* configure timeout if any */
-  to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+  /* configure timeout if any */
+  to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+  g_socket_set_timeout (conn->read_socket, (to + GST_SECOND - 1) / GST_SECOND);
+  res = read_bytes (conn, data, &offset, size, TRUE);
+  g_socket_set_timeout (conn->read_socket, 0);
+
+  return res;
+}
+
+static GstRTSPMessage *
+gen_tunnel_reply (GstRTSPConnection * conn, GstRTSPStatusCode code,
+    const GstRTSPMessage * request)
+{
+  GstRTSPMessage *msg;
+  GstRTSPResult res;
+
+  if (gst_rtsp_status_as_text (code) == NULL)
+    code = GST_RTSP_STS_INTERNAL_SERVER_ERROR;
+
+  GST_RTSP_CHECK (gst_rtsp_message_new_response (&msg, code, NULL, request),
+      no_message);
+
+  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_SERVER,
+      "GStreamer RTSP Server");
+  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CONNECTION, "close");
+  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CACHE_CONTROL, "no-store");
+  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_PRAGMA, "no-cache");
+
+  if (code == GST_RTSP_STS_OK) {
+    /* add the local ip address to the tunnel reply, this is where the client
+     * should send the POST request to */
+    if (conn->local_ip)
+      gst_rtsp_message_add_header (msg, GST_RTSP_HDR_X_SERVER_IP_ADDRESS,
+          conn->local_ip);
+    gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CONTENT_TYPE,
+        "application/x-rtsp-tunnelled");
+  }
+
+  return msg;
+
+  /* ERRORS */
+no_message:
+  {
+    return NULL;
+  }
+}
+
+/* handle the HTTP messages of a tunnel setup. Returns GST_RTSP_OK when
+ * @message is a regular RTSP message. */
+static GstRTSPResult
+handle_http_message (GstRTSPConnection * conn, GstRTSPMessage * message,
+    GTimeVal * timeout)
+{
+  GstRTSPResult res = GST_RTSP_OK;
+
+  if (message->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
+    if (conn->tstate == TUNNEL_STATE_NONE &&
+        message->type_data.request.method == GST_RTSP_GET) {
+      GstRTSPMessage *response;
+
+      conn->tstate = TUNNEL_STATE_GET;
+
+      /* tunnel GET request, we can reply now */
+      response = gen_tunnel_reply (conn, GST_RTSP_STS_OK, message);
+      res = gst_rtsp_connection_send (conn, response, timeout);
+      gst_rtsp_message_free (response);
+      if (res == GST_RTSP_OK)
+        res = GST_RTSP_ETGET;
+    } else if (conn->tstate == TUNNEL_STATE_NONE &&
+        message->type_data.request.method == GST_RTSP_POST) {
+      conn->tstate = TUNNEL_STATE_POST;
+
+      /* tunnel POST request, the caller now has to link the two
+       * connections. */
+      res = GST_RTSP_ETPOST;
+    } else {
+      res = GST_RTSP_EPARSE;
+    }
+  } else if (message->type == GST_RTSP_MESSAGE_HTTP_RESPONSE) {
+    res = GST_RTSP_EPARSE;
+  }
+
+  return res;
+}
+
+/**
+ * gst_rtsp_connection_receive:
+ * @conn: a #GstRTSPConnection
+ * @message: the message to read
+ * @timeout: a timeout value or %NULL
+ *
+ * Attempt to read into @message from the connected @conn, blocking up to
+ * the specified @timeout. @timeout can be %NULL, in which case this function
+ * might block forever.
+ *
+ * This function can be cancelled with gst_rtsp_connection_flush().
+ *
+ * Returns: #GST_RTSP_OK on success.
+ */
+GstRTSPResult
+gst_rtsp_connection_receive (GstRTSPConnection * conn, GstRTSPMessage * message,
+    GTimeVal * timeout)
+{
+  GstRTSPResult res;
+  GstRTSPBuilder builder;
+  GstClockTime to;
+
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
+
+  /* configure timeout if any */
+  to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+  g_socket_set_timeout (conn->read_socket, (to + GST_SECOND - 1) / GST_SECOND);
+  memset (&builder, 0, sizeof (GstRTSPBuilder));
+  res = build_next (&builder, message, conn, TRUE);
+  g_socket_set_timeout (conn->read_socket, 0);
+
+  if (G_UNLIKELY (res != GST_RTSP_OK))
+    goto read_error;
+
+  if (!conn->manual_http) {
+    res = handle_http_message (conn, message, timeout);
+    if (res != GST_RTSP_OK)
+      goto cleanup;
+  }
+
+  /* we have a message here */
+  build_reset (&builder);
+
+  return GST_RTSP_OK;
+
+  /* ERRORS */
+read_error:
+cleanup:
+  {
+    build_reset (&builder);
+    gst_rtsp_message_unset (message);
+    return res;
+  }
+}
+
+/* the largest request/status line plus headers we accept from a peer */
+#define PARSER_MAX_HEADER_SIZE  (64 * 1024)
+/* the amount of bytes we try to read from the connection at once */
+#define PARSER_READ_SIZE        4096
+
+typedef struct
+{
+  GstRTSPHeaderField field;
+  gsize name;                   /* offset of the header name */
+  gsize value;                  /* offset of the header value */
+} GstRTSPParserHeader;
+
+struct _GstRTSPParser
+{
+  /* the receive buffer, all offsets below point into this */
+  guint8 *data;
+  gsize size;
+  gsize alloc;
+
+  gint state;
+  GstRTSPResult status;
+  gsize start;                  /* start of the current message */
+  gsize pos;                    /* start of the current line */
+  gsize scan;                   /* where to continue looking for a line end */
+  guint line;
+
+  GstRTSPMsgType type;
+  GstRTSPVersion version;
+  GstRTSPMethod method;
+  GstRTSPStatusCode code;
+  gsize uri;                    /* request uri or response reason */
+  guint8 channel;
+
+  GArray *headers;              /* GstRTSPParserHeader */
+
+  gboolean has_body;
+  gsize body;
+  gsize body_len;
+};
+
+/**
+ * gst_rtsp_parser_new:
+ *
+ * Create a new incremental RTSP message parser.
+ *
+ * Unlike gst_rtsp_connection_receive(), which builds a #GstRTSPMessage with
+ * copies of every header, the parser keeps the request line, the headers and
+ * the body of the last parsed message as slices of its receive buffer. Well
+ * known headers are looked up by their #GstRTSPHeaderField. A complete
+ * #GstRTSPMessage is only created when requested with
+ * gst_rtsp_parser_get_message().
+ *
+ * The receive buffer and the header index are reused between messages so
+ * that parsing a stream of messages does not allocate memory once the
+ * buffers have grown to the size of the largest message.
+ *
+ * Returns: (transfer full): a new #GstRTSPParser. Free with
+ * gst_rtsp_parser_free().
+ *
+ * Since: 1.16
+ */
+GstRTSPParser *
+gst_rtsp_parser_new (void)
+{
+  GstRTSPParser *parser;
+
+  parser = g_new0 (GstRTSPParser, 1);
+  parser->headers = g_array_sized_new (FALSE, FALSE,
+      sizeof (GstRTSPParserHeader), 16);
+
+  return parser;
+}
+
+/**
+ * gst_rtsp_parser_free:
+ * @parser: a #GstRTSPParser
+ *
+ * Free @parser and all its resources.
+ *
+ * Since: 1.16
+ */
+void
+gst_rtsp_parser_free (GstRTSPParser * parser)
+{
+  g_return_if_fail (parser != NULL);
+
+  g_free (parser->data);
+  g_array_free (parser->headers, TRUE);
+  g_free (parser);
+}
+
+static void
+parser_clear_message (GstRTSPParser * parser)
+{
+  parser->state = STATE_START;
+  parser->status = GST_RTSP_OK;
+  parser->line = 0;
+  parser->type = GST_RTSP_MESSAGE_INVALID;
+  parser->version = GST_RTSP_VERSION_INVALID;
+  parser->method = GST_RTSP_INVALID;
+  parser->code = GST_RTSP_STS_INVALID;
+  parser->uri = 0;
+  parser->channel = 0;
+  parser->has_body = FALSE;
+  parser->body = 0;
+  parser->body_len = 0;
+  g_array_set_size (parser->headers, 0);
+}
+
+/**
+ * gst_rtsp_parser_reset:
+ * @parser: a #GstRTSPParser
+ *
+ * Discard all buffered data and the last parsed message of @parser.
+ *
+ * Since: 1.16
+ */
+void
+gst_rtsp_parser_reset (GstRTSPParser * parser)
+{
+  g_return_if_fail (parser != NULL);
+
+  parser->size = 0;
+  parser->start = parser->pos = parser->scan = 0;
+  parser_clear_message (parser);
+}
+
+/* make room for @size more bytes at the end of the receive buffer */
+static guint8 *
+parser_reserve (GstRTSPParser * parser, gsize size)
+{
+  if (parser->size + size > parser->alloc) {
+    gsize alloc = MAX (parser->alloc, PARSER_READ_SIZE);
+
+    while (alloc < parser->size + size)
+      alloc *= 2;
+
+    parser->data = g_realloc (parser->data, alloc);
+    parser->alloc = alloc;
+  }
+  return &parser->data[parser->size];
+}
+
+/**
+ * gst_rtsp_parser_feed:
+ * @parser: a #GstRTSPParser
+ * @data: (array length=size): data to append
+ * @size: the size of @data
+ *
+ * Append @size bytes of @data to the receive buffer of @parser. @data can
+ * contain partial messages or several messages, call gst_rtsp_parser_parse()
+ * to extract them.
+ *
+ * Since: 1.16
+ */
+void
+gst_rtsp_parser_feed (GstRTSPParser * parser, const guint8 * data, gsize size)
+{
+  g_return_if_fail (parser != NULL);
+  g_return_if_fail (data != NULL || size == 0);
+
+  if (size == 0)
+    return;
+
+  memcpy (parser_reserve (parser, size), data, size);
+  parser->size += size;
+}
+
+/* drop the last message from the receive buffer and move the unparsed bytes
+ * to the front */
+static void
+parser_next_message (GstRTSPParser * parser)
+{
+  gsize left = parser->size - parser->pos;
+
+  if (left > 0 && parser->pos > 0)
+    memmove (parser->data, &parser->data[parser->pos], left);
+  parser->size = left;
+  parser->start = parser->pos = parser->scan = 0;
+
+  parser_clear_message (parser);
+}
+
+/* Find the next line in the receive buffer, handling \r, \n and \r\n line
+ * endings and folding lines starting with LWS like read_line() does. On
+ * success, @line points to the NUL terminated line in the receive buffer or
+ * is %NULL when an empty line was found. Returns GST_RTSP_EINTR when more
+ * data is needed. */
+static GstRTSPResult
+parser_read_line (GstRTSPParser * parser, gchar ** line)
+{
+  guint8 *data = parser->data;
+  gsize i;
+
+  for (i = parser->scan; i < parser->size; i++) {
+    gsize next;
+
+    if (data[i] != '\r' && data[i] != '\n')
+      continue;
+
+    next = i + 1;
+    if (data[i] == '\r') {
+      /* need to know if a \n follows */
+      if (next == parser->size)
+        break;
+      if (data[next] == '\n')
+        next++;
+    }
+
+    if (i == parser->pos) {
+      /* empty line, end of the headers */
+      parser->pos = parser->scan = next;
+      *line = NULL;
+      return GST_RTSP_OK;
+    }
+
+    /* need one more character to know if this is LWS */
+    if (next == parser->size)
+      break;
+
+    if (data[next] == ' ' || data[next] == '\t') {
+      /* got LWS, change the line ending to spaces and continue */
+      memset (&data[i], ' ', next - i);
+      continue;
+    }
+
+    data[i] = '\0';
+    *line = (gchar *) & data[parser->pos];
+    parser->pos = parser->scan = next;
+    return GST_RTSP_OK;
+  }
+  parser->scan = i;
+
+  return GST_RTSP_EINTR;
+}
+
+/* cut the next space separated token from @str */
+static gchar *
+parser_next_token (gchar ** str)
+{
+  gchar *token = *str, *end;
+
+  if ((end = strchr (token, ' ')) != NULL) {
+    *end++ = '\0';
+    *str = end;
+  } else {
+    *str = token + strlen (token);
+  }
+  return token;
+}
+
+/* parse the normalized request or status line in @line in place */
+static GstRTSPResult
+parser_parse_first_line (GstRTSPParser * parser, gchar * line)
+{
+  GstRTSPResult res = GST_RTSP_OK, res2;
+  gchar *bptr = line, *token, *version;
+
+  if (memcmp (line, "RTSP", 4) == 0 || memcmp (line, "HTTP", 4) == 0) {
+    gint code;
+
+    parser->type = GST_RTSP_MESSAGE_RESPONSE;
+
+    version = parser_next_token (&bptr);
+    token = parser_next_token (&bptr);
+    code = atoi (token);
+    if (G_UNLIKELY (*token == '\0' || strlen (token) > 3 || code < 0
+            || code >= 600))
+      res = GST_RTSP_EPARSE;
+
+    parser->code = code;
+    parser->uri = (guint8 *) bptr - parser->data;
+  } else {
+    parser->type = GST_RTSP_MESSAGE_REQUEST;
+
+    token = parser_next_token (&bptr);
+    parser->method = gst_rtsp_find_method (token);
+
+    token = parser_next_token (&bptr);
+    if (G_UNLIKELY (*token == '\0'))
+      res = GST_RTSP_EPARSE;
+    parser->uri = (guint8 *) token - parser->data;
+
+    version = parser_next_token (&bptr);
+    if (G_UNLIKELY (*bptr != '\0'))
+      res = GST_RTSP_EPARSE;
+  }
+
+  res2 = parse_protocol_version (version, &parser->type, &parser->version);
+  if (G_LIKELY (res == GST_RTSP_OK))
+    res = res2;
+
+  if (parser->type == GST_RTSP_MESSAGE_REQUEST) {
+    /* GET and POST are not allowed as RTSP methods */
+    if (parser->method == GST_RTSP_GET || parser->method == GST_RTSP_POST) {
+      parser->method = GST_RTSP_INVALID;
+      if (res == GST_RTSP_OK)
+        res = GST_RTSP_ERROR;
+    }
+  } else if (parser->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
+    /* only GET and POST are allowed as HTTP methods */
+    if (parser->method != GST_RTSP_GET && parser->method != GST_RTSP_POST) {
+      parser->method = GST_RTSP_INVALID;
+      if (res == GST_RTSP_OK)
+        res = GST_RTSP_ERROR;
+    }
+  }
+
+  return res;
+}
+
+/* index the normalized Key: Value pair in @line without copying it */
+static GstRTSPResult
+parser_parse_header (GstRTSPParser * parser, gchar * line)
+{
+  GstRTSPParserHeader header;
+  gchar *value;
+  gsize len;
+
+  if ((value = strchr (line, ':')) == NULL || value == line)
+    return GST_RTSP_EPARSE;
+
+  /* trim space before the colon */
+  if (value[-1] == ' ')
+    value[-1] = '\0';
+
+  /* replace the colon with a NUL */
+  *value++ = '\0';
+
+  /* trim leading and trailing space */
+  if (*value == ' ')
+    value++;
+  len = strlen (value);
+  if (len > 0 && value[len - 1] == ' ')
+    value[len - 1] = '\0';
+
+  header.field = gst_rtsp_find_header_field (line);
+  header.name = (guint8 *) line - parser->data;
+  header.value = (guint8 *) value - parser->data;
+  g_array_append_val (parser->headers, header);
+
+  return GST_RTSP_OK;
+}
+
+static const gchar *
+parser_find_header (GstRTSPParser * parser, GstRTSPHeaderField field,
+    const gchar * name, gint indx)
+{
+  guint i;
+
+  for (i = 0; i < parser->headers->len; i++) {
+    GstRTSPParserHeader *header;
+
+    header = &g_array_index (parser->headers, GstRTSPParserHeader, i);
+
+    if (name != NULL) {
+      if (header->field != GST_RTSP_HDR_INVALID ||
+          g_ascii_strcasecmp ((gchar *) & parser->data[header->name], name))
+        continue;
+    } else if (header->field != field) {
+      continue;
+    }
+
+    if (indx-- == 0)
+      return (const gchar *) &parser->data[header->value];
+  }
+  return NULL;
+}
+
+/* called when the headers are complete, see if we need to read a body */
+static GstRTSPResult
+parser_end_of_headers (GstRTSPParser * parser)
+{
+  const gchar *hdrval;
+
+  parser->body = parser->pos;
+
+  /* see if there is a Content-Length header, but ignore it if this is a POST
+   * request with an x-sessioncookie header */
+  hdrval = parser_find_header (parser, GST_RTSP_HDR_CONTENT_LENGTH, NULL, 0);
+  if (hdrval != NULL &&
+      (parser->type != GST_RTSP_MESSAGE_HTTP_REQUEST ||
+          parser->method != GST_RTSP_POST ||
+          parser_find_header (parser, GST_RTSP_HDR_X_SESSIONCOOKIE, NULL,
+              0) == NULL)) {
+    gint64 len = g_ascii_strtoll (hdrval, NULL, 10);
+
+    if (len < 0 || len > G_MAXUINT - 1)
+      return GST_RTSP_ERROR;
+
+    parser->has_body = TRUE;
+    parser->body_len = len;
+  }
+  parser->state = STATE_DATA_BODY;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_parse:
+ * @parser: a #GstRTSPParser
+ *
+ * Try to parse the next message from the data that was passed to
+ * gst_rtsp_parser_feed() or read with gst_rtsp_connection_receive_parser().
+ *
+ * When a complete message is available, its contents can be retrieved with
+ * the gst_rtsp_parser_parse_request(), gst_rtsp_parser_get_header() etc.
+ * functions until the next call to this function, which discards the message
+ * and continues with the next one.
+ *
+ * Returns: #GST_RTSP_OK when a complete message was parsed, #GST_RTSP_EINTR
+ * when more data is needed or an error when the message was malformed.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_parse (GstRTSPParser * parser)
+{
+  GstRTSPResult res;
+
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+
+  if (parser->state == STATE_END)
+    parser_next_message (parser);
+
+  while (TRUE) {
+    switch (parser->state) {
+      case STATE_START:
+      {
+        guint8 c;
+
+        /* skip \n and \r */
+        while (parser->pos < parser->size &&
+            (parser->data[parser->pos] == '\r' ||
+                parser->data[parser->pos] == '\n'))
+          parser->pos++;
+
+        if (parser->pos == parser->size)
+          return GST_RTSP_EINTR;
+
+        parser->start = parser->scan = parser->pos;
+
+        c = parser->data[parser->pos];
+        if (c == '$') {
+          /* data message, prepare for the header */
+          parser->state = STATE_DATA_HEADER;
+        } else {
+          parser->line = 0;
+          parser->state = STATE_READ_LINES;
+        }
+        break;
+      }
+      case STATE_DATA_HEADER:
+      {
+        guint8 *header;
+
+        if (parser->size - parser->pos < 4)
+          return GST_RTSP_EINTR;
+
+        header = &parser->data[parser->pos];
+        parser->type = GST_RTSP_MESSAGE_DATA;
+        parser->channel = header[1];
+        parser->has_body = TRUE;
+        parser->body_len = (header[2] << 8) | header[3];
+        parser->pos += 4;
+        parser->body = parser->pos;
+        parser->state = STATE_DATA_BODY;
+        break;
+      }
+      case STATE_DATA_BODY:
+      {
+        if (parser->size - parser->body < parser->body_len)
+          return GST_RTSP_EINTR;
+
+        parser->pos = parser->scan = parser->body + parser->body_len;
+        parser->state = STATE_END;
+        break;
+      }
+      case STATE_READ_LINES:
+      {
+        gchar *line;
+
+        res = parser_read_line (parser, &line);
+        if (res == GST_RTSP_EINTR) {
+          if (G_UNLIKELY (parser->size - parser->start >
+                  PARSER_MAX_HEADER_SIZE))
+            goto too_large;
+          return res;
+        }
+
+        if (line == NULL) {
+          /* empty line, end of message header */
+          res = parser_end_of_headers (parser);
+          if (res != GST_RTSP_OK)
+            goto invalid_body_len;
+          break;
+        }
+
+        /* we have a line */
+        normalize_line ((guint8 *) line);
+        if (parser->line == 0) {
+          parser->status = parser_parse_first_line (parser, line);
+        } else {
+          res = parser_parse_header (parser, line);
+          if (res != GST_RTSP_OK)
+            parser->status = res;
+        }
+        parser->line++;
+        break;
+      }
+      case STATE_END:
+        return parser->status;
+      default:
+        return GST_RTSP_ERROR;
+    }
+  }
+
+  /* ERRORS */
+too_large:
+  {
+    GST_WARNING ("message header larger than %d bytes",
+        PARSER_MAX_HEADER_SIZE);
+    return GST_RTSP_ENOMEM;
+  }
+invalid_body_len:
+  {
+    GST_DEBUG ("invalid body length");
+    return res;
+  }
+}
+
+/**
+ * gst_rtsp_parser_get_msg_type:
+ * @parser: a #GstRTSPParser
+ *
+ * Get the message type of the last message parsed by @parser.
+ *
+ * Returns: the message type or #GST_RTSP_MESSAGE_INVALID when no complete
+ * message was parsed.
+ *
+ * Since: 1.16
+ */
+GstRTSPMsgType
+gst_rtsp_parser_get_msg_type (GstRTSPParser * parser)
+{
+  g_return_val_if_fail (parser != NULL, GST_RTSP_MESSAGE_INVALID);
+
+  if (parser->state != STATE_END)
+    return GST_RTSP_MESSAGE_INVALID;
+
+  return parser->type;
+}
+
+/**
+ * gst_rtsp_parser_parse_request:
+ * @parser: a #GstRTSPParser
+ * @method: (out) (allow-none): location to hold the method
+ * @uri: (out) (allow-none) (transfer none): location to hold the uri
+ * @version: (out) (allow-none) (transfer none): location to hold the version
+ *
+ * Get the request line of the last request parsed by @parser. The result
+ * locations can be %NULL if one is not interested in its value.
+ *
+ * @uri points into the receive buffer of @parser and remains valid until the
+ * next call to gst_rtsp_parser_parse().
+ *
+ * Returns: a #GstRTSPResult.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_parse_request (GstRTSPParser * parser, GstRTSPMethod * method,
+    const gchar ** uri, GstRTSPVersion * version)
+{
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->type == GST_RTSP_MESSAGE_REQUEST ||
+      parser->type == GST_RTSP_MESSAGE_HTTP_REQUEST, GST_RTSP_EINVAL);
+
+  if (method)
+    *method = parser->method;
+  if (uri)
+    *uri = (const gchar *) &parser->data[parser->uri];
+  if (version)
+    *version = parser->version;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_parse_response:
+ * @parser: a #GstRTSPParser
+ * @code: (out) (allow-none): location to hold the status code
+ * @reason: (out) (allow-none) (transfer none): location to hold the status reason
+ * @version: (out) (allow-none) (transfer none): location to hold the version
+ *
+ * Get the status line of the last response parsed by @parser. The result
+ * locations can be %NULL if one is not interested in its value.
+ *
+ * @reason points into the receive buffer of @parser and remains valid until
+ * the next call to gst_rtsp_parser_parse().
+ *
+ * Returns: a #GstRTSPResult.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_parse_response (GstRTSPParser * parser,
+    GstRTSPStatusCode * code, const gchar ** reason, GstRTSPVersion * version)
+{
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->type == GST_RTSP_MESSAGE_RESPONSE ||
+      parser->type == GST_RTSP_MESSAGE_HTTP_RESPONSE, GST_RTSP_EINVAL);
+
+  if (code)
+    *code = parser->code;
+  if (reason)
+    *reason = (const gchar *) &parser->data[parser->uri];
+  if (version)
+    *version = parser->version;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_parse_data:
+ * @parser: a #GstRTSPParser
+ * @channel: (out): location to hold the channel
+ *
+ * Get the channel of the last data message parsed by @parser.
+ *
+ * Returns: a #GstRTSPResult.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_parse_data (GstRTSPParser * parser, guint8 * channel)
+{
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->type == GST_RTSP_MESSAGE_DATA,
+      GST_RTSP_EINVAL);
+
+  if (channel)
+    *channel = parser->channel;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_get_header:
+ * @parser: a #GstRTSPParser
+ * @field: a #GstRTSPHeaderField
+ * @value: (out) (transfer none): pointer to hold the result
+ * @indx: the index of the header
+ *
+ * Get the @indx header line with @field of the last message parsed by
+ * @parser.
+ *
+ * Unlike gst_rtsp_message_get_header(), the complete value of the header line
+ * is returned, header lines with multiple comma separated values are not
+ * split up.
+ *
+ * @value points into the receive buffer of @parser and remains valid until
+ * the next call to gst_rtsp_parser_parse().
+ *
+ * Returns: #GST_RTSP_OK when @field was found, #GST_RTSP_ENOTIMPL if the
+ * key was not found.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_get_header (GstRTSPParser * parser, GstRTSPHeaderField field,
+    const gchar ** value, gint indx)
+{
+  const gchar *val;
+
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (field != GST_RTSP_HDR_INVALID, GST_RTSP_EINVAL);
+
+  if ((val = parser_find_header (parser, field, NULL, indx)) == NULL)
+    return GST_RTSP_ENOTIMPL;
+
+  if (value)
+    *value = val;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_get_header_by_name:
+ * @parser: a #GstRTSPParser
+ * @header: a custom header string
+ * @value: (out) (transfer none): pointer to hold the result
+ * @indx: the index of the header
+ *
+ * Get the @indx header line with the custom name @header of the last message
+ * parsed by @parser. See gst_rtsp_parser_get_header().
+ *
+ * Returns: #GST_RTSP_OK when @header was found, #GST_RTSP_ENOTIMPL if the
+ * key was not found.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_get_header_by_name (GstRTSPParser * parser,
+    const gchar * header, const gchar ** value, gint indx)
+{
+  GstRTSPHeaderField field;
+  const gchar *val;
+
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (header != NULL, GST_RTSP_EINVAL);
+
+  field = gst_rtsp_find_header_field (header);
+  if (field != GST_RTSP_HDR_INVALID)
+    val = parser_find_header (parser, field, NULL, indx);
+  else
+    val = parser_find_header (parser, GST_RTSP_HDR_INVALID, header, indx);
+
+  if (val == NULL)
+    return GST_RTSP_ENOTIMPL;
+
+  if (value)
+    *value = val;
+
+  return GST_RTSP_OK;
+}
+
+/**
+ * gst_rtsp_parser_get_body:
+ * @parser: a #GstRTSPParser
+ * @data: (out) (transfer none) (array length=size): location for the data
+ * @size: (out): location for the size of @data
+ *
+ * Get the body of the last message parsed by @parser. The data is not NUL
+ * terminated, it points into the receive buffer of @parser and remains valid
+ * until the next call to gst_rtsp_parser_parse().
+ *
+ * Returns: #GST_RTSP_OK.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_get_body (GstRTSPParser * parser, const guint8 ** data,
+    guint * size)
+{
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (size != NULL, GST_RTSP_EINVAL);
 
-  g_socket_set_timeout (conn->read_socket, (to + GST_SECOND - 1) / GST_SECOND);
-  res = read_bytes (conn, data, &offset, size, TRUE);
-  g_socket_set_timeout (conn->read_socket, 0);
+  *data = parser->body_len ? &parser->data[parser->body] : NULL;
+  *size = parser->body_len;
 
-  return res;
+  return GST_RTSP_OK;
 }
 
-static GstRTSPMessage *
-gen_tunnel_reply (GstRTSPConnection * conn, GstRTSPStatusCode code,
-    const GstRTSPMessage * request)
+/**
+ * gst_rtsp_parser_get_message:
+ * @parser: a #GstRTSPParser
+ * @message: a #GstRTSPMessage to initialize
+ *
+ * Initialize @message with a copy of the last message parsed by @parser. The
+ * result is the same as what gst_rtsp_connection_receive() would have
+ * produced for the message.
+ *
+ * Returns: a #GstRTSPResult.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_parser_get_message (GstRTSPParser * parser, GstRTSPMessage * message)
 {
-  GstRTSPMessage *msg;
-  GstRTSPResult res;
+  guint i;
 
-  if (gst_rtsp_status_as_text (code) == NULL)
-    code = GST_RTSP_STS_INTERNAL_SERVER_ERROR;
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser->state == STATE_END, GST_RTSP_EINVAL);
+  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
-  GST_RTSP_CHECK (gst_rtsp_message_new_response (&msg, code, NULL, request),
-      no_message);
+  switch (parser->type) {
+    case GST_RTSP_MESSAGE_REQUEST:
+    case GST_RTSP_MESSAGE_HTTP_REQUEST:
+      gst_rtsp_message_init_request (message, parser->method,
+          (const gchar *) &parser->data[parser->uri]);
+      message->type_data.request.version = parser->version;
+      break;
+    case GST_RTSP_MESSAGE_RESPONSE:
+    case GST_RTSP_MESSAGE_HTTP_RESPONSE:
+      gst_rtsp_message_init_response (message, parser->code,
+          (const gchar *) &parser->data[parser->uri], NULL);
+      message->type_data.response.version = parser->version;
+      break;
+    case GST_RTSP_MESSAGE_DATA:
+      gst_rtsp_message_init_data (message, parser->channel);
+      break;
+    default:
+      return GST_RTSP_EINVAL;
+  }
+  message->type = parser->type;
 
-  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_SERVER,
-      "GStreamer RTSP Server");
-  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CONNECTION, "close");
-  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CACHE_CONTROL, "no-store");
-  gst_rtsp_message_add_header (msg, GST_RTSP_HDR_PRAGMA, "no-cache");
+  for (i = 0; i < parser->headers->len; i++) {
+    GstRTSPParserHeader *header;
+    gchar *value;
 
-  if (code == GST_RTSP_STS_OK) {
-    /* add the local ip address to the tunnel reply, this is where the client
-     * should send the POST request to */
-    if (conn->local_ip)
-      gst_rtsp_message_add_header (msg, GST_RTSP_HDR_X_SERVER_IP_ADDRESS,
-          conn->local_ip);
-    gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CONTENT_TYPE,
-        "application/x-rtsp-tunnelled");
+    header = &g_array_index (parser->headers, GstRTSPParserHeader, i);
+
+    /* splitting the value modifies it, keep the receive buffer intact */
+    value = g_strdup ((gchar *) & parser->data[header->value]);
+    parse_header_value (message, header->field,
+        (gchar *) & parser->data[header->name], value);
+    g_free (value);
   }
 
-  return msg;
+  if (parser->has_body) {
+    guint8 *body;
 
-  /* ERRORS */
-no_message:
-  {
-    return NULL;
+    /* like build_next(), store the body with a trailing '\0' */
+    body = g_malloc (parser->body_len + 1);
+    memcpy (body, &parser->data[parser->body], parser->body_len);
+    body[parser->body_len] = '\0';
+    gst_rtsp_message_take_body (message, body, parser->body_len + 1);
   }
+
+  return GST_RTSP_OK;
 }
 
 /**
- * gst_rtsp_connection_receive:
+ * gst_rtsp_connection_receive_parser:
  * @conn: a #GstRTSPConnection
- * @message: the message to read
+ * @parser: a #GstRTSPParser
  * @timeout: a timeout value or %NULL
  *
- * Attempt to read into @message from the connected @conn, blocking up to
- * the specified @timeout. @timeout can be %NULL, in which case this function
- * might block forever.
+ * Attempt to read the next message from the connected @conn into @parser,
+ * blocking up to the specified @timeout. @timeout can be %NULL, in which
+ * case this function might block forever.
+ *
+ * Data is read from @conn in large chunks, bytes following the message are
+ * kept in @parser for the next call. The same @parser should therefore be
+ * used for all messages of @conn and it must not be mixed with
+ * gst_rtsp_connection_receive() or gst_rtsp_connection_read().
+ *
+ * The HTTP requests of a tunnel setup are handled in the same way as
+ * gst_rtsp_connection_receive() does.
  *
  * This function can be cancelled with gst_rtsp_connection_flush().
  *
  * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.16
  */
 GstRTSPResult
-gst_rtsp_connection_receive (GstRTSPConnection * conn, GstRTSPMessage * message,
-    GTimeVal * timeout)
+gst_rtsp_connection_receive_parser (GstRTSPConnection * conn,
+    GstRTSPParser * parser, GTimeVal * timeout)
 {
   GstRTSPResult res;
-  GstRTSPBuilder builder;
   GstClockTime to;
 
   g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (parser != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
 
   /* configure timeout if any */
   to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
 
   g_socket_set_timeout (conn->read_socket, (to + GST_SECOND - 1) / GST_SECOND);
-  memset (&builder, 0, sizeof (GstRTSPBuilder));
-  res = build_next (&builder, message, conn, TRUE);
+  while ((res = gst_rtsp_parser_parse (parser)) == GST_RTSP_EINTR) {
+    GError *err = NULL;
+    guint8 *data;
+    gint r;
+
+    /* only allow cancellation in between messages */
+    conn->may_cancel = parser->state == STATE_START;
+
+    data = parser_reserve (parser, PARSER_READ_SIZE);
+    r = fill_bytes (conn, data, PARSER_READ_SIZE, TRUE, &err);
+    if (G_UNLIKELY (r <= 0)) {
+      res = stream_error (r, &err);
+      break;
+    }
+    parser->size += r;
+  }
+  conn->may_cancel = TRUE;
   g_socket_set_timeout (conn->read_socket, 0);
 
   if (G_UNLIKELY (res != GST_RTSP_OK))
-    goto read_error;
-
-  if (!conn->manual_http) {
-    if (message->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
-      if (conn->tstate == TUNNEL_STATE_NONE &&
-          message->type_data.request.method == GST_RTSP_GET) {
-        GstRTSPMessage *response;
-
-        conn->tstate = TUNNEL_STATE_GET;
-
-        /* tunnel GET request, we can reply now */
-        response = gen_tunnel_reply (conn, GST_RTSP_STS_OK, message);
-        res = gst_rtsp_connection_send (conn, response, timeout);
-        gst_rtsp_message_free (response);
-        if (res == GST_RTSP_OK)
-          res = GST_RTSP_ETGET;
-        goto cleanup;
-      } else if (conn->tstate == TUNNEL_STATE_NONE &&
-          message->type_data.request.method == GST_RTSP_POST) {
-        conn->tstate = TUNNEL_STATE_POST;
+    return res;
 
-        /* tunnel POST request, the caller now has to link the two
-         * connections. */
-        res = GST_RTSP_ETPOST;
-        goto cleanup;
-      } else {
-        res = GST_RTSP_EPARSE;
-        goto cleanup;
-      }
-    } else if (message->type == GST_RTSP_MESSAGE_HTTP_RESPONSE) {
-      res = GST_RTSP_EPARSE;
-      goto cleanup;
-    }
+  if (parser->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
+    remember_message_state (conn, parser->type,
+        parser_find_header (parser, GST_RTSP_HDR_X_SESSIONCOOKIE, NULL, 0),
+        NULL);
+  } else if (parser->type == GST_RTSP_MESSAGE_RESPONSE) {
+    remember_message_state (conn, parser->type, NULL,
+        parser_find_header (parser, GST_RTSP_HDR_SESSION, NULL, 0));
   }
 
-  /* we have a message here */
-  build_reset (&builder);
-
-  return GST_RTSP_OK;
+  if (!conn->manual_http && (parser->type == GST_RTSP_MESSAGE_HTTP_REQUEST ||
+          parser->type == GST_RTSP_MESSAGE_HTTP_RESPONSE)) {
+    GstRTSPMessage message = { 0 };
 
-  /* ERRORS */
-read_error:
-cleanup:
-  {
-    build_reset (&builder);
-    gst_rtsp_message_unset (message);
-    return res;
+    /* tunnel setup is rare, use the regular message for it */
+    gst_rtsp_parser_get_message (parser, &message);
+    res = handle_http_message (conn, &message, timeout);
+    gst_rtsp_message_unset (&message);
   }
+
+  return res;
 }
 
 /**
@@ -3140,9 +4379,13 @@ typedef struct
 {
   guint8 *data;
   guint size;
+  guint n_messages;             /* number of messages in data */
   guint id;
 } GstRTSPRec;
 
+/* the maximum number of queued records that are written with one call */
+#define WRITE_BATCH_SIZE  16
+
 /* async functions */
 struct _GstRTSPWatch
 {
@@ -3164,12 +4407,16 @@ struct _GstRTSPWatch
   GMutex mutex;
   GstQueueArray *messages;
   gsize messages_bytes;
-  guint8 *write_data;
-  guint write_off;
-  guint write_size;
-  guint write_id;
+  guint messages_count;
+  /* records being written */
+  GstRTSPRec write_recs[WRITE_BATCH_SIZE];
+  guint n_write_recs;
+  gsize write_off;
   gsize max_bytes;
   guint max_messages;
+  /* size of the last send that did not fit in the backlog */
+  gsize pending_bytes;
+  guint pending_messages;
   GCond queue_not_full;
   gboolean flushing;
 
@@ -3179,8 +4426,18 @@ struct _GstRTSPWatch
   GDestroyNotify notify;
 };
 
-#define IS_BACKLOG_FULL(w) (((w)->max_bytes != 0 && (w)->messages_bytes >= (w)->max_bytes) || \
-      ((w)->max_messages != 0 && gst_queue_array_get_length((w)->messages) >= (w)->max_messages))
+/* whether queueing @bytes more in @msgs messages would exceed the limits. An
+ * empty backlog takes anything, the data might be partially written already
+ * or be bigger than the limits */
+#define IS_BACKLOG_EXCEEDED(w,bytes,msgs) ((w)->messages_count != 0 && \
+    (((w)->max_bytes != 0 && \
+        (w)->messages_bytes + (bytes) > (w)->max_bytes) || \
+      ((w)->max_messages != 0 && \
+        (w)->messages_count + (msgs) > (w)->max_messages)))
+/* whether the last refused send would still not fit, or whether there is no
+ * room at all when nothing was refused yet */
+#define IS_BACKLOG_FULL(w) IS_BACKLOG_EXCEEDED (w, \
+    MAX ((w)->pending_bytes, 1), MAX ((w)->pending_messages, 1))
 
 static gboolean
 gst_rtsp_source_prepare (GSource * source, gint * timeout)
@@ -3431,12 +4688,23 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
 
   g_mutex_lock (&watch->mutex);
   do {
-    if (watch->write_data == NULL) {
-      GstRTSPRec *rec_ptr, rec;
+    GOutputVector vectors[WRITE_BATCH_SIZE];
+    guint i;
+
+    if (watch->n_write_recs == 0) {
+      GstRTSPRec *rec_ptr;
 
-      /* get a new message from the queue */
-      rec_ptr = gst_queue_array_pop_head_struct (watch->messages);
-      if (rec_ptr == NULL) {
+      /* get new messages from the queue, we write up to WRITE_BATCH_SIZE of
+       * them with one call */
+      while (watch->n_write_recs < WRITE_BATCH_SIZE &&
+          (rec_ptr = gst_queue_array_pop_head_struct (watch->messages))) {
+        watch->write_recs[watch->n_write_recs++] = *rec_ptr;
+        watch->messages_bytes -= rec_ptr->size;
+        watch->messages_count -= rec_ptr->n_messages;
+      }
+      watch->write_off = 0;
+
+      if (watch->n_write_recs == 0) {
         if (watch->writesrc) {
           if (!g_source_is_destroyed ((GSource *) watch))
             g_source_remove_child_source ((GSource *) watch, watch->writesrc);
@@ -3462,18 +4730,14 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
         }
         break;
       }
-
-      rec = *rec_ptr;
-      watch->messages_bytes -= rec.size;
-
-      watch->write_off = 0;
-      watch->write_data = rec.data;
-      watch->write_size = rec.size;
-      watch->write_id = rec.id;
     }
 
-    res = write_bytes (conn->output_stream, watch->write_data,
-        &watch->write_off, watch->write_size, FALSE, conn->cancellable);
+    for (i = 0; i < watch->n_write_recs; i++) {
+      vectors[i].buffer = watch->write_recs[i].data;
+      vectors[i].size = watch->write_recs[i].size;
+    }
+    res = writev_bytes (conn->output_stream, vectors, watch->n_write_recs,
+        &watch->write_off, FALSE, conn->cancellable);
 
     if (!IS_BACKLOG_FULL (watch))
       g_cond_signal (&watch->queue_not_full);
@@ -3482,15 +4746,19 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
     if (res == GST_RTSP_EINTR)
       goto write_blocked;
     else if (G_LIKELY (res == GST_RTSP_OK)) {
-      if (watch->funcs.message_sent)
-        watch->funcs.message_sent (watch, watch->write_id, watch->user_data);
+      if (watch->funcs.message_sent) {
+        for (i = 0; i < watch->n_write_recs; i++)
+          watch->funcs.message_sent (watch, watch->write_recs[i].id,
+              watch->user_data);
+      }
     } else {
       goto write_error;
     }
     g_mutex_lock (&watch->mutex);
 
-    g_free (watch->write_data);
-    watch->write_data = NULL;
+    for (i = 0; i < watch->n_write_recs; i++)
+      g_free (watch->write_recs[i].data);
+    watch->n_write_recs = 0;
   } while (TRUE);
   g_mutex_unlock (&watch->mutex);
 
@@ -3504,9 +4772,19 @@ eof:
   }
 write_error:
   {
+    guint i;
+    gsize off = watch->write_off;
+
+    /* find the record that failed */
+    for (i = 0; i + 1 < watch->n_write_recs; i++) {
+      if (off < watch->write_recs[i].size)
+        break;
+      off -= watch->write_recs[i].size;
+    }
+
     if (watch->funcs.error_full)
       watch->funcs.error_full (watch, res, NULL,
-          watch->write_id, watch->user_data);
+          watch->write_recs[i].id, watch->user_data);
     else if (watch->funcs.error)
       watch->funcs.error (watch, res, watch->user_data);
 
@@ -3527,6 +4805,7 @@ gst_rtsp_source_finalize (GSource * source)
 {
   GstRTSPWatch *watch = (GstRTSPWatch *) source;
   GstRTSPRec *rec;
+  guint i;
 
   if (watch->notify)
     watch->notify (watch->user_data);
@@ -3539,8 +4818,11 @@ gst_rtsp_source_finalize (GSource * source)
   gst_queue_array_free (watch->messages);
   watch->messages = NULL;
   watch->messages_bytes = 0;
+  watch->messages_count = 0;
 
-  g_free (watch->write_data);
+  for (i = 0; i < watch->n_write_recs; i++)
+    gst_rtsp_rec_clear (&watch->write_recs[i]);
+  watch->n_write_recs = 0;
   g_cond_clear (&watch->queue_not_full);
 
   if (watch->readsrc)
@@ -3756,6 +5038,43 @@ gst_rtsp_watch_get_send_backlog (GstRTSPWatch * watch,
   g_mutex_unlock (&watch->mutex);
 }
 
+/* queue @rec for sending when the connection becomes writable, must be called
+ * with the watch lock. Returns the context to wake up. */
+static GMainContext *
+gst_rtsp_watch_queue_rec (GstRTSPWatch * watch, GstRTSPRec * rec)
+{
+  do {
+    /* make sure rec->id is never 0 */
+    rec->id = ++watch->id;
+  } while (G_UNLIKELY (rec->id == 0));
+
+  /* add the record to a queue. */
+  gst_queue_array_push_tail_struct (watch->messages, rec);
+  watch->messages_bytes += rec->size;
+  watch->messages_count += rec->n_messages;
+
+  /* make sure the main context will now also check for writability on the
+   * socket */
+  if (!watch->writesrc) {
+    /* remove the read source on the write socket, we will be able to detect
+     * errors while writing */
+    if (watch->controlsrc) {
+      g_source_remove_child_source ((GSource *) watch, watch->controlsrc);
+      g_source_unref (watch->controlsrc);
+      watch->controlsrc = NULL;
+    }
+
+    watch->writesrc =
+        g_pollable_output_stream_create_source (G_POLLABLE_OUTPUT_STREAM
+        (watch->conn->output_stream), NULL);
+    g_source_set_callback (watch->writesrc,
+        (GSourceFunc) gst_rtsp_source_dispatch_write, watch, NULL);
+    g_source_add_child_source ((GSource *) watch, watch->writesrc);
+  }
+
+  return ((GSource *) watch)->context;
+}
+
 /**
  * gst_rtsp_watch_write_data:
  * @watch: a #GstRTSPWatch
@@ -3798,7 +5117,7 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
 
   /* try to send the message synchronously first */
   if (gst_queue_array_get_length (watch->messages) == 0
-      && watch->write_data == NULL) {
+      && watch->n_write_recs == 0) {
     res =
         write_bytes (watch->conn->output_stream, data, &off, size, FALSE,
         watch->conn->cancellable);
@@ -3811,8 +5130,11 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
   }
 
   /* check limits */
-  if (IS_BACKLOG_FULL (watch))
+  if (IS_BACKLOG_EXCEEDED (watch, size - off, 1)) {
+    watch->pending_bytes = size - off;
+    watch->pending_messages = 1;
     goto too_much_backlog;
+  }
 
   /* make a record with the data and id for sending async */
   memset (&rec, 0, sizeof (rec));
@@ -3824,35 +5146,9 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
     rec.size = size - off;
     g_free ((gpointer) data);
   }
+  rec.n_messages = 1;
 
-  do {
-    /* make sure rec->id is never 0 */
-    rec.id = ++watch->id;
-  } while (G_UNLIKELY (rec.id == 0));
-
-  /* add the record to a queue. */
-  gst_queue_array_push_tail_struct (watch->messages, &rec);
-  watch->messages_bytes += rec.size;
-
-  /* make sure the main context will now also check for writability on the
-   * socket */
-  context = ((GSource *) watch)->context;
-  if (!watch->writesrc) {
-    /* remove the read source on the write socket, we will be able to detect
-     * errors while writing */
-    if (watch->controlsrc) {
-      g_source_remove_child_source ((GSource *) watch, watch->controlsrc);
-      g_source_unref (watch->controlsrc);
-      watch->controlsrc = NULL;
-    }
-
-    watch->writesrc =
-        g_pollable_output_stream_create_source (G_POLLABLE_OUTPUT_STREAM
-        (watch->conn->output_stream), NULL);
-    g_source_set_callback (watch->writesrc,
-        (GSourceFunc) gst_rtsp_source_dispatch_write, watch, NULL);
-    g_source_add_child_source ((GSource *) watch, watch->writesrc);
-  }
+  context = gst_rtsp_watch_queue_rec (watch, &rec);
 
   if (id != NULL)
     *id = rec.id;
@@ -3878,8 +5174,7 @@ too_much_backlog:
   {
     GST_WARNING ("too much backlog: max_bytes %" G_GSIZE_FORMAT ", current %"
         G_GSIZE_FORMAT ", max_messages %u, current %u", watch->max_bytes,
-        watch->messages_bytes, watch->max_messages,
-        gst_queue_array_get_length (watch->messages));
+        watch->messages_bytes, watch->max_messages, watch->messages_count);
     g_mutex_unlock (&watch->mutex);
     g_free ((gpointer) data);
     return GST_RTSP_ENOMEM;
@@ -3905,17 +5200,136 @@ GstRTSPResult
 gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
     guint * id)
 {
-  GString *str;
-  guint size;
-
   g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
-  /* make a record with the message as a string and id */
-  str = message_to_string (watch->conn, message);
-  size = str->len;
-  return gst_rtsp_watch_write_data (watch,
-      (guint8 *) g_string_free (str, FALSE), size, id);
+  return gst_rtsp_watch_send_messages (watch, message, 1, id);
+}
+
+/**
+ * gst_rtsp_watch_send_messages:
+ * @watch: a #GstRTSPWatch
+ * @messages: (array length=n_messages): the messages to send
+ * @n_messages: the number of messages to send
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Sends @messages using the connection of the @watch. If they cannot be sent
+ * immediately, the remaining data will be queued for transmission in @watch.
+ * In case the @messages are queued, the ID returned in @id will be non-zero
+ * and used as the ID argument in the message_sent callback once all of them
+ * were written.
+ *
+ * All @messages are written with as few system calls as possible and the
+ * bodies of data messages, as used for interleaved RTP and RTCP, are only
+ * copied when they need to be queued.
+ *
+ * Each of the @messages counts towards the message limit set with
+ * gst_rtsp_watch_set_send_backlog(). @messages are only queued when all of
+ * them fit into the limits, or when nothing is queued yet.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ *
+ * Since: 1.16
+ */
+GstRTSPResult
+gst_rtsp_watch_send_messages (GstRTSPWatch * watch, GstRTSPMessage * messages,
+    guint n_messages, guint * id)
+{
+  GstRTSPSerializedMessage *serialized;
+  GOutputVector *vectors;
+  GstRTSPResult res;
+  GstRTSPRec rec;
+  GMainContext *context = NULL;
+  gsize total, off = 0;
+  gint n_vectors;
+  guint i;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (messages != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (n_messages > 0, GST_RTSP_EINVAL);
+
+  serialized = g_new (GstRTSPSerializedMessage, n_messages);
+  vectors = g_new (GOutputVector, 2 * n_messages);
+
+  n_vectors = serialize_messages (watch->conn, messages, n_messages,
+      serialized, vectors, &total);
+  if (G_UNLIKELY (n_vectors < 0))
+    goto no_message;
+
+  g_mutex_lock (&watch->mutex);
+  if (watch->flushing)
+    goto flushing;
+
+  /* try to send the messages synchronously first */
+  if (gst_queue_array_get_length (watch->messages) == 0
+      && watch->n_write_recs == 0) {
+    res = writev_bytes (watch->conn->output_stream, vectors, n_vectors, &off,
+        FALSE, watch->conn->cancellable);
+    if (res != GST_RTSP_EINTR) {
+      if (id != NULL)
+        *id = 0;
+      goto done;
+    }
+  }
+
+  /* check limits with the whole batch */
+  if (IS_BACKLOG_EXCEEDED (watch, total - off, n_messages)) {
+    watch->pending_bytes = total - off;
+    watch->pending_messages = n_messages;
+    goto too_much_backlog;
+  }
+
+  /* make a record with the remaining data and id for sending async */
+  memset (&rec, 0, sizeof (rec));
+  rec.data = vectors_to_data (vectors, n_vectors, off, &total);
+  rec.size = total;
+  rec.n_messages = n_messages;
+
+  context = gst_rtsp_watch_queue_rec (watch, &rec);
+
+  if (id != NULL)
+    *id = rec.id;
+  res = GST_RTSP_OK;
+
+done:
+  g_mutex_unlock (&watch->mutex);
+
+  if (context)
+    g_main_context_wakeup (context);
+
+cleanup:
+  for (i = 0; i < n_messages; i++)
+    serialized_message_clear (&serialized[i]);
+  g_free (serialized);
+  g_free (vectors);
+
+  return res;
+
+  /* ERRORS */
+no_message:
+  {
+    g_free (serialized);
+    g_free (vectors);
+    g_warning ("Wrong message");
+    return GST_RTSP_EINVAL;
+  }
+flushing:
+  {
+    GST_DEBUG ("we are flushing");
+    g_mutex_unlock (&watch->mutex);
+    res = GST_RTSP_EINTR;
+    goto cleanup;
+  }
+too_much_backlog:
+  {
+    GST_WARNING ("too much backlog: max_bytes %" G_GSIZE_FORMAT ", current %"
+        G_GSIZE_FORMAT ", max_messages %u, current %u", watch->max_bytes,
+        watch->messages_bytes, watch->max_messages, watch->messages_count);
+    g_mutex_unlock (&watch->mutex);
+    res = GST_RTSP_ENOMEM;
+    goto cleanup;
+  }
 }
 
 /**
@@ -3924,7 +5338,8 @@ gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
  * @timeout: a #GTimeVal timeout
  *
  * Wait until there is place in the backlog queue, @timeout is reached
- * or @watch is set to flushing.
+ * or @watch is set to flushing. After a send returned %GST_RTSP_ENOMEM, this
+ * waits until the data of that send fits in the backlog.
  *
  * If @timeout is %NULL this function can block forever. If @timeout
  * contains a valid timeout, this function will return %GST_RTSP_ETIMEOUT
@@ -4009,6 +5424,10 @@ gst_rtsp_watch_set_flushing (GstRTSPWatch * watch, gboolean flushing)
 
     while ((rec = gst_queue_array_pop_head_struct (watch->messages)))
       gst_rtsp_rec_clear (rec);
+    watch->messages_bytes = 0;
+    watch->messages_count = 0;
+    watch->pending_bytes = 0;
+    watch->pending_messages = 0;
   }
   g_mutex_unlock (&watch->mutex);
 }
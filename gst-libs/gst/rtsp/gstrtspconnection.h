@@ -136,10 +136,86 @@ GST_RTSP_API
 GstRTSPResult      gst_rtsp_connection_send           (GstRTSPConnection *conn, GstRTSPMessage *message,
                                                        GTimeVal *timeout);
 
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_connection_send_messages  (GstRTSPConnection *conn, GstRTSPMessage *messages,
+                                                       guint n_messages, GTimeVal *timeout);
+
 GST_RTSP_API
 GstRTSPResult      gst_rtsp_connection_receive        (GstRTSPConnection *conn, GstRTSPMessage *message,
                                                        GTimeVal *timeout);
 
+/* incremental message parsing */
+
+/**
+ * GstRTSPParser:
+ *
+ * Opaque incremental RTSP message parser. See gst_rtsp_parser_new().
+ *
+ * Since: 1.16
+ */
+typedef struct _GstRTSPParser GstRTSPParser;
+
+GST_RTSP_API
+GstRTSPParser *    gst_rtsp_parser_new                (void);
+
+GST_RTSP_API
+void               gst_rtsp_parser_free               (GstRTSPParser *parser);
+
+GST_RTSP_API
+void               gst_rtsp_parser_reset              (GstRTSPParser *parser);
+
+GST_RTSP_API
+void               gst_rtsp_parser_feed               (GstRTSPParser *parser, const guint8 *data,
+                                                       gsize size);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_parse              (GstRTSPParser *parser);
+
+GST_RTSP_API
+GstRTSPMsgType     gst_rtsp_parser_get_msg_type       (GstRTSPParser *parser);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_parse_request      (GstRTSPParser *parser,
+                                                       GstRTSPMethod *method,
+                                                       const gchar **uri,
+                                                       GstRTSPVersion *version);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_parse_response     (GstRTSPParser *parser,
+                                                       GstRTSPStatusCode *code,
+                                                       const gchar **reason,
+                                                       GstRTSPVersion *version);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_parse_data         (GstRTSPParser *parser,
+                                                       guint8 *channel);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_get_header         (GstRTSPParser *parser,
+                                                       GstRTSPHeaderField field,
+                                                       const gchar **value,
+                                                       gint indx);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_get_header_by_name (GstRTSPParser *parser,
+                                                       const gchar *header,
+                                                       const gchar **value,
+                                                       gint indx);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_get_body           (GstRTSPParser *parser,
+                                                       const guint8 **data,
+                                                       guint *size);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_parser_get_message        (GstRTSPParser *parser,
+                                                       GstRTSPMessage *message);
+
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_connection_receive_parser (GstRTSPConnection *conn,
+                                                       GstRTSPParser *parser,
+                                                       GTimeVal *timeout);
+
 /* status management */
 
 GST_RTSP_API
@@ -313,6 +389,12 @@ GstRTSPResult      gst_rtsp_watch_send_message       (GstRTSPWatch *watch,
                                                       GstRTSPMessage *message,
                                                       guint *id);
 
+GST_RTSP_API
+GstRTSPResult      gst_rtsp_watch_send_messages      (GstRTSPWatch *watch,
+                                                      GstRTSPMessage *messages,
+                                                      guint n_messages,
+                                                      guint *id);
+
 GST_RTSP_API
 GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
                                                       GTimeVal *timeout);
@@ -371,6 +371,44 @@ gst_rtsp_header_as_text (GstRTSPHeaderField field)
     return rtsp_headers[field - 1].name;
 }
 
+static guint
+header_case_hash (gconstpointer key)
+{
+  const gchar *p = key;
+  guint h = g_ascii_toupper (*p);
+
+  if (h)
+    for (p += 1; *p != '\0'; p++)
+      h = (h << 5) - h + g_ascii_toupper (*p);
+
+  return h;
+}
+
+static gboolean
+header_case_equal (gconstpointer v1, gconstpointer v2)
+{
+  return g_ascii_strcasecmp ((const gchar *) v1, (const gchar *) v2) == 0;
+}
+
+/* maps header names case-insensitively to their GstRTSPHeaderField, the
+ * lookup is done for every header line we parse so avoid a linear scan */
+static GHashTable *
+rtsp_init_header_fields (void)
+{
+  GHashTable *fields;
+  gint idx;
+
+  fields = g_hash_table_new (header_case_hash, header_case_equal);
+  for (idx = 0; rtsp_headers[idx].name; idx++) {
+    /* keep the first entry if a name would ever appear twice */
+    if (!g_hash_table_contains (fields, rtsp_headers[idx].name))
+      g_hash_table_insert (fields, (gpointer) rtsp_headers[idx].name,
+          GINT_TO_POINTER (idx + 1));
+  }
+
+  return fields;
+}
+
 /**
  * gst_rtsp_status_as_text:
  * @code: a #GstRTSPStatusCode
@@ -402,14 +440,14 @@ gst_rtsp_status_as_text (GstRTSPStatusCode code)
 GstRTSPHeaderField
 gst_rtsp_find_header_field (const gchar * header)
 {
-  gint idx;
+  static GHashTable *fields = NULL;
 
-  for (idx = 0; rtsp_headers[idx].name; idx++) {
-    if (g_ascii_strcasecmp (rtsp_headers[idx].name, header) == 0) {
-      return idx + 1;
-    }
+  if (g_once_init_enter (&fields)) {
+    GHashTable *table = rtsp_init_header_fields ();
+    g_once_init_leave (&fields, table);
   }
-  return GST_RTSP_HDR_INVALID;
+
+  return GPOINTER_TO_INT (g_hash_table_lookup (fields, header));
 }
 
 /**
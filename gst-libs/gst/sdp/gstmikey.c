@@ -2149,6 +2149,561 @@ parse_error:
   }
 }
 
+/* message views */
+typedef struct
+{
+  GstMIKEYPayloadType type;
+  const guint8 *data;
+  gsize size;
+} MIKEYPayloadView;
+
+typedef struct
+{
+  GstMIKEYKeyDataType key_type;
+  GstMIKEYKVType kv_type;
+  const guint8 *key_data;
+  guint16 key_len;
+  const guint8 *salt_data;
+  guint16 salt_len;
+} MIKEYKeyDataView;
+
+/**
+ * GstMIKEYMessageView:
+ *
+ * A read-only view on a serialized MIKEY message. The view only stores
+ * pointers into the parsed data, which must therefore stay valid as long as
+ * the view is used.
+ *
+ * Since: 1.16
+ */
+struct _GstMIKEYMessageView
+{
+  const guint8 *data;
+  gsize size;
+
+  guint8 version;
+  GstMIKEYType type;
+  gboolean V;
+  GstMIKEYPRFFunc prf_func;
+  guint32 CSB_id;
+  GstMIKEYMapType map_type;
+  guint n_cs;
+  const guint8 *cs_data;
+
+  GArray *payloads;             /* MIKEYPayloadView */
+  GArray *key_datas;            /* MIKEYKeyDataView */
+  const guint8 *rand;
+  guint8 rand_len;
+};
+
+/* same framing as payloads_from_bytes() but only records the location of the
+ * payloads */
+static gboolean
+payload_views_from_bytes (GstMIKEYMessageView * view, ParseState state,
+    const guint8 * d, gsize size, guint8 next_payload)
+{
+  MIKEYPayloadView pv;
+
+  while (next_payload != GST_MIKEY_PT_LAST) {
+    pv.type = next_payload;
+    pv.data = d;
+
+    switch (next_payload) {
+      case GST_MIKEY_PT_KEMAC:
+      {
+        guint mac_len;
+        guint16 enc_len;
+
+        CHECK_SIZE (5);
+        next_payload = d[0];
+        enc_len = GST_READ_UINT16_BE (&d[2]);
+        CHECK_SIZE (5 + enc_len);
+        if ((mac_len = get_mac_len (d[4 + enc_len])) == -1)
+          goto invalid_data;
+        CHECK_SIZE (5 + enc_len + mac_len);
+
+        /* only unencrypted key data of a preshared key message is
+         * supported */
+        if (state == STATE_PSK && d[1] == GST_MIKEY_ENC_NULL) {
+          if (!payload_views_from_bytes (view, STATE_KEMAC, &d[4], enc_len,
+                  GST_MIKEY_PT_KEY_DATA))
+            goto invalid_data;
+        }
+        ADVANCE (5 + enc_len + mac_len);
+        break;
+      }
+      case GST_MIKEY_PT_T:
+      {
+        guint ts_len;
+
+        CHECK_SIZE (2);
+        next_payload = d[0];
+        if ((ts_len = get_ts_len (d[1])) == -1)
+          goto invalid_data;
+        CHECK_SIZE (2 + ts_len);
+        ADVANCE (2 + ts_len);
+        break;
+      }
+      case GST_MIKEY_PT_PKE:
+      {
+        guint16 data_len;
+
+        CHECK_SIZE (3);
+        next_payload = d[0];
+        data_len = GST_READ_UINT16_BE (&d[1]) & 0x3fff;
+        CHECK_SIZE (3 + data_len);
+        ADVANCE (3 + data_len);
+        break;
+      }
+      case GST_MIKEY_PT_SP:
+      {
+        guint16 plen;
+
+        CHECK_SIZE (5);
+        next_payload = d[0];
+        plen = GST_READ_UINT16_BE (&d[3]);
+        CHECK_SIZE (5 + plen);
+        ADVANCE (5 + plen);
+        break;
+      }
+      case GST_MIKEY_PT_RAND:
+      {
+        guint8 len;
+
+        CHECK_SIZE (2);
+        next_payload = d[0];
+        len = d[1];
+        CHECK_SIZE (2 + len);
+        view->rand = &d[2];
+        view->rand_len = len;
+        ADVANCE (2 + len);
+        break;
+      }
+      case GST_MIKEY_PT_KEY_DATA:
+      {
+        MIKEYKeyDataView kd = { 0, };
+
+        CHECK_SIZE (4);
+        next_payload = d[0];
+        kd.key_type = d[1] >> 4;
+        kd.kv_type = d[1] & 0xf;
+        kd.key_len = GST_READ_UINT16_BE (&d[2]);
+        CHECK_SIZE (4 + kd.key_len);
+        kd.key_data = &d[4];
+        ADVANCE (4 + kd.key_len);
+        if (kd.key_type & 1) {
+          CHECK_SIZE (2);
+          kd.salt_len = GST_READ_UINT16_BE (&d[0]);
+          CHECK_SIZE (2 + kd.salt_len);
+          kd.salt_data = &d[2];
+          ADVANCE (2 + kd.salt_len);
+        }
+        kd.key_type &= 2;
+
+        if (kd.kv_type == GST_MIKEY_KV_SPI) {
+          CHECK_SIZE (1);
+          CHECK_SIZE (1 + d[0]);
+          ADVANCE (1 + d[0]);
+        } else if (kd.kv_type == GST_MIKEY_KV_INTERVAL) {
+          CHECK_SIZE (1);
+          CHECK_SIZE (1 + d[0]);
+          ADVANCE (1 + d[0]);
+          CHECK_SIZE (1);
+          CHECK_SIZE (1 + d[0]);
+          ADVANCE (1 + d[0]);
+        } else if (kd.kv_type != GST_MIKEY_KV_NULL)
+          goto invalid_data;
+
+        g_array_append_val (view->key_datas, kd);
+        break;
+      }
+      default:
+        /* not supported */
+        goto invalid_data;
+    }
+    /* key data is only reported with gst_mikey_message_view_get_key_data() */
+    if (state != STATE_KEMAC) {
+      pv.size = d - pv.data;
+      g_array_append_val (view->payloads, pv);
+    }
+  }
+  return TRUE;
+
+  /* ERRORS */
+short_data:
+  {
+    GST_DEBUG ("not enough data");
+    return FALSE;
+  }
+invalid_data:
+  {
+    GST_DEBUG ("invalid data");
+    return FALSE;
+  }
+}
+
+/**
+ * gst_mikey_message_view_new:
+ *
+ * Create a new #GstMIKEYMessageView. The view can be reused for parsing
+ * many messages with gst_mikey_message_view_parse().
+ *
+ * Returns: (transfer full): a new #GstMIKEYMessageView. Free with
+ * gst_mikey_message_view_free().
+ *
+ * Since: 1.16
+ */
+GstMIKEYMessageView *
+gst_mikey_message_view_new (void)
+{
+  GstMIKEYMessageView *view;
+
+  view = g_new0 (GstMIKEYMessageView, 1);
+  view->payloads = g_array_new (FALSE, FALSE, sizeof (MIKEYPayloadView));
+  view->key_datas = g_array_new (FALSE, FALSE, sizeof (MIKEYKeyDataView));
+
+  return view;
+}
+
+/**
+ * gst_mikey_message_view_free:
+ * @view: a #GstMIKEYMessageView
+ *
+ * Free @view. This does not touch the data that was parsed.
+ *
+ * Since: 1.16
+ */
+void
+gst_mikey_message_view_free (GstMIKEYMessageView * view)
+{
+  g_return_if_fail (view != NULL);
+
+  g_array_free (view->payloads, TRUE);
+  g_array_free (view->key_datas, TRUE);
+  g_free (view);
+}
+
+/**
+ * gst_mikey_message_view_parse:
+ * @view: a #GstMIKEYMessageView
+ * @data: (array length=size) (element-type guint8): bytes to read
+ * @size: length of @data
+ *
+ * Parse @size bytes from @data into @view. Unlike
+ * gst_mikey_message_new_from_data(), nothing is copied and no payload objects
+ * are created, @view only references @data. The previous contents of @view
+ * are discarded.
+ *
+ * Returns: %TRUE when @data contains a valid MIKEY message.
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_message_view_parse (GstMIKEYMessageView * view, gconstpointer data,
+    gsize size)
+{
+  const guint8 *d = data;
+  guint8 next_payload;
+  ParseState state;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  view->data = data;
+  view->size = size;
+  view->n_cs = 0;
+  view->cs_data = NULL;
+  view->rand = NULL;
+  view->rand_len = 0;
+  g_array_set_size (view->payloads, 0);
+  g_array_set_size (view->key_datas, 0);
+
+  CHECK_SIZE (10);
+  view->version = d[0];
+  if (view->version != GST_MIKEY_VERSION)
+    goto unknown_version;
+
+  view->type = d[1];
+  next_payload = d[2];
+  view->V = d[3] & 0x80 ? TRUE : FALSE;
+  view->prf_func = d[3] & 0x7f;
+  view->CSB_id = GST_READ_UINT32_BE (&d[4]);
+  view->n_cs = d[8];
+  view->map_type = d[9];
+  ADVANCE (10);
+
+  CHECK_SIZE (view->n_cs * 9);
+  view->cs_data = d;
+  ADVANCE (view->n_cs * 9);
+
+  if (view->type == GST_MIKEY_TYPE_PSK_INIT)
+    state = STATE_PSK;
+  else if (view->type == GST_MIKEY_TYPE_PK_INIT)
+    state = STATE_PK;
+  else
+    state = STATE_OTHER;
+
+  if (!payload_views_from_bytes (view, state, d, size, next_payload))
+    goto parse_error;
+
+  return TRUE;
+
+  /* ERRORS */
+short_data:
+  {
+    GST_DEBUG ("not enough data");
+    view->n_cs = 0;
+    return FALSE;
+  }
+unknown_version:
+  {
+    GST_DEBUG ("unknown version");
+    return FALSE;
+  }
+parse_error:
+  {
+    GST_DEBUG ("failed to parse");
+    g_array_set_size (view->payloads, 0);
+    g_array_set_size (view->key_datas, 0);
+    return FALSE;
+  }
+}
+
+/**
+ * gst_mikey_message_view_get_info:
+ * @view: a #GstMIKEYMessageView
+ * @version: (out) (allow-none): the version
+ * @type: (out) (allow-none): the #GstMIKEYType
+ * @V: (out) (allow-none): verify flag
+ * @prf_func: (out) (allow-none): the #GstMIKEYPRFFunc
+ * @CSB_id: (out) (allow-none): the Crypto Session Bundle id
+ * @map_type: (out) (allow-none): the #GstMIKEYMapType
+ *
+ * Get the common header fields of the message parsed into @view.
+ *
+ * Since: 1.16
+ */
+void
+gst_mikey_message_view_get_info (const GstMIKEYMessageView * view,
+    guint8 * version, GstMIKEYType * type, gboolean * V,
+    GstMIKEYPRFFunc * prf_func, guint32 * CSB_id, GstMIKEYMapType * map_type)
+{
+  g_return_if_fail (view != NULL);
+
+  if (version)
+    *version = view->version;
+  if (type)
+    *type = view->type;
+  if (V)
+    *V = view->V;
+  if (prf_func)
+    *prf_func = view->prf_func;
+  if (CSB_id)
+    *CSB_id = view->CSB_id;
+  if (map_type)
+    *map_type = view->map_type;
+}
+
+/**
+ * gst_mikey_message_view_get_n_cs:
+ * @view: a #GstMIKEYMessageView
+ *
+ * Get the number of crypto sessions in @view.
+ *
+ * Returns: the number of crypto sessions
+ *
+ * Since: 1.16
+ */
+guint
+gst_mikey_message_view_get_n_cs (const GstMIKEYMessageView * view)
+{
+  g_return_val_if_fail (view != NULL, 0);
+
+  return view->n_cs;
+}
+
+/**
+ * gst_mikey_message_view_get_cs_srtp:
+ * @view: a #GstMIKEYMessageView
+ * @idx: an index
+ * @map: (out): a #GstMIKEYMapSRTP to fill
+ *
+ * Get the policy information of the crypto session at @idx.
+ *
+ * Returns: %TRUE when @idx is valid
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_message_view_get_cs_srtp (const GstMIKEYMessageView * view,
+    guint idx, GstMIKEYMapSRTP * map)
+{
+  const guint8 *d;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+  g_return_val_if_fail (map != NULL, FALSE);
+  g_return_val_if_fail (view->map_type == GST_MIKEY_MAP_TYPE_SRTP, FALSE);
+
+  if (idx >= view->n_cs)
+    return FALSE;
+
+  d = view->cs_data + idx * 9;
+  map->policy = d[0];
+  map->ssrc = GST_READ_UINT32_BE (&d[1]);
+  map->roc = GST_READ_UINT32_BE (&d[5]);
+
+  return TRUE;
+}
+
+/**
+ * gst_mikey_message_view_get_n_payloads:
+ * @view: a #GstMIKEYMessageView
+ *
+ * Get the number of top level payloads in @view.
+ *
+ * Returns: the number of payloads
+ *
+ * Since: 1.16
+ */
+guint
+gst_mikey_message_view_get_n_payloads (const GstMIKEYMessageView * view)
+{
+  g_return_val_if_fail (view != NULL, 0);
+
+  return view->payloads->len;
+}
+
+/**
+ * gst_mikey_message_view_get_payload:
+ * @view: a #GstMIKEYMessageView
+ * @idx: an index
+ * @type: (out) (allow-none): the #GstMIKEYPayloadType
+ * @data: (out) (allow-none) (transfer none) (array length=size): the payload
+ *   bytes, starting with the next payload field
+ * @size: (out) (allow-none): the size of @data
+ *
+ * Get the payload at @idx. @data points into the data parsed by @view.
+ *
+ * Returns: %TRUE when @idx is valid
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_message_view_get_payload (const GstMIKEYMessageView * view,
+    guint idx, GstMIKEYPayloadType * type, const guint8 ** data, gsize * size)
+{
+  const MIKEYPayloadView *pv;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  if (idx >= view->payloads->len)
+    return FALSE;
+
+  pv = &g_array_index (view->payloads, MIKEYPayloadView, idx);
+  if (type)
+    *type = pv->type;
+  if (data)
+    *data = pv->data;
+  if (size)
+    *size = pv->size;
+
+  return TRUE;
+}
+
+/**
+ * gst_mikey_message_view_get_rand:
+ * @view: a #GstMIKEYMessageView
+ * @rand: (out) (transfer none) (array length=len): the RAND bytes
+ * @len: (out): the length of @rand
+ *
+ * Get the RAND payload of @view.
+ *
+ * Returns: %TRUE when the message has a RAND payload
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_message_view_get_rand (const GstMIKEYMessageView * view,
+    const guint8 ** rand, guint8 * len)
+{
+  g_return_val_if_fail (view != NULL, FALSE);
+  g_return_val_if_fail (rand != NULL, FALSE);
+  g_return_val_if_fail (len != NULL, FALSE);
+
+  if (view->rand == NULL)
+    return FALSE;
+
+  *rand = view->rand;
+  *len = view->rand_len;
+
+  return TRUE;
+}
+
+/**
+ * gst_mikey_message_view_get_n_key_data:
+ * @view: a #GstMIKEYMessageView
+ *
+ * Get the number of key data sub-payloads found in the unencrypted KEMAC
+ * payloads of @view.
+ *
+ * Returns: the number of key data sub-payloads
+ *
+ * Since: 1.16
+ */
+guint
+gst_mikey_message_view_get_n_key_data (const GstMIKEYMessageView * view)
+{
+  g_return_val_if_fail (view != NULL, 0);
+
+  return view->key_datas->len;
+}
+
+/**
+ * gst_mikey_message_view_get_key_data:
+ * @view: a #GstMIKEYMessageView
+ * @idx: an index
+ * @key_type: (out) (allow-none): the #GstMIKEYKeyDataType
+ * @key_data: (out) (allow-none) (transfer none) (array length=key_len): the
+ *   key
+ * @key_len: (out) (allow-none): the length of @key_data
+ * @salt_data: (out) (allow-none) (transfer none) (array length=salt_len): the
+ *   salt or %NULL
+ * @salt_len: (out) (allow-none): the length of @salt_data
+ *
+ * Get the key data sub-payload at @idx. The returned pointers point into the
+ * data parsed by @view.
+ *
+ * Returns: %TRUE when @idx is valid
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_message_view_get_key_data (const GstMIKEYMessageView * view,
+    guint idx, GstMIKEYKeyDataType * key_type, const guint8 ** key_data,
+    guint16 * key_len, const guint8 ** salt_data, guint16 * salt_len)
+{
+  const MIKEYKeyDataView *kd;
+
+  g_return_val_if_fail (view != NULL, FALSE);
+
+  if (idx >= view->key_datas->len)
+    return FALSE;
+
+  kd = &g_array_index (view->key_datas, MIKEYKeyDataView, idx);
+  if (key_type)
+    *key_type = kd->key_type;
+  if (key_data)
+    *key_data = kd->key_data;
+  if (key_len)
+    *key_len = kd->key_len;
+  if (salt_data)
+    *salt_data = kd->salt_data;
+  if (salt_len)
+    *salt_len = kd->salt_len;
+
+  return TRUE;
+}
+
 #define AES_128_KEY_LEN 16
 #define AES_256_KEY_LEN 32
 #define HMAC_32_KEY_LEN 4
@@ -2465,3 +3020,172 @@ gst_mikey_message_base64_encode (GstMIKEYMessage * msg)
 
   return base64;
 }
+
+/* key derivation, see RFC 3830 section 4.1.2 and 4.1.3 */
+#define PRF_KEY_CHUNK_LEN 32    /* 256 bits */
+#define PRF_BLOCK_LEN 20        /* SHA-1 digest, 160 bits */
+#define PRF_MAX_RAND_LEN 255
+
+/**
+ * GstMIKEYKeyDerivation:
+ *
+ * A context to derive keys from a TGK or other master key with the MIKEY
+ * PRF. The HMAC state for the key is computed once when the context is
+ * created and reused for every derived key, so it is best to keep one
+ * context per master key.
+ *
+ * Since: 1.16
+ */
+struct _GstMIKEYKeyDerivation
+{
+  GstMIKEYPRFFunc prf_func;
+  /* keyed HMAC for each 256 bit chunk of the key */
+  GHmac **chunks;
+  guint n_chunks;
+};
+
+/**
+ * gst_mikey_key_derivation_new:
+ * @prf_func: the #GstMIKEYPRFFunc to use
+ * @key: (array length=key_len): the master key
+ * @key_len: the length of @key
+ *
+ * Create a new key derivation context for @key.
+ *
+ * Returns: (transfer full) (nullable): a new #GstMIKEYKeyDerivation or %NULL
+ * when @prf_func is not supported. Free with gst_mikey_key_derivation_free().
+ *
+ * Since: 1.16
+ */
+GstMIKEYKeyDerivation *
+gst_mikey_key_derivation_new (GstMIKEYPRFFunc prf_func, const guint8 * key,
+    gsize key_len)
+{
+  GstMIKEYKeyDerivation *kd;
+  guint i;
+
+  g_return_val_if_fail (key != NULL, NULL);
+  g_return_val_if_fail (key_len > 0, NULL);
+
+  if (prf_func != GST_MIKEY_PRF_MIKEY_1)
+    return NULL;
+
+  kd = g_new0 (GstMIKEYKeyDerivation, 1);
+  kd->prf_func = prf_func;
+  kd->n_chunks = (key_len + PRF_KEY_CHUNK_LEN - 1) / PRF_KEY_CHUNK_LEN;
+  kd->chunks = g_new0 (GHmac *, kd->n_chunks);
+  for (i = 0; i < kd->n_chunks; i++) {
+    gsize len = MIN (PRF_KEY_CHUNK_LEN, key_len - i * PRF_KEY_CHUNK_LEN);
+
+    kd->chunks[i] = g_hmac_new (G_CHECKSUM_SHA1, key + i * PRF_KEY_CHUNK_LEN,
+        len);
+  }
+
+  return kd;
+}
+
+/**
+ * gst_mikey_key_derivation_free:
+ * @kd: a #GstMIKEYKeyDerivation
+ *
+ * Free @kd.
+ *
+ * Since: 1.16
+ */
+void
+gst_mikey_key_derivation_free (GstMIKEYKeyDerivation * kd)
+{
+  guint i;
+
+  g_return_if_fail (kd != NULL);
+
+  for (i = 0; i < kd->n_chunks; i++)
+    g_hmac_unref (kd->chunks[i]);
+  g_free (kd->chunks);
+  g_free (kd);
+}
+
+static void
+prf_hmac (GHmac * keyed, const guint8 * data1, gsize len1,
+    const guint8 * data2, gsize len2, guint8 * digest)
+{
+  GHmac *hmac;
+  gsize len = PRF_BLOCK_LEN;
+
+  hmac = g_hmac_copy (keyed);
+  g_hmac_update (hmac, data1, len1);
+  if (len2 > 0)
+    g_hmac_update (hmac, data2, len2);
+  g_hmac_get_digest (hmac, digest, &len);
+  g_hmac_unref (hmac);
+}
+
+/**
+ * gst_mikey_key_derivation_derive:
+ * @kd: a #GstMIKEYKeyDerivation
+ * @usage: the #GstMIKEYKeyUsage of the derived key
+ * @cs_id: the crypto session id
+ * @CSB_id: the crypto session bundle id
+ * @rand: (array length=rand_len): the RAND of the message
+ * @rand_len: the length of @rand, at most 255
+ * @out: (out caller-allocates) (array length=out_len): destination for the
+ *   derived key
+ * @out_len: the number of bytes to derive
+ *
+ * Derive @out_len bytes of key material for @usage, @cs_id and @CSB_id into
+ * @out.
+ *
+ * @kd is not modified and can be used from multiple threads at the same time.
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 1.16
+ */
+gboolean
+gst_mikey_key_derivation_derive (const GstMIKEYKeyDerivation * kd,
+    GstMIKEYKeyUsage usage, guint8 cs_id, guint32 CSB_id, const guint8 * rand,
+    gsize rand_len, guint8 * out, gsize out_len)
+{
+  guint8 label[9 + PRF_MAX_RAND_LEN];
+  guint8 a[PRF_BLOCK_LEN], block[PRF_BLOCK_LEN];
+  gsize label_len;
+  guint i, j, k;
+
+  g_return_val_if_fail (kd != NULL, FALSE);
+  g_return_val_if_fail (rand != NULL || rand_len == 0, FALSE);
+  g_return_val_if_fail (rand_len <= PRF_MAX_RAND_LEN, FALSE);
+  g_return_val_if_fail (out != NULL || out_len == 0, FALSE);
+
+  /* label = constant || cs_id || csb_id || RAND */
+  GST_WRITE_UINT32_BE (&label[0], usage);
+  label[4] = cs_id;
+  GST_WRITE_UINT32_BE (&label[5], CSB_id);
+  if (rand_len > 0)
+    memcpy (&label[9], rand, rand_len);
+  label_len = 9 + rand_len;
+
+  memset (out, 0, out_len);
+
+  /* PRF (inkey, label) = P (s_1, label, m) XOR ... XOR P (s_n, label, m) */
+  for (i = 0; i < kd->n_chunks; i++) {
+    GHmac *keyed = kd->chunks[i];
+
+    /* P (s, label, m) = HMAC (s, A_1 || label) || ... || HMAC (s, A_m || label)
+     * with A_0 = label and A_i = HMAC (s, A_(i-1)) */
+    for (j = 0; j * PRF_BLOCK_LEN < out_len; j++) {
+      gsize len = MIN (PRF_BLOCK_LEN, out_len - j * PRF_BLOCK_LEN);
+
+      if (j == 0)
+        prf_hmac (keyed, label, label_len, NULL, 0, a);
+      else
+        prf_hmac (keyed, a, PRF_BLOCK_LEN, NULL, 0, a);
+
+      prf_hmac (keyed, a, PRF_BLOCK_LEN, label, label_len, block);
+
+      for (k = 0; k < len; k++)
+        out[j * PRF_BLOCK_LEN + k] ^= block[k];
+    }
+  }
+
+  return TRUE;
+}
@@ -595,6 +595,89 @@ gboolean                    gst_mikey_message_to_caps           (const GstMIKEYM
 GST_SDP_API
 gchar *                     gst_mikey_message_base64_encode     (GstMIKEYMessage* msg);
 
+/* read-only views */
+typedef struct _GstMIKEYMessageView GstMIKEYMessageView;
+
+GST_SDP_API
+GstMIKEYMessageView *       gst_mikey_message_view_new          (void);
+
+GST_SDP_API
+void                        gst_mikey_message_view_free         (GstMIKEYMessageView *view);
+
+GST_SDP_API
+gboolean                    gst_mikey_message_view_parse        (GstMIKEYMessageView *view,
+                                                                 gconstpointer data, gsize size);
+
+GST_SDP_API
+void                        gst_mikey_message_view_get_info     (const GstMIKEYMessageView *view,
+                                                                 guint8 *version, GstMIKEYType *type,
+                                                                 gboolean *V, GstMIKEYPRFFunc *prf_func,
+                                                                 guint32 *CSB_id, GstMIKEYMapType *map_type);
+
+GST_SDP_API
+guint                       gst_mikey_message_view_get_n_cs     (const GstMIKEYMessageView *view);
+
+GST_SDP_API
+gboolean                    gst_mikey_message_view_get_cs_srtp  (const GstMIKEYMessageView *view,
+                                                                 guint idx, GstMIKEYMapSRTP *map);
+
+GST_SDP_API
+guint                       gst_mikey_message_view_get_n_payloads (const GstMIKEYMessageView *view);
+
+GST_SDP_API
+gboolean                    gst_mikey_message_view_get_payload  (const GstMIKEYMessageView *view,
+                                                                 guint idx, GstMIKEYPayloadType *type,
+                                                                 const guint8 **data, gsize *size);
+
+GST_SDP_API
+gboolean                    gst_mikey_message_view_get_rand     (const GstMIKEYMessageView *view,
+                                                                 const guint8 **rand, guint8 *len);
+
+GST_SDP_API
+guint                       gst_mikey_message_view_get_n_key_data (const GstMIKEYMessageView *view);
+
+GST_SDP_API
+gboolean                    gst_mikey_message_view_get_key_data (const GstMIKEYMessageView *view,
+                                                                 guint idx, GstMIKEYKeyDataType *key_type,
+                                                                 const guint8 **key_data, guint16 *key_len,
+                                                                 const guint8 **salt_data, guint16 *salt_len);
+
+/* key derivation */
+
+/**
+ * GstMIKEYKeyUsage:
+ * @GST_MIKEY_KEY_USAGE_TEK: derive a Traffic-Encrypting Key
+ * @GST_MIKEY_KEY_USAGE_TEK_SALT: derive a salting key for the TEK
+ * @GST_MIKEY_KEY_USAGE_ENCR: derive the key to encrypt the KEMAC payload
+ * @GST_MIKEY_KEY_USAGE_AUTH: derive the key to authenticate the message
+ *
+ * The constants used in the MIKEY key derivation label.
+ *
+ * Since: 1.16
+ */
+typedef enum
+{
+  GST_MIKEY_KEY_USAGE_TEK       = 0x2AD01C64,
+  GST_MIKEY_KEY_USAGE_TEK_SALT  = 0x39A2C14B,
+  GST_MIKEY_KEY_USAGE_ENCR      = 0x15798CEF,
+  GST_MIKEY_KEY_USAGE_AUTH      = 0x1B5C7973
+} GstMIKEYKeyUsage;
+
+typedef struct _GstMIKEYKeyDerivation GstMIKEYKeyDerivation;
+
+GST_SDP_API
+GstMIKEYKeyDerivation *     gst_mikey_key_derivation_new        (GstMIKEYPRFFunc prf_func,
+                                                                 const guint8 *key, gsize key_len);
+
+GST_SDP_API
+void                        gst_mikey_key_derivation_free       (GstMIKEYKeyDerivation *kd);
+
+GST_SDP_API
+gboolean                    gst_mikey_key_derivation_derive     (const GstMIKEYKeyDerivation *kd,
+                                                                 GstMIKEYKeyUsage usage, guint8 cs_id,
+                                                                 guint32 CSB_id, const guint8 *rand,
+                                                                 gsize rand_len, guint8 *out, gsize out_len);
+
 /**
  * gst_mikey_message_ref:
  * @message: The message to refcount
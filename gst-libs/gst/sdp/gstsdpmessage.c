@@ -214,6 +214,106 @@ gst_sdp_key_init (GstSDPKey * key)
   FREE_STRING (key->data);
 }
 
+/* append helpers for the text serializers, these avoid going through
+ * printf style formatting for every field */
+static inline void
+append_string (GString * lines, const gchar * val)
+{
+  /* match the output of printf for NULL strings */
+  g_string_append (lines, val ? val : "(null)");
+}
+
+static void
+append_uint (GString * lines, guint val)
+{
+  gchar buf[16];
+  gchar *p = buf + sizeof (buf);
+
+  do {
+    *--p = '0' + (val % 10);
+    val /= 10;
+  } while (val);
+
+  g_string_append_len (lines, p, buf + sizeof (buf) - p);
+}
+
+static void
+append_line (GString * lines, const gchar * prefix, const gchar * val)
+{
+  g_string_append_len (lines, prefix, 2);
+  append_string (lines, val);
+  g_string_append_len (lines, "\r\n", 2);
+}
+
+static void
+append_connection (GString * lines, const GstSDPConnection * conn)
+{
+  if (!conn->nettype || !conn->addrtype || !conn->address)
+    return;
+
+  g_string_append_len (lines, "c=", 2);
+  g_string_append (lines, conn->nettype);
+  g_string_append_c (lines, ' ');
+  g_string_append (lines, conn->addrtype);
+  g_string_append_c (lines, ' ');
+  g_string_append (lines, conn->address);
+  if (gst_sdp_address_is_multicast (conn->nettype, conn->addrtype,
+          conn->address)) {
+    /* only add TTL for IP4 multicast */
+    if (strcmp (conn->addrtype, "IP4") == 0) {
+      g_string_append_c (lines, '/');
+      append_uint (lines, conn->ttl);
+    }
+    if (conn->addr_number > 1) {
+      g_string_append_c (lines, '/');
+      append_uint (lines, conn->addr_number);
+    }
+  }
+  g_string_append_len (lines, "\r\n", 2);
+}
+
+static void
+append_bandwidth (GString * lines, const GstSDPBandwidth * bandwidth)
+{
+  g_string_append_len (lines, "b=", 2);
+  append_string (lines, bandwidth->bwtype);
+  g_string_append_c (lines, ':');
+  append_uint (lines, bandwidth->bandwidth);
+  g_string_append_len (lines, "\r\n", 2);
+}
+
+static void
+append_key (GString * lines, const GstSDPKey * key)
+{
+  if (!key->type)
+    return;
+
+  g_string_append_len (lines, "k=", 2);
+  g_string_append (lines, key->type);
+  if (key->data) {
+    g_string_append_c (lines, ':');
+    g_string_append (lines, key->data);
+  }
+  g_string_append_len (lines, "\r\n", 2);
+}
+
+static void
+append_attribute (GString * lines, const GstSDPAttribute * attr)
+{
+  if (!attr->key)
+    return;
+
+  g_string_append_len (lines, "a=", 2);
+  g_string_append (lines, attr->key);
+  if (attr->value && attr->value[0] != '\0') {
+    g_string_append_c (lines, ':');
+    g_string_append (lines, attr->value);
+  }
+  g_string_append_len (lines, "\r\n", 2);
+}
+
+static void media_append_text (const GstSDPMedia * media, GString * lines);
+
 /**
  * gst_sdp_message_new:
  * @msg: (out) (transfer full): pointer to new #GstSDPMessage
@@ -449,6 +549,23 @@ gst_sdp_message_free (GstSDPMessage * msg)
   return GST_SDP_OK;
 }
 
+static gboolean
+address_maybe_multicast (const gchar * addr)
+{
+  guint octet = 0;
+
+  if (g_ascii_isdigit (*addr)) {
+    /* IPv4 or an IPv6 address starting with a decimal digit, the latter can
+     * never be multicast and will be outside of the range below */
+    while (g_ascii_isdigit (*addr) && octet < 1000)
+      octet = octet * 10 + (*addr++ - '0');
+    return octet >= 224 && octet <= 239;
+  }
+
+  /* IPv6 multicast addresses need a full first group of the form ffXX */
+  return g_ascii_tolower (addr[0]) == 'f' && g_ascii_tolower (addr[1]) == 'f';
+}
+
 /**
  * gst_sdp_address_is_multicast:
  * @nettype: a network type
@@ -472,6 +589,11 @@ gst_sdp_address_is_multicast (const gchar * nettype, const gchar * addrtype,
   if (nettype && strcmp (nettype, "IN") != 0)
     return FALSE;
 
+  /* avoid creating an address object for the common unicast and hostname
+   * cases, only 224.0.0.0/4 and ff00::/8 can be multicast */
+  if (!address_maybe_multicast (addr))
+    return FALSE;
+
   /* guard against parse failures */
   if ((iaddr = g_inet_address_new_from_string (addr)) == NULL)
     return FALSE;
@@ -493,80 +615,103 @@ gst_sdp_address_is_multicast (const gchar * nettype, const gchar * addrtype,
 gchar *
 gst_sdp_message_as_text (const GstSDPMessage * msg)
 {
-  /* change all vars so they match rfc? */
   GString *lines;
-  guint i;
 
   g_return_val_if_fail (msg != NULL, NULL);
 
-  lines = g_string_new ("");
+  lines = g_string_sized_new (1024);
+  gst_sdp_message_append_text (msg, lines);
+
+  return g_string_free (lines, FALSE);
+}
+
+/**
+ * gst_sdp_message_append_text:
+ * @msg: a #GstSDPMessage
+ * @str: a #GString
+ *
+ * Append the text representation of @msg to @str. This produces the same
+ * output as gst_sdp_message_as_text() but lets the caller reuse a
+ * preallocated #GString, for example by calling g_string_truncate() on it
+ * before serializing the next message.
+ *
+ * Returns: a #GstSDPResult.
+ *
+ * Since: 1.16
+ */
+GstSDPResult
+gst_sdp_message_append_text (const GstSDPMessage * msg, GString * str)
+{
+  /* change all vars so they match rfc? */
+  GString *lines = str;
+  guint i;
+
+  g_return_val_if_fail (msg != NULL, GST_SDP_EINVAL);
+  g_return_val_if_fail (str != NULL, GST_SDP_EINVAL);
 
   if (msg->version)
-    g_string_append_printf (lines, "v=%s\r\n", msg->version);
+    append_line (lines, "v=", msg->version);
 
   if (msg->origin.sess_id && msg->origin.sess_version && msg->origin.nettype &&
-      msg->origin.addrtype && msg->origin.addr)
-    g_string_append_printf (lines, "o=%s %s %s %s %s %s\r\n",
-        msg->origin.username ? msg->origin.username : "-", msg->origin.sess_id,
-        msg->origin.sess_version, msg->origin.nettype, msg->origin.addrtype,
-        msg->origin.addr);
+      msg->origin.addrtype && msg->origin.addr) {
+    g_string_append_len (lines, "o=", 2);
+    g_string_append (lines,
+        msg->origin.username ? msg->origin.username : "-");
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, msg->origin.sess_id);
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, msg->origin.sess_version);
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, msg->origin.nettype);
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, msg->origin.addrtype);
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, msg->origin.addr);
+    g_string_append_len (lines, "\r\n", 2);
+  }
 
   if (msg->session_name)
-    g_string_append_printf (lines, "s=%s\r\n", msg->session_name);
+    append_line (lines, "s=", msg->session_name);
 
   if (msg->information)
-    g_string_append_printf (lines, "i=%s\r\n", msg->information);
+    append_line (lines, "i=", msg->information);
 
   if (msg->uri)
-    g_string_append_printf (lines, "u=%s\r\n", msg->uri);
+    append_line (lines, "u=", msg->uri);
 
   for (i = 0; i < gst_sdp_message_emails_len (msg); i++)
-    g_string_append_printf (lines, "e=%s\r\n",
-        gst_sdp_message_get_email (msg, i));
+    append_line (lines, "e=", gst_sdp_message_get_email (msg, i));
 
   for (i = 0; i < gst_sdp_message_phones_len (msg); i++)
-    g_string_append_printf (lines, "p=%s\r\n",
-        gst_sdp_message_get_phone (msg, i));
-
-  if (msg->connection.nettype && msg->connection.addrtype &&
-      msg->connection.address) {
-    g_string_append_printf (lines, "c=%s %s %s", msg->connection.nettype,
-        msg->connection.addrtype, msg->connection.address);
-    if (gst_sdp_address_is_multicast (msg->connection.nettype,
-            msg->connection.addrtype, msg->connection.address)) {
-      /* only add ttl for IP4 */
-      if (strcmp (msg->connection.addrtype, "IP4") == 0)
-        g_string_append_printf (lines, "/%u", msg->connection.ttl);
-      if (msg->connection.addr_number > 1)
-        g_string_append_printf (lines, "/%u", msg->connection.addr_number);
-    }
-    g_string_append_printf (lines, "\r\n");
-  }
+    append_line (lines, "p=", gst_sdp_message_get_phone (msg, i));
 
-  for (i = 0; i < gst_sdp_message_bandwidths_len (msg); i++) {
-    const GstSDPBandwidth *bandwidth = gst_sdp_message_get_bandwidth (msg, i);
+  append_connection (lines, &msg->connection);
 
-    g_string_append_printf (lines, "b=%s:%u\r\n", bandwidth->bwtype,
-        bandwidth->bandwidth);
-  }
+  for (i = 0; i < gst_sdp_message_bandwidths_len (msg); i++)
+    append_bandwidth (lines, gst_sdp_message_get_bandwidth (msg, i));
 
   if (gst_sdp_message_times_len (msg) == 0) {
-    g_string_append_printf (lines, "t=0 0\r\n");
+    g_string_append_len (lines, "t=0 0\r\n", 7);
   } else {
     for (i = 0; i < gst_sdp_message_times_len (msg); i++) {
       const GstSDPTime *times = gst_sdp_message_get_time (msg, i);
 
-      g_string_append_printf (lines, "t=%s %s\r\n", times->start, times->stop);
+      g_string_append_len (lines, "t=", 2);
+      append_string (lines, times->start);
+      g_string_append_c (lines, ' ');
+      append_string (lines, times->stop);
+      g_string_append_len (lines, "\r\n", 2);
 
       if (times->repeat != NULL) {
         guint j;
 
-        g_string_append_printf (lines, "r=%s",
-            g_array_index (times->repeat, gchar *, 0));
-        for (j = 1; j < times->repeat->len; j++)
-          g_string_append_printf (lines, " %s",
-              g_array_index (times->repeat, gchar *, j));
-        g_string_append_printf (lines, "\r\n");
+        g_string_append_len (lines, "r=", 2);
+        append_string (lines, g_array_index (times->repeat, gchar *, 0));
+        for (j = 1; j < times->repeat->len; j++) {
+          g_string_append_c (lines, ' ');
+          append_string (lines, g_array_index (times->repeat, gchar *, j));
+        }
+        g_string_append_len (lines, "\r\n", 2);
       }
     }
   }
@@ -574,42 +719,29 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
   if (gst_sdp_message_zones_len (msg) > 0) {
     const GstSDPZone *zone = gst_sdp_message_get_zone (msg, 0);
 
-    g_string_append_printf (lines, "z=%s %s", zone->time, zone->typed_time);
+    g_string_append_len (lines, "z=", 2);
+    append_string (lines, zone->time);
+    g_string_append_c (lines, ' ');
+    append_string (lines, zone->typed_time);
     for (i = 1; i < gst_sdp_message_zones_len (msg); i++) {
       zone = gst_sdp_message_get_zone (msg, i);
-      g_string_append_printf (lines, " %s %s", zone->time, zone->typed_time);
+      g_string_append_c (lines, ' ');
+      append_string (lines, zone->time);
+      g_string_append_c (lines, ' ');
+      append_string (lines, zone->typed_time);
     }
-    g_string_append_printf (lines, "\r\n");
+    g_string_append_len (lines, "\r\n", 2);
   }
 
-  if (msg->key.type) {
-    g_string_append_printf (lines, "k=%s", msg->key.type);
-    if (msg->key.data)
-      g_string_append_printf (lines, ":%s", msg->key.data);
-    g_string_append_printf (lines, "\r\n");
-  }
+  append_key (lines, &msg->key);
 
-  for (i = 0; i < gst_sdp_message_attributes_len (msg); i++) {
-    const GstSDPAttribute *attr = gst_sdp_message_get_attribute (msg, i);
+  for (i = 0; i < gst_sdp_message_attributes_len (msg); i++)
+    append_attribute (lines, gst_sdp_message_get_attribute (msg, i));
 
-    if (attr->key) {
-      g_string_append_printf (lines, "a=%s", attr->key);
-      if (attr->value && attr->value[0] != '\0')
-        g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
-    }
-  }
-
-  for (i = 0; i < gst_sdp_message_medias_len (msg); i++) {
-    const GstSDPMedia *media = gst_sdp_message_get_media (msg, i);
-    gchar *sdp_media_str;
+  for (i = 0; i < gst_sdp_message_medias_len (msg); i++)
+    media_append_text (gst_sdp_message_get_media (msg, i), lines);
 
-    sdp_media_str = gst_sdp_media_as_text (media);
-    g_string_append_printf (lines, "%s", sdp_media_str);
-    g_free (sdp_media_str);
-  }
-
-  return g_string_free (lines, FALSE);
+  return GST_SDP_OK;
 }
 
 static int
@@ -1959,6 +2091,50 @@ gst_sdp_media_copy (const GstSDPMedia * media, GstSDPMedia ** copy)
   return GST_SDP_OK;
 }
 
+static void
+media_append_text (const GstSDPMedia * media, GString * lines)
+{
+  guint i;
+
+  if (media->media) {
+    g_string_append_len (lines, "m=", 2);
+    g_string_append (lines, media->media);
+  }
+
+  g_string_append_c (lines, ' ');
+  append_uint (lines, media->port);
+
+  if (media->num_ports > 1) {
+    g_string_append_c (lines, '/');
+    append_uint (lines, media->num_ports);
+  }
+
+  g_string_append_c (lines, ' ');
+  append_string (lines, media->proto);
+
+  for (i = 0; i < gst_sdp_media_formats_len (media); i++) {
+    g_string_append_c (lines, ' ');
+    append_string (lines, gst_sdp_media_get_format (media, i));
+  }
+  g_string_append_len (lines, "\r\n", 2);
+
+  if (media->information) {
+    g_string_append_len (lines, "i=", 2);
+    g_string_append (lines, media->information);
+  }
+
+  for (i = 0; i < gst_sdp_media_connections_len (media); i++)
+    append_connection (lines, gst_sdp_media_get_connection (media, i));
+
+  for (i = 0; i < gst_sdp_media_bandwidths_len (media); i++)
+    append_bandwidth (lines, gst_sdp_media_get_bandwidth (media, i));
+
+  append_key (lines, &media->key);
+
+  for (i = 0; i < gst_sdp_media_attributes_len (media); i++)
+    append_attribute (lines, gst_sdp_media_get_attribute (media, i));
+}
+
 /**
  * gst_sdp_media_as_text:
  * @media: a #GstSDPMedia
@@ -1971,71 +2147,11 @@ gchar *
 gst_sdp_media_as_text (const GstSDPMedia * media)
 {
   GString *lines;
-  guint i;
 
   g_return_val_if_fail (media != NULL, NULL);
 
   lines = g_string_new ("");
-
-  if (media->media)
-    g_string_append_printf (lines, "m=%s", media->media);
-
-  g_string_append_printf (lines, " %u", media->port);
-
-  if (media->num_ports > 1)
-    g_string_append_printf (lines, "/%u", media->num_ports);
-
-  g_string_append_printf (lines, " %s", media->proto);
-
-  for (i = 0; i < gst_sdp_media_formats_len (media); i++)
-    g_string_append_printf (lines, " %s", gst_sdp_media_get_format (media, i));
-  g_string_append_printf (lines, "\r\n");
-
-  if (media->information)
-    g_string_append_printf (lines, "i=%s", media->information);
-
-  for (i = 0; i < gst_sdp_media_connections_len (media); i++) {
-    const GstSDPConnection *conn = gst_sdp_media_get_connection (media, i);
-
-    if (conn->nettype && conn->addrtype && conn->address) {
-      g_string_append_printf (lines, "c=%s %s %s", conn->nettype,
-          conn->addrtype, conn->address);
-      if (gst_sdp_address_is_multicast (conn->nettype, conn->addrtype,
-              conn->address)) {
-        /* only add TTL for IP4 multicast */
-        if (strcmp (conn->addrtype, "IP4") == 0)
-          g_string_append_printf (lines, "/%u", conn->ttl);
-        if (conn->addr_number > 1)
-          g_string_append_printf (lines, "/%u", conn->addr_number);
-      }
-      g_string_append_printf (lines, "\r\n");
-    }
-  }
-
-  for (i = 0; i < gst_sdp_media_bandwidths_len (media); i++) {
-    const GstSDPBandwidth *bandwidth = gst_sdp_media_get_bandwidth (media, i);
-
-    g_string_append_printf (lines, "b=%s:%u\r\n", bandwidth->bwtype,
-        bandwidth->bandwidth);
-  }
-
-  if (media->key.type) {
-    g_string_append_printf (lines, "k=%s", media->key.type);
-    if (media->key.data)
-      g_string_append_printf (lines, ":%s", media->key.data);
-    g_string_append_printf (lines, "\r\n");
-  }
-
-  for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
-    const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
-
-    if (attr->key) {
-      g_string_append_printf (lines, "a=%s", attr->key);
-      if (attr->value && attr->value[0] != '\0')
-        g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
-    }
-  }
+  media_append_text (media, lines);
 
   return g_string_free (lines, FALSE);
 }
@@ -2948,23 +3064,44 @@ read_string (gchar * dest, guint size, gchar ** src)
     dest[idx] = '\0';
 }
 
-static void
-read_string_del (gchar * dest, guint size, gchar del, gchar ** src)
+/* like read_string() but returns a newly allocated copy of the string
+ * without a size limit */
+static gchar *
+read_string_dup (gchar ** src)
 {
-  guint idx;
+  gchar *start;
 
-  idx = 0;
   /* skip spaces */
   while (g_ascii_isspace (**src))
     (*src)++;
 
-  while (**src != del && **src != '\0') {
-    if (idx < size - 1)
-      dest[idx++] = **src;
+  start = *src;
+  while (!g_ascii_isspace (**src) && **src != '\0')
     (*src)++;
+
+  return g_strndup (start, *src - start);
+}
+
+/* splits @src at the first @del in place. Returns the part before @del with
+ * leading spaces removed and makes @src point after @del, or to the empty
+ * string at the end of @src when there is no @del */
+static gchar *
+split_string_del (gchar del, gchar ** src)
+{
+  gchar *start, *end;
+
+  /* skip spaces */
+  while (g_ascii_isspace (**src))
+    (*src)++;
+
+  start = *src;
+  if ((end = strchr (start, del))) {
+    *end = '\0';
+    *src = end + 1;
+  } else {
+    *src = start + strlen (start);
   }
-  if (size > 0)
-    dest[idx] = '\0';
+  return start;
 }
 
 enum
@@ -2987,7 +3124,7 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
   gchar *p = buffer;
 
 #define READ_STRING(field) \
-  do { read_string (str, sizeof (str), &p); REPLACE_STRING (field, str); } while (0)
+  do { g_free (field); (field) = read_string_dup (&p); } while (0)
 #define READ_UINT(field) \
   do { read_string (str, sizeof (str), &p); field = strtoul (str, NULL, 10); } while (0)
 
@@ -3042,50 +3179,50 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
         READ_UINT (conn.ttl);
       READ_UINT (conn.addr_number);
 
+      /* transfer the parsed strings instead of copying them again */
       if (c->state == SDP_SESSION) {
-        gst_sdp_message_set_connection (c->msg, conn.nettype, conn.addrtype,
-            conn.address, conn.ttl, conn.addr_number);
+        gst_sdp_connection_clear (&c->msg->connection);
+        c->msg->connection = conn;
       } else {
-        gst_sdp_media_add_connection (c->media, conn.nettype, conn.addrtype,
-            conn.address, conn.ttl, conn.addr_number);
+        g_array_append_val (c->media->connections, conn);
       }
-      gst_sdp_connection_clear (&conn);
       break;
     }
     case 'b':
     {
-      gchar str2[32];
+      gchar *bwtype;
 
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
-      read_string (str2, sizeof (str2), &p);
+      bwtype = split_string_del (':', &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_add_bandwidth (c->msg, str, atoi (str2));
+        gst_sdp_message_add_bandwidth (c->msg, bwtype, atoi (p));
       else
-        gst_sdp_media_add_bandwidth (c->media, str, atoi (str2));
+        gst_sdp_media_add_bandwidth (c->media, bwtype, atoi (p));
       break;
     }
     case 't':
       break;
     case 'k':
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
+    {
+      gchar *type;
+
+      type = split_string_del (':', &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_set_key (c->msg, str, p);
+        gst_sdp_message_set_key (c->msg, type, p);
       else
-        gst_sdp_media_set_key (c->media, str, p);
+        gst_sdp_media_set_key (c->media, type, p);
       break;
+    }
     case 'a':
-      read_string_del (str, sizeof (str), ':', &p);
-      if (*p != '\0')
-        p++;
+    {
+      gchar *key;
+
+      key = split_string_del (':', &p);
       if (c->state == SDP_SESSION)
-        gst_sdp_message_add_attribute (c->msg, str, p);
+        gst_sdp_message_add_attribute (c->msg, key, p);
       else
-        gst_sdp_media_add_attribute (c->media, str, p);
+        gst_sdp_media_add_attribute (c->media, key, p);
       break;
+    }
     case 'm':
     {
       gchar *slash;
@@ -3109,8 +3246,9 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
       }
       READ_STRING (nmedia.proto);
       do {
-        read_string (str, sizeof (str), &p);
-        gst_sdp_media_add_format (&nmedia, str);
+        gchar *fmt = read_string_dup (&p);
+
+        g_array_append_val (nmedia.fmts, fmt);
       } while (*p != '\0');
 
       gst_sdp_message_add_media (c->msg, &nmedia);
@@ -3124,6 +3262,43 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
   return TRUE;
 }
 
+static void
+array_reserve (GArray * array, guint n)
+{
+  guint len = array->len;
+
+  /* GArray never shrinks its allocation */
+  g_array_set_size (array, len + n);
+  g_array_set_size (array, len);
+}
+
+/* count the media and session level attribute lines so that the arrays
+ * holding them only need to be allocated once. Like the parser, this stops
+ * at the first 0 byte */
+static void
+reserve_arrays (GstSDPMessage * msg, const guint8 * data, guint size)
+{
+  guint i = 0, n_medias = 0, n_attributes = 0;
+
+  while (i + 1 < size && data[i] != '\0') {
+    if (data[i + 1] == '=') {
+      if (data[i] == 'm')
+        n_medias++;
+      else if (data[i] == 'a' && n_medias == 0)
+        n_attributes++;
+    }
+    while (i < size && data[i] != '\n' && data[i] != '\0')
+      i++;
+    if (i < size && data[i] == '\n')
+      i++;
+  }
+
+  if (n_medias > 0)
+    array_reserve (msg->medias, n_medias);
+  if (n_attributes > 0)
+    array_reserve (msg->attributes, n_attributes);
+}
+
 /**
  * gst_sdp_message_parse_buffer:
  * @data: (array length=size): the start of the buffer
@@ -3154,6 +3329,8 @@ gst_sdp_message_parse_buffer (const guint8 * data, guint size,
   c.msg = msg;
   c.media = NULL;
 
+  reserve_arrays (msg, data, size);
+
 #define SIZE_CHECK_GUARD \
   G_STMT_START { \
     if (p - (gchar *) data >= size) \
@@ -3913,6 +4090,409 @@ error:
   }
 }
 
+/* caching of the caps <-> media conversions. Both caches are bounded and
+ * evict the least recently used entry when full. */
+#define DEFAULT_CACHE_MAX_SIZE 64
+
+typedef struct
+{
+  gpointer key;
+  gpointer value;
+  GList *link;
+} SDPCacheEntry;
+
+typedef struct
+{
+  GHashTable *table;
+  /* SDPCacheEntry, most recently used first */
+  GQueue lru;
+  GDestroyNotify key_free;
+  GDestroyNotify value_free;
+  guint64 hits;
+  guint64 misses;
+  guint64 evictions;
+} SDPCache;
+
+/* a media with only the fields that gst_sdp_media_set_media_from_caps()
+ * sets */
+typedef struct
+{
+  gchar *media;
+  gchar **formats;
+  GstSDPAttribute *attributes;
+  guint n_attributes;
+} SDPMediaTemplate;
+
+G_LOCK_DEFINE_STATIC (sdp_cache);
+static SDPCache caps_cache;
+static SDPCache media_cache;
+static guint cache_max_size = DEFAULT_CACHE_MAX_SIZE;
+
+static void
+sdp_cache_entry_free (SDPCacheEntry * entry, SDPCache * cache)
+{
+  cache->key_free (entry->key);
+  cache->value_free (entry->value);
+  g_free (entry);
+}
+
+static void
+sdp_cache_ensure (SDPCache * cache, GHashFunc hash_func,
+    GEqualFunc equal_func, GDestroyNotify key_free, GDestroyNotify value_free)
+{
+  if (cache->table)
+    return;
+
+  /* the entries are freed by us because they need the cache */
+  cache->table = g_hash_table_new (hash_func, equal_func);
+  g_queue_init (&cache->lru);
+  cache->key_free = key_free;
+  cache->value_free = value_free;
+}
+
+/* call with the sdp_cache lock */
+static gpointer
+sdp_cache_lookup (SDPCache * cache, gconstpointer key)
+{
+  SDPCacheEntry *entry;
+
+  if (cache->table == NULL ||
+      (entry = g_hash_table_lookup (cache->table, key)) == NULL) {
+    cache->misses++;
+    return NULL;
+  }
+
+  /* move to the front */
+  g_queue_unlink (&cache->lru, entry->link);
+  g_queue_push_head_link (&cache->lru, entry->link);
+  cache->hits++;
+
+  return entry->value;
+}
+
+static void
+sdp_cache_trim (SDPCache * cache, guint max_size)
+{
+  while (cache->lru.length > max_size) {
+    SDPCacheEntry *entry = g_queue_pop_tail (&cache->lru);
+
+    g_hash_table_remove (cache->table, entry->key);
+    sdp_cache_entry_free (entry, cache);
+    cache->evictions++;
+  }
+}
+
+/* call with the sdp_cache lock, takes ownership of @key and @value */
+static void
+sdp_cache_insert (SDPCache * cache, gpointer key, gpointer value)
+{
+  SDPCacheEntry *entry;
+
+  if (cache_max_size == 0 || g_hash_table_contains (cache->table, key)) {
+    cache->key_free (key);
+    cache->value_free (value);
+    return;
+  }
+
+  sdp_cache_trim (cache, cache_max_size - 1);
+
+  entry = g_new0 (SDPCacheEntry, 1);
+  entry->key = key;
+  entry->value = value;
+  g_queue_push_head (&cache->lru, entry);
+  entry->link = cache->lru.head;
+  g_hash_table_insert (cache->table, key, entry);
+}
+
+static void
+sdp_cache_clear (SDPCache * cache)
+{
+  SDPCacheEntry *entry;
+
+  if (cache->table == NULL)
+    return;
+
+  while ((entry = g_queue_pop_head (&cache->lru)))
+    sdp_cache_entry_free (entry, cache);
+  g_hash_table_remove_all (cache->table);
+  cache->hits = cache->misses = cache->evictions = 0;
+}
+
+static void
+sdp_media_template_free (SDPMediaTemplate * templ)
+{
+  guint i;
+
+  g_free (templ->media);
+  g_strfreev (templ->formats);
+  for (i = 0; i < templ->n_attributes; i++)
+    gst_sdp_attribute_clear (&templ->attributes[i]);
+  g_free (templ->attributes);
+  g_free (templ);
+}
+
+/* the key for the caps cache contains everything that
+ * gst_sdp_media_get_caps_from_media() looks at */
+static gchar *
+make_caps_cache_key (const GstSDPMedia * media, gint pt)
+{
+  GString *key;
+  guint i;
+
+  key = g_string_sized_new (256);
+  g_string_append_printf (key, "%s %d\n", GST_STR_NULL (media->media), pt);
+
+  for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
+    const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
+
+    if (attr->key == NULL)
+      continue;
+
+    if (strcmp (attr->key, "rtpmap") && strcmp (attr->key, "fmtp") &&
+        strcmp (attr->key, "framesize") && strcmp (attr->key, "rtcp-fb"))
+      continue;
+
+    g_string_append (key, attr->key);
+    g_string_append_c (key, ':');
+    g_string_append (key, GST_STR_NULL (attr->value));
+    g_string_append_c (key, '\n');
+  }
+
+  return g_string_free (key, FALSE);
+}
+
+/**
+ * gst_sdp_media_get_caps_from_media_cached:
+ * @media: a #GstSDPMedia
+ * @pt: a payload type
+ *
+ * Like gst_sdp_media_get_caps_from_media() but the result is looked up in a
+ * process wide cache keyed on the media type, @pt and the rtpmap, fmtp,
+ * framesize and rtcp-fb attributes of @media. The caps are only created
+ * when no media with the same attributes was converted before.
+ *
+ * The returned caps are shared with the cache and must not be modified, use
+ * gst_caps_make_writable() to get caps that can be changed.
+ *
+ * Returns: (transfer full): a #GstCaps, or %NULL if an error happened
+ *
+ * Since: 1.16
+ */
+GstCaps *
+gst_sdp_media_get_caps_from_media_cached (const GstSDPMedia * media, gint pt)
+{
+  GstCaps *caps;
+  gchar *key;
+
+  g_return_val_if_fail (media != NULL, NULL);
+
+  key = make_caps_cache_key (media, pt);
+
+  G_LOCK (sdp_cache);
+  if ((caps = sdp_cache_lookup (&caps_cache, key)))
+    gst_caps_ref (caps);
+  G_UNLOCK (sdp_cache);
+
+  if (caps) {
+    g_free (key);
+    return caps;
+  }
+
+  if ((caps = gst_sdp_media_get_caps_from_media (media, pt)) == NULL) {
+    g_free (key);
+    return NULL;
+  }
+
+  G_LOCK (sdp_cache);
+  sdp_cache_ensure (&caps_cache, g_str_hash, g_str_equal, g_free,
+      (GDestroyNotify) gst_caps_unref);
+  sdp_cache_insert (&caps_cache, key, gst_caps_ref (caps));
+  G_UNLOCK (sdp_cache);
+
+  return caps;
+}
+
+static SDPMediaTemplate *
+sdp_media_template_new (const GstSDPMedia * media)
+{
+  SDPMediaTemplate *templ;
+  guint i, len;
+
+  templ = g_new0 (SDPMediaTemplate, 1);
+  templ->media = g_strdup (media->media);
+
+  len = gst_sdp_media_formats_len (media);
+  templ->formats = g_new0 (gchar *, len + 1);
+  for (i = 0; i < len; i++)
+    templ->formats[i] = g_strdup (gst_sdp_media_get_format (media, i));
+
+  len = gst_sdp_media_attributes_len (media);
+  templ->attributes = g_new0 (GstSDPAttribute, len);
+  templ->n_attributes = len;
+  for (i = 0; i < len; i++) {
+    const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
+
+    gst_sdp_attribute_set (&templ->attributes[i], attr->key, attr->value);
+  }
+
+  return templ;
+}
+
+static void
+sdp_media_template_apply (const SDPMediaTemplate * templ, GstSDPMedia * media)
+{
+  guint i;
+
+  if (templ->media)
+    gst_sdp_media_set_media (media, templ->media);
+  for (i = 0; templ->formats[i]; i++)
+    gst_sdp_media_add_format (media, templ->formats[i]);
+  for (i = 0; i < templ->n_attributes; i++)
+    gst_sdp_media_add_attribute (media, templ->attributes[i].key,
+        templ->attributes[i].value);
+}
+
+/**
+ * gst_sdp_media_set_media_from_caps_cached:
+ * @caps: a #GstCaps
+ * @media: a #GstSDPMedia
+ *
+ * Like gst_sdp_media_set_media_from_caps() but the media type, format and
+ * attributes generated for @caps are remembered in a process wide cache
+ * keyed on the serialized @caps. Calling this function again with caps that
+ * are equal to @caps only copies the cached fields to @media.
+ *
+ * Returns: a #GstSDPResult.
+ *
+ * Since: 1.16
+ */
+GstSDPResult
+gst_sdp_media_set_media_from_caps_cached (const GstCaps * caps,
+    GstSDPMedia * media)
+{
+  SDPMediaTemplate *templ;
+  GstSDPMedia tmp = { NULL, };
+  GstSDPResult res;
+  gchar *key;
+
+  g_return_val_if_fail (media != NULL, GST_SDP_EINVAL);
+  g_return_val_if_fail (caps != NULL && GST_IS_CAPS (caps), GST_SDP_EINVAL);
+
+  /* keyed on the content, equal caps are usually separate objects */
+  key = gst_caps_to_string (caps);
+
+  /* the template is only used with the lock held, it can be evicted
+   * otherwise */
+  G_LOCK (sdp_cache);
+  if ((templ = sdp_cache_lookup (&media_cache, key)))
+    sdp_media_template_apply (templ, media);
+  G_UNLOCK (sdp_cache);
+
+  if (templ) {
+    g_free (key);
+    return GST_SDP_OK;
+  }
+
+  gst_sdp_media_init (&tmp);
+  res = gst_sdp_media_set_media_from_caps (caps, &tmp);
+  if (res == GST_SDP_OK) {
+    templ = sdp_media_template_new (&tmp);
+    sdp_media_template_apply (templ, media);
+
+    G_LOCK (sdp_cache);
+    sdp_cache_ensure (&media_cache, g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) sdp_media_template_free);
+    sdp_cache_insert (&media_cache, key, templ);
+    G_UNLOCK (sdp_cache);
+  } else {
+    g_free (key);
+  }
+  gst_sdp_media_uninit (&tmp);
+
+  return res;
+}
+
+/**
+ * gst_sdp_media_cache_set_max_size:
+ * @max_size: the maximum number of entries
+ *
+ * Set the maximum number of entries kept by each of the caches used by
+ * gst_sdp_media_get_caps_from_media_cached() and
+ * gst_sdp_media_set_media_from_caps_cached(). The least recently used entries
+ * are removed when a cache grows beyond this size. A size of 0 disables
+ * caching. The default is 64.
+ *
+ * Since: 1.16
+ */
+void
+gst_sdp_media_cache_set_max_size (guint max_size)
+{
+  G_LOCK (sdp_cache);
+  cache_max_size = max_size;
+  if (caps_cache.table)
+    sdp_cache_trim (&caps_cache, max_size);
+  if (media_cache.table)
+    sdp_cache_trim (&media_cache, max_size);
+  G_UNLOCK (sdp_cache);
+}
+
+/**
+ * gst_sdp_media_cache_clear:
+ *
+ * Remove all entries from the caps and media caches and reset their
+ * statistics.
+ *
+ * Since: 1.16
+ */
+void
+gst_sdp_media_cache_clear (void)
+{
+  G_LOCK (sdp_cache);
+  sdp_cache_clear (&caps_cache);
+  sdp_cache_clear (&media_cache);
+  G_UNLOCK (sdp_cache);
+}
+
+/**
+ * gst_sdp_media_cache_get_stats:
+ *
+ * Get the statistics of the caps and media caches. The returned structure
+ * contains the following fields:
+ *
+ * - "max-size" G_TYPE_UINT: the maximum number of entries per cache
+ * - "caps-size", "media-size" G_TYPE_UINT: the current number of entries
+ * - "caps-hits", "media-hits" G_TYPE_UINT64: the number of lookups that were
+ *   found in the cache
+ * - "caps-misses", "media-misses" G_TYPE_UINT64: the number of lookups that
+ *   needed a conversion
+ * - "caps-evictions", "media-evictions" G_TYPE_UINT64: the number of entries
+ *   removed to make room for new ones
+ *
+ * Returns: (transfer full): a #GstStructure with the cache statistics
+ *
+ * Since: 1.16
+ */
+GstStructure *
+gst_sdp_media_cache_get_stats (void)
+{
+  GstStructure *s;
+
+  G_LOCK (sdp_cache);
+  s = gst_structure_new ("application/x-sdp-cache-stats",
+      "max-size", G_TYPE_UINT, cache_max_size,
+      "caps-size", G_TYPE_UINT, caps_cache.lru.length,
+      "caps-hits", G_TYPE_UINT64, caps_cache.hits,
+      "caps-misses", G_TYPE_UINT64, caps_cache.misses,
+      "caps-evictions", G_TYPE_UINT64, caps_cache.evictions,
+      "media-size", G_TYPE_UINT, media_cache.lru.length,
+      "media-hits", G_TYPE_UINT64, media_cache.hits,
+      "media-misses", G_TYPE_UINT64, media_cache.misses,
+      "media-evictions", G_TYPE_UINT64, media_cache.evictions, NULL);
+  G_UNLOCK (sdp_cache);
+
+  return s;
+}
+
 /**
  * gst_sdp_make_keymgmt:
  * @uri: a #gchar URI
@@ -340,6 +340,9 @@ GstSDPResult            gst_sdp_message_parse_buffer        (const guint8 *data,
 GST_SDP_API
 gchar*                  gst_sdp_message_as_text             (const GstSDPMessage *msg);
 
+GST_SDP_API
+GstSDPResult            gst_sdp_message_append_text         (const GstSDPMessage *msg, GString *str);
+
 GST_SDP_API
 GstSDPResult            gst_sdp_message_new_from_text       (const gchar *text, GstSDPMessage ** msg);
 
@@ -740,6 +743,21 @@ GstCaps*                gst_sdp_media_get_caps_from_media   (const GstSDPMedia *
 GST_SDP_API
 GstSDPResult            gst_sdp_media_set_media_from_caps   (const GstCaps* caps, GstSDPMedia *media);
 
+GST_SDP_API
+GstCaps*                gst_sdp_media_get_caps_from_media_cached (const GstSDPMedia *media, gint pt);
+
+GST_SDP_API
+GstSDPResult            gst_sdp_media_set_media_from_caps_cached (const GstCaps* caps, GstSDPMedia *media);
+
+GST_SDP_API
+void                    gst_sdp_media_cache_set_max_size    (guint max_size);
+
+GST_SDP_API
+void                    gst_sdp_media_cache_clear           (void);
+
+GST_SDP_API
+GstStructure*           gst_sdp_media_cache_get_stats       (void);
+
 GST_SDP_API
 gchar *                 gst_sdp_make_keymgmt                (const gchar *uri, const gchar *base64);
 
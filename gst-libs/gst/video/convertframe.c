@@ -41,6 +41,25 @@ caps_are_raw (const GstCaps * caps)
   return FALSE;
 }
 
+static GstCaps *
+caps_without_framerate (const GstCaps * caps)
+{
+  GstCaps *result;
+  guint i, n;
+
+  result = gst_caps_new_empty ();
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; i++) {
+    GstStructure *s = gst_caps_get_structure (caps, i);
+
+    s = gst_structure_copy (s);
+    gst_structure_remove_field (s, "framerate");
+    gst_caps_append_structure (result, s);
+  }
+
+  return result;
+}
+
 static gboolean
 create_element (const gchar * factory_name, GstElement ** element,
     GError ** err)
@@ -309,7 +328,6 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
   GstCaps *from_caps, *to_caps_copy = NULL;
   GstFlowReturn ret;
   GstElement *pipeline, *src, *sink;
-  guint i, n;
 
   g_return_val_if_fail (sample != NULL, NULL);
   g_return_val_if_fail (to_caps != NULL, NULL);
@@ -321,15 +339,7 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
   g_return_val_if_fail (from_caps != NULL, NULL);
 
 
-  to_caps_copy = gst_caps_new_empty ();
-  n = gst_caps_get_size (to_caps);
-  for (i = 0; i < n; i++) {
-    GstStructure *s = gst_caps_get_structure (to_caps, i);
-
-    s = gst_structure_copy (s);
-    gst_structure_remove_field (s, "framerate");
-    gst_caps_append_structure (to_caps_copy, s);
-  }
+  to_caps_copy = caps_without_framerate (to_caps);
 
   pipeline =
       build_convert_frame_pipeline (&src, &sink, from_caps,
@@ -667,7 +677,6 @@ gst_video_convert_sample_async (GstSample * sample,
   GstBuffer *buf;
   GstCaps *from_caps, *to_caps_copy = NULL;
   GstElement *pipeline, *src, *sink;
-  guint i, n;
   GSource *source;
   GstVideoConvertSampleContext *ctx;
 
@@ -686,15 +695,7 @@ gst_video_convert_sample_async (GstSample * sample,
   if (!context)
     context = g_main_context_default ();
 
-  to_caps_copy = gst_caps_new_empty ();
-  n = gst_caps_get_size (to_caps);
-  for (i = 0; i < n; i++) {
-    GstStructure *s = gst_caps_get_structure (to_caps, i);
-
-    s = gst_structure_copy (s);
-    gst_structure_remove_field (s, "framerate");
-    gst_caps_append_structure (to_caps_copy, s);
-  }
+  to_caps_copy = caps_without_framerate (to_caps);
 
   pipeline =
       build_convert_frame_pipeline (&src, &sink, from_caps,
@@ -762,3 +763,390 @@ no_pipeline:
     g_source_unref (source);
   }
 }
+
+/* Number of idle conversion paths kept by a GstVideoSampleConverter */
+#define MAX_IDLE_PATHS 8
+/* Interval for checking the conversion pipeline for errors while waiting */
+#define PULL_SLICE (10 * GST_MSECOND)
+
+struct _GstVideoSampleConverter
+{
+  GMutex lock;
+  /* idle SampleConverterPaths, most recently used first */
+  GQueue idle;
+};
+
+typedef struct
+{
+  GstCaps *from_caps;
+  GstCaps *to_caps;
+
+  /* raw to fixed raw caps: direct conversion */
+  GstVideoConverter *convert;
+  GstVideoInfo in_info, out_info;
+  GstCaps *out_caps;
+
+  /* anything else: a running conversion pipeline */
+  GstElement *pipeline;
+  GstElement *src, *sink;
+  GstBus *bus;
+} SampleConverterPath;
+
+static void
+sample_converter_path_free (SampleConverterPath * path)
+{
+  if (path->convert)
+    gst_video_converter_free (path->convert);
+  if (path->out_caps)
+    gst_caps_unref (path->out_caps);
+  if (path->pipeline) {
+    gst_element_set_state (path->pipeline, GST_STATE_NULL);
+    gst_object_unref (path->bus);
+    gst_object_unref (path->pipeline);
+  }
+  gst_caps_unref (path->from_caps);
+  gst_caps_unref (path->to_caps);
+  g_slice_free (SampleConverterPath, path);
+}
+
+/* Sets up a GstVideoConverter when both caps are raw and @to_caps is fixed,
+ * scaling and adding borders like videoscale in the conversion pipeline */
+static gboolean
+sample_converter_path_setup_raw (SampleConverterPath * path)
+{
+  GstVideoInfo *in_info = &path->in_info, *out_info = &path->out_info;
+  GstStructure *s;
+  gint from_dar_n, from_dar_d, n, d, borders_w = 0, borders_h = 0;
+
+  if (!caps_are_raw (path->from_caps) || !caps_are_raw (path->to_caps) ||
+      !gst_caps_is_fixed (path->to_caps))
+    return FALSE;
+
+  if (!gst_video_info_from_caps (in_info, path->from_caps) ||
+      !gst_video_info_from_caps (out_info, path->to_caps))
+    return FALSE;
+
+  if (GST_VIDEO_INFO_IS_INTERLACED (in_info) ||
+      GST_VIDEO_INFO_MULTIVIEW_MODE (in_info) !=
+      GST_VIDEO_MULTIVIEW_MODE_MONO)
+    return FALSE;
+
+  if (!gst_util_fraction_multiply (in_info->width, in_info->height,
+          in_info->par_n, in_info->par_d, &from_dar_n, &from_dar_d))
+    return FALSE;
+
+  s = gst_caps_get_structure (path->to_caps, 0);
+  if (!gst_structure_has_field (s, "pixel-aspect-ratio")) {
+    /* videoscale picks the pixel-aspect-ratio that keeps the DAR */
+    if (!gst_util_fraction_multiply (from_dar_n, from_dar_d,
+            out_info->height, out_info->width, &out_info->par_n,
+            &out_info->par_d))
+      return FALSE;
+  } else if (gst_util_fraction_multiply (from_dar_n, from_dar_d,
+          out_info->par_d, out_info->par_n, &n, &d)) {
+    gint to_h, to_w;
+
+    to_h = gst_util_uint64_scale_int (out_info->width, d, n);
+    if (to_h <= out_info->height) {
+      borders_h = out_info->height - to_h;
+    } else {
+      to_w = gst_util_uint64_scale_int (out_info->height, n, d);
+      borders_w = out_info->width - to_w;
+    }
+  } else {
+    return FALSE;
+  }
+
+  out_info->fps_n = in_info->fps_n;
+  out_info->fps_d = in_info->fps_d;
+
+  path->convert = gst_video_converter_new_cached (in_info, out_info,
+      gst_structure_new ("GstVideoConverter",
+          GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, borders_w / 2,
+          GST_VIDEO_CONVERTER_OPT_DEST_Y, G_TYPE_INT, borders_h / 2,
+          GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT,
+          out_info->width - borders_w,
+          GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT,
+          out_info->height - borders_h, NULL));
+  if (path->convert == NULL)
+    return FALSE;
+
+  path->out_caps = gst_video_info_to_caps (out_info);
+
+  return TRUE;
+}
+
+static SampleConverterPath *
+sample_converter_path_new (const GstCaps * from_caps, GstCaps * to_caps,
+    GError ** err)
+{
+  SampleConverterPath *path;
+
+  path = g_slice_new0 (SampleConverterPath);
+  path->from_caps = gst_caps_copy (from_caps);
+  path->to_caps = gst_caps_ref (to_caps);
+
+  if (sample_converter_path_setup_raw (path)) {
+    GST_DEBUG ("converting directly to caps %" GST_PTR_FORMAT, to_caps);
+    return path;
+  }
+
+  path->pipeline = build_convert_frame_pipeline (&path->src, &path->sink,
+      from_caps, NULL, to_caps, err);
+  if (!path->pipeline) {
+    sample_converter_path_free (path);
+    return NULL;
+  }
+
+  /* buffers are pulled one by one, whatever their timestamps */
+  g_object_set (path->sink, "sync", FALSE, "emit-signals", FALSE, NULL);
+  path->bus = gst_element_get_bus (path->pipeline);
+
+  GST_DEBUG ("starting conversion pipeline to caps %" GST_PTR_FORMAT,
+      to_caps);
+  if (gst_element_set_state (path->pipeline,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE)
+    goto start_failed;
+
+  return path;
+
+  /* ERRORS */
+start_failed:
+  {
+    GST_ERROR ("Could not convert video frame: failed to start pipeline");
+    if (err)
+      *err = g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_STATE_CHANGE,
+          "Could not convert video frame: failed to start pipeline");
+    sample_converter_path_free (path);
+    return NULL;
+  }
+}
+
+static GstSample *
+sample_converter_path_convert (SampleConverterPath * path, GstBuffer * buf,
+    GstClockTime timeout, GError ** err)
+{
+  GstSample *result = NULL;
+  GstClockTime deadline = 0;
+  GstFlowReturn ret;
+  GstMessage *msg;
+
+  if (path->convert) {
+    GstVideoFrame in_frame, out_frame;
+    GstBuffer *outbuf;
+
+    if (!gst_video_frame_map (&in_frame, &path->in_info, buf, GST_MAP_READ))
+      goto map_failed;
+
+    outbuf = gst_buffer_new_allocate (NULL, path->out_info.size, NULL);
+    gst_video_frame_map (&out_frame, &path->out_info, outbuf, GST_MAP_WRITE);
+    gst_video_converter_frame (path->convert, &in_frame, &out_frame);
+    gst_video_frame_unmap (&out_frame);
+    gst_video_frame_unmap (&in_frame);
+
+    gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+    result = gst_sample_new (outbuf, path->out_caps, NULL, NULL);
+    gst_buffer_unref (outbuf);
+
+    return result;
+  }
+
+  g_signal_emit_by_name (path->src, "push-buffer", buf, &ret);
+  if (ret != GST_FLOW_OK)
+    goto push_failed;
+
+  /* wait for the sample in short slices and check for errors in between,
+   * a pipeline that failed would never produce a sample */
+  if (timeout != GST_CLOCK_TIME_NONE)
+    deadline = gst_util_get_timestamp () + timeout;
+  do {
+    GstClockTime slice = PULL_SLICE;
+
+    if (timeout != GST_CLOCK_TIME_NONE) {
+      GstClockTime now = gst_util_get_timestamp ();
+
+      slice = now < deadline ? MIN (slice, deadline - now) : 0;
+    }
+
+    g_signal_emit_by_name (path->sink, "try-pull-sample", slice, &result);
+    if (result)
+      return result;
+
+    msg = gst_bus_pop_filtered (path->bus, GST_MESSAGE_ERROR);
+  } while (msg == NULL && (timeout == GST_CLOCK_TIME_NONE ||
+          gst_util_get_timestamp () < deadline));
+
+  if (msg) {
+    GError *error = NULL;
+    gchar *dbg = NULL;
+
+    gst_message_parse_error (msg, &error, &dbg);
+    GST_ERROR ("Could not convert video frame: %s", error->message);
+    GST_DEBUG ("%s [debug: %s]", error->message, GST_STR_NULL (dbg));
+    if (err)
+      *err = error;
+    else
+      g_error_free (error);
+    g_free (dbg);
+    gst_message_unref (msg);
+  } else {
+    GST_ERROR ("Could not convert video frame: timeout during conversion");
+    if (err)
+      *err = g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_FAILED,
+          "Could not convert video frame: timeout during conversion");
+  }
+
+  return NULL;
+
+  /* ERRORS */
+map_failed:
+  {
+    GST_ERROR ("Could not convert video frame: failed to map buffer");
+    if (err)
+      *err = g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_FAILED,
+          "Could not convert video frame: failed to map buffer");
+    return NULL;
+  }
+push_failed:
+  {
+    GST_ERROR ("Could not push video frame: %s", gst_flow_get_name (ret));
+    if (err)
+      *err = g_error_new (GST_CORE_ERROR, GST_CORE_ERROR_FAILED,
+          "Could not push video frame: %s", gst_flow_get_name (ret));
+    return NULL;
+  }
+}
+
+/**
+ * gst_video_sample_converter_new: (skip)
+ *
+ * Creates a converter for converting many samples, like
+ * gst_video_convert_sample() but keeping the conversion set up for the same
+ * input and output caps between calls. Conversions between raw video caps
+ * with fixed output caps are done with a #GstVideoConverter, everything
+ * else with a conversion pipeline that is kept running.
+ *
+ * Returns: a new #GstVideoSampleConverter. Free with
+ *     gst_video_sample_converter_free().
+ *
+ * Since: 1.16
+ */
+GstVideoSampleConverter *
+gst_video_sample_converter_new (void)
+{
+  GstVideoSampleConverter *converter;
+
+  converter = g_slice_new0 (GstVideoSampleConverter);
+  g_mutex_init (&converter->lock);
+  g_queue_init (&converter->idle);
+
+  return converter;
+}
+
+/**
+ * gst_video_sample_converter_free:
+ * @converter: a #GstVideoSampleConverter
+ *
+ * Frees @converter and shuts down its conversion pipelines. There must be
+ * no conversion running on @converter anymore.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_sample_converter_free (GstVideoSampleConverter * converter)
+{
+  g_return_if_fail (converter != NULL);
+
+  g_queue_free_full (&converter->idle,
+      (GDestroyNotify) sample_converter_path_free);
+  g_mutex_clear (&converter->lock);
+  g_slice_free (GstVideoSampleConverter, converter);
+}
+
+/**
+ * gst_video_sample_converter_convert:
+ * @converter: a #GstVideoSampleConverter
+ * @sample: a #GstSample
+ * @to_caps: the #GstCaps to convert to
+ * @timeout: the maximum amount of time allowed for the processing.
+ * @error: pointer to a #GError. Can be %NULL.
+ *
+ * Converts a raw video buffer into the specified output caps, like
+ * gst_video_convert_sample(), reusing the conversion of a previous call with
+ * the same caps when possible.
+ *
+ * This function can be called from multiple threads at the same time, each
+ * running conversion uses its own conversion pipeline or converter.
+ *
+ * Returns: The converted #GstSample, or %NULL if an error happened (in which
+ * case @error will point to the #GError).
+ *
+ * Since: 1.16
+ */
+GstSample *
+gst_video_sample_converter_convert (GstVideoSampleConverter * converter,
+    GstSample * sample, const GstCaps * to_caps, GstClockTime timeout,
+    GError ** error)
+{
+  SampleConverterPath *path = NULL, *old = NULL;
+  GstCaps *from_caps, *to_caps_copy;
+  GstSample *result;
+  GstBuffer *buf;
+  GList *l;
+
+  g_return_val_if_fail (converter != NULL, NULL);
+  g_return_val_if_fail (sample != NULL, NULL);
+  g_return_val_if_fail (to_caps != NULL, NULL);
+
+  buf = gst_sample_get_buffer (sample);
+  g_return_val_if_fail (buf != NULL, NULL);
+
+  from_caps = gst_sample_get_caps (sample);
+  g_return_val_if_fail (from_caps != NULL, NULL);
+
+  /* the cropping is configured per buffer, don't keep such pipelines */
+  if (gst_buffer_get_video_crop_meta (buf))
+    return gst_video_convert_sample (sample, to_caps, timeout, error);
+
+  to_caps_copy = caps_without_framerate (to_caps);
+
+  g_mutex_lock (&converter->lock);
+  for (l = converter->idle.head; l; l = l->next) {
+    SampleConverterPath *p = l->data;
+
+    if (gst_caps_is_equal (p->from_caps, from_caps) &&
+        gst_caps_is_equal (p->to_caps, to_caps_copy)) {
+      g_queue_delete_link (&converter->idle, l);
+      path = p;
+      break;
+    }
+  }
+  g_mutex_unlock (&converter->lock);
+
+  if (path == NULL) {
+    path = sample_converter_path_new (from_caps, to_caps_copy, error);
+    if (path == NULL) {
+      gst_caps_unref (to_caps_copy);
+      return NULL;
+    }
+  }
+  gst_caps_unref (to_caps_copy);
+
+  result = sample_converter_path_convert (path, buf, timeout, error);
+  if (result == NULL) {
+    /* the pipeline might be in an error state, don't reuse it */
+    sample_converter_path_free (path);
+    return NULL;
+  }
+
+  g_mutex_lock (&converter->lock);
+  g_queue_push_head (&converter->idle, path);
+  if (converter->idle.length > MAX_IDLE_PATHS)
+    old = g_queue_pop_tail (&converter->idle);
+  g_mutex_unlock (&converter->lock);
+
+  if (old)
+    sample_converter_path_free (old);
+
+  return result;
+}
@@ -46,6 +46,41 @@ gboolean __gst_video_rawvideo_convert (GstVideoCodecState * state, GstFormat src
                                        gint64 src_value, GstFormat * dest_format,
                                        gint64 * dest_value);
 
+/* Blending of overlays with transparent areas */
+G_GNUC_INTERNAL
+GBytes * __gst_video_blend_compute_coverage (GstVideoFrame * src);
+
+G_GNUC_INTERNAL
+gboolean __gst_video_blend_with_coverage (GstVideoFrame * dest, GstVideoFrame * src,
+                                          gint x, gint y, gfloat global_alpha,
+                                          GBytes * coverage);
+
+/* Parallelized task runner, shared by the converter and the blender */
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+
+G_GNUC_INTERNAL
+GstParallelizedTaskRunner * gst_parallelized_task_runner_new (const gchar * name,
+                                                              guint n_threads);
+
+G_GNUC_INTERNAL
+void gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self);
+
+G_GNUC_INTERNAL
+void gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+                                       GstParallelizedTaskFunc func,
+                                       gpointer * task_data);
+
+/* Gamma tables, shared by all converters */
+G_GNUC_INTERNAL
+gconstpointer __gst_video_transfer_table_ref (GstVideoTransferFunction func,
+                                              gboolean encode, guint in_bits,
+                                              guint out_bits);
+
+G_GNUC_INTERNAL
+void __gst_video_transfer_table_unref (gconstpointer table);
+
 G_END_DECLS
 
 #endif
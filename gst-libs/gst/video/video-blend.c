@@ -29,6 +29,7 @@
 
 #include "video-blend.h"
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 
@@ -276,33 +277,233 @@ G_STMT_START { \
 } G_STMT_END
 
 
-/**
- * gst_video_blend:
- * @dest: The #GstVideoFrame where to blend @src in
- * @src: the #GstVideoFrame that we want to blend into
- * @x: The x offset in pixel where the @src image should be blended
- * @y: the y offset in pixel where the @src image should be blended
- * @global_alpha: the global_alpha each per-pixel alpha value is multiplied
- *                with
- *
- * Lets you blend the @src image into the @dest image
- */
-gboolean
-gst_video_blend (GstVideoFrame * dest,
-    GstVideoFrame * src, gint x, gint y, gfloat global_alpha)
+/* Overlays are blended on a shared set of threads once they cover at least
+ * two tasks worth of pixels. Lines are split over the tasks in multiples of
+ * 4 so that lines sharing chroma are always blended by the same task. */
+#define BLEND_MAX_THREADS 16
+#define BLEND_PIXELS_PER_TASK (64 * 1024)
+
+G_LOCK_DEFINE_STATIC (blend_runner);
+static GstParallelizedTaskRunner *blend_runner;
+static guint blend_n_threads;
+static gboolean blend_runner_initialized;
+
+typedef struct
+{
+  GstVideoFrame *dest;
+  GstVideoFrame *src;
+  const GstVideoFormatInfo *dinfo, *sinfo;
+  void (*matrix) (guint8 * tmpline, guint width);
+  const gint *coverage;
+  gfloat global_alpha;
+  gint global_alpha_val;
+  gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
+  gboolean direct;
+  gint x, src_xoff, src_width;
+  /* lines of dest to blend, and the first line of src */
+  gint y_start, y_end, src_yoff;
+} BlendTask;
+
+/* Returns the locked blend runner, or NULL if it is busy or there is only
+ * one CPU */
+static GstParallelizedTaskRunner *
+acquire_blend_runner (guint * n_threads)
+{
+  if (!G_TRYLOCK (blend_runner))
+    return NULL;
+
+  if (!blend_runner_initialized) {
+    blend_n_threads = MIN (g_get_num_processors (), BLEND_MAX_THREADS);
+    if (blend_n_threads > 1)
+      blend_runner = gst_parallelized_task_runner_new ("videoblend",
+          blend_n_threads);
+    blend_runner_initialized = TRUE;
+  }
+
+  if (blend_runner == NULL) {
+    G_UNLOCK (blend_runner);
+    return NULL;
+  }
+
+  *n_threads = blend_n_threads;
+  return blend_runner;
+}
+
+/* Blends an AYUV line straight into the planes of an I420 or NV12 frame
+ * without unpacking and packing the destination line. The result is the
+ * same as with the generic code: the destination is opaque and the chroma
+ * of each 2x2 block comes from its top-left pixel. */
+static void
+blend_line_420 (BlendTask * t, const guint8 * s, gint line, gint x,
+    gint width)
+{
+  GstVideoFrame *dest = t->dest;
+  guint8 *dy, *du, *dv;
+  gint j, c, asrc, src_alpha, uv_pstride, alpha_val = t->global_alpha_val;
+  gboolean chroma_line = !(line & 1);
+
+  dy = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_Y) +
+      line * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_Y) + x;
+  du = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_U) +
+      (line >> 1) * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_U);
+  dv = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (dest, GST_VIDEO_COMP_V) +
+      (line >> 1) * GST_VIDEO_FRAME_COMP_STRIDE (dest, GST_VIDEO_COMP_V);
+  uv_pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (dest, GST_VIDEO_COMP_U);
+
+  for (j = 0; j < width; j++, s += 4) {
+    asrc = s[0] * alpha_val / 255;
+    if (!asrc)
+      continue;
+
+    /* OVER10 and OVER00 with an opaque destination */
+    src_alpha = t->src_premultiplied_alpha ? alpha_val : asrc;
+
+    c = (s[1] * src_alpha + dy[j] * (255 - asrc)) / 255;
+    dy[j] = MIN (c, 255);
+
+    if (chroma_line && !((x + j) & 1)) {
+      gint k = ((x + j) >> 1) * uv_pstride;
+
+      c = (s[2] * src_alpha + du[k] * (255 - asrc)) / 255;
+      du[k] = MIN (c, 255);
+      c = (s[3] * src_alpha + dv[k] * (255 - asrc)) / 255;
+      dv[k] = MIN (c, 255);
+    }
+  }
+}
+
+static void
+blend_task (BlendTask * t)
 {
-  gint i, j, global_alpha_val, src_width, src_height, dest_width, dest_height;
+  GstVideoFrame *dest = t->dest;
+  GstVideoFrame *src = t->src;
+  gint i, j, dest_width, src_yoff;
+  guint8 *tmpdestline = NULL, *tmpsrcline;
+
+  if (t->y_start >= t->y_end)
+    return;
+
+  dest_width = GST_VIDEO_FRAME_WIDTH (dest);
+
+  if (!t->direct)
+    tmpdestline = g_malloc (sizeof (guint8) * (dest_width + 8) * 4);
+  tmpsrcline = g_malloc (sizeof (guint8) * (t->src_width + 8) * 4);
+
+  /* Mainloop doing the needed conversions, and blending */
+  for (i = t->y_start, src_yoff = t->src_yoff; i < t->y_end; i++, src_yoff++) {
+    gint x = t->x, src_xoff = t->src_xoff, src_width = t->src_width;
+
+    /* only blend the part of the line that is not fully transparent */
+    if (t->coverage) {
+      gint first = MAX (t->coverage[2 * src_yoff], src_xoff);
+      gint last = MIN (t->coverage[2 * src_yoff + 1], src_xoff + src_width);
+
+      if (first >= last)
+        continue;
+
+      x += first - src_xoff;
+      src_width = last - first;
+      src_xoff = first;
+    }
+
+    t->sinfo->unpack_func (t->sinfo, 0, tmpsrcline, src->data,
+        src->info.stride, src_xoff, src_yoff, src_width);
+
+    t->matrix (tmpsrcline, src_width);
+
+    if (t->direct) {
+      blend_line_420 (t, tmpsrcline, i, x, src_width);
+      continue;
+    }
+
+    t->dinfo->unpack_func (t->dinfo, 0, tmpdestline, dest->data,
+        dest->info.stride, 0, i, dest_width);
+
+    /* FIXME: use the x parameter of the unpack func once implemented */
+    tmpdestline += 4 * x;
+
+#define BLENDLOOP(op, alpha_val)                                                              \
+  G_STMT_START {                                                                              \
+    for (j = 0; j < src_width * 4; j += 4) {                                                  \
+      guint8 asrc, adst;                                                                      \
+      gint final_alpha;                                                                       \
+                                                                                              \
+      asrc = tmpsrcline[j] * alpha_val / 255;                                                 \
+      if (!asrc)                                                                              \
+        continue;                                                                             \
+                                                                                              \
+      adst = tmpdestline[j];                                                                  \
+      final_alpha = asrc + adst * (255 - asrc) / 255;                                         \
+      tmpdestline[j] = final_alpha;                                                           \
+      if (final_alpha == 0)                                                                   \
+        final_alpha = 1;                                                                      \
+                                                                                              \
+      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 1], adst, tmpdestline[j + 1], final_alpha); \
+      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 2], adst, tmpdestline[j + 2], final_alpha); \
+      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 3], adst, tmpdestline[j + 3], final_alpha); \
+    }                                                                                         \
+  } G_STMT_END
+
+    if (G_LIKELY (t->global_alpha == 1.0)) {
+      if (t->src_premultiplied_alpha && t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER11, 255);
+      } else if (!t->src_premultiplied_alpha && t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER01, 255);
+      } else if (t->src_premultiplied_alpha && !t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER10, 255);
+      } else {
+        BLENDLOOP (OVER00, 255);
+      }
+    } else {
+      if (t->src_premultiplied_alpha && t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER11, t->global_alpha_val);
+      } else if (!t->src_premultiplied_alpha && t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER01, t->global_alpha_val);
+      } else if (t->src_premultiplied_alpha && !t->dest_premultiplied_alpha) {
+        BLENDLOOP (OVER10, t->global_alpha_val);
+      } else {
+        BLENDLOOP (OVER00, t->global_alpha_val);
+      }
+    }
+
+#undef BLENDLOOP
+
+    /* undo previous pointer adjustments to pass right pointer to g_free */
+    tmpdestline -= 4 * x;
+
+    /* FIXME
+     * #if G_BYTE_ORDER == LITTLE_ENDIAN
+     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
+     * #else
+     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
+     * #endif
+     */
+
+    t->dinfo->pack_func (t->dinfo, 0, tmpdestline, dest_width,
+        dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
+  }
+
+  g_free (tmpdestline);
+  g_free (tmpsrcline);
+}
+
+static gboolean
+video_blend (GstVideoFrame * dest, GstVideoFrame * src, gint x, gint y,
+    gfloat global_alpha, const gint * coverage)
+{
+  gint src_width, src_height, dest_width, dest_height;
   gint src_xoff = 0, src_yoff = 0;
-  guint8 *tmpdestline = NULL, *tmpsrcline = NULL;
   gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
   void (*matrix) (guint8 * tmpline, guint width);
   const GstVideoFormatInfo *sinfo, *dinfo, *dunpackinfo, *sunpackinfo;
+  GstParallelizedTaskRunner *runner = NULL;
+  BlendTask tasks[BLEND_MAX_THREADS];
+  gpointer task_data[BLEND_MAX_THREADS];
+  guint i, n_threads = 1, n_tasks = 1;
 
   g_assert (dest != NULL);
   g_assert (src != NULL);
 
-  global_alpha_val = 255.0 * global_alpha;
-
   dest_premultiplied_alpha =
       GST_VIDEO_INFO_FLAGS (&dest->info) & GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA;
   src_premultiplied_alpha =
@@ -342,9 +543,6 @@ gst_video_blend (GstVideoFrame * dest,
   if (GST_VIDEO_FORMAT_INFO_BITS (dunpackinfo) != 8)
     goto unpack_format_not_supported;
 
-  tmpdestline = g_malloc (sizeof (guint8) * (dest_width + 8) * 4);
-  tmpsrcline = g_malloc (sizeof (guint8) * (src_width + 8) * 4);
-
   matrix = matrix_identity;
   if (GST_VIDEO_INFO_IS_RGB (&src->info) != GST_VIDEO_INFO_IS_RGB (&dest->info)) {
     if (GST_VIDEO_INFO_IS_RGB (&src->info)) {
@@ -383,82 +581,53 @@ gst_video_blend (GstVideoFrame * dest,
   if (y + src_height > dest_height)
     src_height = dest_height - y;
 
-  /* Mainloop doing the needed conversions, and blending */
-  for (i = y; i < y + src_height; i++, src_yoff++) {
-
-    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
-        0, i, dest_width);
-    sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
-        src_xoff, src_yoff, src_width);
-
-    /* FIXME: use the x parameter of the unpack func once implemented */
-    tmpdestline += 4 * x;
-
-    matrix (tmpsrcline, src_width);
-
-#define BLENDLOOP(op, alpha_val)                                                              \
-  G_STMT_START {                                                                              \
-    for (j = 0; j < src_width * 4; j += 4) {                                                  \
-      guint8 asrc, adst;                                                                      \
-      gint final_alpha;                                                                       \
-                                                                                              \
-      asrc = tmpsrcline[j] * alpha_val / 255;                                                 \
-      if (!asrc)                                                                              \
-        continue;                                                                             \
-                                                                                              \
-      adst = tmpdestline[j];                                                                  \
-      final_alpha = asrc + adst * (255 - asrc) / 255;                                         \
-      tmpdestline[j] = final_alpha;                                                           \
-      if (final_alpha == 0)                                                                   \
-        final_alpha = 1;                                                                      \
-                                                                                              \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 1], adst, tmpdestline[j + 1], final_alpha); \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 2], adst, tmpdestline[j + 2], final_alpha); \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 3], adst, tmpdestline[j + 3], final_alpha); \
-    }                                                                                         \
-  } G_STMT_END
-
-    if (G_LIKELY (global_alpha == 1.0)) {
-      if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER11, 255);
-      } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER01, 255);
-      } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-        BLENDLOOP (OVER10, 255);
-      } else {
-        BLENDLOOP (OVER00, 255);
-      }
-    } else {
-      if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER11, global_alpha_val);
-      } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER01, global_alpha_val);
-      } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-        BLENDLOOP (OVER10, global_alpha_val);
-      } else {
-        BLENDLOOP (OVER00, global_alpha_val);
-      }
-    }
-
-#undef BLENDLOOP
-
-    /* undo previous pointer adjustments to pass right pointer to g_free */
-    tmpdestline -= 4 * x;
-
-    /* FIXME
-     * #if G_BYTE_ORDER == LITTLE_ENDIAN
-     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
-     * #else
-     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
-     * #endif
-     */
-
-    dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
-        dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
+  if (src_width * src_height >= 2 * BLEND_PIXELS_PER_TASK)
+    runner = acquire_blend_runner (&n_threads);
+  if (runner)
+    n_tasks = MIN (n_threads, src_width * src_height / BLEND_PIXELS_PER_TASK);
+
+  for (i = 0; i < n_threads; i++) {
+    BlendTask *t = &tasks[i];
+
+    t->dest = dest;
+    t->src = src;
+    t->dinfo = dinfo;
+    t->sinfo = sinfo;
+    t->matrix = matrix;
+    t->coverage = coverage;
+    t->global_alpha = global_alpha;
+    t->global_alpha_val = 255.0 * global_alpha;
+    t->src_premultiplied_alpha = src_premultiplied_alpha;
+    t->dest_premultiplied_alpha = dest_premultiplied_alpha;
+    t->direct = !dest_premultiplied_alpha &&
+        (dinfo->format == GST_VIDEO_FORMAT_I420 ||
+        dinfo->format == GST_VIDEO_FORMAT_NV12);
+    t->x = x;
+    t->src_xoff = src_xoff;
+    t->src_width = src_width;
+
+    if (i == 0)
+      t->y_start = y;
+    else
+      t->y_start = tasks[i - 1].y_end;
+
+    if (i + 1 >= n_tasks)
+      t->y_end = y + src_height;
+    else
+      t->y_end = MIN (GST_ROUND_UP_4 (y + (i + 1) * src_height / n_tasks),
+          y + src_height);
+
+    t->src_yoff = src_yoff + t->y_start - y;
+    task_data[i] = t;
   }
 
-  g_free (tmpdestline);
-  g_free (tmpsrcline);
+  if (runner) {
+    gst_parallelized_task_runner_run (runner,
+        (GstParallelizedTaskFunc) blend_task, task_data);
+    G_UNLOCK (blend_runner);
+  } else {
+    blend_task (&tasks[0]);
+  }
 
   return TRUE;
 
@@ -480,3 +649,82 @@ nothing_to_do:
     return TRUE;
   }
 }
+
+/**
+ * gst_video_blend:
+ * @dest: The #GstVideoFrame where to blend @src in
+ * @src: the #GstVideoFrame that we want to blend into
+ * @x: The x offset in pixel where the @src image should be blended
+ * @y: the y offset in pixel where the @src image should be blended
+ * @global_alpha: the global_alpha each per-pixel alpha value is multiplied
+ *                with
+ *
+ * Lets you blend the @src image into the @dest image
+ */
+gboolean
+gst_video_blend (GstVideoFrame * dest,
+    GstVideoFrame * src, gint x, gint y, gfloat global_alpha)
+{
+  return video_blend (dest, src, x, y, global_alpha, NULL);
+}
+
+/* Like gst_video_blend(), but skips the transparent parts of @src described
+ * by @coverage, as returned by __gst_video_blend_compute_coverage() */
+gboolean
+__gst_video_blend_with_coverage (GstVideoFrame * dest, GstVideoFrame * src,
+    gint x, gint y, gfloat global_alpha, GBytes * coverage)
+{
+  const gint *spans = NULL;
+
+  if (coverage) {
+    gsize size;
+
+    spans = g_bytes_get_data (coverage, &size);
+    g_return_val_if_fail (size ==
+        2 * sizeof (gint) * GST_VIDEO_FRAME_HEIGHT (src), FALSE);
+  }
+
+  return video_blend (dest, src, x, y, global_alpha, spans);
+}
+
+/* Returns for each line of @src the range [first, last) of pixels with a
+ * non-zero alpha, which is empty for fully transparent lines, or NULL if
+ * @src has no alpha channel */
+GBytes *
+__gst_video_blend_compute_coverage (GstVideoFrame * src)
+{
+  const GstVideoFormatInfo *sinfo, *sunpackinfo;
+  gint i, j, first, width, height;
+  guint8 *tmpline;
+  gint *spans;
+
+  sinfo = src->info.finfo;
+  if (!GST_VIDEO_FORMAT_INFO_HAS_ALPHA (sinfo))
+    return NULL;
+
+  sunpackinfo = gst_video_format_get_info (sinfo->unpack_format);
+  if (sunpackinfo == NULL || GST_VIDEO_FORMAT_INFO_BITS (sunpackinfo) != 8)
+    return NULL;
+
+  width = GST_VIDEO_FRAME_WIDTH (src);
+  height = GST_VIDEO_FRAME_HEIGHT (src);
+
+  spans = g_new (gint, 2 * height);
+  tmpline = g_malloc (sizeof (guint8) * (width + 8) * 4);
+
+  for (i = 0; i < height; i++) {
+    sinfo->unpack_func (sinfo, 0, tmpline, src->data, src->info.stride, 0, i,
+        width);
+
+    for (j = 0; j < width && tmpline[4 * j] == 0; j++);
+    first = j;
+    for (j = width; j > first && tmpline[4 * (j - 1)] == 0; j--);
+
+    spans[2 * i] = first;
+    spans[2 * i + 1] = j;
+  }
+
+  g_free (tmpline);
+
+  return g_bytes_new_take (spans, 2 * sizeof (gint) * height);
+}
@@ -28,6 +28,7 @@
 #include <math.h>
 
 #include "video-color.h"
+#include "gstvideoutilsprivate.h"
 
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
@@ -556,3 +557,132 @@ gst_video_color_transfer_decode (GstVideoTransferFunction func, gdouble val)
   }
   return res;
 }
+
+/* Gamma tables, shared between all converters using the same transfer
+ * function and depths. A 16 bits table is 128KiB and needs 65536
+ * evaluations of the transfer function to fill so it is worth not doing
+ * that for every converter. */
+typedef struct
+{
+  GstVideoTransferFunction func;
+  gboolean encode;
+  guint in_bits;
+  guint out_bits;
+
+  gint refcount;
+  gpointer table;
+} TransferTable;
+
+G_LOCK_DEFINE_STATIC (transfer_tables);
+static GList *transfer_tables;
+
+static gpointer
+transfer_table_fill (GstVideoTransferFunction func, gboolean encode,
+    guint in_bits, guint out_bits)
+{
+  guint i, n_in;
+  gdouble in_max, out_max;
+  gpointer table;
+
+  n_in = 1 << in_bits;
+  in_max = n_in - 1;
+  out_max = (1 << out_bits) - 1;
+
+  if (out_bits == 8)
+    table = g_malloc (sizeof (guint8) * n_in);
+  else
+    table = g_malloc (sizeof (guint16) * n_in);
+
+  for (i = 0; i < n_in; i++) {
+    gdouble val;
+
+    if (encode)
+      val = gst_video_color_transfer_encode (func, i / in_max);
+    else
+      val = gst_video_color_transfer_decode (func, i / in_max);
+
+    if (out_bits == 8)
+      ((guint8 *) table)[i] = rint (val * out_max);
+    else
+      ((guint16 *) table)[i] = rint (val * out_max);
+  }
+  return table;
+}
+
+/* Returns a table mapping @in_bits input values to @out_bits values
+ * encoded or decoded with @func. @in_bits and @out_bits are 8 or 16 and the
+ * table contains guint8 or guint16 values depending on @out_bits. Release
+ * with __gst_video_transfer_table_unref() */
+gconstpointer
+__gst_video_transfer_table_ref (GstVideoTransferFunction func,
+    gboolean encode, guint in_bits, guint out_bits)
+{
+  TransferTable *tt = NULL;
+  GList *l;
+
+  g_return_val_if_fail (in_bits == 8 || in_bits == 16, NULL);
+  g_return_val_if_fail (out_bits == 8 || out_bits == 16, NULL);
+
+  G_LOCK (transfer_tables);
+  for (l = transfer_tables; l; l = l->next) {
+    TransferTable *t = l->data;
+
+    if (t->func == func && t->encode == encode && t->in_bits == in_bits
+        && t->out_bits == out_bits) {
+      tt = t;
+      break;
+    }
+  }
+
+  if (tt) {
+    tt->refcount++;
+  } else {
+    GST_DEBUG ("creating %s table %d, %u->%u bits",
+        encode ? "encode" : "decode", func, in_bits, out_bits);
+
+    tt = g_slice_new (TransferTable);
+    tt->func = func;
+    tt->encode = encode;
+    tt->in_bits = in_bits;
+    tt->out_bits = out_bits;
+    tt->refcount = 1;
+    tt->table = transfer_table_fill (func, encode, in_bits, out_bits);
+    transfer_tables = g_list_prepend (transfer_tables, tt);
+  }
+  G_UNLOCK (transfer_tables);
+
+  return tt->table;
+}
+
+void
+__gst_video_transfer_table_unref (gconstpointer table)
+{
+  TransferTable *tt = NULL;
+  GList *l;
+
+  G_LOCK (transfer_tables);
+  for (l = transfer_tables; l; l = l->next) {
+    TransferTable *t = l->data;
+
+    if (t->table == table) {
+      tt = t;
+      break;
+    }
+  }
+
+  if (tt == NULL) {
+    G_UNLOCK (transfer_tables);
+    g_return_if_reached ();
+  }
+
+  if (--tt->refcount == 0)
+    transfer_tables = g_list_delete_link (transfer_tables, l);
+  else
+    tt = NULL;
+  G_UNLOCK (transfer_tables);
+
+  if (tt) {
+    g_free (tt->table);
+    g_slice_free (TransferTable, tt);
+  }
+}
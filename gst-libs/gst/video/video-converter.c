@@ -22,13 +22,6 @@
 #include "config.h"
 #endif
 
-#if 0
-#ifdef HAVE_PTHREAD
-#define _GNU_SOURCE
-#include <pthread.h>
-#endif
-#endif
-
 #include "video-converter.h"
 
 #include <glib.h>
@@ -36,6 +29,7 @@
 #include <math.h>
 
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 /**
  * SECTION:videoconverter
@@ -115,199 +109,6 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
-typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
-
-typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
-
-struct _GstParallelizedTaskThread
-{
-  GstParallelizedTaskRunner *runner;
-  guint idx;
-  GThread *thread;
-};
-
-struct _GstParallelizedTaskRunner
-{
-  guint n_threads;
-
-  GstParallelizedTaskThread *threads;
-
-  GstParallelizedTaskFunc func;
-  gpointer *task_data;
-
-  GMutex lock;
-  GCond cond_todo, cond_done;
-  gint n_todo, n_done;
-  gboolean quit;
-};
-
-static gpointer
-gst_parallelized_task_thread_func (gpointer data)
-{
-  GstParallelizedTaskThread *self = data;
-
-#if 0
-#ifdef HAVE_PTHREAD
-  {
-    pthread_t thread = pthread_self ();
-    cpu_set_t cpuset;
-    int r;
-
-    CPU_ZERO (&cpuset);
-    CPU_SET (self->idx, &cpuset);
-    if ((r = pthread_setaffinity_np (thread, sizeof (cpuset), &cpuset)) != 0)
-      GST_ERROR ("Failed to set thread affinity for thread %d: %s", self->idx,
-          g_strerror (r));
-  }
-#endif
-#endif
-
-  g_mutex_lock (&self->runner->lock);
-  self->runner->n_done++;
-  if (self->runner->n_done == self->runner->n_threads - 1)
-    g_cond_signal (&self->runner->cond_done);
-
-  do {
-    gint idx;
-
-    while (self->runner->n_todo == -1 && !self->runner->quit)
-      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
-
-    if (self->runner->quit)
-      break;
-
-    idx = self->runner->n_todo--;
-    g_assert (self->runner->n_todo >= -1);
-    g_mutex_unlock (&self->runner->lock);
-
-    g_assert (self->runner->func != NULL);
-
-    self->runner->func (self->runner->task_data[idx]);
-
-    g_mutex_lock (&self->runner->lock);
-    self->runner->n_done++;
-    if (self->runner->n_done == self->runner->n_threads - 1)
-      g_cond_signal (&self->runner->cond_done);
-  } while (TRUE);
-
-  g_mutex_unlock (&self->runner->lock);
-
-  return NULL;
-}
-
-static void
-gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
-{
-  guint i;
-
-  g_mutex_lock (&self->lock);
-  self->quit = TRUE;
-  g_cond_broadcast (&self->cond_todo);
-  g_mutex_unlock (&self->lock);
-
-  for (i = 1; i < self->n_threads; i++) {
-    if (!self->threads[i].thread)
-      continue;
-
-    g_thread_join (self->threads[i].thread);
-  }
-
-  g_mutex_clear (&self->lock);
-  g_cond_clear (&self->cond_todo);
-  g_cond_clear (&self->cond_done);
-  g_free (self->threads);
-  g_free (self);
-}
-
-static GstParallelizedTaskRunner *
-gst_parallelized_task_runner_new (guint n_threads)
-{
-  GstParallelizedTaskRunner *self;
-  guint i;
-  GError *err = NULL;
-
-  if (n_threads == 0)
-    n_threads = g_get_num_processors ();
-
-  self = g_new0 (GstParallelizedTaskRunner, 1);
-  self->n_threads = n_threads;
-  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
-
-  self->quit = FALSE;
-  self->n_todo = -1;
-  self->n_done = 0;
-  g_mutex_init (&self->lock);
-  g_cond_init (&self->cond_todo);
-  g_cond_init (&self->cond_done);
-
-  /* Set when scheduling a job */
-  self->func = NULL;
-  self->task_data = NULL;
-
-  for (i = 0; i < n_threads; i++) {
-    self->threads[i].runner = self;
-    self->threads[i].idx = i;
-
-    /* First thread is the one calling run() */
-    if (i > 0) {
-      self->threads[i].thread =
-          g_thread_try_new ("videoconvert", gst_parallelized_task_thread_func,
-          &self->threads[i], &err);
-      if (!self->threads[i].thread)
-        goto error;
-    }
-  }
-
-  g_mutex_lock (&self->lock);
-  while (self->n_done < self->n_threads - 1)
-    g_cond_wait (&self->cond_done, &self->lock);
-  self->n_done = 0;
-  g_mutex_unlock (&self->lock);
-
-  return self;
-
-error:
-  {
-    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
-    g_clear_error (&err);
-
-    gst_parallelized_task_runner_free (self);
-    return NULL;
-  }
-}
-
-static void
-gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
-    GstParallelizedTaskFunc func, gpointer * task_data)
-{
-  guint n_threads = self->n_threads;
-
-  self->func = func;
-  self->task_data = task_data;
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    self->n_todo = self->n_threads - 2;
-    self->n_done = 0;
-    g_cond_broadcast (&self->cond_todo);
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func (self->task_data[self->n_threads - 1]);
-
-  if (n_threads > 1) {
-    g_mutex_lock (&self->lock);
-    while (self->n_done < self->n_threads - 1)
-      g_cond_wait (&self->cond_done, &self->lock);
-    self->n_done = 0;
-    g_mutex_unlock (&self->lock);
-  }
-
-  self->func = NULL;
-  self->task_data = NULL;
-}
-
 typedef struct _GstLineCache GstLineCache;
 
 #define SCALE    (8)
@@ -335,7 +136,7 @@ typedef struct _GammaData GammaData;
 
 struct _GammaData
 {
-  gpointer gamma_table;
+  gconstpointer gamma_table;
   gint width;
   void (*gamma_func) (GammaData * data, gpointer dest, gpointer src);
 };
@@ -498,6 +299,14 @@ struct _GstVideoConverter
     GstVideoScaler **scaler;
   } fv_scaler[4];
   FastConvertFunc fconvert[4];
+
+  /* converter cache, see gst_video_converter_new_cached() */
+  gboolean cached;
+  GstVideoInfo cache_in_info;
+  GstVideoInfo cache_out_info;
+  GstStructure *cache_config;
+  gsize cache_size;
+  GList cache_link;
 };
 
 typedef gpointer (*GstLineCacheAllocLineFunc) (GstLineCache * cache, gint idx,
@@ -1462,7 +1271,7 @@ gamma_convert_u8_u16 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint8 *s = src;
   guint16 *d = dest;
-  guint16 *table = data->gamma_table;
+  const guint16 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1479,7 +1288,7 @@ gamma_convert_u16_u8 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint16 *s = src;
   guint8 *d = dest;
-  guint8 *table = data->gamma_table;
+  const guint8 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1496,7 +1305,7 @@ gamma_convert_u16_u16 (GammaData * data, gpointer dest, gpointer src)
   gint i;
   guint16 *s = src;
   guint16 *d = dest;
-  guint16 *table = data->gamma_table;
+  const guint16 *table = data->gamma_table;
   gint width = data->width * 4;
 
   for (i = 0; i < width; i += 4) {
@@ -1511,28 +1320,28 @@ static void
 setup_gamma_decode (GstVideoConverter * convert)
 {
   GstVideoTransferFunction func;
-  guint16 *t;
-  gint i;
+  gconstpointer old_table;
 
   func = convert->in_info.colorimetry.transfer;
 
+  /* called for each thread, they all use the same shared table */
+  old_table = convert->gamma_dec.gamma_table;
+
   convert->gamma_dec.width = convert->current_width;
   if (convert->current_bits == 8) {
     GST_DEBUG ("gamma decode 8->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u8_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 256);
-
-    for (i = 0; i < 256; i++)
-      t[i] = rint (gst_video_color_transfer_decode (func, i / 255.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        __gst_video_transfer_table_ref (func, FALSE, 8, 16);
   } else {
     GST_DEBUG ("gamma decode 16->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_decode (func, i / 65535.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        __gst_video_transfer_table_ref (func, FALSE, 16, 16);
   }
+  if (old_table)
+    __gst_video_transfer_table_unref (old_table);
+
   convert->current_bits = 16;
   convert->current_pstride = 8;
   convert->current_format = GST_VIDEO_FORMAT_ARGB64;
@@ -1542,31 +1351,26 @@ static void
 setup_gamma_encode (GstVideoConverter * convert, gint target_bits)
 {
   GstVideoTransferFunction func;
-  gint i;
+  gconstpointer old_table;
 
   func = convert->out_info.colorimetry.transfer;
 
+  old_table = convert->gamma_enc.gamma_table;
+
   convert->gamma_enc.width = convert->current_width;
   if (target_bits == 8) {
-    guint8 *t;
-
     GST_DEBUG ("gamma encode 16->8: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u8;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint8) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] = rint (gst_video_color_transfer_encode (func, i / 65535.0) * 255.0);
+    convert->gamma_enc.gamma_table =
+        __gst_video_transfer_table_ref (func, TRUE, 16, 8);
   } else {
-    guint16 *t;
-
     GST_DEBUG ("gamma encode 16->16: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_encode (func, i / 65535.0) * 65535.0);
+    convert->gamma_enc.gamma_table =
+        __gst_video_transfer_table_ref (func, TRUE, 16, 16);
   }
+  if (old_table)
+    __gst_video_transfer_table_unref (old_table);
 }
 
 static GstLineCache *
@@ -1844,15 +1648,31 @@ chain_convert (GstVideoConverter * convert, GstLineCache * prev, gint idx)
   return prev;
 }
 
+/* the unpacked lines are AYUV or ARGB, the alpha is in the first byte of
+ * each pixel. Build the 32 bit values for the orc functions in memory order
+ * so that they work on any endianness */
+static guint32
+make_alpha_word (guint8 b0, guint8 b1)
+{
+  union
+  {
+    guint8 b[4];
+    guint32 u;
+  } w;
+
+  w.b[0] = b0;
+  w.b[1] = w.b[2] = w.b[3] = b1;
+
+  return w.u;
+}
+
 static void
 convert_set_alpha_u8 (GstVideoConverter * convert, gpointer pixels, gint width)
 {
-  guint8 *p = pixels;
   guint8 alpha = MIN (convert->alpha_value, 255);
-  int i;
 
-  for (i = 0; i < width; i++)
-    p[i * 4] = alpha;
+  video_orc_set_alpha_u8 (pixels, make_alpha_word (0x00, 0xff),
+      make_alpha_word (alpha, 0x00), width);
 }
 
 static void
@@ -1872,14 +1692,11 @@ convert_set_alpha_u16 (GstVideoConverter * convert, gpointer pixels, gint width)
 static void
 convert_mult_alpha_u8 (GstVideoConverter * convert, gpointer pixels, gint width)
 {
-  guint8 *p = pixels;
-  guint alpha = convert->alpha_value;
-  int i;
+  guint8 alpha = MIN (convert->alpha_value, 255);
 
-  for (i = 0; i < width; i++) {
-    gint a = (p[i * 4] * alpha) / 255;
-    p[i * 4] = CLAMP (a, 0, 255);
-  }
+  /* multiply the alpha with the value and the other components with 255 so
+   * that they stay the same */
+  video_orc_mult_alpha_u8 (pixels, make_alpha_word (alpha, 0xff), width);
 }
 
 static void
@@ -2364,7 +2181,8 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   /* Magic number of 200 lines */
   if (MAX (convert->out_height, convert->in_height) / n_threads < 200)
     n_threads = (MAX (convert->out_height, convert->in_height) + 199) / 200;
-  convert->conversion_runner = gst_parallelized_task_runner_new (n_threads);
+  convert->conversion_runner = gst_parallelized_task_runner_new ("videoconvert",
+      n_threads);
 
   if (video_converter_lookup_fastpath (convert))
     goto done;
@@ -2458,21 +2276,11 @@ clear_matrix_data (MatrixData * data)
   g_free (data->t_b);
 }
 
-/**
- * gst_video_converter_free:
- * @convert: a #GstVideoConverter
- *
- * Free @convert
- *
- * Since: 1.6
- */
-void
-gst_video_converter_free (GstVideoConverter * convert)
+static void
+video_converter_destroy (GstVideoConverter * convert)
 {
   guint i, j;
 
-  g_return_if_fail (convert != NULL);
-
   for (i = 0; i < convert->conversion_runner->n_threads; i++) {
     if (convert->upsample_p && convert->upsample_p[i])
       gst_video_chroma_resample_free (convert->upsample_p[i]);
@@ -2531,8 +2339,10 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_free (convert->dither_lines);
   g_free (convert->dither);
 
-  g_free (convert->gamma_dec.gamma_table);
-  g_free (convert->gamma_enc.gamma_table);
+  if (convert->gamma_dec.gamma_table)
+    __gst_video_transfer_table_unref (convert->gamma_dec.gamma_table);
+  if (convert->gamma_enc.gamma_table)
+    __gst_video_transfer_table_unref (convert->gamma_enc.gamma_table);
 
   if (convert->tmpline) {
     for (i = 0; i < convert->conversion_runner->n_threads; i++)
@@ -2544,6 +2354,8 @@ gst_video_converter_free (GstVideoConverter * convert)
 
   if (convert->config)
     gst_structure_free (convert->config);
+  if (convert->cache_config)
+    gst_structure_free (convert->cache_config);
 
   for (i = 0; i < 4; i++) {
     for (j = 0; j < convert->conversion_runner->n_threads; j++) {
@@ -2566,6 +2378,246 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_slice_free (GstVideoConverter, convert);
 }
 
+#define DEFAULT_CONVERTER_CACHE_SIZE (32 * 1024 * 1024)
+
+G_LOCK_DEFINE_STATIC (converter_cache);
+static GQueue converter_cache = G_QUEUE_INIT;   /* most recently freed first */
+static gsize converter_cache_size;
+static gsize converter_cache_max_size = DEFAULT_CONVERTER_CACHE_SIZE;
+static guint64 converter_cache_hits;
+static guint64 converter_cache_misses;
+static guint64 converter_cache_evictions;
+
+/* rough estimate of the memory kept alive by @convert, the temporary lines
+ * and lookup tables make up most of it */
+static gsize
+video_converter_estimate_size (GstVideoConverter * convert)
+{
+  gsize size, line, n_threads;
+
+  n_threads = convert->conversion_runner->n_threads;
+  line = sizeof (guint16) * 4 *
+      (MAX (convert->in_maxwidth, convert->out_maxwidth) + convert->out_x + 8);
+
+  size = sizeof (GstVideoConverter);
+  if (convert->tmpline)
+    size += n_threads * line;
+  if (convert->convert == video_converter_generic)
+    size += n_threads * line * (4 + BACKLOG) * 2;
+  if (convert->borderline)
+    size += line;
+  if (convert->to_RGB_matrix.t_r)
+    size += 3 * 256 * sizeof (gint64);
+  if (convert->convert_matrix.t_r)
+    size += 3 * 256 * sizeof (gint64);
+  if (convert->to_YUV_matrix.t_r)
+    size += 3 * 256 * sizeof (gint64);
+
+  return size;
+}
+
+/* must be called with the converter_cache lock, returns the evicted
+ * converters that need to be destroyed after releasing the lock */
+static GList *
+converter_cache_evict (gsize max_size)
+{
+  GList *evicted = NULL;
+
+  while (converter_cache_size > max_size && converter_cache.tail) {
+    GstVideoConverter *convert = converter_cache.tail->data;
+
+    g_queue_unlink (&converter_cache, &convert->cache_link);
+    converter_cache_size -= convert->cache_size;
+    converter_cache_evictions++;
+    evicted = g_list_prepend (evicted, convert);
+  }
+  return evicted;
+}
+
+static gboolean
+converter_cache_put (GstVideoConverter * convert)
+{
+  GList *evicted;
+
+  /* the config was changed after creation, the converter does not match
+   * its key anymore */
+  if (!gst_structure_is_equal (convert->config, convert->cache_config))
+    return FALSE;
+
+  G_LOCK (converter_cache);
+  if (convert->cache_size > converter_cache_max_size) {
+    G_UNLOCK (converter_cache);
+    return FALSE;
+  }
+  evicted = converter_cache_evict (converter_cache_max_size -
+      convert->cache_size);
+  g_queue_push_head_link (&converter_cache, &convert->cache_link);
+  converter_cache_size += convert->cache_size;
+  G_UNLOCK (converter_cache);
+
+  /* this waits for the threads of the converters to finish so don't do it
+   * with the lock */
+  g_list_free_full (evicted, (GDestroyNotify) video_converter_destroy);
+
+  return TRUE;
+}
+
+static gboolean
+copy_field (GQuark field_id, const GValue * value, gpointer user_data)
+{
+  gst_structure_id_set_value (user_data, field_id, value);
+
+  return TRUE;
+}
+
+/**
+ * gst_video_converter_new_cached: (skip)
+ * @in_info: a #GstVideoInfo
+ * @out_info: a #GstVideoInfo
+ * @config: (transfer full): a #GstStructure with configuration options
+ *
+ * Create a converter like gst_video_converter_new() but reuse a previously
+ * freed converter for the same @in_info, @out_info and @config when there
+ * is one, which avoids setting up the tables, scalers and threads again.
+ *
+ * When the returned converter is freed with gst_video_converter_free() it
+ * is kept in a cache that is shared by the whole process, see
+ * gst_video_converter_set_cache_size().
+ *
+ * Returns: a #GstVideoConverter or %NULL if conversion is not possible.
+ *
+ * Since: 1.16
+ */
+GstVideoConverter *
+gst_video_converter_new_cached (GstVideoInfo * in_info,
+    GstVideoInfo * out_info, GstStructure * config)
+{
+  GstVideoConverter *convert;
+  GstStructure *key;
+  GList *l;
+
+  g_return_val_if_fail (in_info != NULL, NULL);
+  g_return_val_if_fail (out_info != NULL, NULL);
+
+  /* same as the config of a new converter */
+  key = gst_structure_new_empty ("GstVideoConverter");
+  if (config) {
+    gst_structure_foreach (config, copy_field, key);
+    gst_structure_free (config);
+  }
+
+  G_LOCK (converter_cache);
+  for (l = converter_cache.head; l; l = l->next) {
+    convert = l->data;
+
+    if (gst_video_info_is_equal (&convert->cache_in_info, in_info) &&
+        gst_video_info_is_equal (&convert->cache_out_info, out_info) &&
+        gst_structure_is_equal (convert->cache_config, key)) {
+      g_queue_unlink (&converter_cache, &convert->cache_link);
+      converter_cache_size -= convert->cache_size;
+      converter_cache_hits++;
+      G_UNLOCK (converter_cache);
+
+      GST_DEBUG ("reusing cached converter %p", convert);
+      gst_structure_free (key);
+      return convert;
+    }
+  }
+  converter_cache_misses++;
+  G_UNLOCK (converter_cache);
+
+  convert = gst_video_converter_new (in_info, out_info,
+      gst_structure_copy (key));
+  if (convert == NULL) {
+    gst_structure_free (key);
+    return NULL;
+  }
+
+  convert->cached = TRUE;
+  convert->cache_in_info = *in_info;
+  convert->cache_out_info = *out_info;
+  convert->cache_config = key;
+  convert->cache_size = video_converter_estimate_size (convert);
+  convert->cache_link.data = convert;
+
+  return convert;
+}
+
+/**
+ * gst_video_converter_free:
+ * @convert: a #GstVideoConverter
+ *
+ * Free @convert. Converters created with gst_video_converter_new_cached()
+ * are kept for reuse when they fit in the cache.
+ *
+ * Since: 1.6
+ */
+void
+gst_video_converter_free (GstVideoConverter * convert)
+{
+  g_return_if_fail (convert != NULL);
+
+  if (convert->cached && converter_cache_put (convert))
+    return;
+
+  video_converter_destroy (convert);
+}
+
+/**
+ * gst_video_converter_set_cache_size:
+ * @max_size: maximum size of the cache in bytes, 0 disables the cache
+ *
+ * Set the maximum amount of memory used by the converters that are kept
+ * for reuse by gst_video_converter_new_cached(). The size of a converter is
+ * estimated from its temporary lines and tables, the least recently freed
+ * converters are destroyed first. The default is 32 MiB.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_converter_set_cache_size (gsize max_size)
+{
+  GList *evicted;
+
+  G_LOCK (converter_cache);
+  converter_cache_max_size = max_size;
+  evicted = converter_cache_evict (max_size);
+  G_UNLOCK (converter_cache);
+
+  g_list_free_full (evicted, (GDestroyNotify) video_converter_destroy);
+}
+
+/**
+ * gst_video_converter_get_cache_stats:
+ *
+ * Returns statistics about the cache used by
+ * gst_video_converter_new_cached(). The structure contains the number of
+ * cached converters in "entries", their estimated size in "size" and the
+ * maximum size in "max-size" (#guint64, bytes) and the "hits", "misses" and
+ * "evictions" (#guint64) since the start of the process.
+ *
+ * Returns: (transfer full): a new #GstStructure with the statistics
+ *
+ * Since: 1.16
+ */
+GstStructure *
+gst_video_converter_get_cache_stats (void)
+{
+  GstStructure *s;
+
+  G_LOCK (converter_cache);
+  s = gst_structure_new ("GstVideoConverterCacheStats",
+      "entries", G_TYPE_UINT, converter_cache.length,
+      "size", G_TYPE_UINT64, (guint64) converter_cache_size,
+      "max-size", G_TYPE_UINT64, (guint64) converter_cache_max_size,
+      "hits", G_TYPE_UINT64, converter_cache_hits,
+      "misses", G_TYPE_UINT64, converter_cache_misses,
+      "evictions", G_TYPE_UINT64, converter_cache_evictions, NULL);
+  G_UNLOCK (converter_cache);
+
+  return s;
+}
+
 static gboolean
 copy_config (GQuark field_id, const GValue * value, gpointer user_data)
 {
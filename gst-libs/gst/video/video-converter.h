@@ -280,6 +280,11 @@ GstVideoConverter *  gst_video_converter_new            (GstVideoInfo *in_info,
                                                          GstVideoInfo *out_info,
                                                          GstStructure *config);
 
+GST_VIDEO_API
+GstVideoConverter *  gst_video_converter_new_cached     (GstVideoInfo *in_info,
+                                                         GstVideoInfo *out_info,
+                                                         GstStructure *config);
+
 GST_VIDEO_API
 void                 gst_video_converter_free           (GstVideoConverter * convert);
 
@@ -293,6 +298,12 @@ GST_VIDEO_API
 void                 gst_video_converter_frame          (GstVideoConverter * convert,
                                                          const GstVideoFrame *src, GstVideoFrame *dest);
 
+GST_VIDEO_API
+void                 gst_video_converter_set_cache_size (gsize max_size);
+
+GST_VIDEO_API
+GstStructure *       gst_video_converter_get_cache_stats (void);
+
 
 G_END_DECLS
 
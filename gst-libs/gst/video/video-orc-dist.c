@@ -444,6 +444,8 @@ void video_orc_resample_v_muladdscaletaps4_u8_lq (guint8 * ORC_RESTRICT d1,
     const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n);
 void video_orc_chroma_down_h2_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, int n);
+void video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
 void video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n);
 void video_orc_chroma_up_v2_u8 (guint8 * ORC_RESTRICT d1,
@@ -14691,6 +14693,327 @@ video_orc_splat2_u64 (guint8 * ORC_RESTRICT d1, int p1, int n)
 #endif
 
 
+/* video_orc_set_alpha_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_set_alpha_u8 (guint8 * ORC_RESTRICT d1, int p1, int p2, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+
+  ptr0 = (orc_union32 *) d1;
+
+  /* 1: loadpl */
+  var34.i = p1;
+  /* 3: loadpl */
+  var36.i = p2;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr0[i];
+    /* 2: andl */
+    var35.i = var33.i & var34.i;
+    /* 4: orl */
+    var37.i = var35.i | var36.i;
+    /* 5: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_set_alpha_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+
+  /* 1: loadpl */
+  var34.i = ex->params[24];
+  /* 3: loadpl */
+  var36.i = ex->params[25];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr0[i];
+    /* 2: andl */
+    var35.i = var33.i & var34.i;
+    /* 4: orl */
+    var37.i = var35.i | var36.i;
+    /* 5: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+void
+video_orc_set_alpha_u8 (guint8 * ORC_RESTRICT d1, int p1, int p2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 22, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 115, 101, 116,
+        95, 97, 108, 112, 104, 97, 95, 117, 56, 11, 4, 4, 16, 4, 16, 4,
+        20, 4, 113, 32, 0, 106, 32, 32, 24, 123, 32, 32, 25, 128, 0, 32,
+        2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_set_alpha_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_set_alpha_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_set_alpha_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_parameter (p, 4, "p2");
+      orc_program_add_temporary (p, 4, "t1");
+
+      orc_program_append_2 (p, "loadl", 0, ORC_VAR_T1, ORC_VAR_D1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "andl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "orl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "storel", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_mult_alpha_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_mult_alpha_u8 (guint8 * ORC_RESTRICT d1, int p1, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+  orc_union32 var40;
+
+  ptr0 = (orc_union32 *) d1;
+
+  /* 2: loadpl */
+  var36.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr0[i];
+    /* 1: convubw */
+    var35.x4[0] = (orc_uint8) var34.x4[0];
+    var35.x4[1] = (orc_uint8) var34.x4[1];
+    var35.x4[2] = (orc_uint8) var34.x4[2];
+    var35.x4[3] = (orc_uint8) var34.x4[3];
+    /* 3: convubw */
+    var37.x4[0] = (orc_uint8) var36.x4[0];
+    var37.x4[1] = (orc_uint8) var36.x4[1];
+    var37.x4[2] = (orc_uint8) var36.x4[2];
+    var37.x4[3] = (orc_uint8) var36.x4[3];
+    /* 4: mullw */
+    var38.x4[0] = (var35.x4[0] * var37.x4[0]) & 0xffff;
+    var38.x4[1] = (var35.x4[1] * var37.x4[1]) & 0xffff;
+    var38.x4[2] = (var35.x4[2] * var37.x4[2]) & 0xffff;
+    var38.x4[3] = (var35.x4[3] * var37.x4[3]) & 0xffff;
+    /* 5: div255w */
+    var39.x4[0] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[0] + 128)) +
+            (((orc_uint16) (var38.x4[0] + 128)) >> 8))) >> 8;
+    var39.x4[1] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[1] + 128)) +
+            (((orc_uint16) (var38.x4[1] + 128)) >> 8))) >> 8;
+    var39.x4[2] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[2] + 128)) +
+            (((orc_uint16) (var38.x4[2] + 128)) >> 8))) >> 8;
+    var39.x4[3] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[3] + 128)) +
+            (((orc_uint16) (var38.x4[3] + 128)) >> 8))) >> 8;
+    /* 6: convwb */
+    var40.x4[0] = var39.x4[0];
+    var40.x4[1] = var39.x4[1];
+    var40.x4[2] = var39.x4[2];
+    var40.x4[3] = var39.x4[3];
+    /* 7: storel */
+    ptr0[i] = var40;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_mult_alpha_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+  orc_union32 var40;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+
+  /* 2: loadpl */
+  var36.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr0[i];
+    /* 1: convubw */
+    var35.x4[0] = (orc_uint8) var34.x4[0];
+    var35.x4[1] = (orc_uint8) var34.x4[1];
+    var35.x4[2] = (orc_uint8) var34.x4[2];
+    var35.x4[3] = (orc_uint8) var34.x4[3];
+    /* 3: convubw */
+    var37.x4[0] = (orc_uint8) var36.x4[0];
+    var37.x4[1] = (orc_uint8) var36.x4[1];
+    var37.x4[2] = (orc_uint8) var36.x4[2];
+    var37.x4[3] = (orc_uint8) var36.x4[3];
+    /* 4: mullw */
+    var38.x4[0] = (var35.x4[0] * var37.x4[0]) & 0xffff;
+    var38.x4[1] = (var35.x4[1] * var37.x4[1]) & 0xffff;
+    var38.x4[2] = (var35.x4[2] * var37.x4[2]) & 0xffff;
+    var38.x4[3] = (var35.x4[3] * var37.x4[3]) & 0xffff;
+    /* 5: div255w */
+    var39.x4[0] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[0] + 128)) +
+            (((orc_uint16) (var38.x4[0] + 128)) >> 8))) >> 8;
+    var39.x4[1] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[1] + 128)) +
+            (((orc_uint16) (var38.x4[1] + 128)) >> 8))) >> 8;
+    var39.x4[2] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[2] + 128)) +
+            (((orc_uint16) (var38.x4[2] + 128)) >> 8))) >> 8;
+    var39.x4[3] =
+        ((orc_uint16) (((orc_uint16) (var38.x4[3] + 128)) +
+            (((orc_uint16) (var38.x4[3] + 128)) >> 8))) >> 8;
+    /* 6: convwb */
+    var40.x4[0] = var39.x4[0];
+    var40.x4[1] = var39.x4[1];
+    var40.x4[2] = var39.x4[2];
+    var40.x4[3] = var39.x4[3];
+    /* 7: storel */
+    ptr0[i] = var40;
+  }
+
+}
+
+void
+video_orc_mult_alpha_u8 (guint8 * ORC_RESTRICT d1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 23, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 109, 117, 108,
+        116, 95, 97, 108, 112, 104, 97, 95, 117, 56, 11, 4, 4, 16, 4, 20,
+        4, 20, 8, 20, 8, 113, 32, 0, 21, 2, 150, 33, 32, 21, 2, 150,
+        34, 24, 21, 2, 89, 33, 33, 34, 21, 2, 80, 33, 33, 21, 2, 157,
+        32, 33, 128, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_mult_alpha_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_mult_alpha_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_mult_alpha_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 8, "t2");
+      orc_program_add_temporary (p, 8, "t3");
+
+      orc_program_append_2 (p, "loadl", 0, ORC_VAR_T1, ORC_VAR_D1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 2, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 2, ORC_VAR_T3, ORC_VAR_P1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 2, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "div255w", 2, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convwb", 2, ORC_VAR_T1, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "storel", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
 /* video_orc_convert_I420_UYVY */
 #ifdef DISABLE_ORC
 void
@@ -29771,121 +30094,263 @@ video_orc_chroma_down_h2_u8 (guint8 * ORC_RESTRICT d1,
 #endif
 
 
-/* video_orc_chroma_down_v2_u8 */
+/* video_orc_chroma_down_h2_cs_u8 */
 #ifdef DISABLE_ORC
 void
-video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
+video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
 {
   int i;
-  orc_union32 *ORC_RESTRICT ptr0;
-  const orc_union32 *ORC_RESTRICT ptr4;
-  const orc_union32 *ORC_RESTRICT ptr5;
-  orc_union32 var35;
-  orc_union32 var36;
-  orc_union32 var37;
-  orc_union16 var38;
-  orc_union16 var39;
-  orc_union16 var40;
-  orc_union16 var41;
-
-  ptr0 = (orc_union32 *) d1;
-  ptr4 = (orc_union32 *) s1;
-  ptr5 = (orc_union32 *) s2;
-
-
-  for (i = 0; i < n; i++) {
-    /* 0: loadl */
-    var35 = ptr4[i];
-    /* 1: splitlw */
-    {
-      orc_union32 _src;
-      _src.i = var35.i;
-      var38.i = _src.x2[1];
-      var39.i = _src.x2[0];
-    }
-    /* 2: loadl */
-    var36 = ptr5[i];
-    /* 3: select1lw */
-    {
-      orc_union32 _src;
-      _src.i = var36.i;
-      var40.i = _src.x2[1];
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union32 var62;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+
+  /* 13: loadpw */
+  var44.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var44.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var42 = ptr4[i];
+    /* 1: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[0];
     }
-    /* 4: avgub */
-    var41.x2[0] = ((orc_uint8) var38.x2[0] + (orc_uint8) var40.x2[0] + 1) >> 1;
-    var41.x2[1] = ((orc_uint8) var38.x2[1] + (orc_uint8) var40.x2[1] + 1) >> 1;
-    /* 5: mergewl */
+    /* 2: loadq */
+    var43 = ptr5[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var46.i;
+      var49.i = _src.x2[1];
+    }
+    /* 5: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+      var51.i = _src.x2[0];
+    }
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var52.i = _src.x2[1];
+    }
+    /* 7: convubw */
+    var53.x2[0] = (orc_uint8) var49.x2[0];
+    var53.x2[1] = (orc_uint8) var49.x2[1];
+    /* 8: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 9: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: shlw */
+    var56.x2[0] = ((orc_uint16) var54.x2[0]) << 1;
+    var56.x2[1] = ((orc_uint16) var54.x2[1]) << 1;
+    /* 11: addw */
+    var57.x2[0] = var53.x2[0] + var56.x2[0];
+    var57.x2[1] = var53.x2[1] + var56.x2[1];
+    /* 12: addw */
+    var58.x2[0] = var57.x2[0] + var55.x2[0];
+    var58.x2[1] = var57.x2[1] + var55.x2[1];
+    /* 14: addw */
+    var59.x2[0] = var58.x2[0] + var44.x2[0];
+    var59.x2[1] = var58.x2[1] + var44.x2[1];
+    /* 15: shruw */
+    var60.x2[0] = ((orc_uint16) var59.x2[0]) >> 2;
+    var60.x2[1] = ((orc_uint16) var59.x2[1]) >> 2;
+    /* 16: convsuswb */
+    var61.x2[0] = ORC_CLAMP_UB (var60.x2[0]);
+    var61.x2[1] = ORC_CLAMP_UB (var60.x2[1]);
+    /* 17: mergewl */
     {
       orc_union32 _dest;
-      _dest.x2[0] = var39.i;
-      _dest.x2[1] = var41.i;
-      var37.i = _dest.i;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var61.i;
+      var62.i = _dest.i;
     }
-    /* 6: storel */
-    ptr0[i] = var37;
+    /* 18: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var47.i;
+      var45.i = _dest.i;
+    }
+    /* 19: storeq */
+    ptr0[i] = var45;
   }
 
 }
 
 #else
 static void
-_backup_video_orc_chroma_down_v2_u8 (OrcExecutor * ORC_RESTRICT ex)
+_backup_video_orc_chroma_down_h2_cs_u8 (OrcExecutor * ORC_RESTRICT ex)
 {
   int i;
   int n = ex->n;
-  orc_union32 *ORC_RESTRICT ptr0;
-  const orc_union32 *ORC_RESTRICT ptr4;
-  const orc_union32 *ORC_RESTRICT ptr5;
-  orc_union32 var35;
-  orc_union32 var36;
-  orc_union32 var37;
-  orc_union16 var38;
-  orc_union16 var39;
-  orc_union16 var40;
-  orc_union16 var41;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var42;
+  orc_union64 var43;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union16 var51;
+  orc_union16 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union16 var61;
+  orc_union32 var62;
 
-  ptr0 = (orc_union32 *) ex->arrays[0];
-  ptr4 = (orc_union32 *) ex->arrays[4];
-  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
 
+  /* 13: loadpw */
+  var44.x2[0] = 0x00000002;     /* 2 or 9.88131e-324f */
+  var44.x2[1] = 0x00000002;     /* 2 or 9.88131e-324f */
 
   for (i = 0; i < n; i++) {
-    /* 0: loadl */
-    var35 = ptr4[i];
-    /* 1: splitlw */
+    /* 0: loadq */
+    var42 = ptr4[i];
+    /* 1: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var42.i;
+      var46.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var43 = ptr5[i];
+    /* 3: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var43.i;
+      var47.i = _src.x2[1];
+      var48.i = _src.x2[0];
+    }
+    /* 4: select1lw */
     {
       orc_union32 _src;
-      _src.i = var35.i;
-      var38.i = _src.x2[1];
-      var39.i = _src.x2[0];
+      _src.i = var46.i;
+      var49.i = _src.x2[1];
     }
-    /* 2: loadl */
-    var36 = ptr5[i];
-    /* 3: select1lw */
+    /* 5: splitlw */
     {
       orc_union32 _src;
-      _src.i = var36.i;
-      var40.i = _src.x2[1];
+      _src.i = var48.i;
+      var50.i = _src.x2[1];
+      var51.i = _src.x2[0];
     }
-    /* 4: avgub */
-    var41.x2[0] = ((orc_uint8) var38.x2[0] + (orc_uint8) var40.x2[0] + 1) >> 1;
-    var41.x2[1] = ((orc_uint8) var38.x2[1] + (orc_uint8) var40.x2[1] + 1) >> 1;
-    /* 5: mergewl */
+    /* 6: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var52.i = _src.x2[1];
+    }
+    /* 7: convubw */
+    var53.x2[0] = (orc_uint8) var49.x2[0];
+    var53.x2[1] = (orc_uint8) var49.x2[1];
+    /* 8: convubw */
+    var54.x2[0] = (orc_uint8) var50.x2[0];
+    var54.x2[1] = (orc_uint8) var50.x2[1];
+    /* 9: convubw */
+    var55.x2[0] = (orc_uint8) var52.x2[0];
+    var55.x2[1] = (orc_uint8) var52.x2[1];
+    /* 10: shlw */
+    var56.x2[0] = ((orc_uint16) var54.x2[0]) << 1;
+    var56.x2[1] = ((orc_uint16) var54.x2[1]) << 1;
+    /* 11: addw */
+    var57.x2[0] = var53.x2[0] + var56.x2[0];
+    var57.x2[1] = var53.x2[1] + var56.x2[1];
+    /* 12: addw */
+    var58.x2[0] = var57.x2[0] + var55.x2[0];
+    var58.x2[1] = var57.x2[1] + var55.x2[1];
+    /* 14: addw */
+    var59.x2[0] = var58.x2[0] + var44.x2[0];
+    var59.x2[1] = var58.x2[1] + var44.x2[1];
+    /* 15: shruw */
+    var60.x2[0] = ((orc_uint16) var59.x2[0]) >> 2;
+    var60.x2[1] = ((orc_uint16) var59.x2[1]) >> 2;
+    /* 16: convsuswb */
+    var61.x2[0] = ORC_CLAMP_UB (var60.x2[0]);
+    var61.x2[1] = ORC_CLAMP_UB (var60.x2[1]);
+    /* 17: mergewl */
     {
       orc_union32 _dest;
-      _dest.x2[0] = var39.i;
-      _dest.x2[1] = var41.i;
-      var37.i = _dest.i;
+      _dest.x2[0] = var51.i;
+      _dest.x2[1] = var61.i;
+      var62.i = _dest.i;
     }
-    /* 6: storel */
-    ptr0[i] = var37;
+    /* 18: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var62.i;
+      _dest.x2[1] = var47.i;
+      var45.i = _dest.i;
+    }
+    /* 19: storeq */
+    ptr0[i] = var45;
   }
 
 }
 
 void
-video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
+video_orc_chroma_down_h2_cs_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
 {
   OrcExecutor _ex, *ex = &_ex;
@@ -29900,32 +30365,72 @@ video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
 
 #if 1
       static const orc_uint8 bc[] = {
-        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
-        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 50, 95, 117, 56, 11, 4,
-        4, 12, 4, 4, 12, 4, 4, 20, 2, 20, 2, 20, 2, 198, 33, 32,
-        4, 191, 34, 5, 21, 1, 39, 33, 33, 34, 195, 0, 32, 33, 2, 0,
-
+        1, 9, 30, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 104, 50, 95, 99, 115, 95, 117,
+        56, 11, 8, 8, 12, 8, 8, 12, 8, 8, 14, 2, 1, 0, 0, 0,
+        14, 2, 2, 0, 0, 0, 20, 4, 20, 4, 20, 4, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 192, 32, 4, 197, 34, 33,
+        5, 191, 36, 32, 198, 37, 35, 33, 191, 38, 34, 21, 1, 150, 39, 36,
+        21, 1, 150, 40, 37, 21, 1, 150, 41, 38, 21, 1, 93, 40, 40, 16,
+        21, 1, 70, 39, 39, 40, 21, 1, 70, 39, 39, 41, 21, 1, 70, 39,
+        39, 17, 21, 1, 95, 39, 39, 17, 21, 1, 160, 37, 39, 195, 33, 35,
+        37, 194, 0, 33, 34, 2, 0,
       };
       p = orc_program_new_from_static_bytecode (bc);
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u8);
+      orc_program_set_backup_function (p,
+          _backup_video_orc_chroma_down_h2_cs_u8);
 #else
       p = orc_program_new ();
-      orc_program_set_name (p, "video_orc_chroma_down_v2_u8");
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u8);
-      orc_program_add_destination (p, 4, "d1");
-      orc_program_add_source (p, 4, "s1");
-      orc_program_add_source (p, 4, "s2");
-      orc_program_add_temporary (p, 2, "t1");
-      orc_program_add_temporary (p, 2, "t2");
-      orc_program_add_temporary (p, 2, "t3");
+      orc_program_set_name (p, "video_orc_chroma_down_h2_cs_u8");
+      orc_program_set_backup_function (p,
+          _backup_video_orc_chroma_down_h2_cs_u8);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_constant (p, 2, 0x00000002, "c2");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 2, "t5");
+      orc_program_add_temporary (p, 2, "t6");
+      orc_program_add_temporary (p, 2, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+      orc_program_add_temporary (p, 4, "t9");
+      orc_program_add_temporary (p, 4, "t10");
 
-      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+      orc_program_append_2 (p, "select0ql", 0, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_S2,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T3, ORC_VAR_S2,
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T5, ORC_VAR_T1,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "avgub", 1, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_T2,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T7, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T8, ORC_VAR_T5, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T9, ORC_VAR_T6, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T10, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 1, ORC_VAR_T9, ORC_VAR_T9, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T9,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_T10,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T8, ORC_VAR_T8, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T6, ORC_VAR_T8,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_T2, ORC_VAR_T4, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T2, ORC_VAR_T3,
           ORC_VAR_D1);
 #endif
 
@@ -29950,40 +30455,219 @@ video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
 #endif
 
 
-/* video_orc_chroma_up_v2_u8 */
+/* video_orc_chroma_down_v2_u8 */
 #ifdef DISABLE_ORC
 void
-video_orc_chroma_up_v2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
 {
   int i;
   orc_union32 *ORC_RESTRICT ptr0;
-  orc_union32 *ORC_RESTRICT ptr1;
   const orc_union32 *ORC_RESTRICT ptr4;
   const orc_union32 *ORC_RESTRICT ptr5;
-  orc_union32 var39;
-  orc_union32 var40;
-#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union32 var41;
-#else
-  orc_union32 var41;
-#endif
-#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union32 var42;
-#else
-  orc_union32 var42;
-#endif
-  orc_union32 var43;
-  orc_union32 var44;
-  orc_union16 var45;
-  orc_union16 var46;
-  orc_union16 var47;
-  orc_union16 var48;
-  orc_union32 var49;
-  orc_union32 var50;
-  orc_union32 var51;
-  orc_union32 var52;
-  orc_union32 var53;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var35 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var35.i;
+      var38.i = _src.x2[1];
+      var39.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var36 = ptr5[i];
+    /* 3: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var36.i;
+      var40.i = _src.x2[1];
+    }
+    /* 4: avgub */
+    var41.x2[0] = ((orc_uint8) var38.x2[0] + (orc_uint8) var40.x2[0] + 1) >> 1;
+    var41.x2[1] = ((orc_uint8) var38.x2[1] + (orc_uint8) var40.x2[1] + 1) >> 1;
+    /* 5: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var39.i;
+      _dest.x2[1] = var41.i;
+      var37.i = _dest.i;
+    }
+    /* 6: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_down_v2_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union16 var41;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var35 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var35.i;
+      var38.i = _src.x2[1];
+      var39.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var36 = ptr5[i];
+    /* 3: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var36.i;
+      var40.i = _src.x2[1];
+    }
+    /* 4: avgub */
+    var41.x2[0] = ((orc_uint8) var38.x2[0] + (orc_uint8) var40.x2[0] + 1) >> 1;
+    var41.x2[1] = ((orc_uint8) var38.x2[1] + (orc_uint8) var40.x2[1] + 1) >> 1;
+    /* 5: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var39.i;
+      _dest.x2[1] = var41.i;
+      var37.i = _dest.i;
+    }
+    /* 6: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+void
+video_orc_chroma_down_v2_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 50, 95, 117, 56, 11, 4,
+        4, 12, 4, 4, 12, 4, 4, 20, 2, 20, 2, 20, 2, 198, 33, 32,
+        4, 191, 34, 5, 21, 1, 39, 33, 33, 34, 195, 0, 32, 33, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_down_v2_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T3, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "avgub", 1, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_v2_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_v2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var39;
+  orc_union32 var40;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var41;
+#else
+  orc_union32 var41;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var42;
+#else
+  orc_union32 var42;
+#endif
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union32 var52;
+  orc_union32 var53;
   orc_union32 var54;
   orc_union16 var55;
   orc_union32 var56;
@@ -30688,126 +31372,2096 @@ video_orc_chroma_up_v2_u16 (guint16 * ORC_RESTRICT d1,
 #endif
 
 
-/* video_orc_chroma_down_v2_u16 */
+/* video_orc_chroma_down_v2_u16 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var35;
+  orc_union64 var36;
+  orc_union64 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var35 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var35.i;
+      var38.i = _src.x2[1];
+      var39.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var36 = ptr5[i];
+    /* 3: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var36.i;
+      var40.i = _src.x2[1];
+    }
+    /* 4: avguw */
+    var41.x2[0] =
+        ((orc_uint16) var38.x2[0] + (orc_uint16) var40.x2[0] + 1) >> 1;
+    var41.x2[1] =
+        ((orc_uint16) var38.x2[1] + (orc_uint16) var40.x2[1] + 1) >> 1;
+    /* 5: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var39.i;
+      _dest.x2[1] = var41.i;
+      var37.i = _dest.i;
+    }
+    /* 6: storeq */
+    ptr0[i] = var37;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_down_v2_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  orc_union64 var35;
+  orc_union64 var36;
+  orc_union64 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var35 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var35.i;
+      var38.i = _src.x2[1];
+      var39.i = _src.x2[0];
+    }
+    /* 2: loadq */
+    var36 = ptr5[i];
+    /* 3: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var36.i;
+      var40.i = _src.x2[1];
+    }
+    /* 4: avguw */
+    var41.x2[0] =
+        ((orc_uint16) var38.x2[0] + (orc_uint16) var40.x2[0] + 1) >> 1;
+    var41.x2[1] =
+        ((orc_uint16) var38.x2[1] + (orc_uint16) var40.x2[1] + 1) >> 1;
+    /* 5: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var39.i;
+      _dest.x2[1] = var41.i;
+      var37.i = _dest.i;
+    }
+    /* 6: storeq */
+    ptr0[i] = var37;
+  }
+
+}
+
+void
+video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 28, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 50, 95, 117, 49, 54, 11,
+        8, 8, 12, 8, 8, 12, 8, 8, 20, 4, 20, 4, 20, 4, 197, 33,
+        32, 4, 193, 34, 5, 21, 1, 76, 33, 33, 34, 194, 0, 32, 33, 2,
+        0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_down_v2_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u16);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T3, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "avguw", 1, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_down_v4_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var41;
+#else
+  orc_union32 var41;
+#endif
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union32 var50;
+  orc_union16 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union16 var59;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+  ptr6 = (orc_union32 *) s3;
+  ptr7 = (orc_union32 *) s4;
+
+  /* 17: loadpw */
+  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var37 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var37.i;
+      var43.i = _src.x2[1];
+      var44.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var45.x2[0] = (orc_uint8) var43.x2[0];
+    var45.x2[1] = (orc_uint8) var43.x2[1];
+    /* 3: loadl */
+    var38 = ptr7[i];
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var38.i;
+      var46.i = _src.x2[1];
+    }
+    /* 5: convubw */
+    var47.x2[0] = (orc_uint8) var46.x2[0];
+    var47.x2[1] = (orc_uint8) var46.x2[1];
+    /* 6: addw */
+    var48.x2[0] = var45.x2[0] + var47.x2[0];
+    var48.x2[1] = var45.x2[1] + var47.x2[1];
+    /* 7: loadl */
+    var39 = ptr5[i];
+    /* 8: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var39.i;
+      var49.i = _src.x2[1];
+    }
+    /* 9: convubw */
+    var50.x2[0] = (orc_uint8) var49.x2[0];
+    var50.x2[1] = (orc_uint8) var49.x2[1];
+    /* 10: loadl */
+    var40 = ptr6[i];
+    /* 11: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var40.i;
+      var51.i = _src.x2[1];
+    }
+    /* 12: convubw */
+    var52.x2[0] = (orc_uint8) var51.x2[0];
+    var52.x2[1] = (orc_uint8) var51.x2[1];
+    /* 13: addw */
+    var53.x2[0] = var50.x2[0] + var52.x2[0];
+    var53.x2[1] = var50.x2[1] + var52.x2[1];
+    /* 14: shlw */
+    var54.x2[0] = ((orc_uint16) var53.x2[0]) << 1;
+    var54.x2[1] = ((orc_uint16) var53.x2[1]) << 1;
+    /* 15: addw */
+    var55.x2[0] = var53.x2[0] + var54.x2[0];
+    var55.x2[1] = var53.x2[1] + var54.x2[1];
+    /* 16: addw */
+    var56.x2[0] = var48.x2[0] + var55.x2[0];
+    var56.x2[1] = var48.x2[1] + var55.x2[1];
+    /* 18: addw */
+    var57.x2[0] = var56.x2[0] + var41.x2[0];
+    var57.x2[1] = var56.x2[1] + var41.x2[1];
+    /* 19: shruw */
+    var58.x2[0] = ((orc_uint16) var57.x2[0]) >> 3;
+    var58.x2[1] = ((orc_uint16) var57.x2[1]) >> 3;
+    /* 20: convsuswb */
+    var59.x2[0] = ORC_CLAMP_UB (var58.x2[0]);
+    var59.x2[1] = ORC_CLAMP_UB (var58.x2[1]);
+    /* 21: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var44.i;
+      _dest.x2[1] = var59.i;
+      var42.i = _dest.i;
+    }
+    /* 22: storel */
+    ptr0[i] = var42;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_down_v4_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var41;
+#else
+  orc_union32 var41;
+#endif
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union16 var49;
+  orc_union32 var50;
+  orc_union16 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union16 var59;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr6 = (orc_union32 *) ex->arrays[6];
+  ptr7 = (orc_union32 *) ex->arrays[7];
+
+  /* 17: loadpw */
+  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var37 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var37.i;
+      var43.i = _src.x2[1];
+      var44.i = _src.x2[0];
+    }
+    /* 2: convubw */
+    var45.x2[0] = (orc_uint8) var43.x2[0];
+    var45.x2[1] = (orc_uint8) var43.x2[1];
+    /* 3: loadl */
+    var38 = ptr7[i];
+    /* 4: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var38.i;
+      var46.i = _src.x2[1];
+    }
+    /* 5: convubw */
+    var47.x2[0] = (orc_uint8) var46.x2[0];
+    var47.x2[1] = (orc_uint8) var46.x2[1];
+    /* 6: addw */
+    var48.x2[0] = var45.x2[0] + var47.x2[0];
+    var48.x2[1] = var45.x2[1] + var47.x2[1];
+    /* 7: loadl */
+    var39 = ptr5[i];
+    /* 8: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var39.i;
+      var49.i = _src.x2[1];
+    }
+    /* 9: convubw */
+    var50.x2[0] = (orc_uint8) var49.x2[0];
+    var50.x2[1] = (orc_uint8) var49.x2[1];
+    /* 10: loadl */
+    var40 = ptr6[i];
+    /* 11: select1lw */
+    {
+      orc_union32 _src;
+      _src.i = var40.i;
+      var51.i = _src.x2[1];
+    }
+    /* 12: convubw */
+    var52.x2[0] = (orc_uint8) var51.x2[0];
+    var52.x2[1] = (orc_uint8) var51.x2[1];
+    /* 13: addw */
+    var53.x2[0] = var50.x2[0] + var52.x2[0];
+    var53.x2[1] = var50.x2[1] + var52.x2[1];
+    /* 14: shlw */
+    var54.x2[0] = ((orc_uint16) var53.x2[0]) << 1;
+    var54.x2[1] = ((orc_uint16) var53.x2[1]) << 1;
+    /* 15: addw */
+    var55.x2[0] = var53.x2[0] + var54.x2[0];
+    var55.x2[1] = var53.x2[1] + var54.x2[1];
+    /* 16: addw */
+    var56.x2[0] = var48.x2[0] + var55.x2[0];
+    var56.x2[1] = var48.x2[1] + var55.x2[1];
+    /* 18: addw */
+    var57.x2[0] = var56.x2[0] + var41.x2[0];
+    var57.x2[1] = var56.x2[1] + var41.x2[1];
+    /* 19: shruw */
+    var58.x2[0] = ((orc_uint16) var57.x2[0]) >> 3;
+    var58.x2[1] = ((orc_uint16) var57.x2[1]) >> 3;
+    /* 20: convsuswb */
+    var59.x2[0] = ORC_CLAMP_UB (var58.x2[0]);
+    var59.x2[1] = ORC_CLAMP_UB (var58.x2[1]);
+    /* 21: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var44.i;
+      _dest.x2[1] = var59.i;
+      var42.i = _dest.i;
+    }
+    /* 22: storel */
+    ptr0[i] = var42;
+  }
+
+}
+
+void
+video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 52, 95, 117, 56, 11, 4,
+        4, 12, 4, 4, 12, 4, 4, 12, 4, 4, 12, 4, 4, 14, 2, 1,
+        0, 0, 0, 14, 2, 4, 0, 0, 0, 14, 2, 3, 0, 0, 0, 20,
+        2, 20, 2, 20, 4, 20, 4, 20, 4, 198, 33, 32, 4, 21, 1, 150,
+        34, 33, 191, 33, 7, 21, 1, 150, 35, 33, 21, 1, 70, 36, 34, 35,
+        191, 33, 5, 21, 1, 150, 34, 33, 191, 33, 6, 21, 1, 150, 35, 33,
+        21, 1, 70, 34, 34, 35, 21, 1, 93, 35, 34, 16, 21, 1, 70, 34,
+        34, 35, 21, 1, 70, 36, 36, 34, 21, 1, 70, 36, 36, 17, 21, 1,
+        95, 36, 36, 18, 21, 1, 160, 33, 36, 195, 0, 32, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_down_v4_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_source (p, 4, "s3");
+      orc_program_add_source (p, 4, "s4");
+      orc_program_add_constant (p, 2, 0x00000001, "c1");
+      orc_program_add_constant (p, 2, 0x00000004, "c2");
+      orc_program_add_constant (p, 2, 0x00000003, "c3");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S4,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shlw", 1, ORC_VAR_T4, ORC_VAR_T3, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_down_v4_u16 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
+    const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+  orc_union64 var40;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var41;
+#else
+  orc_union64 var41;
+#endif
+  orc_union64 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union64 var47;
+  orc_union64 var48;
+  orc_union32 var49;
+  orc_union64 var50;
+  orc_union32 var51;
+  orc_union64 var52;
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union64 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union64 var58;
+  orc_union32 var59;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union64 *) s2;
+  ptr6 = (orc_union64 *) s3;
+  ptr7 = (orc_union64 *) s4;
+
+  /* 17: loadpl */
+  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var37 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var37.i;
+      var43.i = _src.x2[1];
+      var44.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var45.x2[0] = (orc_uint16) var43.x2[0];
+    var45.x2[1] = (orc_uint16) var43.x2[1];
+    /* 3: loadq */
+    var38 = ptr7[i];
+    /* 4: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var38.i;
+      var46.i = _src.x2[1];
+    }
+    /* 5: convuwl */
+    var47.x2[0] = (orc_uint16) var46.x2[0];
+    var47.x2[1] = (orc_uint16) var46.x2[1];
+    /* 6: addl */
+    var48.x2[0] = ((orc_uint32) var45.x2[0]) + ((orc_uint32) var47.x2[0]);
+    var48.x2[1] = ((orc_uint32) var45.x2[1]) + ((orc_uint32) var47.x2[1]);
+    /* 7: loadq */
+    var39 = ptr5[i];
+    /* 8: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var39.i;
+      var49.i = _src.x2[1];
+    }
+    /* 9: convuwl */
+    var50.x2[0] = (orc_uint16) var49.x2[0];
+    var50.x2[1] = (orc_uint16) var49.x2[1];
+    /* 10: loadq */
+    var40 = ptr6[i];
+    /* 11: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var40.i;
+      var51.i = _src.x2[1];
+    }
+    /* 12: convuwl */
+    var52.x2[0] = (orc_uint16) var51.x2[0];
+    var52.x2[1] = (orc_uint16) var51.x2[1];
+    /* 13: addl */
+    var53.x2[0] = ((orc_uint32) var50.x2[0]) + ((orc_uint32) var52.x2[0]);
+    var53.x2[1] = ((orc_uint32) var50.x2[1]) + ((orc_uint32) var52.x2[1]);
+    /* 14: shll */
+    var54.x2[0] = ((orc_uint32) var53.x2[0]) << 1;
+    var54.x2[1] = ((orc_uint32) var53.x2[1]) << 1;
+    /* 15: addl */
+    var55.x2[0] = ((orc_uint32) var53.x2[0]) + ((orc_uint32) var54.x2[0]);
+    var55.x2[1] = ((orc_uint32) var53.x2[1]) + ((orc_uint32) var54.x2[1]);
+    /* 16: addl */
+    var56.x2[0] = ((orc_uint32) var48.x2[0]) + ((orc_uint32) var55.x2[0]);
+    var56.x2[1] = ((orc_uint32) var48.x2[1]) + ((orc_uint32) var55.x2[1]);
+    /* 18: addl */
+    var57.x2[0] = ((orc_uint32) var56.x2[0]) + ((orc_uint32) var41.x2[0]);
+    var57.x2[1] = ((orc_uint32) var56.x2[1]) + ((orc_uint32) var41.x2[1]);
+    /* 19: shrul */
+    var58.x2[0] = ((orc_uint32) var57.x2[0]) >> 3;
+    var58.x2[1] = ((orc_uint32) var57.x2[1]) >> 3;
+    /* 20: convsuslw */
+    var59.x2[0] = ORC_CLAMP_UW (var58.x2[0]);
+    var59.x2[1] = ORC_CLAMP_UW (var58.x2[1]);
+    /* 21: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var44.i;
+      _dest.x2[1] = var59.i;
+      var42.i = _dest.i;
+    }
+    /* 22: storeq */
+    ptr0[i] = var42;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_down_v4_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union64 *ORC_RESTRICT ptr5;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+  orc_union64 var40;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var41;
+#else
+  orc_union64 var41;
+#endif
+  orc_union64 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union64 var45;
+  orc_union32 var46;
+  orc_union64 var47;
+  orc_union64 var48;
+  orc_union32 var49;
+  orc_union64 var50;
+  orc_union32 var51;
+  orc_union64 var52;
+  orc_union64 var53;
+  orc_union64 var54;
+  orc_union64 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union64 var58;
+  orc_union32 var59;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union64 *) ex->arrays[5];
+  ptr6 = (orc_union64 *) ex->arrays[6];
+  ptr7 = (orc_union64 *) ex->arrays[7];
+
+  /* 17: loadpl */
+  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var37 = ptr4[i];
+    /* 1: splitql */
+    {
+      orc_union64 _src;
+      _src.i = var37.i;
+      var43.i = _src.x2[1];
+      var44.i = _src.x2[0];
+    }
+    /* 2: convuwl */
+    var45.x2[0] = (orc_uint16) var43.x2[0];
+    var45.x2[1] = (orc_uint16) var43.x2[1];
+    /* 3: loadq */
+    var38 = ptr7[i];
+    /* 4: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var38.i;
+      var46.i = _src.x2[1];
+    }
+    /* 5: convuwl */
+    var47.x2[0] = (orc_uint16) var46.x2[0];
+    var47.x2[1] = (orc_uint16) var46.x2[1];
+    /* 6: addl */
+    var48.x2[0] = ((orc_uint32) var45.x2[0]) + ((orc_uint32) var47.x2[0]);
+    var48.x2[1] = ((orc_uint32) var45.x2[1]) + ((orc_uint32) var47.x2[1]);
+    /* 7: loadq */
+    var39 = ptr5[i];
+    /* 8: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var39.i;
+      var49.i = _src.x2[1];
+    }
+    /* 9: convuwl */
+    var50.x2[0] = (orc_uint16) var49.x2[0];
+    var50.x2[1] = (orc_uint16) var49.x2[1];
+    /* 10: loadq */
+    var40 = ptr6[i];
+    /* 11: select1ql */
+    {
+      orc_union64 _src;
+      _src.i = var40.i;
+      var51.i = _src.x2[1];
+    }
+    /* 12: convuwl */
+    var52.x2[0] = (orc_uint16) var51.x2[0];
+    var52.x2[1] = (orc_uint16) var51.x2[1];
+    /* 13: addl */
+    var53.x2[0] = ((orc_uint32) var50.x2[0]) + ((orc_uint32) var52.x2[0]);
+    var53.x2[1] = ((orc_uint32) var50.x2[1]) + ((orc_uint32) var52.x2[1]);
+    /* 14: shll */
+    var54.x2[0] = ((orc_uint32) var53.x2[0]) << 1;
+    var54.x2[1] = ((orc_uint32) var53.x2[1]) << 1;
+    /* 15: addl */
+    var55.x2[0] = ((orc_uint32) var53.x2[0]) + ((orc_uint32) var54.x2[0]);
+    var55.x2[1] = ((orc_uint32) var53.x2[1]) + ((orc_uint32) var54.x2[1]);
+    /* 16: addl */
+    var56.x2[0] = ((orc_uint32) var48.x2[0]) + ((orc_uint32) var55.x2[0]);
+    var56.x2[1] = ((orc_uint32) var48.x2[1]) + ((orc_uint32) var55.x2[1]);
+    /* 18: addl */
+    var57.x2[0] = ((orc_uint32) var56.x2[0]) + ((orc_uint32) var41.x2[0]);
+    var57.x2[1] = ((orc_uint32) var56.x2[1]) + ((orc_uint32) var41.x2[1]);
+    /* 19: shrul */
+    var58.x2[0] = ((orc_uint32) var57.x2[0]) >> 3;
+    var58.x2[1] = ((orc_uint32) var57.x2[1]) >> 3;
+    /* 20: convsuslw */
+    var59.x2[0] = ORC_CLAMP_UW (var58.x2[0]);
+    var59.x2[1] = ORC_CLAMP_UW (var58.x2[1]);
+    /* 21: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var44.i;
+      _dest.x2[1] = var59.i;
+      var42.i = _dest.i;
+    }
+    /* 22: storeq */
+    ptr0[i] = var42;
+  }
+
+}
+
+void
+video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
+    const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 28, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 52, 95, 117, 49, 54, 11,
+        8, 8, 12, 8, 8, 12, 8, 8, 12, 8, 8, 12, 8, 8, 14, 4,
+        1, 0, 0, 0, 14, 4, 4, 0, 0, 0, 14, 4, 3, 0, 0, 0,
+        20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 197, 33, 32, 4, 21, 1,
+        154, 34, 33, 193, 33, 7, 21, 1, 154, 35, 33, 21, 1, 103, 36, 34,
+        35, 193, 33, 5, 21, 1, 154, 34, 33, 193, 33, 6, 21, 1, 154, 35,
+        33, 21, 1, 103, 34, 34, 35, 21, 1, 124, 35, 34, 16, 21, 1, 103,
+        34, 34, 35, 21, 1, 103, 36, 36, 34, 21, 1, 103, 36, 36, 17, 21,
+        1, 126, 36, 36, 18, 21, 1, 166, 33, 36, 194, 0, 32, 33, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_down_v4_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u16);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 8, "s2");
+      orc_program_add_source (p, 8, "s3");
+      orc_program_add_source (p, 8, "s4");
+      orc_program_add_constant (p, 4, 0x00000001, "c1");
+      orc_program_add_constant (p, 4, 0x00000004, "c2");
+      orc_program_add_constant (p, 4, 0x00000003, "c3");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 8, "t3");
+      orc_program_add_temporary (p, 8, "t4");
+      orc_program_add_temporary (p, 8, "t5");
+
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S4,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shll", 1, ORC_VAR_T4, ORC_VAR_T3, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T2, ORC_VAR_T5,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_v4_u8 */
+#ifdef DISABLE_ORC
+void
+video_orc_chroma_up_v4_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var40;
+  orc_union32 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var42;
+#else
+  orc_union32 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var43;
+#else
+  orc_union32 var43;
+#endif
+  orc_union32 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union16 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union32 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr1 = (orc_union32 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union32 *) s2;
+  ptr6 = (orc_union32 *) s3;
+  ptr7 = (orc_union32 *) s4;
+
+  /* 6: loadpw */
+  var42.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var42.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+  /* 9: loadpw */
+  var43.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var43.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 15: loadpw */
+  var45.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var45.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 17: loadpw */
+  var46.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var46.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var40 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var41 = ptr6[i];
+    /* 3: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
+    }
+    /* 4: convubw */
+    var56.x2[0] = (orc_uint8) var52.x2[0];
+    var56.x2[1] = (orc_uint8) var52.x2[1];
+    /* 5: convubw */
+    var57.x2[0] = (orc_uint8) var54.x2[0];
+    var57.x2[1] = (orc_uint8) var54.x2[1];
+    /* 7: mullw */
+    var58.x2[0] = (var56.x2[0] * var42.x2[0]) & 0xffff;
+    var58.x2[1] = (var56.x2[1] * var42.x2[1]) & 0xffff;
+    /* 8: addw */
+    var59.x2[0] = var58.x2[0] + var57.x2[0];
+    var59.x2[1] = var58.x2[1] + var57.x2[1];
+    /* 10: addw */
+    var60.x2[0] = var59.x2[0] + var43.x2[0];
+    var60.x2[1] = var59.x2[1] + var43.x2[1];
+    /* 11: shruw */
+    var61.x2[0] = ((orc_uint16) var60.x2[0]) >> 3;
+    var61.x2[1] = ((orc_uint16) var60.x2[1]) >> 3;
+    /* 12: convsuswb */
+    var62.x2[0] = ORC_CLAMP_UB (var61.x2[0]);
+    var62.x2[1] = ORC_CLAMP_UB (var61.x2[1]);
+    /* 13: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var62.i;
+      var44.i = _dest.i;
+    }
+    /* 14: storel */
+    ptr0[i] = var44;
+    /* 16: mullw */
+    var63.x2[0] = (var56.x2[0] * var45.x2[0]) & 0xffff;
+    var63.x2[1] = (var56.x2[1] * var45.x2[1]) & 0xffff;
+    /* 18: mullw */
+    var64.x2[0] = (var57.x2[0] * var46.x2[0]) & 0xffff;
+    var64.x2[1] = (var57.x2[1] * var46.x2[1]) & 0xffff;
+    /* 19: addw */
+    var65.x2[0] = var63.x2[0] + var64.x2[0];
+    var65.x2[1] = var63.x2[1] + var64.x2[1];
+    /* 20: addw */
+    var66.x2[0] = var65.x2[0] + var43.x2[0];
+    var66.x2[1] = var65.x2[1] + var43.x2[1];
+    /* 21: shruw */
+    var67.x2[0] = ((orc_uint16) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint16) var66.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var68.x2[0] = ORC_CLAMP_UB (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UB (var67.x2[1]);
+    /* 23: loadl */
+    var47 = ptr5[i];
+    /* 24: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var69.i = _src.x2[0];
+    }
+    /* 25: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var69.i;
+      _dest.x2[1] = var68.i;
+      var48.i = _dest.i;
+    }
+    /* 26: storel */
+    ptr1[i] = var48;
+    /* 27: mullw */
+    var70.x2[0] = (var56.x2[0] * var46.x2[0]) & 0xffff;
+    var70.x2[1] = (var56.x2[1] * var46.x2[1]) & 0xffff;
+    /* 28: mullw */
+    var71.x2[0] = (var57.x2[0] * var45.x2[0]) & 0xffff;
+    var71.x2[1] = (var57.x2[1] * var45.x2[1]) & 0xffff;
+    /* 29: addw */
+    var72.x2[0] = var70.x2[0] + var71.x2[0];
+    var72.x2[1] = var70.x2[1] + var71.x2[1];
+    /* 30: addw */
+    var73.x2[0] = var72.x2[0] + var43.x2[0];
+    var73.x2[1] = var72.x2[1] + var43.x2[1];
+    /* 31: shruw */
+    var74.x2[0] = ((orc_uint16) var73.x2[0]) >> 3;
+    var74.x2[1] = ((orc_uint16) var73.x2[1]) >> 3;
+    /* 32: convsuswb */
+    var75.x2[0] = ORC_CLAMP_UB (var74.x2[0]);
+    var75.x2[1] = ORC_CLAMP_UB (var74.x2[1]);
+    /* 33: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var75.i;
+      var49.i = _dest.i;
+    }
+    /* 34: storel */
+    ptr2[i] = var49;
+    /* 35: mullw */
+    var76.x2[0] = (var57.x2[0] * var42.x2[0]) & 0xffff;
+    var76.x2[1] = (var57.x2[1] * var42.x2[1]) & 0xffff;
+    /* 36: addw */
+    var77.x2[0] = var76.x2[0] + var56.x2[0];
+    var77.x2[1] = var76.x2[1] + var56.x2[1];
+    /* 37: addw */
+    var78.x2[0] = var77.x2[0] + var43.x2[0];
+    var78.x2[1] = var77.x2[1] + var43.x2[1];
+    /* 38: shruw */
+    var79.x2[0] = ((orc_uint16) var78.x2[0]) >> 3;
+    var79.x2[1] = ((orc_uint16) var78.x2[1]) >> 3;
+    /* 39: convsuswb */
+    var80.x2[0] = ORC_CLAMP_UB (var79.x2[0]);
+    var80.x2[1] = ORC_CLAMP_UB (var79.x2[1]);
+    /* 40: loadl */
+    var50 = ptr7[i];
+    /* 41: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var50.i;
+      var81.i = _src.x2[0];
+    }
+    /* 42: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var81.i;
+      _dest.x2[1] = var80.i;
+      var51.i = _dest.i;
+    }
+    /* 43: storel */
+    ptr3[i] = var51;
+  }
+
+}
+
+#else
+static void
+_backup_video_orc_chroma_up_v4_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  const orc_union32 *ORC_RESTRICT ptr6;
+  const orc_union32 *ORC_RESTRICT ptr7;
+  orc_union32 var40;
+  orc_union32 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var42;
+#else
+  orc_union32 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var43;
+#else
+  orc_union32 var43;
+#endif
+  orc_union32 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var45;
+#else
+  orc_union32 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
+  orc_union32 var47;
+  orc_union32 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
+  orc_union32 var56;
+  orc_union32 var57;
+  orc_union32 var58;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union16 var62;
+  orc_union32 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union16 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union32 var79;
+  orc_union16 var80;
+  orc_union16 var81;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr1 = (orc_union32 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+  ptr6 = (orc_union32 *) ex->arrays[6];
+  ptr7 = (orc_union32 *) ex->arrays[7];
+
+  /* 6: loadpw */
+  var42.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var42.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+  /* 9: loadpw */
+  var43.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var43.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 15: loadpw */
+  var45.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var45.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 17: loadpw */
+  var46.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var46.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var40 = ptr4[i];
+    /* 1: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
+    }
+    /* 2: loadl */
+    var41 = ptr6[i];
+    /* 3: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
+    }
+    /* 4: convubw */
+    var56.x2[0] = (orc_uint8) var52.x2[0];
+    var56.x2[1] = (orc_uint8) var52.x2[1];
+    /* 5: convubw */
+    var57.x2[0] = (orc_uint8) var54.x2[0];
+    var57.x2[1] = (orc_uint8) var54.x2[1];
+    /* 7: mullw */
+    var58.x2[0] = (var56.x2[0] * var42.x2[0]) & 0xffff;
+    var58.x2[1] = (var56.x2[1] * var42.x2[1]) & 0xffff;
+    /* 8: addw */
+    var59.x2[0] = var58.x2[0] + var57.x2[0];
+    var59.x2[1] = var58.x2[1] + var57.x2[1];
+    /* 10: addw */
+    var60.x2[0] = var59.x2[0] + var43.x2[0];
+    var60.x2[1] = var59.x2[1] + var43.x2[1];
+    /* 11: shruw */
+    var61.x2[0] = ((orc_uint16) var60.x2[0]) >> 3;
+    var61.x2[1] = ((orc_uint16) var60.x2[1]) >> 3;
+    /* 12: convsuswb */
+    var62.x2[0] = ORC_CLAMP_UB (var61.x2[0]);
+    var62.x2[1] = ORC_CLAMP_UB (var61.x2[1]);
+    /* 13: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var62.i;
+      var44.i = _dest.i;
+    }
+    /* 14: storel */
+    ptr0[i] = var44;
+    /* 16: mullw */
+    var63.x2[0] = (var56.x2[0] * var45.x2[0]) & 0xffff;
+    var63.x2[1] = (var56.x2[1] * var45.x2[1]) & 0xffff;
+    /* 18: mullw */
+    var64.x2[0] = (var57.x2[0] * var46.x2[0]) & 0xffff;
+    var64.x2[1] = (var57.x2[1] * var46.x2[1]) & 0xffff;
+    /* 19: addw */
+    var65.x2[0] = var63.x2[0] + var64.x2[0];
+    var65.x2[1] = var63.x2[1] + var64.x2[1];
+    /* 20: addw */
+    var66.x2[0] = var65.x2[0] + var43.x2[0];
+    var66.x2[1] = var65.x2[1] + var43.x2[1];
+    /* 21: shruw */
+    var67.x2[0] = ((orc_uint16) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint16) var66.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var68.x2[0] = ORC_CLAMP_UB (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UB (var67.x2[1]);
+    /* 23: loadl */
+    var47 = ptr5[i];
+    /* 24: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var47.i;
+      var69.i = _src.x2[0];
+    }
+    /* 25: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var69.i;
+      _dest.x2[1] = var68.i;
+      var48.i = _dest.i;
+    }
+    /* 26: storel */
+    ptr1[i] = var48;
+    /* 27: mullw */
+    var70.x2[0] = (var56.x2[0] * var46.x2[0]) & 0xffff;
+    var70.x2[1] = (var56.x2[1] * var46.x2[1]) & 0xffff;
+    /* 28: mullw */
+    var71.x2[0] = (var57.x2[0] * var45.x2[0]) & 0xffff;
+    var71.x2[1] = (var57.x2[1] * var45.x2[1]) & 0xffff;
+    /* 29: addw */
+    var72.x2[0] = var70.x2[0] + var71.x2[0];
+    var72.x2[1] = var70.x2[1] + var71.x2[1];
+    /* 30: addw */
+    var73.x2[0] = var72.x2[0] + var43.x2[0];
+    var73.x2[1] = var72.x2[1] + var43.x2[1];
+    /* 31: shruw */
+    var74.x2[0] = ((orc_uint16) var73.x2[0]) >> 3;
+    var74.x2[1] = ((orc_uint16) var73.x2[1]) >> 3;
+    /* 32: convsuswb */
+    var75.x2[0] = ORC_CLAMP_UB (var74.x2[0]);
+    var75.x2[1] = ORC_CLAMP_UB (var74.x2[1]);
+    /* 33: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var75.i;
+      var49.i = _dest.i;
+    }
+    /* 34: storel */
+    ptr2[i] = var49;
+    /* 35: mullw */
+    var76.x2[0] = (var57.x2[0] * var42.x2[0]) & 0xffff;
+    var76.x2[1] = (var57.x2[1] * var42.x2[1]) & 0xffff;
+    /* 36: addw */
+    var77.x2[0] = var76.x2[0] + var56.x2[0];
+    var77.x2[1] = var76.x2[1] + var56.x2[1];
+    /* 37: addw */
+    var78.x2[0] = var77.x2[0] + var43.x2[0];
+    var78.x2[1] = var77.x2[1] + var43.x2[1];
+    /* 38: shruw */
+    var79.x2[0] = ((orc_uint16) var78.x2[0]) >> 3;
+    var79.x2[1] = ((orc_uint16) var78.x2[1]) >> 3;
+    /* 39: convsuswb */
+    var80.x2[0] = ORC_CLAMP_UB (var79.x2[0]);
+    var80.x2[1] = ORC_CLAMP_UB (var79.x2[1]);
+    /* 40: loadl */
+    var50 = ptr7[i];
+    /* 41: select0lw */
+    {
+      orc_union32 _src;
+      _src.i = var50.i;
+      var81.i = _src.x2[0];
+    }
+    /* 42: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var81.i;
+      _dest.x2[1] = var80.i;
+      var51.i = _dest.i;
+    }
+    /* 43: storel */
+    ptr3[i] = var51;
+  }
+
+}
+
+void
+video_orc_chroma_up_v4_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 52, 95, 117, 56, 11, 4, 4, 11,
+        4, 4, 11, 4, 4, 11, 4, 4, 12, 4, 4, 12, 4, 4, 12, 4,
+        4, 12, 4, 4, 14, 2, 7, 0, 0, 0, 14, 2, 4, 0, 0, 0,
+        14, 2, 3, 0, 0, 0, 14, 2, 5, 0, 0, 0, 20, 2, 20, 2,
+        20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 20, 4, 198, 34, 32, 4,
+        198, 35, 33, 6, 21, 1, 150, 36, 34, 21, 1, 150, 37, 35, 21, 1,
+        89, 38, 36, 16, 21, 1, 70, 38, 38, 37, 21, 1, 70, 38, 38, 17,
+        21, 1, 95, 38, 38, 18, 21, 1, 160, 34, 38, 195, 0, 32, 34, 21,
+        1, 89, 38, 36, 19, 21, 1, 89, 39, 37, 18, 21, 1, 70, 38, 38,
+        39, 21, 1, 70, 38, 38, 17, 21, 1, 95, 38, 38, 18, 21, 1, 160,
+        34, 38, 190, 32, 5, 195, 1, 32, 34, 21, 1, 89, 38, 36, 18, 21,
+        1, 89, 39, 37, 19, 21, 1, 70, 38, 38, 39, 21, 1, 70, 38, 38,
+        17, 21, 1, 95, 38, 38, 18, 21, 1, 160, 34, 38, 195, 2, 33, 34,
+        21, 1, 89, 38, 37, 16, 21, 1, 70, 38, 38, 36, 21, 1, 70, 38,
+        38, 17, 21, 1, 95, 38, 38, 18, 21, 1, 160, 34, 38, 190, 32, 7,
+        195, 3, 32, 34, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_orc_chroma_up_v4_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_destination (p, 4, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_source (p, 4, "s3");
+      orc_program_add_source (p, 4, "s4");
+      orc_program_add_constant (p, 2, 0x00000007, "c1");
+      orc_program_add_constant (p, 2, 0x00000004, "c2");
+      orc_program_add_constant (p, 2, 0x00000003, "c3");
+      orc_program_add_constant (p, 2, 0x00000005, "c4");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
+      orc_program_add_temporary (p, 4, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+      orc_program_add_temporary (p, 4, "t7");
+      orc_program_add_temporary (p, 4, "t8");
+
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0lw", 0, ORC_VAR_T1, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D3, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0lw", 0, ORC_VAR_T1, ORC_VAR_S4,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D4, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_orc_chroma_up_v4_u16 */
 #ifdef DISABLE_ORC
 void
-video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
-    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int n)
+video_orc_chroma_up_v4_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
 {
   int i;
   orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
   const orc_union64 *ORC_RESTRICT ptr4;
   const orc_union64 *ORC_RESTRICT ptr5;
-  orc_union64 var35;
-  orc_union64 var36;
-  orc_union64 var37;
-  orc_union32 var38;
-  orc_union32 var39;
-  orc_union32 var40;
-  orc_union32 var41;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var40;
+  orc_union64 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var42;
+#else
+  orc_union64 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var43;
+#else
+  orc_union64 var43;
+#endif
+  orc_union64 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var45;
+#else
+  orc_union64 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
+  orc_union64 var47;
+  orc_union64 var48;
+  orc_union64 var49;
+  orc_union64 var50;
+  orc_union64 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union64 var58;
+  orc_union64 var59;
+  orc_union64 var60;
+  orc_union64 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union32 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union64 var79;
+  orc_union32 var80;
+  orc_union32 var81;
 
   ptr0 = (orc_union64 *) d1;
+  ptr1 = (orc_union64 *) d2;
+  ptr2 = (orc_union64 *) d3;
+  ptr3 = (orc_union64 *) d4;
   ptr4 = (orc_union64 *) s1;
   ptr5 = (orc_union64 *) s2;
+  ptr6 = (orc_union64 *) s3;
+  ptr7 = (orc_union64 *) s4;
 
+  /* 6: loadpl */
+  var42.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var42.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+  /* 9: loadpl */
+  var43.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var43.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 15: loadpl */
+  var45.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var45.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 17: loadpl */
+  var46.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var46.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadq */
-    var35 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitql */
     {
       orc_union64 _src;
-      _src.i = var35.i;
-      var38.i = _src.x2[1];
-      var39.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
     /* 2: loadq */
-    var36 = ptr5[i];
-    /* 3: select1ql */
+    var41 = ptr6[i];
+    /* 3: splitql */
     {
       orc_union64 _src;
-      _src.i = var36.i;
-      var40.i = _src.x2[1];
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
     }
-    /* 4: avguw */
-    var41.x2[0] =
-        ((orc_uint16) var38.x2[0] + (orc_uint16) var40.x2[0] + 1) >> 1;
-    var41.x2[1] =
-        ((orc_uint16) var38.x2[1] + (orc_uint16) var40.x2[1] + 1) >> 1;
-    /* 5: mergelq */
+    /* 4: convuwl */
+    var56.x2[0] = (orc_uint16) var52.x2[0];
+    var56.x2[1] = (orc_uint16) var52.x2[1];
+    /* 5: convuwl */
+    var57.x2[0] = (orc_uint16) var54.x2[0];
+    var57.x2[1] = (orc_uint16) var54.x2[1];
+    /* 7: mulll */
+    var58.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var58.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 8: addl */
+    var59.x2[0] = ((orc_uint32) var58.x2[0]) + ((orc_uint32) var57.x2[0]);
+    var59.x2[1] = ((orc_uint32) var58.x2[1]) + ((orc_uint32) var57.x2[1]);
+    /* 10: addl */
+    var60.x2[0] = ((orc_uint32) var59.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var60.x2[1] = ((orc_uint32) var59.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 11: shrul */
+    var61.x2[0] = ((orc_uint32) var60.x2[0]) >> 3;
+    var61.x2[1] = ((orc_uint32) var60.x2[1]) >> 3;
+    /* 12: convsuslw */
+    var62.x2[0] = ORC_CLAMP_UW (var61.x2[0]);
+    var62.x2[1] = ORC_CLAMP_UW (var61.x2[1]);
+    /* 13: mergelq */
     {
       orc_union64 _dest;
-      _dest.x2[0] = var39.i;
-      _dest.x2[1] = var41.i;
-      var37.i = _dest.i;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var62.i;
+      var44.i = _dest.i;
     }
-    /* 6: storeq */
-    ptr0[i] = var37;
+    /* 14: storeq */
+    ptr0[i] = var44;
+    /* 16: mulll */
+    var63.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var63.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 18: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var65.x2[0] = ((orc_uint32) var63.x2[0]) + ((orc_uint32) var64.x2[0]);
+    var65.x2[1] = ((orc_uint32) var63.x2[1]) + ((orc_uint32) var64.x2[1]);
+    /* 20: addl */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 21: shrul */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var68.x2[0] = ORC_CLAMP_UW (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UW (var67.x2[1]);
+    /* 23: loadq */
+    var47 = ptr5[i];
+    /* 24: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var47.i;
+      var69.i = _src.x2[0];
+    }
+    /* 25: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var69.i;
+      _dest.x2[1] = var68.i;
+      var48.i = _dest.i;
+    }
+    /* 26: storeq */
+    ptr1[i] = var48;
+    /* 27: mulll */
+    var70.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var70.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 28: mulll */
+    var71.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var71.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 29: addl */
+    var72.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var71.x2[0]);
+    var72.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var71.x2[1]);
+    /* 30: addl */
+    var73.x2[0] = ((orc_uint32) var72.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var73.x2[1] = ((orc_uint32) var72.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 31: shrul */
+    var74.x2[0] = ((orc_uint32) var73.x2[0]) >> 3;
+    var74.x2[1] = ((orc_uint32) var73.x2[1]) >> 3;
+    /* 32: convsuslw */
+    var75.x2[0] = ORC_CLAMP_UW (var74.x2[0]);
+    var75.x2[1] = ORC_CLAMP_UW (var74.x2[1]);
+    /* 33: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var75.i;
+      var49.i = _dest.i;
+    }
+    /* 34: storeq */
+    ptr2[i] = var49;
+    /* 35: mulll */
+    var76.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var76.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 36: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var56.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var56.x2[1]);
+    /* 37: addl */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 38: shrul */
+    var79.x2[0] = ((orc_uint32) var78.x2[0]) >> 3;
+    var79.x2[1] = ((orc_uint32) var78.x2[1]) >> 3;
+    /* 39: convsuslw */
+    var80.x2[0] = ORC_CLAMP_UW (var79.x2[0]);
+    var80.x2[1] = ORC_CLAMP_UW (var79.x2[1]);
+    /* 40: loadq */
+    var50 = ptr7[i];
+    /* 41: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var50.i;
+      var81.i = _src.x2[0];
+    }
+    /* 42: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var81.i;
+      _dest.x2[1] = var80.i;
+      var51.i = _dest.i;
+    }
+    /* 43: storeq */
+    ptr3[i] = var51;
   }
 
 }
 
 #else
 static void
-_backup_video_orc_chroma_down_v2_u16 (OrcExecutor * ORC_RESTRICT ex)
+_backup_video_orc_chroma_up_v4_u16 (OrcExecutor * ORC_RESTRICT ex)
 {
   int i;
   int n = ex->n;
   orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
   const orc_union64 *ORC_RESTRICT ptr4;
   const orc_union64 *ORC_RESTRICT ptr5;
-  orc_union64 var35;
-  orc_union64 var36;
-  orc_union64 var37;
-  orc_union32 var38;
-  orc_union32 var39;
-  orc_union32 var40;
-  orc_union32 var41;
+  const orc_union64 *ORC_RESTRICT ptr6;
+  const orc_union64 *ORC_RESTRICT ptr7;
+  orc_union64 var40;
+  orc_union64 var41;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var42;
+#else
+  orc_union64 var42;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var43;
+#else
+  orc_union64 var43;
+#endif
+  orc_union64 var44;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var45;
+#else
+  orc_union64 var45;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
+  orc_union64 var47;
+  orc_union64 var48;
+  orc_union64 var49;
+  orc_union64 var50;
+  orc_union64 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union64 var56;
+  orc_union64 var57;
+  orc_union64 var58;
+  orc_union64 var59;
+  orc_union64 var60;
+  orc_union64 var61;
+  orc_union32 var62;
+  orc_union64 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union64 var70;
+  orc_union64 var71;
+  orc_union64 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union32 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union64 var79;
+  orc_union32 var80;
+  orc_union32 var81;
 
   ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr1 = (orc_union64 *) ex->arrays[1];
+  ptr2 = (orc_union64 *) ex->arrays[2];
+  ptr3 = (orc_union64 *) ex->arrays[3];
   ptr4 = (orc_union64 *) ex->arrays[4];
   ptr5 = (orc_union64 *) ex->arrays[5];
+  ptr6 = (orc_union64 *) ex->arrays[6];
+  ptr7 = (orc_union64 *) ex->arrays[7];
 
+  /* 6: loadpl */
+  var42.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var42.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
+  /* 9: loadpl */
+  var43.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var43.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  /* 15: loadpl */
+  var45.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var45.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 17: loadpl */
+  var46.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var46.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadq */
-    var35 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitql */
     {
       orc_union64 _src;
-      _src.i = var35.i;
-      var38.i = _src.x2[1];
-      var39.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
     /* 2: loadq */
-    var36 = ptr5[i];
-    /* 3: select1ql */
+    var41 = ptr6[i];
+    /* 3: splitql */
     {
       orc_union64 _src;
-      _src.i = var36.i;
-      var40.i = _src.x2[1];
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
     }
-    /* 4: avguw */
-    var41.x2[0] =
-        ((orc_uint16) var38.x2[0] + (orc_uint16) var40.x2[0] + 1) >> 1;
-    var41.x2[1] =
-        ((orc_uint16) var38.x2[1] + (orc_uint16) var40.x2[1] + 1) >> 1;
-    /* 5: mergelq */
+    /* 4: convuwl */
+    var56.x2[0] = (orc_uint16) var52.x2[0];
+    var56.x2[1] = (orc_uint16) var52.x2[1];
+    /* 5: convuwl */
+    var57.x2[0] = (orc_uint16) var54.x2[0];
+    var57.x2[1] = (orc_uint16) var54.x2[1];
+    /* 7: mulll */
+    var58.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var58.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 8: addl */
+    var59.x2[0] = ((orc_uint32) var58.x2[0]) + ((orc_uint32) var57.x2[0]);
+    var59.x2[1] = ((orc_uint32) var58.x2[1]) + ((orc_uint32) var57.x2[1]);
+    /* 10: addl */
+    var60.x2[0] = ((orc_uint32) var59.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var60.x2[1] = ((orc_uint32) var59.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 11: shrul */
+    var61.x2[0] = ((orc_uint32) var60.x2[0]) >> 3;
+    var61.x2[1] = ((orc_uint32) var60.x2[1]) >> 3;
+    /* 12: convsuslw */
+    var62.x2[0] = ORC_CLAMP_UW (var61.x2[0]);
+    var62.x2[1] = ORC_CLAMP_UW (var61.x2[1]);
+    /* 13: mergelq */
     {
       orc_union64 _dest;
-      _dest.x2[0] = var39.i;
-      _dest.x2[1] = var41.i;
-      var37.i = _dest.i;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var62.i;
+      var44.i = _dest.i;
     }
-    /* 6: storeq */
-    ptr0[i] = var37;
+    /* 14: storeq */
+    ptr0[i] = var44;
+    /* 16: mulll */
+    var63.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var63.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 18: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var65.x2[0] = ((orc_uint32) var63.x2[0]) + ((orc_uint32) var64.x2[0]);
+    var65.x2[1] = ((orc_uint32) var63.x2[1]) + ((orc_uint32) var64.x2[1]);
+    /* 20: addl */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 21: shrul */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var68.x2[0] = ORC_CLAMP_UW (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UW (var67.x2[1]);
+    /* 23: loadq */
+    var47 = ptr5[i];
+    /* 24: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var47.i;
+      var69.i = _src.x2[0];
+    }
+    /* 25: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var69.i;
+      _dest.x2[1] = var68.i;
+      var48.i = _dest.i;
+    }
+    /* 26: storeq */
+    ptr1[i] = var48;
+    /* 27: mulll */
+    var70.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var70.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 28: mulll */
+    var71.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var45.x2[0])) & 0xffffffff;
+    var71.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var45.x2[1])) & 0xffffffff;
+    /* 29: addl */
+    var72.x2[0] = ((orc_uint32) var70.x2[0]) + ((orc_uint32) var71.x2[0]);
+    var72.x2[1] = ((orc_uint32) var70.x2[1]) + ((orc_uint32) var71.x2[1]);
+    /* 30: addl */
+    var73.x2[0] = ((orc_uint32) var72.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var73.x2[1] = ((orc_uint32) var72.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 31: shrul */
+    var74.x2[0] = ((orc_uint32) var73.x2[0]) >> 3;
+    var74.x2[1] = ((orc_uint32) var73.x2[1]) >> 3;
+    /* 32: convsuslw */
+    var75.x2[0] = ORC_CLAMP_UW (var74.x2[0]);
+    var75.x2[1] = ORC_CLAMP_UW (var74.x2[1]);
+    /* 33: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var75.i;
+      var49.i = _dest.i;
+    }
+    /* 34: storeq */
+    ptr2[i] = var49;
+    /* 35: mulll */
+    var76.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var76.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 36: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var56.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var56.x2[1]);
+    /* 37: addl */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) + ((orc_uint32) var43.x2[0]);
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) + ((orc_uint32) var43.x2[1]);
+    /* 38: shrul */
+    var79.x2[0] = ((orc_uint32) var78.x2[0]) >> 3;
+    var79.x2[1] = ((orc_uint32) var78.x2[1]) >> 3;
+    /* 39: convsuslw */
+    var80.x2[0] = ORC_CLAMP_UW (var79.x2[0]);
+    var80.x2[1] = ORC_CLAMP_UW (var79.x2[1]);
+    /* 40: loadq */
+    var50 = ptr7[i];
+    /* 41: select0ql */
+    {
+      orc_union64 _src;
+      _src.i = var50.i;
+      var81.i = _src.x2[0];
+    }
+    /* 42: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var81.i;
+      _dest.x2[1] = var80.i;
+      var51.i = _dest.i;
+    }
+    /* 43: storeq */
+    ptr3[i] = var51;
   }
 
 }
 
 void
-video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
-    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int n)
+video_orc_chroma_up_v4_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
 {
   OrcExecutor _ex, *ex = &_ex;
   static volatile int p_inited = 0;
@@ -30821,32 +33475,114 @@ video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
 
 #if 1
       static const orc_uint8 bc[] = {
-        1, 9, 28, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
-        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 50, 95, 117, 49, 54, 11,
-        8, 8, 12, 8, 8, 12, 8, 8, 20, 4, 20, 4, 20, 4, 197, 33,
-        32, 4, 193, 34, 5, 21, 1, 76, 33, 33, 34, 194, 0, 32, 33, 2,
-        0,
+        1, 9, 26, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 52, 95, 117, 49, 54, 11, 8, 8,
+        11, 8, 8, 11, 8, 8, 11, 8, 8, 12, 8, 8, 12, 8, 8, 12,
+        8, 8, 12, 8, 8, 14, 4, 7, 0, 0, 0, 14, 4, 4, 0, 0,
+        0, 14, 4, 3, 0, 0, 0, 14, 4, 5, 0, 0, 0, 20, 4, 20,
+        4, 20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 20, 8, 197, 34, 32,
+        4, 197, 35, 33, 6, 21, 1, 154, 36, 34, 21, 1, 154, 37, 35, 21,
+        1, 120, 38, 36, 16, 21, 1, 103, 38, 38, 37, 21, 1, 103, 38, 38,
+        17, 21, 1, 126, 38, 38, 18, 21, 1, 166, 34, 38, 194, 0, 32, 34,
+        21, 1, 120, 38, 36, 19, 21, 1, 120, 39, 37, 18, 21, 1, 103, 38,
+        38, 39, 21, 1, 103, 38, 38, 17, 21, 1, 126, 38, 38, 18, 21, 1,
+        166, 34, 38, 192, 32, 5, 194, 1, 32, 34, 21, 1, 120, 38, 36, 18,
+        21, 1, 120, 39, 37, 19, 21, 1, 103, 38, 38, 39, 21, 1, 103, 38,
+        38, 17, 21, 1, 126, 38, 38, 18, 21, 1, 166, 34, 38, 194, 2, 33,
+        34, 21, 1, 120, 38, 37, 16, 21, 1, 103, 38, 38, 36, 21, 1, 103,
+        38, 38, 17, 21, 1, 126, 38, 38, 18, 21, 1, 166, 34, 38, 192, 32,
+        7, 194, 3, 32, 34, 2, 0,
       };
       p = orc_program_new_from_static_bytecode (bc);
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u16);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u16);
 #else
       p = orc_program_new ();
-      orc_program_set_name (p, "video_orc_chroma_down_v2_u16");
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v2_u16);
+      orc_program_set_name (p, "video_orc_chroma_up_v4_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_v4_u16);
       orc_program_add_destination (p, 8, "d1");
+      orc_program_add_destination (p, 8, "d2");
+      orc_program_add_destination (p, 8, "d3");
+      orc_program_add_destination (p, 8, "d4");
       orc_program_add_source (p, 8, "s1");
       orc_program_add_source (p, 8, "s2");
+      orc_program_add_source (p, 8, "s3");
+      orc_program_add_source (p, 8, "s4");
+      orc_program_add_constant (p, 4, 0x00000007, "c1");
+      orc_program_add_constant (p, 4, 0x00000004, "c2");
+      orc_program_add_constant (p, 4, 0x00000003, "c3");
+      orc_program_add_constant (p, 4, 0x00000005, "c4");
       orc_program_add_temporary (p, 4, "t1");
       orc_program_add_temporary (p, 4, "t2");
       orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 8, "t5");
+      orc_program_add_temporary (p, 8, "t6");
+      orc_program_add_temporary (p, 8, "t7");
+      orc_program_add_temporary (p, 8, "t8");
 
-      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T6,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0ql", 0, ORC_VAR_T1, ORC_VAR_S2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_T3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T3, ORC_VAR_S2,
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "avguw", 1, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D3, ORC_VAR_T2, ORC_VAR_T3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "select0ql", 0, ORC_VAR_T1, ORC_VAR_S4,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D4, ORC_VAR_T1, ORC_VAR_T3,
           ORC_VAR_D1);
 #endif
 
@@ -30862,8 +33598,13 @@ video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
 
   ex->n = n;
   ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
   ex->arrays[ORC_VAR_S1] = (void *) s1;
   ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
 
   func = c->exec;
   func (ex);
@@ -30871,274 +33612,520 @@ video_orc_chroma_down_v2_u16 (guint16 * ORC_RESTRICT d1,
 #endif
 
 
-/* video_orc_chroma_down_v4_u8 */
+/* video_orc_chroma_up_vi2_u8 */
 #ifdef DISABLE_ORC
 void
-video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
     const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
 {
   int i;
   orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
   const orc_union32 *ORC_RESTRICT ptr4;
   const orc_union32 *ORC_RESTRICT ptr5;
   const orc_union32 *ORC_RESTRICT ptr6;
   const orc_union32 *ORC_RESTRICT ptr7;
-  orc_union32 var37;
-  orc_union32 var38;
-  orc_union32 var39;
   orc_union32 var40;
+  orc_union32 var41;
 #if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union32 var41;
+  volatile orc_union32 var42;
 #else
-  orc_union32 var41;
-#endif
   orc_union32 var42;
-  orc_union16 var43;
-  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var43;
+#else
+  orc_union32 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
   orc_union32 var45;
-  orc_union16 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
   orc_union32 var47;
   orc_union32 var48;
-  orc_union16 var49;
+  orc_union32 var49;
   orc_union32 var50;
-  orc_union16 var51;
-  orc_union32 var52;
-  orc_union32 var53;
-  orc_union32 var54;
-  orc_union32 var55;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
   orc_union32 var56;
   orc_union32 var57;
   orc_union32 var58;
-  orc_union16 var59;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union16 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union16 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union16 var85;
 
   ptr0 = (orc_union32 *) d1;
+  ptr1 = (orc_union32 *) d2;
+  ptr2 = (orc_union32 *) d3;
+  ptr3 = (orc_union32 *) d4;
   ptr4 = (orc_union32 *) s1;
   ptr5 = (orc_union32 *) s2;
   ptr6 = (orc_union32 *) s3;
   ptr7 = (orc_union32 *) s4;
 
+  /* 6: loadpw */
+  var42.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var42.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpw */
+  var43.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var43.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpw */
+  var44.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var44.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
   /* 17: loadpw */
-  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
-  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var46.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var46.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadl */
-    var37 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitlw */
     {
       orc_union32 _src;
-      _src.i = var37.i;
-      var43.i = _src.x2[1];
-      var44.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
-    /* 2: convubw */
-    var45.x2[0] = (orc_uint8) var43.x2[0];
-    var45.x2[1] = (orc_uint8) var43.x2[1];
-    /* 3: loadl */
-    var38 = ptr7[i];
-    /* 4: select1lw */
+    /* 2: loadl */
+    var41 = ptr6[i];
+    /* 3: splitlw */
     {
       orc_union32 _src;
-      _src.i = var38.i;
-      var46.i = _src.x2[1];
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
     }
+    /* 4: convubw */
+    var56.x2[0] = (orc_uint8) var52.x2[0];
+    var56.x2[1] = (orc_uint8) var52.x2[1];
     /* 5: convubw */
-    var47.x2[0] = (orc_uint8) var46.x2[0];
-    var47.x2[1] = (orc_uint8) var46.x2[1];
-    /* 6: addw */
-    var48.x2[0] = var45.x2[0] + var47.x2[0];
-    var48.x2[1] = var45.x2[1] + var47.x2[1];
-    /* 7: loadl */
-    var39 = ptr5[i];
-    /* 8: select1lw */
+    var57.x2[0] = (orc_uint8) var54.x2[0];
+    var57.x2[1] = (orc_uint8) var54.x2[1];
+    /* 7: mullw */
+    var58.x2[0] = (var56.x2[0] * var42.x2[0]) & 0xffff;
+    var58.x2[1] = (var56.x2[1] * var42.x2[1]) & 0xffff;
+    /* 9: mullw */
+    var59.x2[0] = (var57.x2[0] * var43.x2[0]) & 0xffff;
+    var59.x2[1] = (var57.x2[1] * var43.x2[1]) & 0xffff;
+    /* 10: addw */
+    var60.x2[0] = var58.x2[0] + var59.x2[0];
+    var60.x2[1] = var58.x2[1] + var59.x2[1];
+    /* 12: addw */
+    var61.x2[0] = var60.x2[0] + var44.x2[0];
+    var61.x2[1] = var60.x2[1] + var44.x2[1];
+    /* 13: shruw */
+    var62.x2[0] = ((orc_uint16) var61.x2[0]) >> 3;
+    var62.x2[1] = ((orc_uint16) var61.x2[1]) >> 3;
+    /* 14: convsuswb */
+    var63.x2[0] = ORC_CLAMP_UB (var62.x2[0]);
+    var63.x2[1] = ORC_CLAMP_UB (var62.x2[1]);
+    /* 15: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var63.i;
+      var45.i = _dest.i;
+    }
+    /* 16: storel */
+    ptr0[i] = var45;
+    /* 18: mullw */
+    var64.x2[0] = (var57.x2[0] * var46.x2[0]) & 0xffff;
+    var64.x2[1] = (var57.x2[1] * var46.x2[1]) & 0xffff;
+    /* 19: addw */
+    var65.x2[0] = var64.x2[0] + var56.x2[0];
+    var65.x2[1] = var64.x2[1] + var56.x2[1];
+    /* 20: addw */
+    var66.x2[0] = var65.x2[0] + var44.x2[0];
+    var66.x2[1] = var65.x2[1] + var44.x2[1];
+    /* 21: shruw */
+    var67.x2[0] = ((orc_uint16) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint16) var66.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var68.x2[0] = ORC_CLAMP_UB (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UB (var67.x2[1]);
+    /* 23: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var68.i;
+      var47.i = _dest.i;
+    }
+    /* 24: storel */
+    ptr2[i] = var47;
+    /* 25: loadl */
+    var48 = ptr5[i];
+    /* 26: splitlw */
     {
       orc_union32 _src;
-      _src.i = var39.i;
-      var49.i = _src.x2[1];
+      _src.i = var48.i;
+      var69.i = _src.x2[1];
+      var70.i = _src.x2[0];
     }
-    /* 9: convubw */
-    var50.x2[0] = (orc_uint8) var49.x2[0];
-    var50.x2[1] = (orc_uint8) var49.x2[1];
-    /* 10: loadl */
-    var40 = ptr6[i];
-    /* 11: select1lw */
+    /* 27: loadl */
+    var49 = ptr7[i];
+    /* 28: splitlw */
     {
       orc_union32 _src;
-      _src.i = var40.i;
-      var51.i = _src.x2[1];
+      _src.i = var49.i;
+      var71.i = _src.x2[1];
+      var72.i = _src.x2[0];
+    }
+    /* 29: convubw */
+    var73.x2[0] = (orc_uint8) var69.x2[0];
+    var73.x2[1] = (orc_uint8) var69.x2[1];
+    /* 30: convubw */
+    var74.x2[0] = (orc_uint8) var71.x2[0];
+    var74.x2[1] = (orc_uint8) var71.x2[1];
+    /* 31: mullw */
+    var75.x2[0] = (var73.x2[0] * var46.x2[0]) & 0xffff;
+    var75.x2[1] = (var73.x2[1] * var46.x2[1]) & 0xffff;
+    /* 32: addw */
+    var76.x2[0] = var75.x2[0] + var74.x2[0];
+    var76.x2[1] = var75.x2[1] + var74.x2[1];
+    /* 33: addw */
+    var77.x2[0] = var76.x2[0] + var44.x2[0];
+    var77.x2[1] = var76.x2[1] + var44.x2[1];
+    /* 34: shruw */
+    var78.x2[0] = ((orc_uint16) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint16) var77.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var79.x2[0] = ORC_CLAMP_UB (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UB (var78.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var70.i;
+      _dest.x2[1] = var79.i;
+      var50.i = _dest.i;
     }
-    /* 12: convubw */
-    var52.x2[0] = (orc_uint8) var51.x2[0];
-    var52.x2[1] = (orc_uint8) var51.x2[1];
-    /* 13: addw */
-    var53.x2[0] = var50.x2[0] + var52.x2[0];
-    var53.x2[1] = var50.x2[1] + var52.x2[1];
-    /* 14: shlw */
-    var54.x2[0] = ((orc_uint16) var53.x2[0]) << 1;
-    var54.x2[1] = ((orc_uint16) var53.x2[1]) << 1;
-    /* 15: addw */
-    var55.x2[0] = var53.x2[0] + var54.x2[0];
-    var55.x2[1] = var53.x2[1] + var54.x2[1];
-    /* 16: addw */
-    var56.x2[0] = var48.x2[0] + var55.x2[0];
-    var56.x2[1] = var48.x2[1] + var55.x2[1];
-    /* 18: addw */
-    var57.x2[0] = var56.x2[0] + var41.x2[0];
-    var57.x2[1] = var56.x2[1] + var41.x2[1];
-    /* 19: shruw */
-    var58.x2[0] = ((orc_uint16) var57.x2[0]) >> 3;
-    var58.x2[1] = ((orc_uint16) var57.x2[1]) >> 3;
-    /* 20: convsuswb */
-    var59.x2[0] = ORC_CLAMP_UB (var58.x2[0]);
-    var59.x2[1] = ORC_CLAMP_UB (var58.x2[1]);
-    /* 21: mergewl */
+    /* 37: storel */
+    ptr1[i] = var50;
+    /* 38: mullw */
+    var80.x2[0] = (var73.x2[0] * var43.x2[0]) & 0xffff;
+    var80.x2[1] = (var73.x2[1] * var43.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var81.x2[0] = (var74.x2[0] * var42.x2[0]) & 0xffff;
+    var81.x2[1] = (var74.x2[1] * var42.x2[1]) & 0xffff;
+    /* 40: addw */
+    var82.x2[0] = var80.x2[0] + var81.x2[0];
+    var82.x2[1] = var80.x2[1] + var81.x2[1];
+    /* 41: addw */
+    var83.x2[0] = var82.x2[0] + var44.x2[0];
+    var83.x2[1] = var82.x2[1] + var44.x2[1];
+    /* 42: shruw */
+    var84.x2[0] = ((orc_uint16) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint16) var83.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var85.x2[0] = ORC_CLAMP_UB (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UB (var84.x2[1]);
+    /* 44: mergewl */
     {
       orc_union32 _dest;
-      _dest.x2[0] = var44.i;
-      _dest.x2[1] = var59.i;
-      var42.i = _dest.i;
+      _dest.x2[0] = var72.i;
+      _dest.x2[1] = var85.i;
+      var51.i = _dest.i;
     }
-    /* 22: storel */
-    ptr0[i] = var42;
+    /* 45: storel */
+    ptr3[i] = var51;
   }
 
 }
 
 #else
 static void
-_backup_video_orc_chroma_down_v4_u8 (OrcExecutor * ORC_RESTRICT ex)
+_backup_video_orc_chroma_up_vi2_u8 (OrcExecutor * ORC_RESTRICT ex)
 {
   int i;
   int n = ex->n;
   orc_union32 *ORC_RESTRICT ptr0;
+  orc_union32 *ORC_RESTRICT ptr1;
+  orc_union32 *ORC_RESTRICT ptr2;
+  orc_union32 *ORC_RESTRICT ptr3;
   const orc_union32 *ORC_RESTRICT ptr4;
   const orc_union32 *ORC_RESTRICT ptr5;
   const orc_union32 *ORC_RESTRICT ptr6;
   const orc_union32 *ORC_RESTRICT ptr7;
-  orc_union32 var37;
-  orc_union32 var38;
-  orc_union32 var39;
   orc_union32 var40;
+  orc_union32 var41;
 #if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union32 var41;
+  volatile orc_union32 var42;
 #else
-  orc_union32 var41;
-#endif
   orc_union32 var42;
-  orc_union16 var43;
-  orc_union16 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var43;
+#else
+  orc_union32 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var44;
+#else
+  orc_union32 var44;
+#endif
   orc_union32 var45;
-  orc_union16 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var46;
+#else
+  orc_union32 var46;
+#endif
   orc_union32 var47;
   orc_union32 var48;
-  orc_union16 var49;
+  orc_union32 var49;
   orc_union32 var50;
-  orc_union16 var51;
-  orc_union32 var52;
-  orc_union32 var53;
-  orc_union32 var54;
-  orc_union32 var55;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_union16 var53;
+  orc_union16 var54;
+  orc_union16 var55;
   orc_union32 var56;
   orc_union32 var57;
   orc_union32 var58;
-  orc_union16 var59;
+  orc_union32 var59;
+  orc_union32 var60;
+  orc_union32 var61;
+  orc_union32 var62;
+  orc_union16 var63;
+  orc_union32 var64;
+  orc_union32 var65;
+  orc_union32 var66;
+  orc_union32 var67;
+  orc_union16 var68;
+  orc_union16 var69;
+  orc_union16 var70;
+  orc_union16 var71;
+  orc_union16 var72;
+  orc_union32 var73;
+  orc_union32 var74;
+  orc_union32 var75;
+  orc_union32 var76;
+  orc_union32 var77;
+  orc_union32 var78;
+  orc_union16 var79;
+  orc_union32 var80;
+  orc_union32 var81;
+  orc_union32 var82;
+  orc_union32 var83;
+  orc_union32 var84;
+  orc_union16 var85;
 
   ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr1 = (orc_union32 *) ex->arrays[1];
+  ptr2 = (orc_union32 *) ex->arrays[2];
+  ptr3 = (orc_union32 *) ex->arrays[3];
   ptr4 = (orc_union32 *) ex->arrays[4];
   ptr5 = (orc_union32 *) ex->arrays[5];
   ptr6 = (orc_union32 *) ex->arrays[6];
   ptr7 = (orc_union32 *) ex->arrays[7];
 
+  /* 6: loadpw */
+  var42.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var42.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpw */
+  var43.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var43.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpw */
+  var44.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var44.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
   /* 17: loadpw */
-  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
-  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var46.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var46.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadl */
-    var37 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitlw */
     {
       orc_union32 _src;
-      _src.i = var37.i;
-      var43.i = _src.x2[1];
-      var44.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
-    /* 2: convubw */
-    var45.x2[0] = (orc_uint8) var43.x2[0];
-    var45.x2[1] = (orc_uint8) var43.x2[1];
-    /* 3: loadl */
-    var38 = ptr7[i];
-    /* 4: select1lw */
+    /* 2: loadl */
+    var41 = ptr6[i];
+    /* 3: splitlw */
+    {
+      orc_union32 _src;
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
+    }
+    /* 4: convubw */
+    var56.x2[0] = (orc_uint8) var52.x2[0];
+    var56.x2[1] = (orc_uint8) var52.x2[1];
+    /* 5: convubw */
+    var57.x2[0] = (orc_uint8) var54.x2[0];
+    var57.x2[1] = (orc_uint8) var54.x2[1];
+    /* 7: mullw */
+    var58.x2[0] = (var56.x2[0] * var42.x2[0]) & 0xffff;
+    var58.x2[1] = (var56.x2[1] * var42.x2[1]) & 0xffff;
+    /* 9: mullw */
+    var59.x2[0] = (var57.x2[0] * var43.x2[0]) & 0xffff;
+    var59.x2[1] = (var57.x2[1] * var43.x2[1]) & 0xffff;
+    /* 10: addw */
+    var60.x2[0] = var58.x2[0] + var59.x2[0];
+    var60.x2[1] = var58.x2[1] + var59.x2[1];
+    /* 12: addw */
+    var61.x2[0] = var60.x2[0] + var44.x2[0];
+    var61.x2[1] = var60.x2[1] + var44.x2[1];
+    /* 13: shruw */
+    var62.x2[0] = ((orc_uint16) var61.x2[0]) >> 3;
+    var62.x2[1] = ((orc_uint16) var61.x2[1]) >> 3;
+    /* 14: convsuswb */
+    var63.x2[0] = ORC_CLAMP_UB (var62.x2[0]);
+    var63.x2[1] = ORC_CLAMP_UB (var62.x2[1]);
+    /* 15: mergewl */
     {
-      orc_union32 _src;
-      _src.i = var38.i;
-      var46.i = _src.x2[1];
+      orc_union32 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var63.i;
+      var45.i = _dest.i;
     }
-    /* 5: convubw */
-    var47.x2[0] = (orc_uint8) var46.x2[0];
-    var47.x2[1] = (orc_uint8) var46.x2[1];
-    /* 6: addw */
-    var48.x2[0] = var45.x2[0] + var47.x2[0];
-    var48.x2[1] = var45.x2[1] + var47.x2[1];
-    /* 7: loadl */
-    var39 = ptr5[i];
-    /* 8: select1lw */
+    /* 16: storel */
+    ptr0[i] = var45;
+    /* 18: mullw */
+    var64.x2[0] = (var57.x2[0] * var46.x2[0]) & 0xffff;
+    var64.x2[1] = (var57.x2[1] * var46.x2[1]) & 0xffff;
+    /* 19: addw */
+    var65.x2[0] = var64.x2[0] + var56.x2[0];
+    var65.x2[1] = var64.x2[1] + var56.x2[1];
+    /* 20: addw */
+    var66.x2[0] = var65.x2[0] + var44.x2[0];
+    var66.x2[1] = var65.x2[1] + var44.x2[1];
+    /* 21: shruw */
+    var67.x2[0] = ((orc_uint16) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint16) var66.x2[1]) >> 3;
+    /* 22: convsuswb */
+    var68.x2[0] = ORC_CLAMP_UB (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UB (var67.x2[1]);
+    /* 23: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var68.i;
+      var47.i = _dest.i;
+    }
+    /* 24: storel */
+    ptr2[i] = var47;
+    /* 25: loadl */
+    var48 = ptr5[i];
+    /* 26: splitlw */
     {
       orc_union32 _src;
-      _src.i = var39.i;
-      var49.i = _src.x2[1];
+      _src.i = var48.i;
+      var69.i = _src.x2[1];
+      var70.i = _src.x2[0];
     }
-    /* 9: convubw */
-    var50.x2[0] = (orc_uint8) var49.x2[0];
-    var50.x2[1] = (orc_uint8) var49.x2[1];
-    /* 10: loadl */
-    var40 = ptr6[i];
-    /* 11: select1lw */
+    /* 27: loadl */
+    var49 = ptr7[i];
+    /* 28: splitlw */
     {
       orc_union32 _src;
-      _src.i = var40.i;
-      var51.i = _src.x2[1];
+      _src.i = var49.i;
+      var71.i = _src.x2[1];
+      var72.i = _src.x2[0];
+    }
+    /* 29: convubw */
+    var73.x2[0] = (orc_uint8) var69.x2[0];
+    var73.x2[1] = (orc_uint8) var69.x2[1];
+    /* 30: convubw */
+    var74.x2[0] = (orc_uint8) var71.x2[0];
+    var74.x2[1] = (orc_uint8) var71.x2[1];
+    /* 31: mullw */
+    var75.x2[0] = (var73.x2[0] * var46.x2[0]) & 0xffff;
+    var75.x2[1] = (var73.x2[1] * var46.x2[1]) & 0xffff;
+    /* 32: addw */
+    var76.x2[0] = var75.x2[0] + var74.x2[0];
+    var76.x2[1] = var75.x2[1] + var74.x2[1];
+    /* 33: addw */
+    var77.x2[0] = var76.x2[0] + var44.x2[0];
+    var77.x2[1] = var76.x2[1] + var44.x2[1];
+    /* 34: shruw */
+    var78.x2[0] = ((orc_uint16) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint16) var77.x2[1]) >> 3;
+    /* 35: convsuswb */
+    var79.x2[0] = ORC_CLAMP_UB (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UB (var78.x2[1]);
+    /* 36: mergewl */
+    {
+      orc_union32 _dest;
+      _dest.x2[0] = var70.i;
+      _dest.x2[1] = var79.i;
+      var50.i = _dest.i;
     }
-    /* 12: convubw */
-    var52.x2[0] = (orc_uint8) var51.x2[0];
-    var52.x2[1] = (orc_uint8) var51.x2[1];
-    /* 13: addw */
-    var53.x2[0] = var50.x2[0] + var52.x2[0];
-    var53.x2[1] = var50.x2[1] + var52.x2[1];
-    /* 14: shlw */
-    var54.x2[0] = ((orc_uint16) var53.x2[0]) << 1;
-    var54.x2[1] = ((orc_uint16) var53.x2[1]) << 1;
-    /* 15: addw */
-    var55.x2[0] = var53.x2[0] + var54.x2[0];
-    var55.x2[1] = var53.x2[1] + var54.x2[1];
-    /* 16: addw */
-    var56.x2[0] = var48.x2[0] + var55.x2[0];
-    var56.x2[1] = var48.x2[1] + var55.x2[1];
-    /* 18: addw */
-    var57.x2[0] = var56.x2[0] + var41.x2[0];
-    var57.x2[1] = var56.x2[1] + var41.x2[1];
-    /* 19: shruw */
-    var58.x2[0] = ((orc_uint16) var57.x2[0]) >> 3;
-    var58.x2[1] = ((orc_uint16) var57.x2[1]) >> 3;
-    /* 20: convsuswb */
-    var59.x2[0] = ORC_CLAMP_UB (var58.x2[0]);
-    var59.x2[1] = ORC_CLAMP_UB (var58.x2[1]);
-    /* 21: mergewl */
+    /* 37: storel */
+    ptr1[i] = var50;
+    /* 38: mullw */
+    var80.x2[0] = (var73.x2[0] * var43.x2[0]) & 0xffff;
+    var80.x2[1] = (var73.x2[1] * var43.x2[1]) & 0xffff;
+    /* 39: mullw */
+    var81.x2[0] = (var74.x2[0] * var42.x2[0]) & 0xffff;
+    var81.x2[1] = (var74.x2[1] * var42.x2[1]) & 0xffff;
+    /* 40: addw */
+    var82.x2[0] = var80.x2[0] + var81.x2[0];
+    var82.x2[1] = var80.x2[1] + var81.x2[1];
+    /* 41: addw */
+    var83.x2[0] = var82.x2[0] + var44.x2[0];
+    var83.x2[1] = var82.x2[1] + var44.x2[1];
+    /* 42: shruw */
+    var84.x2[0] = ((orc_uint16) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint16) var83.x2[1]) >> 3;
+    /* 43: convsuswb */
+    var85.x2[0] = ORC_CLAMP_UB (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UB (var84.x2[1]);
+    /* 44: mergewl */
     {
       orc_union32 _dest;
-      _dest.x2[0] = var44.i;
-      _dest.x2[1] = var59.i;
-      var42.i = _dest.i;
+      _dest.x2[0] = var72.i;
+      _dest.x2[1] = var85.i;
+      var51.i = _dest.i;
     }
-    /* 22: storel */
-    ptr0[i] = var42;
+    /* 45: storel */
+    ptr3[i] = var51;
   }
 
 }
 
 void
-video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
+video_orc_chroma_up_vi2_u8 (guint8 * ORC_RESTRICT d1, guint8 * ORC_RESTRICT d2,
+    guint8 * ORC_RESTRICT d3, guint8 * ORC_RESTRICT d4,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
     const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int n)
 {
@@ -31154,70 +34141,119 @@ video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
 
 #if 1
       static const orc_uint8 bc[] = {
-        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
-        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 52, 95, 117, 56, 11, 4,
-        4, 12, 4, 4, 12, 4, 4, 12, 4, 4, 12, 4, 4, 14, 2, 1,
-        0, 0, 0, 14, 2, 4, 0, 0, 0, 14, 2, 3, 0, 0, 0, 20,
-        2, 20, 2, 20, 4, 20, 4, 20, 4, 198, 33, 32, 4, 21, 1, 150,
-        34, 33, 191, 33, 7, 21, 1, 150, 35, 33, 21, 1, 70, 36, 34, 35,
-        191, 33, 5, 21, 1, 150, 34, 33, 191, 33, 6, 21, 1, 150, 35, 33,
-        21, 1, 70, 34, 34, 35, 21, 1, 93, 35, 34, 16, 21, 1, 70, 34,
-        34, 35, 21, 1, 70, 36, 36, 34, 21, 1, 70, 36, 36, 17, 21, 1,
-        95, 36, 36, 18, 21, 1, 160, 33, 36, 195, 0, 32, 33, 2, 0,
+        1, 9, 26, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 56, 11, 4, 4,
+        11, 4, 4, 11, 4, 4, 11, 4, 4, 12, 4, 4, 12, 4, 4, 12,
+        4, 4, 12, 4, 4, 14, 2, 5, 0, 0, 0, 14, 2, 3, 0, 0,
+        0, 14, 2, 4, 0, 0, 0, 14, 2, 7, 0, 0, 0, 20, 2, 20,
+        2, 20, 2, 20, 2, 20, 4, 20, 4, 20, 4, 20, 4, 198, 34, 32,
+        4, 198, 35, 33, 6, 21, 1, 150, 36, 34, 21, 1, 150, 37, 35, 21,
+        1, 89, 38, 36, 16, 21, 1, 89, 39, 37, 17, 21, 1, 70, 38, 38,
+        39, 21, 1, 70, 38, 38, 18, 21, 1, 95, 38, 38, 17, 21, 1, 160,
+        34, 38, 195, 0, 32, 34, 21, 1, 89, 38, 37, 19, 21, 1, 70, 38,
+        38, 36, 21, 1, 70, 38, 38, 18, 21, 1, 95, 38, 38, 17, 21, 1,
+        160, 35, 38, 195, 2, 33, 35, 198, 34, 32, 5, 198, 35, 33, 7, 21,
+        1, 150, 36, 34, 21, 1, 150, 37, 35, 21, 1, 89, 38, 36, 19, 21,
+        1, 70, 38, 38, 37, 21, 1, 70, 38, 38, 18, 21, 1, 95, 38, 38,
+        17, 21, 1, 160, 34, 38, 195, 1, 32, 34, 21, 1, 89, 38, 36, 17,
+        21, 1, 89, 39, 37, 16, 21, 1, 70, 38, 38, 39, 21, 1, 70, 38,
+        38, 18, 21, 1, 95, 38, 38, 17, 21, 1, 160, 35, 38, 195, 3, 33,
+        35, 2, 0,
       };
       p = orc_program_new_from_static_bytecode (bc);
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u8);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
 #else
       p = orc_program_new ();
-      orc_program_set_name (p, "video_orc_chroma_down_v4_u8");
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u8);
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u8");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u8);
       orc_program_add_destination (p, 4, "d1");
+      orc_program_add_destination (p, 4, "d2");
+      orc_program_add_destination (p, 4, "d3");
+      orc_program_add_destination (p, 4, "d4");
       orc_program_add_source (p, 4, "s1");
       orc_program_add_source (p, 4, "s2");
       orc_program_add_source (p, 4, "s3");
       orc_program_add_source (p, 4, "s4");
-      orc_program_add_constant (p, 2, 0x00000001, "c1");
-      orc_program_add_constant (p, 2, 0x00000004, "c2");
-      orc_program_add_constant (p, 2, 0x00000003, "c3");
+      orc_program_add_constant (p, 2, 0x00000005, "c1");
+      orc_program_add_constant (p, 2, 0x00000003, "c2");
+      orc_program_add_constant (p, 2, 0x00000004, "c3");
+      orc_program_add_constant (p, 2, 0x00000007, "c4");
       orc_program_add_temporary (p, 2, "t1");
       orc_program_add_temporary (p, 2, "t2");
-      orc_program_add_temporary (p, 4, "t3");
-      orc_program_add_temporary (p, 4, "t4");
+      orc_program_add_temporary (p, 2, "t3");
+      orc_program_add_temporary (p, 2, "t4");
       orc_program_add_temporary (p, 4, "t5");
+      orc_program_add_temporary (p, 4, "t6");
+      orc_program_add_temporary (p, 4, "t7");
+      orc_program_add_temporary (p, 4, "t8");
 
-      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S4,
-          ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S2,
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1lw", 0, ORC_VAR_T2, ORC_VAR_S3,
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T4, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D3, ORC_VAR_T2, ORC_VAR_T4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addw", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S2,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "shlw", 1, ORC_VAR_T4, ORC_VAR_T3, ORC_VAR_C1,
+      orc_program_append_2 (p, "splitlw", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addw", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T3,
+      orc_program_append_2 (p, "convubw", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C2,
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C3,
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T6,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T2, ORC_VAR_T5,
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T3, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mullw", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shruw", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 1, ORC_VAR_T4, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergewl", 0, ORC_VAR_D4, ORC_VAR_T2, ORC_VAR_T4,
           ORC_VAR_D1);
 #endif
 
@@ -31233,6 +34269,9 @@ video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
 
   ex->n = n;
   ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
   ex->arrays[ORC_VAR_S1] = (void *) s1;
   ex->arrays[ORC_VAR_S2] = (void *) s2;
   ex->arrays[ORC_VAR_S3] = (void *) s3;
@@ -31244,276 +34283,548 @@ video_orc_chroma_down_v4_u8 (guint8 * ORC_RESTRICT d1,
 #endif
 
 
-/* video_orc_chroma_down_v4_u16 */
+/* video_orc_chroma_up_vi2_u16 */
 #ifdef DISABLE_ORC
 void
-video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
-    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
-    const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n)
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
 {
   int i;
   orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
   const orc_union64 *ORC_RESTRICT ptr4;
   const orc_union64 *ORC_RESTRICT ptr5;
   const orc_union64 *ORC_RESTRICT ptr6;
   const orc_union64 *ORC_RESTRICT ptr7;
-  orc_union64 var37;
-  orc_union64 var38;
-  orc_union64 var39;
   orc_union64 var40;
+  orc_union64 var41;
 #if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union64 var41;
+  volatile orc_union64 var42;
 #else
-  orc_union64 var41;
-#endif
   orc_union64 var42;
-  orc_union32 var43;
-  orc_union32 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var43;
+#else
+  orc_union64 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var44;
+#else
+  orc_union64 var44;
+#endif
   orc_union64 var45;
-  orc_union32 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
   orc_union64 var47;
   orc_union64 var48;
-  orc_union32 var49;
+  orc_union64 var49;
   orc_union64 var50;
-  orc_union32 var51;
-  orc_union64 var52;
-  orc_union64 var53;
-  orc_union64 var54;
-  orc_union64 var55;
+  orc_union64 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
   orc_union64 var56;
   orc_union64 var57;
   orc_union64 var58;
-  orc_union32 var59;
+  orc_union64 var59;
+  orc_union64 var60;
+  orc_union64 var61;
+  orc_union64 var62;
+  orc_union32 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union32 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union32 var85;
 
   ptr0 = (orc_union64 *) d1;
+  ptr1 = (orc_union64 *) d2;
+  ptr2 = (orc_union64 *) d3;
+  ptr3 = (orc_union64 *) d4;
   ptr4 = (orc_union64 *) s1;
   ptr5 = (orc_union64 *) s2;
   ptr6 = (orc_union64 *) s3;
   ptr7 = (orc_union64 *) s4;
 
+  /* 6: loadpl */
+  var42.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var42.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpl */
+  var43.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var43.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpl */
+  var44.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var44.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
   /* 17: loadpl */
-  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
-  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var46.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var46.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadq */
-    var37 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitql */
     {
       orc_union64 _src;
-      _src.i = var37.i;
-      var43.i = _src.x2[1];
-      var44.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
-    /* 2: convuwl */
-    var45.x2[0] = (orc_uint16) var43.x2[0];
-    var45.x2[1] = (orc_uint16) var43.x2[1];
-    /* 3: loadq */
-    var38 = ptr7[i];
-    /* 4: select1ql */
+    /* 2: loadq */
+    var41 = ptr6[i];
+    /* 3: splitql */
     {
       orc_union64 _src;
-      _src.i = var38.i;
-      var46.i = _src.x2[1];
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
     }
+    /* 4: convuwl */
+    var56.x2[0] = (orc_uint16) var52.x2[0];
+    var56.x2[1] = (orc_uint16) var52.x2[1];
     /* 5: convuwl */
-    var47.x2[0] = (orc_uint16) var46.x2[0];
-    var47.x2[1] = (orc_uint16) var46.x2[1];
-    /* 6: addl */
-    var48.x2[0] = ((orc_uint32) var45.x2[0]) + ((orc_uint32) var47.x2[0]);
-    var48.x2[1] = ((orc_uint32) var45.x2[1]) + ((orc_uint32) var47.x2[1]);
-    /* 7: loadq */
-    var39 = ptr5[i];
-    /* 8: select1ql */
+    var57.x2[0] = (orc_uint16) var54.x2[0];
+    var57.x2[1] = (orc_uint16) var54.x2[1];
+    /* 7: mulll */
+    var58.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var58.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 9: mulll */
+    var59.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var43.x2[0])) & 0xffffffff;
+    var59.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var43.x2[1])) & 0xffffffff;
+    /* 10: addl */
+    var60.x2[0] = ((orc_uint32) var58.x2[0]) + ((orc_uint32) var59.x2[0]);
+    var60.x2[1] = ((orc_uint32) var58.x2[1]) + ((orc_uint32) var59.x2[1]);
+    /* 12: addl */
+    var61.x2[0] = ((orc_uint32) var60.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var61.x2[1] = ((orc_uint32) var60.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 13: shrul */
+    var62.x2[0] = ((orc_uint32) var61.x2[0]) >> 3;
+    var62.x2[1] = ((orc_uint32) var61.x2[1]) >> 3;
+    /* 14: convsuslw */
+    var63.x2[0] = ORC_CLAMP_UW (var62.x2[0]);
+    var63.x2[1] = ORC_CLAMP_UW (var62.x2[1]);
+    /* 15: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var63.i;
+      var45.i = _dest.i;
+    }
+    /* 16: storeq */
+    ptr0[i] = var45;
+    /* 18: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var65.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var56.x2[0]);
+    var65.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var56.x2[1]);
+    /* 20: addl */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 21: shrul */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var68.x2[0] = ORC_CLAMP_UW (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UW (var67.x2[1]);
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var68.i;
+      var47.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr2[i] = var47;
+    /* 25: loadq */
+    var48 = ptr5[i];
+    /* 26: splitql */
     {
       orc_union64 _src;
-      _src.i = var39.i;
-      var49.i = _src.x2[1];
+      _src.i = var48.i;
+      var69.i = _src.x2[1];
+      var70.i = _src.x2[0];
     }
-    /* 9: convuwl */
-    var50.x2[0] = (orc_uint16) var49.x2[0];
-    var50.x2[1] = (orc_uint16) var49.x2[1];
-    /* 10: loadq */
-    var40 = ptr6[i];
-    /* 11: select1ql */
+    /* 27: loadq */
+    var49 = ptr7[i];
+    /* 28: splitql */
     {
       orc_union64 _src;
-      _src.i = var40.i;
-      var51.i = _src.x2[1];
+      _src.i = var49.i;
+      var71.i = _src.x2[1];
+      var72.i = _src.x2[0];
+    }
+    /* 29: convuwl */
+    var73.x2[0] = (orc_uint16) var69.x2[0];
+    var73.x2[1] = (orc_uint16) var69.x2[1];
+    /* 30: convuwl */
+    var74.x2[0] = (orc_uint16) var71.x2[0];
+    var74.x2[1] = (orc_uint16) var71.x2[1];
+    /* 31: mulll */
+    var75.x2[0] =
+        (((orc_uint32) var73.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var75.x2[1] =
+        (((orc_uint32) var73.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var76.x2[0] = ((orc_uint32) var75.x2[0]) + ((orc_uint32) var74.x2[0]);
+    var76.x2[1] = ((orc_uint32) var75.x2[1]) + ((orc_uint32) var74.x2[1]);
+    /* 33: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 34: shrul */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var79.x2[0] = ORC_CLAMP_UW (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UW (var78.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var70.i;
+      _dest.x2[1] = var79.i;
+      var50.i = _dest.i;
     }
-    /* 12: convuwl */
-    var52.x2[0] = (orc_uint16) var51.x2[0];
-    var52.x2[1] = (orc_uint16) var51.x2[1];
-    /* 13: addl */
-    var53.x2[0] = ((orc_uint32) var50.x2[0]) + ((orc_uint32) var52.x2[0]);
-    var53.x2[1] = ((orc_uint32) var50.x2[1]) + ((orc_uint32) var52.x2[1]);
-    /* 14: shll */
-    var54.x2[0] = ((orc_uint32) var53.x2[0]) << 1;
-    var54.x2[1] = ((orc_uint32) var53.x2[1]) << 1;
-    /* 15: addl */
-    var55.x2[0] = ((orc_uint32) var53.x2[0]) + ((orc_uint32) var54.x2[0]);
-    var55.x2[1] = ((orc_uint32) var53.x2[1]) + ((orc_uint32) var54.x2[1]);
-    /* 16: addl */
-    var56.x2[0] = ((orc_uint32) var48.x2[0]) + ((orc_uint32) var55.x2[0]);
-    var56.x2[1] = ((orc_uint32) var48.x2[1]) + ((orc_uint32) var55.x2[1]);
-    /* 18: addl */
-    var57.x2[0] = ((orc_uint32) var56.x2[0]) + ((orc_uint32) var41.x2[0]);
-    var57.x2[1] = ((orc_uint32) var56.x2[1]) + ((orc_uint32) var41.x2[1]);
-    /* 19: shrul */
-    var58.x2[0] = ((orc_uint32) var57.x2[0]) >> 3;
-    var58.x2[1] = ((orc_uint32) var57.x2[1]) >> 3;
-    /* 20: convsuslw */
-    var59.x2[0] = ORC_CLAMP_UW (var58.x2[0]);
-    var59.x2[1] = ORC_CLAMP_UW (var58.x2[1]);
-    /* 21: mergelq */
+    /* 37: storeq */
+    ptr1[i] = var50;
+    /* 38: mulll */
+    var80.x2[0] =
+        (((orc_uint32) var73.x2[0]) * ((orc_uint32) var43.x2[0])) & 0xffffffff;
+    var80.x2[1] =
+        (((orc_uint32) var73.x2[1]) * ((orc_uint32) var43.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var81.x2[0] =
+        (((orc_uint32) var74.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var81.x2[1] =
+        (((orc_uint32) var74.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var82.x2[0] = ((orc_uint32) var80.x2[0]) + ((orc_uint32) var81.x2[0]);
+    var82.x2[1] = ((orc_uint32) var80.x2[1]) + ((orc_uint32) var81.x2[1]);
+    /* 41: addl */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 42: shrul */
+    var84.x2[0] = ((orc_uint32) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint32) var83.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var85.x2[0] = ORC_CLAMP_UW (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UW (var84.x2[1]);
+    /* 44: mergelq */
     {
       orc_union64 _dest;
-      _dest.x2[0] = var44.i;
-      _dest.x2[1] = var59.i;
-      var42.i = _dest.i;
+      _dest.x2[0] = var72.i;
+      _dest.x2[1] = var85.i;
+      var51.i = _dest.i;
     }
-    /* 22: storeq */
-    ptr0[i] = var42;
+    /* 45: storeq */
+    ptr3[i] = var51;
   }
 
 }
 
 #else
 static void
-_backup_video_orc_chroma_down_v4_u16 (OrcExecutor * ORC_RESTRICT ex)
+_backup_video_orc_chroma_up_vi2_u16 (OrcExecutor * ORC_RESTRICT ex)
 {
   int i;
   int n = ex->n;
   orc_union64 *ORC_RESTRICT ptr0;
+  orc_union64 *ORC_RESTRICT ptr1;
+  orc_union64 *ORC_RESTRICT ptr2;
+  orc_union64 *ORC_RESTRICT ptr3;
   const orc_union64 *ORC_RESTRICT ptr4;
   const orc_union64 *ORC_RESTRICT ptr5;
   const orc_union64 *ORC_RESTRICT ptr6;
   const orc_union64 *ORC_RESTRICT ptr7;
-  orc_union64 var37;
-  orc_union64 var38;
-  orc_union64 var39;
   orc_union64 var40;
+  orc_union64 var41;
 #if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
-  volatile orc_union64 var41;
+  volatile orc_union64 var42;
 #else
-  orc_union64 var41;
-#endif
   orc_union64 var42;
-  orc_union32 var43;
-  orc_union32 var44;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var43;
+#else
+  orc_union64 var43;
+#endif
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var44;
+#else
+  orc_union64 var44;
+#endif
   orc_union64 var45;
-  orc_union32 var46;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union64 var46;
+#else
+  orc_union64 var46;
+#endif
   orc_union64 var47;
   orc_union64 var48;
-  orc_union32 var49;
+  orc_union64 var49;
   orc_union64 var50;
-  orc_union32 var51;
-  orc_union64 var52;
-  orc_union64 var53;
-  orc_union64 var54;
-  orc_union64 var55;
+  orc_union64 var51;
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union32 var54;
+  orc_union32 var55;
   orc_union64 var56;
   orc_union64 var57;
   orc_union64 var58;
-  orc_union32 var59;
+  orc_union64 var59;
+  orc_union64 var60;
+  orc_union64 var61;
+  orc_union64 var62;
+  orc_union32 var63;
+  orc_union64 var64;
+  orc_union64 var65;
+  orc_union64 var66;
+  orc_union64 var67;
+  orc_union32 var68;
+  orc_union32 var69;
+  orc_union32 var70;
+  orc_union32 var71;
+  orc_union32 var72;
+  orc_union64 var73;
+  orc_union64 var74;
+  orc_union64 var75;
+  orc_union64 var76;
+  orc_union64 var77;
+  orc_union64 var78;
+  orc_union32 var79;
+  orc_union64 var80;
+  orc_union64 var81;
+  orc_union64 var82;
+  orc_union64 var83;
+  orc_union64 var84;
+  orc_union32 var85;
 
   ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr1 = (orc_union64 *) ex->arrays[1];
+  ptr2 = (orc_union64 *) ex->arrays[2];
+  ptr3 = (orc_union64 *) ex->arrays[3];
   ptr4 = (orc_union64 *) ex->arrays[4];
   ptr5 = (orc_union64 *) ex->arrays[5];
   ptr6 = (orc_union64 *) ex->arrays[6];
   ptr7 = (orc_union64 *) ex->arrays[7];
 
+  /* 6: loadpl */
+  var42.x2[0] = 0x00000005;     /* 5 or 2.47033e-323f */
+  var42.x2[1] = 0x00000005;     /* 5 or 2.47033e-323f */
+  /* 8: loadpl */
+  var43.x2[0] = 0x00000003;     /* 3 or 1.4822e-323f */
+  var43.x2[1] = 0x00000003;     /* 3 or 1.4822e-323f */
+  /* 11: loadpl */
+  var44.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var44.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
   /* 17: loadpl */
-  var41.x2[0] = 0x00000004;     /* 4 or 1.97626e-323f */
-  var41.x2[1] = 0x00000004;     /* 4 or 1.97626e-323f */
+  var46.x2[0] = 0x00000007;     /* 7 or 3.45846e-323f */
+  var46.x2[1] = 0x00000007;     /* 7 or 3.45846e-323f */
 
   for (i = 0; i < n; i++) {
     /* 0: loadq */
-    var37 = ptr4[i];
+    var40 = ptr4[i];
     /* 1: splitql */
     {
       orc_union64 _src;
-      _src.i = var37.i;
-      var43.i = _src.x2[1];
-      var44.i = _src.x2[0];
+      _src.i = var40.i;
+      var52.i = _src.x2[1];
+      var53.i = _src.x2[0];
     }
-    /* 2: convuwl */
-    var45.x2[0] = (orc_uint16) var43.x2[0];
-    var45.x2[1] = (orc_uint16) var43.x2[1];
-    /* 3: loadq */
-    var38 = ptr7[i];
-    /* 4: select1ql */
+    /* 2: loadq */
+    var41 = ptr6[i];
+    /* 3: splitql */
     {
       orc_union64 _src;
-      _src.i = var38.i;
-      var46.i = _src.x2[1];
+      _src.i = var41.i;
+      var54.i = _src.x2[1];
+      var55.i = _src.x2[0];
     }
+    /* 4: convuwl */
+    var56.x2[0] = (orc_uint16) var52.x2[0];
+    var56.x2[1] = (orc_uint16) var52.x2[1];
     /* 5: convuwl */
-    var47.x2[0] = (orc_uint16) var46.x2[0];
-    var47.x2[1] = (orc_uint16) var46.x2[1];
-    /* 6: addl */
-    var48.x2[0] = ((orc_uint32) var45.x2[0]) + ((orc_uint32) var47.x2[0]);
-    var48.x2[1] = ((orc_uint32) var45.x2[1]) + ((orc_uint32) var47.x2[1]);
-    /* 7: loadq */
-    var39 = ptr5[i];
-    /* 8: select1ql */
+    var57.x2[0] = (orc_uint16) var54.x2[0];
+    var57.x2[1] = (orc_uint16) var54.x2[1];
+    /* 7: mulll */
+    var58.x2[0] =
+        (((orc_uint32) var56.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var58.x2[1] =
+        (((orc_uint32) var56.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 9: mulll */
+    var59.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var43.x2[0])) & 0xffffffff;
+    var59.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var43.x2[1])) & 0xffffffff;
+    /* 10: addl */
+    var60.x2[0] = ((orc_uint32) var58.x2[0]) + ((orc_uint32) var59.x2[0]);
+    var60.x2[1] = ((orc_uint32) var58.x2[1]) + ((orc_uint32) var59.x2[1]);
+    /* 12: addl */
+    var61.x2[0] = ((orc_uint32) var60.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var61.x2[1] = ((orc_uint32) var60.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 13: shrul */
+    var62.x2[0] = ((orc_uint32) var61.x2[0]) >> 3;
+    var62.x2[1] = ((orc_uint32) var61.x2[1]) >> 3;
+    /* 14: convsuslw */
+    var63.x2[0] = ORC_CLAMP_UW (var62.x2[0]);
+    var63.x2[1] = ORC_CLAMP_UW (var62.x2[1]);
+    /* 15: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var53.i;
+      _dest.x2[1] = var63.i;
+      var45.i = _dest.i;
+    }
+    /* 16: storeq */
+    ptr0[i] = var45;
+    /* 18: mulll */
+    var64.x2[0] =
+        (((orc_uint32) var57.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var64.x2[1] =
+        (((orc_uint32) var57.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 19: addl */
+    var65.x2[0] = ((orc_uint32) var64.x2[0]) + ((orc_uint32) var56.x2[0]);
+    var65.x2[1] = ((orc_uint32) var64.x2[1]) + ((orc_uint32) var56.x2[1]);
+    /* 20: addl */
+    var66.x2[0] = ((orc_uint32) var65.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var66.x2[1] = ((orc_uint32) var65.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 21: shrul */
+    var67.x2[0] = ((orc_uint32) var66.x2[0]) >> 3;
+    var67.x2[1] = ((orc_uint32) var66.x2[1]) >> 3;
+    /* 22: convsuslw */
+    var68.x2[0] = ORC_CLAMP_UW (var67.x2[0]);
+    var68.x2[1] = ORC_CLAMP_UW (var67.x2[1]);
+    /* 23: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var55.i;
+      _dest.x2[1] = var68.i;
+      var47.i = _dest.i;
+    }
+    /* 24: storeq */
+    ptr2[i] = var47;
+    /* 25: loadq */
+    var48 = ptr5[i];
+    /* 26: splitql */
     {
       orc_union64 _src;
-      _src.i = var39.i;
-      var49.i = _src.x2[1];
+      _src.i = var48.i;
+      var69.i = _src.x2[1];
+      var70.i = _src.x2[0];
     }
-    /* 9: convuwl */
-    var50.x2[0] = (orc_uint16) var49.x2[0];
-    var50.x2[1] = (orc_uint16) var49.x2[1];
-    /* 10: loadq */
-    var40 = ptr6[i];
-    /* 11: select1ql */
+    /* 27: loadq */
+    var49 = ptr7[i];
+    /* 28: splitql */
     {
       orc_union64 _src;
-      _src.i = var40.i;
-      var51.i = _src.x2[1];
+      _src.i = var49.i;
+      var71.i = _src.x2[1];
+      var72.i = _src.x2[0];
+    }
+    /* 29: convuwl */
+    var73.x2[0] = (orc_uint16) var69.x2[0];
+    var73.x2[1] = (orc_uint16) var69.x2[1];
+    /* 30: convuwl */
+    var74.x2[0] = (orc_uint16) var71.x2[0];
+    var74.x2[1] = (orc_uint16) var71.x2[1];
+    /* 31: mulll */
+    var75.x2[0] =
+        (((orc_uint32) var73.x2[0]) * ((orc_uint32) var46.x2[0])) & 0xffffffff;
+    var75.x2[1] =
+        (((orc_uint32) var73.x2[1]) * ((orc_uint32) var46.x2[1])) & 0xffffffff;
+    /* 32: addl */
+    var76.x2[0] = ((orc_uint32) var75.x2[0]) + ((orc_uint32) var74.x2[0]);
+    var76.x2[1] = ((orc_uint32) var75.x2[1]) + ((orc_uint32) var74.x2[1]);
+    /* 33: addl */
+    var77.x2[0] = ((orc_uint32) var76.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var77.x2[1] = ((orc_uint32) var76.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 34: shrul */
+    var78.x2[0] = ((orc_uint32) var77.x2[0]) >> 3;
+    var78.x2[1] = ((orc_uint32) var77.x2[1]) >> 3;
+    /* 35: convsuslw */
+    var79.x2[0] = ORC_CLAMP_UW (var78.x2[0]);
+    var79.x2[1] = ORC_CLAMP_UW (var78.x2[1]);
+    /* 36: mergelq */
+    {
+      orc_union64 _dest;
+      _dest.x2[0] = var70.i;
+      _dest.x2[1] = var79.i;
+      var50.i = _dest.i;
     }
-    /* 12: convuwl */
-    var52.x2[0] = (orc_uint16) var51.x2[0];
-    var52.x2[1] = (orc_uint16) var51.x2[1];
-    /* 13: addl */
-    var53.x2[0] = ((orc_uint32) var50.x2[0]) + ((orc_uint32) var52.x2[0]);
-    var53.x2[1] = ((orc_uint32) var50.x2[1]) + ((orc_uint32) var52.x2[1]);
-    /* 14: shll */
-    var54.x2[0] = ((orc_uint32) var53.x2[0]) << 1;
-    var54.x2[1] = ((orc_uint32) var53.x2[1]) << 1;
-    /* 15: addl */
-    var55.x2[0] = ((orc_uint32) var53.x2[0]) + ((orc_uint32) var54.x2[0]);
-    var55.x2[1] = ((orc_uint32) var53.x2[1]) + ((orc_uint32) var54.x2[1]);
-    /* 16: addl */
-    var56.x2[0] = ((orc_uint32) var48.x2[0]) + ((orc_uint32) var55.x2[0]);
-    var56.x2[1] = ((orc_uint32) var48.x2[1]) + ((orc_uint32) var55.x2[1]);
-    /* 18: addl */
-    var57.x2[0] = ((orc_uint32) var56.x2[0]) + ((orc_uint32) var41.x2[0]);
-    var57.x2[1] = ((orc_uint32) var56.x2[1]) + ((orc_uint32) var41.x2[1]);
-    /* 19: shrul */
-    var58.x2[0] = ((orc_uint32) var57.x2[0]) >> 3;
-    var58.x2[1] = ((orc_uint32) var57.x2[1]) >> 3;
-    /* 20: convsuslw */
-    var59.x2[0] = ORC_CLAMP_UW (var58.x2[0]);
-    var59.x2[1] = ORC_CLAMP_UW (var58.x2[1]);
-    /* 21: mergelq */
+    /* 37: storeq */
+    ptr1[i] = var50;
+    /* 38: mulll */
+    var80.x2[0] =
+        (((orc_uint32) var73.x2[0]) * ((orc_uint32) var43.x2[0])) & 0xffffffff;
+    var80.x2[1] =
+        (((orc_uint32) var73.x2[1]) * ((orc_uint32) var43.x2[1])) & 0xffffffff;
+    /* 39: mulll */
+    var81.x2[0] =
+        (((orc_uint32) var74.x2[0]) * ((orc_uint32) var42.x2[0])) & 0xffffffff;
+    var81.x2[1] =
+        (((orc_uint32) var74.x2[1]) * ((orc_uint32) var42.x2[1])) & 0xffffffff;
+    /* 40: addl */
+    var82.x2[0] = ((orc_uint32) var80.x2[0]) + ((orc_uint32) var81.x2[0]);
+    var82.x2[1] = ((orc_uint32) var80.x2[1]) + ((orc_uint32) var81.x2[1]);
+    /* 41: addl */
+    var83.x2[0] = ((orc_uint32) var82.x2[0]) + ((orc_uint32) var44.x2[0]);
+    var83.x2[1] = ((orc_uint32) var82.x2[1]) + ((orc_uint32) var44.x2[1]);
+    /* 42: shrul */
+    var84.x2[0] = ((orc_uint32) var83.x2[0]) >> 3;
+    var84.x2[1] = ((orc_uint32) var83.x2[1]) >> 3;
+    /* 43: convsuslw */
+    var85.x2[0] = ORC_CLAMP_UW (var84.x2[0]);
+    var85.x2[1] = ORC_CLAMP_UW (var84.x2[1]);
+    /* 44: mergelq */
     {
       orc_union64 _dest;
-      _dest.x2[0] = var44.i;
-      _dest.x2[1] = var59.i;
-      var42.i = _dest.i;
+      _dest.x2[0] = var72.i;
+      _dest.x2[1] = var85.i;
+      var51.i = _dest.i;
     }
-    /* 22: storeq */
-    ptr0[i] = var42;
+    /* 45: storeq */
+    ptr3[i] = var51;
   }
 
 }
 
 void
-video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
-    const guint16 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2,
-    const guint16 * ORC_RESTRICT s3, const guint16 * ORC_RESTRICT s4, int n)
+video_orc_chroma_up_vi2_u16 (guint16 * ORC_RESTRICT d1,
+    guint16 * ORC_RESTRICT d2, guint16 * ORC_RESTRICT d3,
+    guint16 * ORC_RESTRICT d4, const guint16 * ORC_RESTRICT s1,
+    const guint16 * ORC_RESTRICT s2, const guint16 * ORC_RESTRICT s3,
+    const guint16 * ORC_RESTRICT s4, int n)
 {
   OrcExecutor _ex, *ex = &_ex;
   static volatile int p_inited = 0;
@@ -31527,71 +34838,119 @@ video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
 
 #if 1
       static const orc_uint8 bc[] = {
-        1, 9, 28, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
-        111, 109, 97, 95, 100, 111, 119, 110, 95, 118, 52, 95, 117, 49, 54, 11,
-        8, 8, 12, 8, 8, 12, 8, 8, 12, 8, 8, 12, 8, 8, 14, 4,
-        1, 0, 0, 0, 14, 4, 4, 0, 0, 0, 14, 4, 3, 0, 0, 0,
-        20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 197, 33, 32, 4, 21, 1,
-        154, 34, 33, 193, 33, 7, 21, 1, 154, 35, 33, 21, 1, 103, 36, 34,
-        35, 193, 33, 5, 21, 1, 154, 34, 33, 193, 33, 6, 21, 1, 154, 35,
-        33, 21, 1, 103, 34, 34, 35, 21, 1, 124, 35, 34, 16, 21, 1, 103,
-        34, 34, 35, 21, 1, 103, 36, 36, 34, 21, 1, 103, 36, 36, 17, 21,
-        1, 126, 36, 36, 18, 21, 1, 166, 33, 36, 194, 0, 32, 33, 2, 0,
-
+        1, 9, 27, 118, 105, 100, 101, 111, 95, 111, 114, 99, 95, 99, 104, 114,
+        111, 109, 97, 95, 117, 112, 95, 118, 105, 50, 95, 117, 49, 54, 11, 8,
+        8, 11, 8, 8, 11, 8, 8, 11, 8, 8, 12, 8, 8, 12, 8, 8,
+        12, 8, 8, 12, 8, 8, 14, 4, 5, 0, 0, 0, 14, 4, 3, 0,
+        0, 0, 14, 4, 4, 0, 0, 0, 14, 4, 7, 0, 0, 0, 20, 4,
+        20, 4, 20, 4, 20, 4, 20, 8, 20, 8, 20, 8, 20, 8, 197, 34,
+        32, 4, 197, 35, 33, 6, 21, 1, 154, 36, 34, 21, 1, 154, 37, 35,
+        21, 1, 120, 38, 36, 16, 21, 1, 120, 39, 37, 17, 21, 1, 103, 38,
+        38, 39, 21, 1, 103, 38, 38, 18, 21, 1, 126, 38, 38, 17, 21, 1,
+        166, 34, 38, 194, 0, 32, 34, 21, 1, 120, 38, 37, 19, 21, 1, 103,
+        38, 38, 36, 21, 1, 103, 38, 38, 18, 21, 1, 126, 38, 38, 17, 21,
+        1, 166, 35, 38, 194, 2, 33, 35, 197, 34, 32, 5, 197, 35, 33, 7,
+        21, 1, 154, 36, 34, 21, 1, 154, 37, 35, 21, 1, 120, 38, 36, 19,
+        21, 1, 103, 38, 38, 37, 21, 1, 103, 38, 38, 18, 21, 1, 126, 38,
+        38, 17, 21, 1, 166, 34, 38, 194, 1, 32, 34, 21, 1, 120, 38, 36,
+        17, 21, 1, 120, 39, 37, 16, 21, 1, 103, 38, 38, 39, 21, 1, 103,
+        38, 38, 18, 21, 1, 126, 38, 38, 17, 21, 1, 166, 35, 38, 194, 3,
+        33, 35, 2, 0,
       };
       p = orc_program_new_from_static_bytecode (bc);
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u16);
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
 #else
       p = orc_program_new ();
-      orc_program_set_name (p, "video_orc_chroma_down_v4_u16");
-      orc_program_set_backup_function (p, _backup_video_orc_chroma_down_v4_u16);
+      orc_program_set_name (p, "video_orc_chroma_up_vi2_u16");
+      orc_program_set_backup_function (p, _backup_video_orc_chroma_up_vi2_u16);
       orc_program_add_destination (p, 8, "d1");
+      orc_program_add_destination (p, 8, "d2");
+      orc_program_add_destination (p, 8, "d3");
+      orc_program_add_destination (p, 8, "d4");
       orc_program_add_source (p, 8, "s1");
       orc_program_add_source (p, 8, "s2");
       orc_program_add_source (p, 8, "s3");
       orc_program_add_source (p, 8, "s4");
-      orc_program_add_constant (p, 4, 0x00000001, "c1");
-      orc_program_add_constant (p, 4, 0x00000004, "c2");
-      orc_program_add_constant (p, 4, 0x00000003, "c3");
+      orc_program_add_constant (p, 4, 0x00000005, "c1");
+      orc_program_add_constant (p, 4, 0x00000003, "c2");
+      orc_program_add_constant (p, 4, 0x00000004, "c3");
+      orc_program_add_constant (p, 4, 0x00000007, "c4");
       orc_program_add_temporary (p, 4, "t1");
       orc_program_add_temporary (p, 4, "t2");
-      orc_program_add_temporary (p, 8, "t3");
-      orc_program_add_temporary (p, 8, "t4");
+      orc_program_add_temporary (p, 4, "t3");
+      orc_program_add_temporary (p, 4, "t4");
       orc_program_add_temporary (p, 8, "t5");
+      orc_program_add_temporary (p, 8, "t6");
+      orc_program_add_temporary (p, 8, "t7");
+      orc_program_add_temporary (p, 8, "t8");
 
-      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_S1,
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S4,
-          ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S2,
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T3,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "select1ql", 0, ORC_VAR_T2, ORC_VAR_S3,
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T6, ORC_VAR_C4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T5,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T4, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_D1,
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D3, ORC_VAR_T2, ORC_VAR_T4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addl", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_S2,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "shll", 1, ORC_VAR_T4, ORC_VAR_T3, ORC_VAR_C1,
+      orc_program_append_2 (p, "splitql", 0, ORC_VAR_T4, ORC_VAR_T2, ORC_VAR_S4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addl", 1, ORC_VAR_T3, ORC_VAR_T3, ORC_VAR_T4,
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T5, ORC_VAR_T3, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_T3,
+      orc_program_append_2 (p, "convuwl", 1, ORC_VAR_T6, ORC_VAR_T4, ORC_VAR_D1,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "addl", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C2,
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C4,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T5, ORC_VAR_T5, ORC_VAR_C3,
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T6,
           ORC_VAR_D1);
-      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T2, ORC_VAR_T5,
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T3, ORC_VAR_T7,
           ORC_VAR_D1, ORC_VAR_D1);
-      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D2, ORC_VAR_T1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T7, ORC_VAR_T5, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulll", 1, ORC_VAR_T8, ORC_VAR_T6, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_T8,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrul", 1, ORC_VAR_T7, ORC_VAR_T7, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuslw", 1, ORC_VAR_T4, ORC_VAR_T7,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "mergelq", 0, ORC_VAR_D4, ORC_VAR_T2, ORC_VAR_T4,
           ORC_VAR_D1);
 #endif
 
@@ -31607,6 +34966,9 @@ video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
 
   ex->n = n;
   ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_D2] = d2;
+  ex->arrays[ORC_VAR_D3] = d3;
+  ex->arrays[ORC_VAR_D4] = d4;
   ex->arrays[ORC_VAR_S1] = (void *) s1;
   ex->arrays[ORC_VAR_S2] = (void *) s2;
   ex->arrays[ORC_VAR_S3] = (void *) s3;
@@ -31617,7 +34979,6 @@ video_orc_chroma_down_v4_u16 (guint16 * ORC_RESTRICT d1,
 }
 #endif
 
-
 /* video_orc_dither_none_4u8_mask */
 #ifdef DISABLE_ORC
 void
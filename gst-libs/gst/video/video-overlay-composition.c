@@ -60,6 +60,7 @@
 
 #include "video-overlay-composition.h"
 #include "video-blend.h"
+#include "gstvideoutilsprivate.h"
 #include "gstvideometa.h"
 #include <string.h>
 
@@ -119,6 +120,14 @@ struct _GstVideoOverlayRectangle
    * rectangles have expired. */
   guint seq_num;
 
+  /* sequence number of the pixel data, shared with copies of the rectangle
+   * as they share the pixels. Used as key for the scale cache */
+  guint pixels_seq_num;
+
+  /* non-transparent part of each line of the pixels, computed on the first
+   * blend and cleared when the pixels change. Protected by the lock */
+  GBytes *coverage;
+
   /* global alpha: global alpha value of the rectangle. Each each per-pixel
    * alpha value of image-data will be multiplied with the global alpha value
    * during blending.
@@ -179,6 +188,224 @@ gst_video_overlay_get_seqnum (void)
   return (guint) g_atomic_int_add (&seqnum, 1);
 }
 
+/* ------------------------------ scale cache ------------------------------ */
+
+/* Rectangle pixels scaled to their render size for blending, shared between
+ * all compositions and kept in least-recently-used order. The pixels of a
+ * rectangle never change after creation, so entries don't need to be
+ * invalidated and just age out of the cache. */
+
+#define DEFAULT_SCALE_CACHE_SIZE (32 * 1024 * 1024)
+
+typedef struct
+{
+  guint pixels_seq_num;
+  guint width, height;
+  GstVideoFormat format;
+  gboolean premultiplied;
+  gfloat applied_global_alpha;
+} ScaleCacheKey;
+
+typedef struct
+{
+  ScaleCacheKey key;
+  GstVideoInfo info;
+  GstBuffer *pixels;
+  GBytes *coverage;
+  gsize size;
+  GList link;                   /* in scale_cache_lru */
+} ScaleCacheEntry;
+
+G_LOCK_DEFINE_STATIC (scale_cache);
+static GHashTable *scale_cache;
+static GQueue scale_cache_lru = G_QUEUE_INIT;   /* most recently used first */
+static gsize scale_cache_size;
+static gsize scale_cache_max_size = DEFAULT_SCALE_CACHE_SIZE;
+static guint64 scale_cache_hits;
+static guint64 scale_cache_misses;
+static guint64 scale_cache_evictions;
+
+static guint
+scale_cache_key_hash (gconstpointer key)
+{
+  const ScaleCacheKey *k = key;
+
+  return k->pixels_seq_num ^ (k->width << 16) ^ k->height ^
+      ((guint) k->format << 24) ^ ((guint) k->premultiplied << 31);
+}
+
+static gboolean
+scale_cache_key_equal (gconstpointer a, gconstpointer b)
+{
+  const ScaleCacheKey *ka = a, *kb = b;
+
+  return ka->pixels_seq_num == kb->pixels_seq_num &&
+      ka->width == kb->width && ka->height == kb->height &&
+      ka->format == kb->format && ka->premultiplied == kb->premultiplied &&
+      ka->applied_global_alpha == kb->applied_global_alpha;
+}
+
+static void
+scale_cache_entry_free (ScaleCacheEntry * entry)
+{
+  gst_buffer_unref (entry->pixels);
+  if (entry->coverage)
+    g_bytes_unref (entry->coverage);
+  g_slice_free (ScaleCacheEntry, entry);
+}
+
+/* must be called with the scale_cache lock */
+static void
+scale_cache_evict (gsize max_size)
+{
+  while (scale_cache_size > max_size && scale_cache_lru.tail) {
+    ScaleCacheEntry *entry = scale_cache_lru.tail->data;
+
+    g_queue_unlink (&scale_cache_lru, &entry->link);
+    scale_cache_size -= entry->size;
+    scale_cache_evictions++;
+    g_hash_table_remove (scale_cache, &entry->key);
+  }
+}
+
+static GBytes *
+compute_coverage (GstVideoInfo * info, GstBuffer * pixels)
+{
+  GstVideoFrame frame;
+  GBytes *coverage;
+
+  if (!gst_video_frame_map (&frame, info, pixels, GST_MAP_READ))
+    return NULL;
+  coverage = __gst_video_blend_compute_coverage (&frame);
+  gst_video_frame_unmap (&frame);
+
+  return coverage;
+}
+
+/* Returns the pixels of @rect scaled to the render size and their coverage,
+ * taken from the cache when possible */
+static GstBuffer *
+gst_video_overlay_rectangle_get_scaled_pixels (GstVideoOverlayRectangle *
+    rect, GstVideoInfo * scaled_info, GBytes ** coverage)
+{
+  ScaleCacheEntry *entry;
+  ScaleCacheKey key;
+  GstBuffer *pixels;
+
+  key.pixels_seq_num = rect->pixels_seq_num;
+  key.width = rect->render_width;
+  key.height = rect->render_height;
+  key.format = GST_VIDEO_INFO_FORMAT (&rect->info);
+  key.premultiplied =
+      ! !(rect->flags & GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA);
+  key.applied_global_alpha = rect->applied_global_alpha;
+
+  G_LOCK (scale_cache);
+  if (scale_cache
+      && (entry = g_hash_table_lookup (scale_cache, &key)) != NULL) {
+    g_queue_unlink (&scale_cache_lru, &entry->link);
+    g_queue_push_head_link (&scale_cache_lru, &entry->link);
+    scale_cache_hits++;
+    *scaled_info = entry->info;
+    pixels = gst_buffer_ref (entry->pixels);
+    *coverage = entry->coverage ? g_bytes_ref (entry->coverage) : NULL;
+    G_UNLOCK (scale_cache);
+    return pixels;
+  }
+  scale_cache_misses++;
+  G_UNLOCK (scale_cache);
+
+  gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
+      rect->render_height, rect->render_width, scaled_info, &pixels);
+  *coverage = compute_coverage (scaled_info, pixels);
+
+  entry = g_slice_new0 (ScaleCacheEntry);
+  entry->key = key;
+  entry->info = *scaled_info;
+  entry->pixels = gst_buffer_ref (pixels);
+  entry->coverage = *coverage ? g_bytes_ref (*coverage) : NULL;
+  entry->size = gst_buffer_get_size (pixels);
+  entry->link.data = entry;
+
+  G_LOCK (scale_cache);
+  if (entry->size > scale_cache_max_size) {
+    /* would evict everything else, don't cache */
+    G_UNLOCK (scale_cache);
+    scale_cache_entry_free (entry);
+    return pixels;
+  }
+  if (scale_cache == NULL)
+    scale_cache = g_hash_table_new_full (scale_cache_key_hash,
+        scale_cache_key_equal, NULL, (GDestroyNotify) scale_cache_entry_free);
+  if (g_hash_table_contains (scale_cache, &key)) {
+    /* another thread scaled the same rectangle in the meantime */
+    G_UNLOCK (scale_cache);
+    scale_cache_entry_free (entry);
+    return pixels;
+  }
+  scale_cache_evict (scale_cache_max_size - entry->size);
+  g_hash_table_insert (scale_cache, &entry->key, entry);
+  g_queue_push_head_link (&scale_cache_lru, &entry->link);
+  scale_cache_size += entry->size;
+  G_UNLOCK (scale_cache);
+
+  return pixels;
+}
+
+/**
+ * gst_video_overlay_composition_set_scale_cache_size:
+ * @max_size: maximum size of the cache in bytes, 0 disables the cache
+ *
+ * gst_video_overlay_composition_blend() keeps the pixels of rectangles
+ * scaled to their render size in a cache that is shared by all
+ * compositions, so that the same rectangle is not scaled again for every
+ * frame. This sets the maximum amount of pixel data kept in that cache,
+ * least recently used pixels are dropped first. The default is 32 MiB.
+ *
+ * Since: 1.16
+ */
+void
+gst_video_overlay_composition_set_scale_cache_size (gsize max_size)
+{
+  G_LOCK (scale_cache);
+  scale_cache_max_size = max_size;
+  scale_cache_evict (max_size);
+  G_UNLOCK (scale_cache);
+}
+
+/**
+ * gst_video_overlay_composition_get_scale_cache_stats:
+ *
+ * Returns statistics about the cache of scaled rectangle pixels used by
+ * gst_video_overlay_composition_blend(), see
+ * gst_video_overlay_composition_set_scale_cache_size(). The structure
+ * contains the number of cached rectangles in "entries", their size in
+ * "size" and the maximum size in "max-size" (#guint64, bytes) and the
+ * "hits", "misses" and "evictions" (#guint64) since the start of the
+ * process.
+ *
+ * Returns: (transfer full): a new #GstStructure with the statistics
+ *
+ * Since: 1.16
+ */
+GstStructure *
+gst_video_overlay_composition_get_scale_cache_stats (void)
+{
+  GstStructure *s;
+
+  G_LOCK (scale_cache);
+  s = gst_structure_new ("GstVideoOverlayScaleCacheStats",
+      "entries", G_TYPE_UINT, scale_cache_lru.length,
+      "size", G_TYPE_UINT64, (guint64) scale_cache_size,
+      "max-size", G_TYPE_UINT64, (guint64) scale_cache_max_size,
+      "hits", G_TYPE_UINT64, scale_cache_hits,
+      "misses", G_TYPE_UINT64, scale_cache_misses,
+      "evictions", G_TYPE_UINT64, scale_cache_evictions, NULL);
+  G_UNLOCK (scale_cache);
+
+  return s;
+}
+
 static gboolean
 gst_video_overlay_composition_meta_init (GstMeta * meta, gpointer params,
     GstBuffer * buf)
@@ -478,6 +705,7 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   GstVideoFrame rectangle_frame;
   GstVideoFormat fmt;
   GstBuffer *pixels = NULL;
+  GBytes *coverage;
   gboolean ret = TRUE;
   guint n, num;
   int w, h;
@@ -505,24 +733,31 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
 
     needs_scaling = gst_video_overlay_rectangle_needs_scaling (rect);
     if (needs_scaling) {
-      gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
-          rect->render_height, rect->render_width, &scaled_info, &pixels);
+      pixels = gst_video_overlay_rectangle_get_scaled_pixels (rect,
+          &scaled_info, &coverage);
       vinfo = &scaled_info;
     } else {
+      GST_RECTANGLE_LOCK (rect);
       pixels = gst_buffer_ref (rect->pixels);
+      if (rect->coverage == NULL)
+        rect->coverage = compute_coverage (&rect->info, pixels);
+      coverage = rect->coverage ? g_bytes_ref (rect->coverage) : NULL;
+      GST_RECTANGLE_UNLOCK (rect);
       vinfo = &rect->info;
     }
 
     gst_video_frame_map (&rectangle_frame, vinfo, pixels, GST_MAP_READ);
 
-    ret = gst_video_blend (video_buf, &rectangle_frame, rect->x, rect->y,
-        rect->global_alpha);
+    /* the transparent parts of the rectangle are skipped */
+    ret = __gst_video_blend_with_coverage (video_buf, &rectangle_frame,
+        rect->x, rect->y, rect->global_alpha, coverage);
     gst_video_frame_unmap (&rectangle_frame);
     if (!ret) {
       GST_WARNING ("Could not blend overlay rectangle onto video buffer");
     }
 
-    /* FIXME: should cache scaled pixels in the rectangle struct */
+    if (coverage)
+      g_bytes_unref (coverage);
     gst_buffer_unref (pixels);
   }
 
@@ -649,6 +884,8 @@ gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
   }
 
   g_free (rect->initial_alpha);
+  if (rect->coverage)
+    g_bytes_unref (rect->coverage);
   g_mutex_clear (&rect->lock);
 
   g_slice_free (GstVideoOverlayRectangle, rect);
@@ -762,6 +999,7 @@ gst_video_overlay_rectangle_new_raw (GstBuffer * pixels,
   rect->flags = flags;
 
   rect->seq_num = gst_video_overlay_get_seqnum ();
+  rect->pixels_seq_num = rect->seq_num;
 
   GST_LOG ("new rectangle %p: %ux%u => %ux%u @ %u,%u, seq_num %u, format %u, "
       "flags %x, pixels %p, global_alpha=%f", rect, width, height, render_width,
@@ -1055,6 +1293,12 @@ gst_video_overlay_rectangle_apply_global_alpha (GstVideoOverlayRectangle * rect,
   gst_video_frame_unmap (&frame);
 
   rect->applied_global_alpha = global_alpha;
+
+  /* the coverage is outdated now, the caller holds the rectangle lock */
+  if (rect->coverage) {
+    g_bytes_unref (rect->coverage);
+    rect->coverage = NULL;
+  }
 }
 
 static void
@@ -1589,6 +1833,7 @@ gst_video_overlay_rectangle_copy (GstVideoOverlayRectangle * rectangle)
   if (rectangle->global_alpha != 1)
     gst_video_overlay_rectangle_set_global_alpha (copy,
         rectangle->global_alpha);
+  copy->pixels_seq_num = rectangle->pixels_seq_num;
 
   return copy;
 }
@@ -266,6 +266,12 @@ GST_VIDEO_API
 gboolean                     gst_video_overlay_composition_blend         (GstVideoOverlayComposition * comp,
                                                                           GstVideoFrame              * video_buf);
 
+GST_VIDEO_API
+void                         gst_video_overlay_composition_set_scale_cache_size  (gsize max_size);
+
+GST_VIDEO_API
+GstStructure *               gst_video_overlay_composition_get_scale_cache_stats (void);
+
 /* attach/retrieve composition from buffers */
 
 #define GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE \
@@ -76,6 +76,9 @@ ensure_debug_category (void)
 
 #define LQ
 
+/* output pixels per block in the horizontal n-tap functions */
+#define H_NTAP_BLOCK      256
+
 typedef void (*GstVideoScalerHFunc) (GstVideoScaler * scale,
     gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems);
 typedef void (*GstVideoScalerVFunc) (GstVideoScaler * scale,
@@ -614,131 +617,123 @@ video_scale_h_2tap_4u8 (GstVideoScaler * scale,
 }
 
 static void
-video_scale_h_ntap_u8 (GstVideoScaler * scale,
-    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
+video_scale_h_ntap_u8_block (GstVideoScaler * scale, gpointer src,
+    gpointer d, guint dest_offset, guint width, guint n_elems)
 {
   gint16 *taps;
-  gint i, max_taps, count;
-  gpointer d;
+  gint i, j, max_taps, count, out_size, tstride;
   guint32 *offset_n;
   guint8 *pixels;
   gint16 *temp;
 
-  if (scale->taps_s16 == NULL)
-#ifdef LQ
-    make_s16_taps (scale, n_elems, SCALE_U8_LQ);
-#else
-    make_s16_taps (scale, n_elems, SCALE_U8);
-#endif
-
   max_taps = scale->resampler.max_taps;
-  offset_n = scale->offset_n;
+  out_size = scale->resampler.out_size;
+  offset_n = scale->offset_n + dest_offset;
 
   pixels = (guint8 *) scale->tmpline1;
 
-  /* prepare the arrays */
-  count = width * max_taps;
-  switch (n_elems) {
-    case 1:
-    {
-      guint8 *s = (guint8 *) src;
-
-      for (i = 0; i < count; i++)
-        pixels[i] = s[offset_n[i]];
+  /* prepare the arrays, the offsets and taps are stored per tap for the
+   * complete output line, gather the pixels of this block per tap */
+  for (j = 0; j < max_taps; j++) {
+    guint32 *o = offset_n + j * out_size;
 
-      d = (guint8 *) dest + dest_offset;
-      break;
-    }
-    case 2:
-    {
-      guint16 *p16 = (guint16 *) pixels;
-      guint16 *s = (guint16 *) src;
+    switch (n_elems) {
+      case 1:
+      {
+        guint8 *p = pixels + j * width;
+        guint8 *s = (guint8 *) src;
 
-      for (i = 0; i < count; i++)
-        p16[i] = s[offset_n[i]];
+        for (i = 0; i < width; i++)
+          p[i] = s[o[i]];
+        break;
+      }
+      case 2:
+      {
+        guint16 *p16 = (guint16 *) pixels + j * width;
+        guint16 *s = (guint16 *) src;
 
-      d = (guint16 *) dest + dest_offset;
-      break;
-    }
-    case 3:
-    {
-      guint8 *s = (guint8 *) src;
+        for (i = 0; i < width; i++)
+          p16[i] = s[o[i]];
+        break;
+      }
+      case 3:
+      {
+        guint8 *p = pixels + j * width * 3;
+        guint8 *s = (guint8 *) src;
+
+        for (i = 0; i < width; i++) {
+          gint k = o[i] * 3;
+          p[i * 3 + 0] = s[k + 0];
+          p[i * 3 + 1] = s[k + 1];
+          p[i * 3 + 2] = s[k + 2];
+        }
+        break;
+      }
+      case 4:
+      {
+        guint32 *p32 = (guint32 *) pixels + j * width;
+        guint32 *s = (guint32 *) src;
 
-      for (i = 0; i < count; i++) {
-        gint j = offset_n[i] * 3;
-        pixels[i * 3 + 0] = s[j + 0];
-        pixels[i * 3 + 1] = s[j + 1];
-        pixels[i * 3 + 2] = s[j + 2];
+        for (i = 0; i < width; i++)
+          p32[i] = s[o[i]];
+        break;
       }
-      d = (guint8 *) dest + dest_offset * 3;
-      break;
-    }
-    case 4:
-    {
-      guint32 *p32 = (guint32 *) pixels;
-      guint32 *s = (guint32 *) src;
-#if 0
-      video_orc_resample_h_near_u32 (p32, s, offset_n, count);
-#else
-      for (i = 0; i < count; i++)
-        p32[i] = s[offset_n[i]];
-#endif
-      d = (guint32 *) dest + dest_offset;
-      break;
+      default:
+        return;
     }
-    default:
-      return;
   }
   temp = (gint16 *) scale->tmpline2;
-  taps = scale->taps_s16_4;
+  taps = scale->taps_s16_4 + dest_offset * n_elems;
+  tstride = out_size * n_elems;
   count = width * n_elems;
 
 #ifdef LQ
   if (max_taps == 2) {
     video_orc_resample_h_2tap_u8_lq (d, pixels, pixels + count, taps,
-        taps + count, count);
+        taps + tstride, count);
   } else {
     /* first pixels with first tap to temp */
     if (max_taps >= 3) {
       video_orc_resample_h_multaps3_u8_lq (temp, pixels, pixels + count,
-          pixels + count * 2, taps, taps + count, taps + count * 2, count);
+          pixels + count * 2, taps, taps + tstride, taps + tstride * 2, count);
       max_taps -= 3;
       pixels += count * 3;
-      taps += count * 3;
+      taps += tstride * 3;
     } else {
       gint first = max_taps % 3;
 
       video_orc_resample_h_multaps_u8_lq (temp, pixels, taps, count);
       video_orc_resample_h_muladdtaps_u8_lq (temp, 0, pixels + count, count,
-          taps + count, count * 2, count, first - 1);
+          taps + tstride, tstride * 2, count, first - 1);
       max_taps -= first;
       pixels += count * first;
-      taps += count * first;
+      taps += tstride * first;
     }
     while (max_taps > 3) {
       if (max_taps >= 6) {
         video_orc_resample_h_muladdtaps3_u8_lq (temp, pixels, pixels + count,
-            pixels + count * 2, taps, taps + count, taps + count * 2, count);
+            pixels + count * 2, taps, taps + tstride, taps + tstride * 2,
+            count);
         max_taps -= 3;
         pixels += count * 3;
-        taps += count * 3;
+        taps += tstride * 3;
       } else {
         video_orc_resample_h_muladdtaps_u8_lq (temp, 0, pixels, count,
-            taps, count * 2, count, max_taps - 3);
+            taps, tstride * 2, count, max_taps - 3);
         pixels += count * (max_taps - 3);
-        taps += count * (max_taps - 3);
+        taps += tstride * (max_taps - 3);
         max_taps = 3;
       }
     }
     if (max_taps == 3) {
       video_orc_resample_h_muladdscaletaps3_u8_lq (d, pixels, pixels + count,
-          pixels + count * 2, taps, taps + count, taps + count * 2, temp,
+          pixels + count * 2, taps, taps + tstride, taps + tstride * 2, temp,
           count);
     } else {
       if (max_taps) {
         /* add other pixels with other taps to t4 */
         video_orc_resample_h_muladdtaps_u8_lq (temp, 0, pixels, count,
-            taps, count * 2, count, max_taps);
+            taps, tstride * 2, count, max_taps);
       }
       /* scale and write final result */
       video_orc_resample_scaletaps_u8_lq (d, temp, count);
@@ -749,12 +744,38 @@ video_scale_h_ntap_u8 (GstVideoScaler * scale,
   video_orc_resample_h_multaps_u8 (temp, pixels, taps, count);
   /* add other pixels with other taps to t4 */
   video_orc_resample_h_muladdtaps_u8 (temp, 0, pixels + count, count,
-      taps + count, count * 2, count, max_taps - 1);
+      taps + tstride, tstride * 2, count, max_taps - 1);
   /* scale and write final result */
   video_orc_resample_scaletaps_u8 (d, temp, count);
 #endif
 }
 
+static void
+video_scale_h_ntap_u8 (GstVideoScaler * scale,
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
+{
+  guint i;
+  guint8 *d;
+
+  if (scale->taps_s16 == NULL)
+#ifdef LQ
+    make_s16_taps (scale, n_elems, SCALE_U8_LQ);
+#else
+    make_s16_taps (scale, n_elems, SCALE_U8);
+#endif
+
+  d = (guint8 *) dest + dest_offset * n_elems;
+
+  /* process the line in blocks so that the gathered pixels and the
+   * intermediate sums stay in the cache for all the taps */
+  for (i = 0; i < width; i += H_NTAP_BLOCK) {
+    guint w = MIN (H_NTAP_BLOCK, width - i);
+
+    video_scale_h_ntap_u8_block (scale, src, d + i * n_elems,
+        dest_offset + i, w, n_elems);
+  }
+}
+
 static void
 video_scale_h_ntap_u16 (GstVideoScaler * scale,
     gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
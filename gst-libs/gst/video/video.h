@@ -161,6 +161,29 @@ GstSample *   gst_video_convert_sample       (GstSample     * sample,
                                               GstClockTime    timeout,
                                               GError       ** error);
 
+/**
+ * GstVideoSampleConverter:
+ *
+ * Opaque structure for converting many samples with the same caps, see
+ * gst_video_sample_converter_new().
+ *
+ * Since: 1.16
+ */
+typedef struct _GstVideoSampleConverter GstVideoSampleConverter;
+
+GST_VIDEO_API
+GstVideoSampleConverter * gst_video_sample_converter_new     (void);
+
+GST_VIDEO_API
+void                      gst_video_sample_converter_free    (GstVideoSampleConverter * converter);
+
+GST_VIDEO_API
+GstSample *               gst_video_sample_converter_convert (GstVideoSampleConverter * converter,
+                                                              GstSample               * sample,
+                                                              const GstCaps           * to_caps,
+                                                              GstClockTime              timeout,
+                                                              GError                 ** error);
+
 G_END_DECLS
 
 #include <gst/video/colorbalancechannel.h>
@@ -171,6 +171,8 @@ struct _GstDecodeBin
                                  * protected by above mutex! */
 
   gboolean have_type;           /* if we received the have_type signal */
+  gint first_demuxed_buffer;    /* if the first-demuxed-buffer milestone was
+                                 * posted (atomic) */
   guint have_type_id;           /* signal id for have-type from typefind */
 
   gboolean async_pending;       /* async-start has been emitted */
@@ -1382,8 +1384,8 @@ gst_decode_bin_autoplug_factories (GstElement * element, GstPad * pad,
   g_mutex_lock (&dbin->factories_lock);
   gst_decode_bin_update_factories_list (dbin);
   list =
-      gst_element_factory_list_filter (dbin->factories, caps, GST_PAD_SINK,
-      gst_caps_is_fixed (caps));
+      gst_playback_utils_filter_factories ("decodebin", dbin->factories,
+      dbin->factories_cookie, caps, GST_PAD_SINK, gst_caps_is_fixed (caps));
   g_mutex_unlock (&dbin->factories_lock);
 
   result = g_value_array_new (g_list_length (list));
@@ -1484,6 +1486,20 @@ decode_pad_set_target (GstDecodePad * dpad, GstPad * target)
     gst_pad_sticky_events_foreach (target, copy_sticky_events, dpad);
 }
 
+/* One-shot probe on demuxer source pads, posts the first-demuxed-buffer
+ * milestone for the first buffer any of them outputs */
+static GstPadProbeReturn
+demuxer_first_buffer_probe (GstPad * pad, GstPadProbeInfo * info,
+    GstDecodeBin * dbin)
+{
+  if (g_atomic_int_compare_and_exchange (&dbin->first_demuxed_buffer, FALSE,
+          TRUE))
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (dbin),
+        "first-demuxed-buffer", NULL);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
 /* called when a new pad is discovered. It will perform some basic actions
  * before trying to link something to it.
  *
@@ -1528,6 +1544,11 @@ analyze_new_pad (GstDecodeBin * dbin, GstElement * src, GstPad * pad,
     return FALSE;
   }
 
+  if (!g_atomic_int_get (&dbin->first_demuxed_buffer)
+      && is_demuxer_element (src))
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+        (GstPadProbeCallback) demuxer_first_buffer_probe, dbin, NULL);
+
   if (chain->demuxer) {
     GstDecodeGroup *group;
     GstDecodeChain *oldchain = chain;
@@ -2591,6 +2612,10 @@ connect_pad (GstDecodeBin * dbin, GstElement * src, GstDecodePad * dpad,
       GST_PAD_STREAM_UNLOCK (sinkpad);
     }
 
+    if (is_decoder)
+      gst_playback_utils_post_milestone (GST_ELEMENT_CAST (dbin),
+          "decoder-configured", GST_ELEMENT_NAME (element));
+
     /* Remove error filter now, from now on we can't gracefully
      * handle errors of the element anymore */
     remove_error_filter (dbin, element, NULL);
@@ -2840,6 +2865,7 @@ type_found (GstElement * typefind, guint probability,
 {
   GstPad *pad, *sink_pad;
   GstDecodeChain *chain;
+  gchar *caps_str;
 
   GST_DEBUG_OBJECT (decode_bin, "typefind found caps %" GST_PTR_FORMAT, caps);
 
@@ -2867,6 +2893,11 @@ type_found (GstElement * typefind, guint probability,
   } else {
     decode_bin->have_type = TRUE;
 
+    caps_str = gst_caps_to_string (caps);
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (decode_bin),
+        "typefound", caps_str);
+    g_free (caps_str);
+
     decode_bin->decode_chain = gst_decode_chain_new (decode_bin, NULL, pad);
     chain = gst_decode_chain_ref (decode_bin->decode_chain);
 
@@ -5351,6 +5382,7 @@ gst_decode_bin_change_state (GstElement * element, GstStateChange transition)
         goto missing_typefind;
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      g_atomic_int_set (&dbin->first_demuxed_buffer, FALSE);
       /* Make sure we've cleared all existing chains */
       EXPOSE_LOCK (dbin);
       if (dbin->decode_chain) {
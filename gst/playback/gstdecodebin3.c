@@ -32,6 +32,7 @@
 
 #include "gstplayback.h"
 #include "gstplay-enum.h"
+#include "gstplaybackutils.h"
 #include "gstrawcaps.h"
 
 /**
@@ -265,6 +266,21 @@ struct _GstDecodebin3
 
   /* Properties */
   GstCaps *caps;
+  guint max_pooled_decoders;
+  gboolean drop_unselected;     /* protected by selection_lock */
+
+  /* The object lock protects the following variables */
+  /* Decoders released by outputs, kept in READY for reuse (most recently
+   * released first) */
+  GList *decoder_pool;
+  /* Statistics */
+  guint64 decoders_created;
+  guint64 decoders_reused;
+  guint64 reconfigurations;
+  GstClockTime last_reconfigure_time;
+  GstClockTime total_reconfigure_time;
+  /* Buffers of unselected streams dropped before the multiqueue */
+  guint64 dropped_buffers;
 };
 
 struct _GstDecodebin3Class
@@ -326,6 +342,12 @@ typedef struct _MultiQueueSlot
 
   /* id of the MQ src_pad event probe */
   gulong probe_id;
+  /* id of the MQ sink_pad buffer probe */
+  gulong sink_probe_id;
+
+  /* TRUE if incoming buffers should be dropped because the stream isn't
+   * part of the selection (atomic, written with selection_lock) */
+  gint drop_buffers;
 
   gboolean is_drained;
 
@@ -368,10 +390,16 @@ typedef struct _PendingPad
 } PendingPad;
 
 /* properties */
+#define DEFAULT_MAX_POOLED_DECODERS 0
+#define DEFAULT_DROP_UNSELECTED FALSE
+
 enum
 {
   PROP_0,
-  PROP_CAPS
+  PROP_CAPS,
+  PROP_MAX_POOLED_DECODERS,
+  PROP_DROP_UNSELECTED,
+  PROP_STATS
 };
 
 /* signals */
@@ -515,6 +543,11 @@ static void free_multiqueue_slot_async (GstDecodebin3 * dbin,
 
 static GstStreamCollection *get_merged_collection (GstDecodebin3 * dbin);
 static void update_requested_selection (GstDecodebin3 * dbin);
+static void update_slots_drop_state (GstDecodebin3 * dbin);
+
+static void trim_decoder_pool (GstDecodebin3 * dbin);
+static void clear_decoder_pool (GstDecodebin3 * dbin);
+static GstStructure *gst_decodebin3_get_stats (GstDecodebin3 * dbin);
 
 /* FIXME: Really make all the parser stuff a self-contained helper object */
 #include "gstdecodebin3-parse.c"
@@ -551,6 +584,78 @@ gst_decodebin3_class_init (GstDecodebin3Class * klass)
           "The caps on which to stop decoding. (NULL = default)",
           GST_TYPE_CAPS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDecodebin3:max-pooled-decoders:
+   *
+   * Maximum number of decoders that are kept around in the READY state when
+   * they are no longer needed by an output, for example after a stream
+   * switch or when going back to READY to change the input. A pooled decoder
+   * is reused instead of creating a new one if it accepts the caps of a new
+   * stream. 0 disables the pool.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_klass, PROP_MAX_POOLED_DECODERS,
+      g_param_spec_uint ("max-pooled-decoders", "Max pooled decoders",
+          "Maximum number of unused decoders kept around for reuse",
+          0, G_MAXUINT, DEFAULT_MAX_POOLED_DECODERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDecodebin3:drop-unselected:
+   *
+   * Drop the buffers of streams that are not part of the current selection
+   * before they get queued in the multiqueue. This avoids buffering (and
+   * interleaving) data of streams that will not be output, which matters
+   * for inputs with many streams like broadcasts with a lot of audio tracks.
+   *
+   * Nothing is dropped until the initial selection is known. When a stream
+   * gets selected later on, its output starts with the next buffer
+   * received from upstream instead of the data that would otherwise have
+   * been queued.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_klass, PROP_DROP_UNSELECTED,
+      g_param_spec_boolean ("drop-unselected", "Drop unselected",
+          "Drop buffers of unselected streams before queueing them",
+          DEFAULT_DROP_UNSELECTED,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDecodebin3:stats:
+   *
+   * Various decodebin3 statistics. This property returns a #GstStructure
+   * with name application/x-decodebin3-stats with the following fields:
+   *
+   * - "decoders-created" G_TYPE_UINT64 Number of decoders instantiated.
+   * - "decoders-reused" G_TYPE_UINT64 Number of decoders taken from the pool.
+   * - "pooled-decoders" G_TYPE_UINT Number of decoders currently pooled.
+   * - "reconfigurations" G_TYPE_UINT64 Number of output reconfigurations.
+   * - "last-reconfigure-time" G_TYPE_UINT64 Duration of the last output
+   *   reconfiguration, in nanoseconds.
+   * - "total-reconfigure-time" G_TYPE_UINT64 Accumulated duration of all
+   *   output reconfigurations, in nanoseconds.
+   * - "dropped-buffers" G_TYPE_UINT64 Number of buffers of unselected streams
+   *   dropped because of #GstDecodebin3:drop-unselected.
+   * - "factory-cache-entries" G_TYPE_UINT Number of cached factory lookups.
+   *   The cache is shared by all decodebin, decodebin3 and parsebin
+   *   instances, the factory cache counters cover all of them but are only
+   *   exposed here.
+   * - "factory-cache-hits" G_TYPE_UINT64 Factory lookups served from the
+   *   cache.
+   * - "factory-cache-misses" G_TYPE_UINT64 Factory lookups that needed to
+   *   go through the registry.
+   * - "factory-cache-invalidations" G_TYPE_UINT64 Number of times the cache
+   *   was dropped because the registry changed.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_klass, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Various statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /* FIXME : ADD SIGNALS ! */
   /**
    * GstDecodebin3::select-stream
@@ -628,6 +733,8 @@ gst_decodebin3_init (GstDecodebin3 * dbin)
   g_mutex_init (&dbin->input_lock);
 
   dbin->caps = gst_static_caps_get (&default_raw_caps);
+  dbin->max_pooled_decoders = DEFAULT_MAX_POOLED_DECODERS;
+  dbin->drop_unselected = DEFAULT_DROP_UNSELECTED;
 
   GST_OBJECT_FLAG_SET (dbin, GST_BIN_FLAG_STREAMS_AWARE);
 }
@@ -650,6 +757,8 @@ gst_decodebin3_dispose (GObject * object)
   g_list_free (dbin->pending_select_streams);
   g_clear_object (&dbin->collection);
 
+  clear_decoder_pool (dbin);
+
   free_input (dbin, dbin->main_input);
 
   for (walk = dbin->other_inputs; walk; walk = next) {
@@ -679,6 +788,18 @@ gst_decodebin3_set_property (GObject * object, guint prop_id,
       dbin->caps = g_value_dup_boxed (value);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_MAX_POOLED_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      dbin->max_pooled_decoders = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (dbin);
+      trim_decoder_pool (dbin);
+      break;
+    case PROP_DROP_UNSELECTED:
+      SELECTION_LOCK (dbin);
+      dbin->drop_unselected = g_value_get_boolean (value);
+      update_slots_drop_state (dbin);
+      SELECTION_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -698,6 +819,19 @@ gst_decodebin3_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_boxed (value, dbin->caps);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_MAX_POOLED_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      g_value_set_uint (value, dbin->max_pooled_decoders);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
+    case PROP_DROP_UNSELECTED:
+      SELECTION_LOCK (dbin);
+      g_value_set_boolean (value, dbin->drop_unselected);
+      SELECTION_UNLOCK (dbin);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_decodebin3_get_stats (dbin));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1070,6 +1204,50 @@ stream_in_list (GList * list, const gchar * sid)
   return NULL;
 }
 
+/* Returns TRUE if buffers for the stream of @slot should be dropped at the
+ * multiqueue input.
+ * Must be called with SELECTION_LOCK */
+static gboolean
+slot_should_drop_buffers (GstDecodebin3 * dbin, MultiQueueSlot * slot)
+{
+  const gchar *sid;
+
+  if (!dbin->drop_unselected || slot->input == NULL
+      || slot->input->active_stream == NULL)
+    return FALSE;
+
+  /* No selection was made yet, we don't know which streams will be used */
+  if (dbin->requested_selection == NULL && dbin->active_selection == NULL)
+    return FALSE;
+
+  sid = gst_stream_get_stream_id (slot->input->active_stream);
+  if (stream_in_list (dbin->requested_selection, sid)
+      || stream_in_list (dbin->active_selection, sid)
+      || stream_in_list (dbin->to_activate, sid)
+      || stream_in_list (dbin->pending_select_streams, sid))
+    return FALSE;
+
+  return TRUE;
+}
+
+/* Must be called with SELECTION_LOCK whenever the selection changes */
+static void
+update_slots_drop_state (GstDecodebin3 * dbin)
+{
+  GList *tmp;
+
+  for (tmp = dbin->slots; tmp; tmp = tmp->next) {
+    MultiQueueSlot *slot = (MultiQueueSlot *) tmp->data;
+    gboolean drop = slot_should_drop_buffers (dbin, slot);
+
+    if (drop != g_atomic_int_get (&slot->drop_buffers)) {
+      GST_DEBUG_OBJECT (slot->sink_pad, "%s buffers of unselected stream",
+          drop ? "Dropping" : "No longer dropping");
+      g_atomic_int_set (&slot->drop_buffers, drop);
+    }
+  }
+}
+
 static void
 update_requested_selection (GstDecodebin3 * dbin)
 {
@@ -1150,6 +1328,7 @@ beach:
         g_list_copy_deep (tmp, (GCopyFunc) g_strdup, NULL);
     dbin->selection_updated = TRUE;
     g_list_free (tmp);
+    update_slots_drop_state (dbin);
   }
   SELECTION_UNLOCK (dbin);
 }
@@ -1901,6 +2080,23 @@ multiqueue_src_probe (GstPad * pad, GstPadProbeInfo * info,
   return ret;
 }
 
+/* Drops buffers of unselected streams before they reach the multiqueue,
+ * events are always let through */
+static GstPadProbeReturn
+multiqueue_sink_probe (GstPad * pad, GstPadProbeInfo * info,
+    MultiQueueSlot * slot)
+{
+  if (G_LIKELY (!g_atomic_int_get (&slot->drop_buffers)))
+    return GST_PAD_PROBE_OK;
+
+  GST_LOG_OBJECT (pad, "Dropping buffer of unselected stream");
+  GST_OBJECT_LOCK (slot->dbin);
+  slot->dbin->dropped_buffers++;
+  GST_OBJECT_UNLOCK (slot->dbin);
+
+  return GST_PAD_PROBE_DROP;
+}
+
 /* Create a new multiqueue slot for the given type
  *
  * It is up to the caller to know whether that slot is needed or not
@@ -1941,6 +2137,10 @@ create_new_slot (GstDecodebin3 * dbin, GstStreamType type)
       gst_pad_add_probe (slot->src_pad,
       GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM | GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM,
       (GstPadProbeCallback) multiqueue_src_probe, slot, NULL);
+  slot->sink_probe_id =
+      gst_pad_add_probe (slot->sink_pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) multiqueue_sink_probe, slot, NULL);
 
   GST_DEBUG ("Created new slot %u (%p) (%s:%s)", slot->id, slot,
       GST_DEBUG_PAD_NAME (slot->src_pad));
@@ -2031,6 +2231,8 @@ link_input_to_slot (DecodebinInputStream * input, MultiQueueSlot * slot)
   gst_pad_link_full (input->srcpad, slot->sink_pad, GST_PAD_LINK_CHECK_NOTHING);
   slot->pending_stream = input->active_stream;
   slot->input = input;
+  g_atomic_int_set (&slot->drop_buffers,
+      slot_should_drop_buffers (slot->dbin, slot));
 }
 
 #if 0
@@ -2045,12 +2247,14 @@ have_factory (GstDecodebin3 * dbin, GstCaps * caps,
   gst_decode_bin_update_factories_list (dbin);
   if (ftype == GST_ELEMENT_FACTORY_TYPE_DECODER)
     res =
-        gst_element_factory_list_filter (dbin->decoder_factories,
-        caps, GST_PAD_SINK, TRUE);
+        gst_playback_utils_filter_factories ("decodebin3-decoders",
+        dbin->decoder_factories, dbin->factories_cookie, caps, GST_PAD_SINK,
+        TRUE);
   else
     res =
-        gst_element_factory_list_filter (dbin->decodable_factories,
-        caps, GST_PAD_SINK, TRUE);
+        gst_playback_utils_filter_factories ("decodebin3-decodables",
+        dbin->decodable_factories, dbin->factories_cookie, caps, GST_PAD_SINK,
+        TRUE);
   g_mutex_unlock (&dbin->factories_lock);
 
   if (res) {
@@ -2075,12 +2279,14 @@ create_element (GstDecodebin3 * dbin, GstStream * stream,
   caps = gst_stream_get_caps (stream);
   if (ftype == GST_ELEMENT_FACTORY_TYPE_DECODER)
     res =
-        gst_element_factory_list_filter (dbin->decoder_factories,
-        caps, GST_PAD_SINK, TRUE);
+        gst_playback_utils_filter_factories ("decodebin3-decoders",
+        dbin->decoder_factories, dbin->factories_cookie, caps, GST_PAD_SINK,
+        TRUE);
   else
     res =
-        gst_element_factory_list_filter (dbin->decodable_factories,
-        caps, GST_PAD_SINK, TRUE);
+        gst_playback_utils_filter_factories ("decodebin3-decodables",
+        dbin->decodable_factories, dbin->factories_cookie, caps, GST_PAD_SINK,
+        TRUE);
   g_mutex_unlock (&dbin->factories_lock);
 
   if (res) {
@@ -2096,11 +2302,168 @@ create_element (GstDecodebin3 * dbin, GstStream * stream,
   return element;
 }
 
+/* Decoder pool */
+
+/* Takes the first pooled decoder that accepts @caps out of the pool */
+static GstElement *
+acquire_pooled_decoder (GstDecodebin3 * dbin, GstCaps * caps)
+{
+  GList *pool, *tmp;
+  GstElement *decoder = NULL;
+
+  /* Steal the pool, accept-caps queries must not be done with the lock */
+  GST_OBJECT_LOCK (dbin);
+  pool = dbin->decoder_pool;
+  dbin->decoder_pool = NULL;
+  GST_OBJECT_UNLOCK (dbin);
+
+  for (tmp = pool; tmp; tmp = tmp->next) {
+    GstPad *sinkpad = gst_element_get_static_pad (tmp->data, "sink");
+    gboolean accepted = FALSE;
+
+    if (sinkpad) {
+      accepted = gst_pad_query_accept_caps (sinkpad, caps);
+      gst_object_unref (sinkpad);
+    }
+    if (accepted) {
+      decoder = tmp->data;
+      pool = g_list_delete_link (pool, tmp);
+      break;
+    }
+  }
+
+  GST_OBJECT_LOCK (dbin);
+  dbin->decoder_pool = g_list_concat (pool, dbin->decoder_pool);
+  if (decoder)
+    dbin->decoders_reused++;
+  GST_OBJECT_UNLOCK (dbin);
+
+  if (decoder) {
+    GST_DEBUG_OBJECT (dbin, "Reusing pooled decoder %" GST_PTR_FORMAT,
+        decoder);
+    gst_element_set_locked_state (decoder, FALSE);
+  }
+
+  return decoder;
+}
+
+/* Removes an unlinked decoder from the bin, and either keeps it in the pool
+ * or discards it */
+static void
+release_decoder (GstDecodebin3 * dbin, GstElement * decoder)
+{
+  gboolean pool;
+
+  GST_OBJECT_LOCK (dbin);
+  pool = dbin->max_pooled_decoders > 0;
+  GST_OBJECT_UNLOCK (dbin);
+
+  gst_element_set_locked_state (decoder, TRUE);
+
+  /* READY resets the decoder but keeps its resources allocated */
+  if (!pool
+      || gst_element_set_state (decoder,
+          GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+    gst_element_set_state (decoder, GST_STATE_NULL);
+    gst_bin_remove ((GstBin *) dbin, decoder);
+    return;
+  }
+
+  gst_object_ref (decoder);
+  gst_bin_remove ((GstBin *) dbin, decoder);
+
+  GST_DEBUG_OBJECT (dbin, "Pooling decoder %" GST_PTR_FORMAT, decoder);
+
+  GST_OBJECT_LOCK (dbin);
+  dbin->decoder_pool = g_list_prepend (dbin->decoder_pool, decoder);
+  GST_OBJECT_UNLOCK (dbin);
+
+  trim_decoder_pool (dbin);
+}
+
+/* Discards the least recently pooled decoders above the maximum */
+static void
+trim_decoder_pool (GstDecodebin3 * dbin)
+{
+  GList *discard = NULL, *tmp;
+
+  GST_OBJECT_LOCK (dbin);
+  tmp = g_list_nth (dbin->decoder_pool, dbin->max_pooled_decoders);
+  if (tmp) {
+    if (tmp->prev)
+      tmp->prev->next = NULL;
+    else
+      dbin->decoder_pool = NULL;
+    tmp->prev = NULL;
+    discard = tmp;
+  }
+  GST_OBJECT_UNLOCK (dbin);
+
+  for (tmp = discard; tmp; tmp = tmp->next) {
+    GST_DEBUG_OBJECT (dbin, "Discarding pooled decoder %" GST_PTR_FORMAT,
+        tmp->data);
+    gst_element_set_state (tmp->data, GST_STATE_NULL);
+  }
+  g_list_free_full (discard, gst_object_unref);
+}
+
+static void
+clear_decoder_pool (GstDecodebin3 * dbin)
+{
+  GList *pool, *tmp;
+
+  GST_OBJECT_LOCK (dbin);
+  pool = dbin->decoder_pool;
+  dbin->decoder_pool = NULL;
+  GST_OBJECT_UNLOCK (dbin);
+
+  for (tmp = pool; tmp; tmp = tmp->next)
+    gst_element_set_state (tmp->data, GST_STATE_NULL);
+  g_list_free_full (pool, gst_object_unref);
+}
+
+static GstStructure *
+gst_decodebin3_get_stats (GstDecodebin3 * dbin)
+{
+  GstStructure *s;
+
+  GST_OBJECT_LOCK (dbin);
+  s = gst_structure_new ("application/x-decodebin3-stats",
+      "decoders-created", G_TYPE_UINT64, dbin->decoders_created,
+      "decoders-reused", G_TYPE_UINT64, dbin->decoders_reused,
+      "pooled-decoders", G_TYPE_UINT, g_list_length (dbin->decoder_pool),
+      "reconfigurations", G_TYPE_UINT64, dbin->reconfigurations,
+      "last-reconfigure-time", G_TYPE_UINT64, dbin->last_reconfigure_time,
+      "total-reconfigure-time", G_TYPE_UINT64, dbin->total_reconfigure_time,
+      "dropped-buffers", G_TYPE_UINT64, dbin->dropped_buffers, NULL);
+  GST_OBJECT_UNLOCK (dbin);
+
+  gst_playback_utils_add_factory_cache_stats (s);
+
+  return s;
+}
+
 /* FIXME : VERY NAIVE. ASSUMING FIRST ONE WILL WORK */
 static GstElement *
 create_decoder (GstDecodebin3 * dbin, GstStream * stream)
 {
-  return create_element (dbin, stream, GST_ELEMENT_FACTORY_TYPE_DECODER);
+  GstElement *decoder;
+  GstCaps *caps;
+
+  caps = gst_stream_get_caps (stream);
+  decoder = acquire_pooled_decoder (dbin, caps);
+  gst_caps_unref (caps);
+  if (decoder)
+    return decoder;
+
+  decoder = create_element (dbin, stream, GST_ELEMENT_FACTORY_TYPE_DECODER);
+  if (decoder) {
+    GST_OBJECT_LOCK (dbin);
+    dbin->decoders_created++;
+    GST_OBJECT_UNLOCK (dbin);
+  }
+
+  return decoder;
 }
 
 static GstPadProbeReturn
@@ -2122,7 +2485,7 @@ keyframe_waiter_probe (GstPad * pad, GstPadProbeInfo * info,
 }
 
 static void
-reconfigure_output_stream (DecodebinOutputStream * output,
+reconfigure_output_stream_internal (DecodebinOutputStream * output,
     MultiQueueSlot * slot)
 {
   GstDecodebin3 *dbin = output->dbin;
@@ -2188,10 +2551,7 @@ reconfigure_output_stream (DecodebinOutputStream * output,
       goto cleanup;
     }
 
-    gst_element_set_locked_state (output->decoder, TRUE);
-    gst_element_set_state (output->decoder, GST_STATE_NULL);
-
-    gst_bin_remove ((GstBin *) dbin, output->decoder);
+    release_decoder (dbin, output->decoder);
     output->decoder = NULL;
   }
 
@@ -2250,8 +2610,11 @@ reconfigure_output_stream (DecodebinOutputStream * output,
     gst_element_add_pad (GST_ELEMENT_CAST (dbin), output->src_pad);
   }
 
-  if (output->decoder)
+  if (output->decoder) {
     gst_element_sync_state_with_parent (output->decoder);
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (dbin),
+        "decoder-configured", GST_ELEMENT_NAME (output->decoder));
+  }
 
   output->slot = slot;
   return;
@@ -2275,6 +2638,27 @@ cleanup:
   }
 }
 
+static void
+reconfigure_output_stream (DecodebinOutputStream * output,
+    MultiQueueSlot * slot)
+{
+  GstDecodebin3 *dbin = output->dbin;
+  GstClockTime start, elapsed;
+
+  start = gst_util_get_timestamp ();
+  reconfigure_output_stream_internal (output, slot);
+  elapsed = gst_util_get_timestamp () - start;
+
+  GST_DEBUG_OBJECT (dbin, "Reconfigured output %p in %" GST_TIME_FORMAT,
+      output, GST_TIME_ARGS (elapsed));
+
+  GST_OBJECT_LOCK (dbin);
+  dbin->reconfigurations++;
+  dbin->last_reconfigure_time = elapsed;
+  dbin->total_reconfigure_time += elapsed;
+  GST_OBJECT_UNLOCK (dbin);
+}
+
 static GstPadProbeReturn
 idle_reconfigure (GstPad * pad, GstPadProbeInfo * info, MultiQueueSlot * slot)
 {
@@ -2401,6 +2785,7 @@ reassign_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot)
     output->slot = target_slot;
     dbin->active_selection =
         g_list_append (dbin->active_selection, (gchar *) tsid);
+    update_slots_drop_state (dbin);
     SELECTION_UNLOCK (dbin);
 
     /* Wakeup the target slot so that it retries to send events/buffers
@@ -2413,6 +2798,7 @@ reassign_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot)
 
     dbin->output_streams = g_list_remove (dbin->output_streams, output);
     free_output_stream (dbin, output);
+    update_slots_drop_state (dbin);
     msg = is_selection_done (slot->dbin);
     SELECTION_UNLOCK (dbin);
 
@@ -2609,6 +2995,7 @@ handle_stream_switch (GstDecodebin3 * dbin, GList * select_streams,
   }
 
   dbin->selection_updated = TRUE;
+  update_slots_drop_state (dbin);
   SELECTION_UNLOCK (dbin);
 
   if (unknown) {
@@ -2682,6 +3069,7 @@ ghost_pad_event_probe (GstPad * pad, GstPadProbeInfo * info,
       }
       gst_event_parse_select_streams (event, &streams);
       dbin->pending_select_streams = g_list_copy (streams);
+      update_slots_drop_state (dbin);
       SELECTION_UNLOCK (dbin);
 
       /* Send event upstream */
@@ -2730,6 +3118,7 @@ gst_decodebin3_send_event (GstElement * element, GstEvent * event)
     }
     gst_event_parse_select_streams (event, &streams);
     dbin->pending_select_streams = g_list_copy (streams);
+    update_slots_drop_state (dbin);
     SELECTION_UNLOCK (dbin);
 
     /* FIXME : We don't have an upstream ?? */
@@ -2758,6 +3147,8 @@ free_multiqueue_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot)
 {
   if (slot->probe_id)
     gst_pad_remove_probe (slot->src_pad, slot->probe_id);
+  if (slot->sink_probe_id)
+    gst_pad_remove_probe (slot->sink_pad, slot->sink_probe_id);
   if (slot->input) {
     if (slot->input->srcpad)
       gst_pad_unlink (slot->input->srcpad, slot->sink_pad);
@@ -2852,11 +3243,8 @@ free_output_stream (GstDecodebin3 * dbin, DecodebinOutputStream * output)
   if (output->src_exposed) {
     gst_element_remove_pad ((GstElement *) dbin, output->src_pad);
   }
-  if (output->decoder) {
-    gst_element_set_locked_state (output->decoder, TRUE);
-    gst_element_set_state (output->decoder, GST_STATE_NULL);
-    gst_bin_remove ((GstBin *) dbin, output->decoder);
-  }
+  if (output->decoder)
+    release_decoder (dbin, output->decoder);
   g_free (output);
 }
 
@@ -2898,6 +3286,9 @@ gst_decodebin3_change_state (GstElement * element, GstStateChange transition)
       /* Free inputs */
     }
       break;
+    case GST_STATE_CHANGE_READY_TO_NULL:
+      clear_decoder_pool (dbin);
+      break;
     default:
       break;
   }
@@ -168,6 +168,8 @@ struct _GstParseBin
                                  * protected by above mutex! */
 
   gboolean have_type;           /* if we received the have_type signal */
+  gint first_demuxed_buffer;    /* if the first-demuxed-buffer milestone was
+                                 * posted (atomic) */
   guint have_type_id;           /* signal id for have-type from typefind */
 
   GMutex dyn_lock;              /* lock protecting pad blocking */
@@ -1133,8 +1135,8 @@ gst_parse_bin_autoplug_factories (GstElement * element, GstPad * pad,
   g_mutex_lock (&parsebin->factories_lock);
   gst_parse_bin_update_factories_list (parsebin);
   list =
-      gst_element_factory_list_filter (parsebin->factories, caps, GST_PAD_SINK,
-      gst_caps_is_fixed (caps));
+      gst_playback_utils_filter_factories ("parsebin", parsebin->factories,
+      parsebin->factories_cookie, caps, GST_PAD_SINK, gst_caps_is_fixed (caps));
   g_mutex_unlock (&parsebin->factories_lock);
 
   result = g_value_array_new (g_list_length (list));
@@ -1267,6 +1269,20 @@ parse_pad_set_target (GstParsePad * parsepad, GstPad * target)
   }
 }
 
+/* One-shot probe on demuxer source pads, posts the first-demuxed-buffer
+ * milestone for the first buffer any of them outputs */
+static GstPadProbeReturn
+demuxer_first_buffer_probe (GstPad * pad, GstPadProbeInfo * info,
+    GstParseBin * parsebin)
+{
+  if (g_atomic_int_compare_and_exchange (&parsebin->first_demuxed_buffer, FALSE,
+          TRUE))
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (parsebin),
+        "first-demuxed-buffer", NULL);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
 /* called when a new pad is discovered. It will perform some basic actions
  * before trying to link something to it.
  *
@@ -1303,6 +1319,11 @@ analyze_new_pad (GstParseBin * parsebin, GstElement * src, GstPad * pad,
     return;
   }
 
+  if (!g_atomic_int_get (&parsebin->first_demuxed_buffer)
+      && is_demuxer_element (src))
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+        (GstPadProbeCallback) demuxer_first_buffer_probe, parsebin, NULL);
+
   if (chain->demuxer) {
     GstParseGroup *group;
     GstParseChain *oldchain = chain;
@@ -2374,6 +2395,7 @@ type_found (GstElement * typefind, guint probability,
     GstCaps * caps, GstParseBin * parse_bin)
 {
   GstPad *pad, *sink_pad;
+  gchar *caps_str;
 
   GST_DEBUG_OBJECT (parse_bin, "typefind found caps %" GST_PTR_FORMAT, caps);
 
@@ -2394,6 +2416,11 @@ type_found (GstElement * typefind, guint probability,
 
   parse_bin->have_type = TRUE;
 
+  caps_str = gst_caps_to_string (caps);
+  gst_playback_utils_post_milestone (GST_ELEMENT_CAST (parse_bin),
+      "typefound", caps_str);
+  g_free (caps_str);
+
   pad = gst_element_get_static_pad (typefind, "src");
   sink_pad = gst_element_get_static_pad (typefind, "sink");
 
@@ -4287,6 +4314,7 @@ gst_parse_bin_change_state (GstElement * element, GstStateChange transition)
         goto missing_typefind;
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      g_atomic_int_set (&parsebin->first_demuxed_buffer, FALSE);
       /* Make sure we've cleared all existing chains */
       EXPOSE_LOCK (parsebin);
       if (parsebin->parse_chain) {
@@ -26,6 +26,24 @@
 #include <gst/gst.h>
 #include "gstplaybackutils.h"
 
+/* Process-wide cache of gst_element_factory_list_filter() results.
+ *
+ * Every decodebin/parsebin instance builds its factory lists from the
+ * registry in the same way, so the filtered result only depends on the
+ * kind of list, the caps and the registry contents. Filtering means
+ * intersecting the caps with the pad templates of every factory, which
+ * gets expensive with large registries and is repeated for each new pad,
+ * so results are shared between all bins and dropped whenever the
+ * registry feature list changes. */
+#define FACTORY_CACHE_MAX_ENTRIES 256
+
+G_LOCK_DEFINE_STATIC (factory_cache);
+static GHashTable *factory_cache = NULL;
+static guint32 factory_cache_cookie = 0;
+static guint64 factory_cache_hits = 0;
+static guint64 factory_cache_misses = 0;
+static guint64 factory_cache_invalidations = 0;
+
 static GstStaticCaps raw_audio_caps = GST_STATIC_CAPS ("audio/x-raw(ANY)");
 static GstStaticCaps raw_video_caps = GST_STATIC_CAPS ("video/x-raw(ANY)");
 
@@ -162,3 +180,119 @@ gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2)
    * and then by factory name */
   return gst_plugin_feature_rank_compare_func (p1, p2);
 }
+
+static gchar *
+factory_cache_key (const gchar * list_id, GstCaps * caps,
+    GstPadDirection direction, gboolean subsetonly)
+{
+  gchar *caps_str, *key;
+
+  caps_str = gst_caps_to_string (caps);
+  key = g_strdup_printf ("%s:%d:%d:%s", list_id, direction, subsetonly != 0,
+      caps_str);
+  g_free (caps_str);
+
+  return key;
+}
+
+/* Must be called with the factory_cache lock */
+static void
+factory_cache_validate (guint32 cookie)
+{
+  if (factory_cache == NULL) {
+    factory_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) gst_plugin_feature_list_free);
+    factory_cache_cookie = cookie;
+  } else if (factory_cache_cookie != cookie) {
+    g_hash_table_remove_all (factory_cache);
+    factory_cache_cookie = cookie;
+    factory_cache_invalidations++;
+  }
+}
+
+/* Cached version of gst_element_factory_list_filter(). @list_id identifies
+ * how @factories was built and @cookie is the registry feature list cookie
+ * it was built with: all lists with the same id and cookie must be
+ * identical. Free the result with gst_plugin_feature_list_free() */
+GList *
+gst_playback_utils_filter_factories (const gchar * list_id,
+    GList * factories, guint32 cookie, GstCaps * caps,
+    GstPadDirection direction, gboolean subsetonly)
+{
+  GList *result;
+  gchar *key;
+
+  key = factory_cache_key (list_id, caps, direction, subsetonly);
+
+  G_LOCK (factory_cache);
+  factory_cache_validate (cookie);
+  if (g_hash_table_lookup_extended (factory_cache, key, NULL,
+          (gpointer *) & result)) {
+    factory_cache_hits++;
+    result = gst_plugin_feature_list_copy (result);
+    G_UNLOCK (factory_cache);
+    g_free (key);
+    return result;
+  }
+  factory_cache_misses++;
+  G_UNLOCK (factory_cache);
+
+  result =
+      gst_element_factory_list_filter (factories, caps, direction, subsetonly);
+
+  G_LOCK (factory_cache);
+  /* Don't store anything if the registry changed in the meantime */
+  if (factory_cache_cookie == cookie) {
+    /* Caps are mostly taken from a small set of streams, a full cache
+     * means something is generating lots of distinct caps, so just
+     * start over instead of tracking usage of every entry */
+    if (g_hash_table_size (factory_cache) >= FACTORY_CACHE_MAX_ENTRIES)
+      g_hash_table_remove_all (factory_cache);
+    g_hash_table_insert (factory_cache, key,
+        gst_plugin_feature_list_copy (result));
+    key = NULL;
+  }
+  G_UNLOCK (factory_cache);
+  g_free (key);
+
+  return result;
+}
+
+/* Adds the factory cache counters to @s */
+void
+gst_playback_utils_add_factory_cache_stats (GstStructure * s)
+{
+  guint entries;
+  guint64 hits, misses, invalidations;
+
+  G_LOCK (factory_cache);
+  entries = factory_cache ? g_hash_table_size (factory_cache) : 0;
+  hits = factory_cache_hits;
+  misses = factory_cache_misses;
+  invalidations = factory_cache_invalidations;
+  G_UNLOCK (factory_cache);
+
+  gst_structure_set (s, "factory-cache-entries", G_TYPE_UINT, entries,
+      "factory-cache-hits", G_TYPE_UINT64, hits,
+      "factory-cache-misses", G_TYPE_UINT64, misses,
+      "factory-cache-invalidations", G_TYPE_UINT64, invalidations, NULL);
+}
+
+/* Posts a "playback-milestone" element message from @element, see the
+ * playbin documentation for the list of milestones. @detail is optional */
+void
+gst_playback_utils_post_milestone (GstElement * element,
+    const gchar * milestone, const gchar * detail)
+{
+  GstClockTime timestamp = gst_util_get_timestamp ();
+  GstStructure *s;
+
+  s = gst_structure_new ("playback-milestone",
+      "milestone", G_TYPE_STRING, milestone,
+      "timestamp", G_TYPE_UINT64, timestamp, NULL);
+  if (detail)
+    gst_structure_set (s, "detail", G_TYPE_STRING, detail, NULL);
+
+  gst_element_post_message (element,
+      gst_message_new_element (GST_OBJECT_CAST (element), s));
+}
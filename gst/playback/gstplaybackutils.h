@@ -36,6 +36,22 @@ gst_playback_utils_get_n_common_capsfeatures (GstElementFactory * fact1,
 G_GNUC_INTERNAL
 gint
 gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2);
+G_GNUC_INTERNAL
+GList *
+gst_playback_utils_filter_factories (const gchar * list_id,
+                                     GList * factories,
+                                     guint32 cookie,
+                                     GstCaps * caps,
+                                     GstPadDirection direction,
+                                     gboolean subsetonly);
+G_GNUC_INTERNAL
+void
+gst_playback_utils_add_factory_cache_stats (GstStructure * s);
+G_GNUC_INTERNAL
+void
+gst_playback_utils_post_milestone (GstElement * element,
+                                   const gchar * milestone,
+                                   const gchar * detail);
 G_END_DECLS
 
 #endif /* __GST_PLAYBACK_UTILS_H__ */
@@ -162,6 +162,37 @@
  * playback, the following syntax might work (if the resindvd plugin is used):
  * dvd://[/path/to/device]
  *
+ * ## Startup milestones
+ *
+ * To find out where the time until playback starts is spent, the playback
+ * elements post element messages containing a structure named
+ * 'playback-milestone'. Its 'milestone' field is a string naming the
+ * milestone and its 'timestamp' field is a #guint64 taken with
+ * gst_util_get_timestamp() when it was reached. Some milestones have an
+ * additional 'detail' string field. The message source is the element that
+ * reached the milestone. The milestones are:
+ *
+ * * 'source-setup': playbin3 created the source element, posted once after
+ * going from READY to PAUSED.
+ * * 'sinks-prepared': playbin3 prepared the sinks for its
+ * #GstPlayBin3:fast-start-caps.
+ * * 'source-opened': the source element of uridecodebin or urisourcebin
+ * reached the PAUSED state.
+ * * 'typefound': the type of the stream was found, the detail contains the
+ * caps.
+ * * 'first-demuxed-buffer': a demuxer in decodebin or parsebin output its
+ * first buffer.
+ * * 'decoder-configured': a decoder was plugged and configured, the detail
+ * contains its name.
+ * * 'stream-collection': playbin3 received its first stream collection,
+ * posted once after going from READY to PAUSED.
+ * * 'first-decoded-pad': playbin3 got its first decoded pad, posted once
+ * after going from READY to PAUSED.
+ * * 'first-buffer-at-sink': the first buffer of a stream reached playsink,
+ * the detail contains the stream type. It is posted again for the first
+ * buffer of every following stream, e.g. after a gapless switch.
+ * * 'preroll': the sinks prerolled.
+ *
  * ## Handling redirects
  *
  * Some elements may post 'redirect' messages on the bus to tell the
@@ -2893,6 +2924,10 @@ gst_play_bin_handle_message (GstBin * bin, GstMessage * msg)
           GST_OBJECT_NAME (src));
       gst_message_unref (msg);
       msg = NULL;
+    } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ASYNC_DONE
+        && src == GST_OBJECT_CAST (playbin->playsink)) {
+      gst_playback_utils_post_milestone (GST_ELEMENT_CAST (playbin),
+          "preroll", NULL);
     }
   } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_STREAM_START) {
     GstSourceGroup *new_group = playbin->curr_group;
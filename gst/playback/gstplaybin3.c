@@ -169,6 +169,12 @@
  * example, for DVD menu playback, the following syntax might work (if the
  * resindvd plugin is used): dvd://[/path/to/device]
  *
+ * ## Startup milestones
+ *
+ * playbin3 posts the same 'playback-milestone' element messages as playbin,
+ * see the "Startup milestones" section of the playbin documentation for
+ * their format and the list of milestones.
+ *
  * ## Handling redirects
  *
  * Some elements may post 'redirect' messages on the bus to tell the
@@ -412,6 +418,15 @@ struct _GstSourceGroup
 #define GST_PLAY_BIN3_SHUTDOWN_UNLOCK(bin)	\
   GST_PLAY_BIN3_DYN_UNLOCK (bin);		\
 
+/* milestones that playbin3 posts only for the first occurrence after
+ * READY to PAUSED */
+typedef enum
+{
+  STARTUP_SOURCE_SETUP = (1 << 0),
+  STARTUP_STREAM_COLLECTION = (1 << 1),
+  STARTUP_FIRST_PAD = (1 << 2)
+} StartupMilestone;
+
 /**
  * GstPlayBin3:
  *
@@ -503,6 +518,12 @@ struct _GstPlayBin3
   GSequence *velements;         /* a list of GstAVElements for video stream */
 
   guint64 ring_buffer_max_size; /* 0 means disabled */
+
+  GstCaps *fast_start_caps;     /* media types to prepare sinks for, or NULL */
+
+  /* StartupMilestone flags of the milestones that are only posted once
+   * after READY to PAUSED, protected by the object lock */
+  guint startup_milestones;
 };
 
 struct _GstPlayBin3Class
@@ -539,6 +560,7 @@ struct _GstPlayBin3Class
 #define DEFAULT_BUFFER_DURATION   -1
 #define DEFAULT_BUFFER_SIZE       -1
 #define DEFAULT_RING_BUFFER_MAX_SIZE 0
+#define DEFAULT_FAST_START_CAPS   NULL
 
 enum
 {
@@ -569,7 +591,8 @@ enum
   PROP_AUDIO_FILTER,
   PROP_VIDEO_FILTER,
   PROP_MULTIVIEW_MODE,
-  PROP_MULTIVIEW_FLAGS
+  PROP_MULTIVIEW_FLAGS,
+  PROP_FAST_START_CAPS
 };
 
 /* signals */
@@ -960,6 +983,28 @@ gst_play_bin3_class_init (GstPlayBin3Class * klass)
           GST_TYPE_VIDEO_MULTIVIEW_FLAGS, GST_VIDEO_MULTIVIEW_FLAGS_NONE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstPlayBin3:fast-start-caps:
+   *
+   * Hint about the media types the next uri is expected to contain, for
+   * example "audio/x-raw; video/x-raw". When set, the default audio and/or
+   * video sinks for these media types are created and brought to the READY
+   * state in a separate thread while the source is being opened and
+   * typefound, instead of after the streams have been discovered. Sinks
+   * configured by the application are not affected. %NULL disables this.
+   *
+   * The 'sinks-prepared' playback milestone is posted once the sinks are
+   * ready, see the "Startup milestones" section of the playbin
+   * documentation.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_klass, PROP_FAST_START_CAPS,
+      g_param_spec_boxed ("fast-start-caps", "Fast start caps",
+          "Media types to prepare sinks for while opening the source "
+          "(NULL = disabled)", GST_TYPE_CAPS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstPlayBin3::about-to-finish
    * @playbin: a #GstPlayBin3
@@ -1066,6 +1111,23 @@ do_async_start (GstPlayBin3 * playbin)
       message);
 }
 
+/* Posts @milestone unless it was already posted since READY to PAUSED */
+static void
+post_startup_milestone (GstPlayBin3 * playbin, StartupMilestone flag,
+    const gchar * milestone)
+{
+  gboolean post;
+
+  GST_OBJECT_LOCK (playbin);
+  post = !(playbin->startup_milestones & flag);
+  playbin->startup_milestones |= flag;
+  GST_OBJECT_UNLOCK (playbin);
+
+  if (post)
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (playbin), milestone,
+        NULL);
+}
+
 static void
 do_async_done (GstPlayBin3 * playbin)
 {
@@ -1362,6 +1424,8 @@ gst_play_bin3_init (GstPlayBin3 * playbin)
 
   playbin->multiview_mode = GST_VIDEO_MULTIVIEW_FRAME_PACKING_NONE;
   playbin->multiview_flags = GST_VIDEO_MULTIVIEW_FLAGS_NONE;
+
+  playbin->fast_start_caps = DEFAULT_FAST_START_CAPS;
 }
 
 static void
@@ -1415,6 +1479,9 @@ gst_play_bin3_finalize (GObject * object)
   if (playbin->elements)
     gst_plugin_feature_list_free (playbin->elements);
 
+  if (playbin->fast_start_caps)
+    gst_caps_unref (playbin->fast_start_caps);
+
   if (playbin->aelements)
     g_sequence_free (playbin->aelements);
 
@@ -1847,6 +1914,11 @@ gst_play_bin3_set_property (GObject * object, guint prop_id,
       playbin->multiview_flags = g_value_get_flags (value);
       GST_PLAY_BIN3_UNLOCK (playbin);
       break;
+    case PROP_FAST_START_CAPS:
+      GST_OBJECT_LOCK (playbin);
+      gst_caps_replace (&playbin->fast_start_caps, g_value_get_boxed (value));
+      GST_OBJECT_UNLOCK (playbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2045,6 +2117,11 @@ gst_play_bin3_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_flags (value, playbin->multiview_flags);
       GST_OBJECT_UNLOCK (playbin);
       break;
+    case PROP_FAST_START_CAPS:
+      GST_OBJECT_LOCK (playbin);
+      g_value_set_boxed (value, playbin->fast_start_caps);
+      GST_OBJECT_UNLOCK (playbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2502,6 +2579,8 @@ gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
     GstStreamCollection *collection = NULL;
 
     gst_message_parse_stream_collection (msg, &collection);
+    post_startup_milestone (playbin, STARTUP_STREAM_COLLECTION,
+        "stream-collection");
 
     if (collection) {
       gboolean pstate = playbin->do_stream_selections;
@@ -2527,6 +2606,10 @@ gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
 
       gst_object_unref (collection);
     }
+  } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ASYNC_DONE
+      && GST_MESSAGE_SRC (msg) == GST_OBJECT_CAST (playbin->playsink)) {
+    gst_playback_utils_post_milestone (GST_ELEMENT_CAST (playbin), "preroll",
+        NULL);
   }
 
 beach:
@@ -3008,6 +3091,8 @@ pad_added_cb (GstElement * uridecodebin, GstPad * pad, GstSourceGroup * group)
 
   GST_PLAY_BIN3_SHUTDOWN_LOCK (playbin, shutdown);
 
+  post_startup_milestone (playbin, STARTUP_FIRST_PAD, "first-decoded-pad");
+
   pad_name = gst_object_get_name (GST_OBJECT (pad));
 
   GST_DEBUG_OBJECT (playbin, "decoded pad %s:%s added",
@@ -4394,15 +4479,29 @@ static void
 source_setup_cb (GstElement * element, GstElement * source,
     GstSourceGroup * group)
 {
+  post_startup_milestone (group->playbin, STARTUP_SOURCE_SETUP,
+      "source-setup");
+
   g_signal_emit (group->playbin, gst_play_bin3_signals[SIGNAL_SOURCE_SETUP], 0,
       source);
 }
 
+static void
+prepare_sinks_async (GstElement * element, GstCaps * caps)
+{
+  GstPlayBin3 *playbin = GST_PLAY_BIN3 (element);
+
+  GST_DEBUG_OBJECT (playbin, "preparing sinks for %" GST_PTR_FORMAT, caps);
+  gst_play_sink_prepare_sinks (playbin->playsink, caps);
+  gst_playback_utils_post_milestone (element, "sinks-prepared", NULL);
+}
+
 /* must be called with PLAY_BIN_LOCK */
 static GstStateChangeReturn
 activate_group (GstPlayBin3 * playbin, GstSourceGroup * group)
 {
   GstElement *uridecodebin = NULL;
+  GstCaps *fast_start_caps = NULL;
   GstPlayFlags flags;
   gboolean audio_sink_activated = FALSE;
   gboolean video_sink_activated = FALSE;
@@ -4509,6 +4608,17 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group)
    * group_lock taken. */
   GST_SOURCE_GROUP_UNLOCK (group);
 
+  /* Get the sinks ready while the source is being opened and typefound,
+   * building the chains will pick them up */
+  GST_OBJECT_LOCK (playbin);
+  if (playbin->fast_start_caps)
+    fast_start_caps = gst_caps_ref (playbin->fast_start_caps);
+  GST_OBJECT_UNLOCK (playbin);
+  if (fast_start_caps)
+    gst_element_call_async (GST_ELEMENT_CAST (playbin),
+        (GstElementCallAsyncFunc) prepare_sinks_async, fast_start_caps,
+        (GDestroyNotify) gst_caps_unref);
+
   if ((state_ret =
           gst_element_set_state (uridecodebin,
               GST_STATE_PAUSED)) == GST_STATE_CHANGE_FAILURE)
@@ -4894,6 +5004,9 @@ gst_play_bin3_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      GST_OBJECT_LOCK (playbin);
+      playbin->startup_milestones = 0;
+      GST_OBJECT_UNLOCK (playbin);
       if (!gst_play_bin3_start (playbin))
         return GST_STATE_CHANGE_FAILURE;
       break;
@@ -37,6 +37,7 @@
 #include "gststreamsynchronizer.h"
 #include "gstplaysinkvideoconvert.h"
 #include "gstplaysinkaudioconvert.h"
+#include "gstplaybackutils.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_play_sink_debug);
 #define GST_CAT_DEFAULT gst_play_sink_debug
@@ -1466,6 +1467,69 @@ try_element (GstPlaySink * playsink, GstElement * element, gboolean unref)
   return element;
 }
 
+/* Try the auto sink and then the default sink from config.h. Returns the
+ * sink in the READY state or NULL */
+static GstElement *
+try_default_sink (GstPlaySink * playsink, const gchar * autosink,
+    const gchar * defaultsink, const gchar * name)
+{
+  GstElement *elem, *sink;
+
+  GST_DEBUG_OBJECT (playsink, "trying %s", autosink);
+  elem = gst_element_factory_make (autosink, name);
+  sink = try_element (playsink, elem, TRUE);
+  if (sink == NULL && strcmp (defaultsink, autosink)) {
+    GST_DEBUG_OBJECT (playsink, "trying %s", defaultsink);
+    elem = gst_element_factory_make (defaultsink, name);
+    sink = try_element (playsink, elem, TRUE);
+  }
+
+  return sink;
+}
+
+/* Creates the default audio and/or video sink for the media types in @caps
+ * and brings them to READY, the same way the chains would do it once the
+ * streams are known. This allows opening the devices while the source is
+ * still being set up. Configured sinks are left untouched and failures are
+ * only reported when building the chains. */
+void
+gst_play_sink_prepare_sinks (GstPlaySink * playsink, GstCaps * caps)
+{
+  gboolean need_audio = FALSE, need_video = FALSE;
+  guint i;
+
+  for (i = 0; i < gst_caps_get_size (caps); i++) {
+    const gchar *name =
+        gst_structure_get_name (gst_caps_get_structure (caps, i));
+
+    if (g_str_has_prefix (name, "audio/"))
+      need_audio = TRUE;
+    else if (g_str_has_prefix (name, "video/")
+        || g_str_has_prefix (name, "image/"))
+      need_video = TRUE;
+  }
+
+  GST_PLAY_SINK_LOCK (playsink);
+  if (need_video && !(playsink->flags & GST_PLAY_FLAG_VIDEO))
+    need_video = FALSE;
+  if (need_audio && !(playsink->flags & GST_PLAY_FLAG_AUDIO))
+    need_audio = FALSE;
+
+  if (need_video && playsink->video_sink == NULL) {
+    GstElement *sink = try_default_sink (playsink, "autovideosink",
+        DEFAULT_VIDEOSINK, "videosink");
+    if (sink)
+      playsink->video_sink = gst_object_ref_sink (sink);
+  }
+  if (need_audio && playsink->audio_sink == NULL) {
+    GstElement *sink = try_default_sink (playsink, "autoaudiosink",
+        DEFAULT_AUDIOSINK, "audiosink");
+    if (sink)
+      playsink->audio_sink = gst_object_ref_sink (sink);
+  }
+  GST_PLAY_SINK_UNLOCK (playsink);
+}
+
 /* make the element (bin) that contains the elements needed to perform
  * video deinterlacing. Only used for *raw* video streams.
  *
@@ -4432,6 +4496,41 @@ wrong_type:
   }
 }
 
+typedef struct
+{
+  const gchar *stream_type;
+  gboolean armed;
+} FirstBufferProbe;
+
+/* posts the first-buffer-at-sink milestone for the first buffer after each
+ * stream-start, so that gapless switches to the next stream post it too */
+static GstPadProbeReturn
+first_buffer_probe_cb (GstPad * pad, GstPadProbeInfo * info,
+    FirstBufferProbe * probe)
+{
+  GstElement *playsink;
+
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    if (GST_EVENT_TYPE (GST_PAD_PROBE_INFO_EVENT (info)) ==
+        GST_EVENT_STREAM_START)
+      probe->armed = TRUE;
+    return GST_PAD_PROBE_OK;
+  }
+
+  if (!probe->armed)
+    return GST_PAD_PROBE_OK;
+  probe->armed = FALSE;
+
+  playsink = gst_pad_get_parent_element (pad);
+  if (playsink) {
+    gst_playback_utils_post_milestone (playsink, "first-buffer-at-sink",
+        probe->stream_type);
+    gst_object_unref (playsink);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
 /**
  * gst_play_sink_request_pad
  * @playsink: a #GstPlaySink
@@ -4449,6 +4548,7 @@ gst_play_sink_request_pad (GstPlaySink * playsink, GstPlaySinkType type)
   gboolean activate = TRUE;
   const gchar *pad_name = NULL;
   gulong *block_id = NULL;
+  const gchar *stream_type = NULL;
 
   GST_DEBUG_OBJECT (playsink, "request pad type %d", type);
 
@@ -4487,6 +4587,7 @@ gst_play_sink_request_pad (GstPlaySink * playsink, GstPlaySinkType type)
       playsink->audio_pad_raw = FALSE;
       res = playsink->audio_pad;
       block_id = &playsink->audio_block_id;
+      stream_type = "audio";
       break;
     case GST_PLAY_SINK_TYPE_VIDEO_RAW:
     case GST_PLAY_SINK_TYPE_VIDEO:
@@ -4503,6 +4604,7 @@ gst_play_sink_request_pad (GstPlaySink * playsink, GstPlaySinkType type)
       playsink->video_pad_raw = FALSE;
       res = playsink->video_pad;
       block_id = &playsink->video_block_id;
+      stream_type = "video";
       break;
     case GST_PLAY_SINK_TYPE_TEXT:
       GST_LOG_OBJECT (playsink, "ghosting text");
@@ -4539,6 +4641,17 @@ gst_play_sink_request_pad (GstPlaySink * playsink, GstPlaySinkType type)
     gst_pad_set_active (res, TRUE);
     gst_element_add_pad (GST_ELEMENT_CAST (playsink), res);
 
+    if (stream_type) {
+      FirstBufferProbe *probe = g_new (FirstBufferProbe, 1);
+
+      probe->stream_type = stream_type;
+      probe->armed = TRUE;
+      gst_pad_add_probe (res,
+          GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST |
+          GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+          (GstPadProbeCallback) first_buffer_probe_cb, probe, g_free);
+    }
+
     GST_PLAY_SINK_LOCK (playsink);
     if (block_id && *block_id == 0) {
       GstPad *blockpad =
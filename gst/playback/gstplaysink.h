@@ -77,6 +77,7 @@ GstElement *     gst_play_sink_get_filter     (GstPlaySink * playsink, GstPlaySi
 
 void             gst_play_sink_set_sink       (GstPlaySink * playsink, GstPlaySinkType type, GstElement * sink);
 GstElement *     gst_play_sink_get_sink       (GstPlaySink * playsink, GstPlaySinkType type);
+void             gst_play_sink_prepare_sinks  (GstPlaySink * playsink, GstCaps * caps);
 
 void             gst_play_sink_set_vis_plugin (GstPlaySink * playsink, GstElement * vis);
 GstElement *     gst_play_sink_get_vis_plugin (GstPlaySink * playsink);
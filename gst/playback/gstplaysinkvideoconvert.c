@@ -54,7 +54,15 @@ gst_play_sink_video_convert_add_conversion_elements (GstPlaySinkVideoConvert *
       "Building video conversion with use-converters %d, use-balance %d",
       self->use_converters, self->use_balance);
 
-  if (self->use_converters) {
+  /* Prefer doing the conversion and scaling in a single pass, fall back to
+   * separate elements otherwise */
+  if (self->use_converters
+      && (el = gst_element_factory_make ("videoconvertscale", "convscale"))) {
+    gst_play_sink_convert_bin_add_conversion_element (cbin, el);
+    /* Add black borders if necessary to keep the DAR */
+    g_object_set (el, "add-borders", TRUE, NULL);
+    prev = el;
+  } else if (self->use_converters) {
     el = gst_play_sink_convert_bin_add_conversion_element_factory (cbin,
         COLORSPACE, "conv");
     if (el)
@@ -1889,9 +1889,15 @@ type_found (GstElement * typefind, guint probability,
   GstStructure *s;
   const gchar *media_type, *elem_name;
   gboolean do_download = FALSE;
+  gchar *caps_str;
 
   GST_DEBUG_OBJECT (decoder, "typefind found caps %" GST_PTR_FORMAT, caps);
 
+  caps_str = gst_caps_to_string (caps);
+  gst_playback_utils_post_milestone (GST_ELEMENT_CAST (decoder), "typefound",
+      caps_str);
+  g_free (caps_str);
+
   s = gst_caps_get_structure (caps, 0);
   media_type = gst_structure_get_name (s);
 
@@ -2829,6 +2835,9 @@ gst_uri_decode_bin_change_state (GstElement * element,
         ret = gst_element_set_state (decoder->source, GST_STATE_PAUSED);
       if (ret == GST_STATE_CHANGE_FAILURE)
         goto setup_failed;
+      if (decoder->source)
+        gst_playback_utils_post_milestone (element, "source-opened",
+            GST_ELEMENT_NAME (decoder->source));
       if (ret == GST_STATE_CHANGE_SUCCESS)
         ret = GST_STATE_CHANGE_ASYNC;
 
@@ -42,6 +42,7 @@
 #  include "config.h"
 #endif
 
+#include <math.h>
 #include <string.h>
 
 #include <gst/gst.h>
@@ -111,6 +112,17 @@ struct _OutputSlotInfo
   GstPad *sinkpad;              /* Sink pad of the queue eleemnt */
   GstPad *srcpad;               /* Output ghost pad */
   gboolean is_eos;              /* Did EOS get fed into the buffering element */
+
+  /* adaptive buffering, only accessed from the queue sinkpad streaming
+   * thread */
+  gdouble rebuffer_target;      /* accepted rebuffer probability */
+  GstClockTime window_start;    /* start of the current measurement window */
+  guint64 window_bytes;         /* bytes received in the current window */
+  gdouble rate_avg;             /* download rate average (bytes/s) */
+  gdouble rate_var;             /* download rate variance */
+  guint n_rate_samples;
+  guint64 bitrate;              /* stream bitrate (bits/s), 0 if unknown */
+  gdouble high_watermark;       /* last high watermark set on the queue */
 };
 
 /**
@@ -138,6 +150,8 @@ struct _GstURISourceBin
   guint buffer_size;            /* When buffering, buffer size (bytes) */
   gboolean download;
   gboolean use_buffering;
+  gboolean adaptive_buffering;
+  gdouble rebuffer_target;
 
   GstElement *source;
   GList *typefinds;             /* list of typefind element */
@@ -203,6 +217,8 @@ enum
 #define DEFAULT_DOWNLOAD            FALSE
 #define DEFAULT_USE_BUFFERING       TRUE
 #define DEFAULT_RING_BUFFER_MAX_SIZE 0
+#define DEFAULT_ADAPTIVE_BUFFERING  FALSE
+#define DEFAULT_REBUFFER_TARGET     0.05
 
 #define DEFAULT_CAPS (gst_static_caps_get (&default_raw_caps))
 enum
@@ -215,7 +231,9 @@ enum
   PROP_BUFFER_DURATION,
   PROP_DOWNLOAD,
   PROP_USE_BUFFERING,
-  PROP_RING_BUFFER_MAX_SIZE
+  PROP_RING_BUFFER_MAX_SIZE,
+  PROP_ADAPTIVE_BUFFERING,
+  PROP_REBUFFER_TARGET
 };
 
 #define CUSTOM_EOS_QUARK _custom_eos_quark_get ()
@@ -345,6 +363,44 @@ gst_uri_source_bin_class_init (GstURISourceBinClass * klass)
           0, G_MAXUINT, DEFAULT_RING_BUFFER_MAX_SIZE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstURISourceBin::adaptive-buffering:
+   *
+   * Continuously estimate the download rate and the bitrate of buffered
+   * streams and adjust the high watermark of the buffering queues to the
+   * lowest level that keeps the probability of rebuffering below
+   * #GstURISourceBin:rebuffer-target. Playback of streams that download
+   * much faster than they play starts after a small amount of data was
+   * buffered, while slow links buffer more before playback starts.
+   *
+   * The adjustment only starts once the bitrate of the stream is known,
+   * either from bitrate tags or derived from the byte and time durations
+   * reported by duration queries. Until then the static watermarks are
+   * used. This property does nothing when download buffering is used.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_ADAPTIVE_BUFFERING,
+      g_param_spec_boolean ("adaptive-buffering", "Adaptive Buffering",
+          "Adapt the buffering watermarks to the measured download rate",
+          DEFAULT_ADAPTIVE_BUFFERING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstURISourceBin::rebuffer-target:
+   *
+   * With #GstURISourceBin:adaptive-buffering, the accepted probability
+   * that playback has to rebuffer before the buffer was played once.
+   * Lower values buffer more data before playback starts.
+   *
+   * Since: 1.16
+   */
+  g_object_class_install_property (gobject_class, PROP_REBUFFER_TARGET,
+      g_param_spec_double ("rebuffer-target", "Rebuffer target",
+          "Accepted rebuffering probability for adaptive buffering",
+          0.001, 0.5, DEFAULT_REBUFFER_TARGET,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstURISourceBin::drained:
    *
@@ -418,6 +474,8 @@ gst_uri_source_bin_init (GstURISourceBin * urisrc)
   urisrc->download = DEFAULT_DOWNLOAD;
   urisrc->use_buffering = DEFAULT_USE_BUFFERING;
   urisrc->ring_buffer_max_size = DEFAULT_RING_BUFFER_MAX_SIZE;
+  urisrc->adaptive_buffering = DEFAULT_ADAPTIVE_BUFFERING;
+  urisrc->rebuffer_target = DEFAULT_REBUFFER_TARGET;
   urisrc->last_buffering_pct = -1;
 
   GST_OBJECT_FLAG_SET (urisrc,
@@ -476,6 +534,12 @@ gst_uri_source_bin_set_property (GObject * object, guint prop_id,
     case PROP_RING_BUFFER_MAX_SIZE:
       urisrc->ring_buffer_max_size = g_value_get_uint64 (value);
       break;
+    case PROP_ADAPTIVE_BUFFERING:
+      urisrc->adaptive_buffering = g_value_get_boolean (value);
+      break;
+    case PROP_REBUFFER_TARGET:
+      urisrc->rebuffer_target = g_value_get_double (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -523,6 +587,12 @@ gst_uri_source_bin_get_property (GObject * object, guint prop_id,
     case PROP_RING_BUFFER_MAX_SIZE:
       g_value_set_uint64 (value, urisrc->ring_buffer_max_size);
       break;
+    case PROP_ADAPTIVE_BUFFERING:
+      g_value_set_boolean (value, urisrc->adaptive_buffering);
+      break;
+    case PROP_REBUFFER_TARGET:
+      g_value_set_double (value, urisrc->rebuffer_target);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -840,6 +910,153 @@ pre_queue_event_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
   return ret;
 }
 
+/* adaptive buffering: the download rate is measured over windows of
+ * ADAPTIVE_WINDOW, windows where the queue was almost full are ignored as
+ * the rate was limited by the consumer and not by the link. */
+#define ADAPTIVE_WINDOW             (250 * GST_MSECOND)
+#define ADAPTIVE_MIN_SAMPLES        4
+#define ADAPTIVE_RATE_WEIGHT        0.2
+#define ADAPTIVE_FULL_LEVEL         0.9
+#define ADAPTIVE_MIN_HIGH_WATERMARK 0.1
+#define ADAPTIVE_LOW_WATERMARK      0.01
+
+/* Returns z so that a standard normal variable is above z with probability
+ * @p, for 0 < @p <= 0.5 (Abramowitz and Stegun 26.2.23) */
+static gdouble
+normal_upper_quantile (gdouble p)
+{
+  gdouble t = sqrt (-2.0 * log (p));
+
+  return t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+      (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+}
+
+static gboolean
+queue_is_almost_full (GstElement * queue)
+{
+  guint level_bytes, max_bytes;
+  guint64 level_time, max_time;
+
+  g_object_get (queue, "current-level-bytes", &level_bytes,
+      "max-size-bytes", &max_bytes, "current-level-time", &level_time,
+      "max-size-time", &max_time, NULL);
+
+  return (max_bytes && level_bytes >= max_bytes * ADAPTIVE_FULL_LEVEL) ||
+      (max_time && level_time >= max_time * ADAPTIVE_FULL_LEVEL);
+}
+
+/* Sets the high watermark to the level that lets playback continue for as
+ * long as it takes to play a full queue when the download rate stays above
+ * its pessimistic estimate, which it does with probability
+ * 1 - rebuffer_target when the rate is normally distributed. If data
+ * arrives at a fraction f of the rate it is played, a level of (1 - f)
+ * is needed. */
+static void
+update_adaptive_watermarks (OutputSlotInfo * slot)
+{
+  gdouble worst_rate, high;
+  gint64 bytes, duration;
+
+  /* without bitrate tags, derive the bitrate from the size of the stream
+   * and the duration reported by the demuxer downstream */
+  if (slot->bitrate == 0
+      && gst_pad_peer_query_duration (slot->sinkpad, GST_FORMAT_BYTES, &bytes)
+      && gst_pad_peer_query_duration (slot->srcpad, GST_FORMAT_TIME,
+          &duration) && bytes > 0 && duration > 0)
+    slot->bitrate = gst_util_uint64_scale (bytes, 8 * GST_SECOND, duration);
+
+  if (slot->bitrate == 0) {
+    GST_LOG_OBJECT (slot->queue, "bitrate unknown, not adapting");
+    return;
+  }
+
+  worst_rate = slot->rate_avg -
+      normal_upper_quantile (slot->rebuffer_target) * sqrt (slot->rate_var);
+  worst_rate = MAX (worst_rate, 0.0);
+
+  high = 1.0 - (worst_rate * 8.0) / slot->bitrate;
+  high = CLAMP (high, ADAPTIVE_MIN_HIGH_WATERMARK, 1.0);
+
+  /* don't touch the queue for small changes */
+  if (fabs (high - slot->high_watermark) < 0.02)
+    return;
+
+  GST_DEBUG_OBJECT (slot->queue, "download rate %.0f +- %.0f bytes/s, "
+      "bitrate %" G_GUINT64_FORMAT " bits/s, high watermark %.2f",
+      slot->rate_avg, sqrt (slot->rate_var), slot->bitrate, high);
+
+  slot->high_watermark = high;
+  g_object_set (slot->queue, "low-watermark", ADAPTIVE_LOW_WATERMARK,
+      "high-watermark", high, NULL);
+}
+
+static GstPadProbeReturn
+adaptive_buffering_probe (GstPad * pad, GstPadProbeInfo * info,
+    OutputSlotInfo * slot)
+{
+  GstClockTime now, elapsed;
+  gdouble rate, delta;
+  gsize size;
+
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+    GstTagList *tags;
+    guint bitrate;
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_TAG) {
+      gst_event_parse_tag (event, &tags);
+      if (gst_tag_list_get_uint (tags, GST_TAG_NOMINAL_BITRATE, &bitrate)
+          || gst_tag_list_get_uint (tags, GST_TAG_BITRATE, &bitrate))
+        slot->bitrate = bitrate;
+    }
+    return GST_PAD_PROBE_OK;
+  }
+
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER)
+    size = gst_buffer_get_size (GST_PAD_PROBE_INFO_BUFFER (info));
+  else
+    size = gst_buffer_list_calculate_size (GST_PAD_PROBE_INFO_BUFFER_LIST
+        (info));
+
+  now = gst_util_get_timestamp ();
+  if (slot->window_start == GST_CLOCK_TIME_NONE) {
+    slot->window_start = now;
+    slot->window_bytes = 0;
+  }
+  slot->window_bytes += size;
+
+  elapsed = now - slot->window_start;
+  if (elapsed < ADAPTIVE_WINDOW)
+    return GST_PAD_PROBE_OK;
+
+  slot->window_start = now;
+
+  if (queue_is_almost_full (slot->queue)) {
+    slot->window_bytes = 0;
+    return GST_PAD_PROBE_OK;
+  }
+
+  rate = gst_util_uint64_scale (slot->window_bytes, GST_SECOND, elapsed);
+  slot->window_bytes = 0;
+
+  /* exponentially weighted average and variance */
+  if (slot->n_rate_samples == 0) {
+    slot->rate_avg = rate;
+    slot->rate_var = 0.0;
+  } else {
+    delta = rate - slot->rate_avg;
+    slot->rate_avg += ADAPTIVE_RATE_WEIGHT * delta;
+    slot->rate_var = (1.0 - ADAPTIVE_RATE_WEIGHT) *
+        (slot->rate_var + ADAPTIVE_RATE_WEIGHT * delta * delta);
+  }
+  slot->n_rate_samples++;
+
+  if (slot->n_rate_samples >= ADAPTIVE_MIN_SAMPLES)
+    update_adaptive_watermarks (slot);
+
+  return GST_PAD_PROBE_OK;
+}
+
 /* Called with lock held */
 static OutputSlotInfo *
 get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
@@ -959,6 +1176,16 @@ get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
 
   gst_object_unref (srcpad);
 
+  if (urisrc->adaptive_buffering && urisrc->use_buffering && !do_download) {
+    slot->rebuffer_target = urisrc->rebuffer_target;
+    slot->window_start = GST_CLOCK_TIME_NONE;
+    slot->high_watermark = 0.6;
+    gst_pad_add_probe (slot->sinkpad,
+        GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST |
+        GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+        (GstPadProbeCallback) adaptive_buffering_probe, slot, NULL);
+  }
+
   return slot;
 
 no_buffer_element:
@@ -1722,9 +1949,16 @@ type_found (GstElement * typefind, guint probability,
     GstCaps * caps, GstURISourceBin * urisrc)
 {
   GstPad *srcpad = gst_element_get_static_pad (typefind, "src");
+  gchar *caps_str;
 
   GST_DEBUG_OBJECT (urisrc, "typefind found caps %" GST_PTR_FORMAT
       " on pad %" GST_PTR_FORMAT, caps, srcpad);
+
+  caps_str = gst_caps_to_string (caps);
+  gst_playback_utils_post_milestone (GST_ELEMENT_CAST (urisrc), "typefound",
+      caps_str);
+  g_free (caps_str);
+
   handle_new_pad (urisrc, srcpad, caps);
 
   gst_object_unref (GST_OBJECT (srcpad));
@@ -2612,6 +2846,9 @@ gst_uri_source_bin_change_state (GstElement * element,
 
   switch (transition) {
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      if (urisrc->source)
+        gst_playback_utils_post_milestone (element, "source-opened",
+            GST_ELEMENT_NAME (urisrc->source));
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       GST_DEBUG ("paused to ready");
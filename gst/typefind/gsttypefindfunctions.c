@@ -121,6 +121,39 @@ data_scan_ctx_memcmp (GstTypeFind * tf, DataScanCtx * c, guint offset,
   return (memcmp (c->data + offset, data, len) == 0);
 }
 
+/* Returns the offset of the first 0x000001 start code in @data, or an offset
+ * close to the end of @data before which there is no start code. Only every
+ * third byte needs to be looked at when the data contains no zero bytes: if
+ * data[i + 2] is larger than 1, none of the offsets i, i + 1 and i + 2 can be
+ * the start of a start code. */
+static inline guint
+find_start_code (const guint8 * data, guint size)
+{
+  guint i = 0;
+
+  while (i + 2 < size) {
+    if (data[i + 2] > 1) {
+      i += 3;
+    } else if (data[i + 2] == 1) {
+      if (data[i] == 0 && data[i + 1] == 0)
+        return i;
+      i += 3;
+    } else {
+      i++;
+    }
+  }
+  return i;
+}
+
+/* Advance @c to the next 0x000001 start code in the data that is currently
+ * available. When there is none, @c is advanced as far as possible and the
+ * caller needs to call data_scan_ctx_ensure_data() again. */
+static inline void
+data_scan_ctx_skip_to_start_code (GstTypeFind * tf, DataScanCtx * c)
+{
+  data_scan_ctx_advance (tf, c, MAX (find_start_code (c->data, c->size), 1));
+}
+
 /*** text/plain ***/
 static gboolean xml_check_first_element (GstTypeFind * tf,
     const gchar * element, guint elen, gboolean strict);
@@ -2514,16 +2547,16 @@ static gboolean
 mpeg_find_next_header (GstTypeFind * tf, DataScanCtx * c,
     guint64 max_extra_offset)
 {
-  guint64 extra_offset;
+  guint64 end_offset = c->offset + max_extra_offset;
 
-  for (extra_offset = 0; extra_offset <= max_extra_offset; ++extra_offset) {
+  while (c->offset <= end_offset) {
     if (!data_scan_ctx_ensure_data (tf, c, 4))
       return FALSE;
     if (IS_MPEG_HEADER (c->data)) {
       data_scan_ctx_advance (tf, c, 3);
       return TRUE;
     }
-    data_scan_ctx_advance (tf, c, 1);
+    data_scan_ctx_skip_to_start_code (tf, c);
   }
   return FALSE;
 }
@@ -2797,9 +2830,10 @@ h264_video_type_find (GstTypeFind * tf, gpointer unused)
         return;
       }
 
-      data_scan_ctx_advance (tf, &c, 4);
+      data_scan_ctx_advance (tf, &c, 5);
+    } else {
+      data_scan_ctx_skip_to_start_code (tf, &c);
     }
-    data_scan_ctx_advance (tf, &c, 1);
   }
 
   GST_LOG ("good:%d, bad:%d, pps:%d, sps:%d, idr:%d ssps=%d", good, bad,
@@ -2890,9 +2924,10 @@ h265_video_type_find (GstTypeFind * tf, gpointer unused)
         return;
       }
 
-      data_scan_ctx_advance (tf, &c, 5);
+      data_scan_ctx_advance (tf, &c, 6);
+    } else {
+      data_scan_ctx_skip_to_start_code (tf, &c);
     }
-    data_scan_ctx_advance (tf, &c, 1);
   }
 
   GST_LOG ("good:%d, bad:%d, pps:%d, sps:%d, vps:%d, irap:%d", good, bad,
@@ -2936,8 +2971,10 @@ mpeg_video_stream_type_find (GstTypeFind * tf, gpointer unused)
     if (!data_scan_ctx_ensure_data (tf, &c, 5))
       break;
 
-    if (!IS_MPEG_HEADER (c.data))
-      goto next;
+    if (!IS_MPEG_HEADER (c.data)) {
+      data_scan_ctx_skip_to_start_code (tf, &c);
+      continue;
+    }
 
     /* a pack header indicates that this isn't an elementary stream */
     if (c.data[3] == 0xBA && mpeg_sys_is_valid_pack (tf, c.data, c.size, NULL))
@@ -2976,8 +3013,6 @@ mpeg_video_stream_type_find (GstTypeFind * tf, gpointer unused)
       continue;
     }
 
-  next:
-
     data_scan_ctx_advance (tf, &c, 1);
   }
 
@@ -454,7 +454,7 @@ gst_video_convert_set_info (GstVideoFilter * filter,
     goto format_mismatch;
 
 
-  space->convert = gst_video_converter_new (in_info, out_info,
+  space->convert = gst_video_converter_new_cached (in_info, out_info,
       gst_structure_new ("GstVideoConvertConfig",
           GST_VIDEO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_VIDEO_DITHER_METHOD,
           space->dither,
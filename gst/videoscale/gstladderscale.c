@@ -0,0 +1,955 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-ladderscale
+ * @title: ladderscale
+ * @see_also: videoscale, tee
+ *
+ * This element scales every input frame to several output sizes at once,
+ * one per requested source pad. The size of each output is negotiated with
+ * the downstream elements of the pad, the format stays the same as the
+ * input.
+ *
+ * Instead of scaling every output from the input frame like a tee with
+ * a videoscale per branch would, the outputs are produced in a cascade:
+ * an output is scaled from the smallest already scaled output that is at
+ * least twice as big in both dimensions, and only from the input frame
+ * when there is no such output. A 1080p input with 720p, 480p and 360p
+ * outputs is therefore only read twice, and the 360p output is made from
+ * the 720p one with the same filter.
+ *
+ * ## Example pipelines
+ * |[
+ * gst-launch-1.0 -v videotestsrc ! video/x-raw,width=1920,height=1080 ! ladderscale name=l \
+ *   l. ! video/x-raw,width=1280,height=720 ! queue ! fakesink \
+ *   l. ! video/x-raw,width=854,height=480 ! queue ! fakesink \
+ *   l. ! video/x-raw,width=640,height=360 ! queue ! fakesink
+ * ]|
+ *  Scale a test pattern to three renditions of an adaptive streaming ladder.
+ *
+ * Since: 1.16
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include <gst/video/gstvideometa.h>
+#include <gst/video/gstvideopool.h>
+
+#include "gstladderscale.h"
+
+#define GST_CAT_DEFAULT ladder_scale_debug
+GST_DEBUG_CATEGORY_STATIC (ladder_scale_debug);
+
+#define DEFAULT_PROP_METHOD       GST_VIDEO_RESAMPLER_METHOD_CUBIC
+#define DEFAULT_PROP_N_THREADS    1
+
+enum
+{
+  PROP_0,
+  PROP_METHOD,
+  PROP_N_THREADS
+};
+
+#define LADDER_SCALE_FORMATS "{ I420, YV12, NV12, NV21, Y42B, Y444, " \
+    "AYUV, YUY2, UYVY, ARGB, BGRA, RGBA, ABGR, xRGB, BGRx, RGBx, xBGR, " \
+    "RGB, BGR, GRAY8 }"
+
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (LADDER_SCALE_FORMATS))
+    );
+
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (LADDER_SCALE_FORMATS))
+    );
+
+/* A source pad of the element with the output it produces */
+#define GST_TYPE_LADDER_SCALE_PAD (gst_ladder_scale_pad_get_type())
+#define GST_LADDER_SCALE_PAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_LADDER_SCALE_PAD,GstLadderScalePad))
+
+typedef struct _GstLadderScalePad GstLadderScalePad;
+typedef struct _GstLadderScalePadClass GstLadderScalePadClass;
+
+struct _GstLadderScalePad
+{
+  GstPad pad;
+
+  guint index;
+
+  /* all of these are only used from the streaming thread */
+  guint caps_cookie;
+  gboolean negotiated;
+  GstVideoInfo info;
+  GstBufferPool *pool;
+
+  /* converter from convert_info to info */
+  GstVideoConverter *convert;
+  GstVideoInfo convert_info;
+
+  /* the output this pad is scaled from for the current buffer, or NULL
+   * for the input frame */
+  GstLadderScalePad *source;
+  GstBuffer *outbuf;
+  GstVideoFrame frame;
+  gboolean mapped;
+  GstFlowReturn ret;
+};
+
+struct _GstLadderScalePadClass
+{
+  GstPadClass parent_class;
+};
+
+GType gst_ladder_scale_pad_get_type (void);
+G_DEFINE_TYPE (GstLadderScalePad, gst_ladder_scale_pad, GST_TYPE_PAD);
+
+static void
+gst_ladder_scale_pad_reset (GstLadderScalePad * pad)
+{
+  if (pad->pool) {
+    gst_buffer_pool_set_active (pad->pool, FALSE);
+    gst_object_unref (pad->pool);
+    pad->pool = NULL;
+  }
+  if (pad->convert) {
+    gst_video_converter_free (pad->convert);
+    pad->convert = NULL;
+  }
+  pad->negotiated = FALSE;
+}
+
+static void
+gst_ladder_scale_pad_finalize (GObject * object)
+{
+  gst_ladder_scale_pad_reset (GST_LADDER_SCALE_PAD (object));
+
+  G_OBJECT_CLASS (gst_ladder_scale_pad_parent_class)->finalize (object);
+}
+
+static void
+gst_ladder_scale_pad_class_init (GstLadderScalePadClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_ladder_scale_pad_finalize;
+}
+
+static void
+gst_ladder_scale_pad_init (GstLadderScalePad * pad)
+{
+}
+
+static void gst_ladder_scale_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_ladder_scale_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_ladder_scale_finalize (GObject * object);
+
+static GstPad *gst_ladder_scale_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static void gst_ladder_scale_release_pad (GstElement * element, GstPad * pad);
+static GstStateChangeReturn gst_ladder_scale_change_state (GstElement *
+    element, GstStateChange transition);
+
+static GstFlowReturn gst_ladder_scale_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer);
+static gboolean gst_ladder_scale_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event);
+static gboolean gst_ladder_scale_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query);
+static gboolean gst_ladder_scale_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query);
+
+#define gst_ladder_scale_parent_class parent_class
+G_DEFINE_TYPE (GstLadderScale, gst_ladder_scale, GST_TYPE_ELEMENT);
+
+static void
+gst_ladder_scale_class_init (GstLadderScaleClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  GST_DEBUG_CATEGORY_INIT (ladder_scale_debug, "ladderscale", 0,
+      "ladderscale element");
+
+  gobject_class->set_property = gst_ladder_scale_set_property;
+  gobject_class->get_property = gst_ladder_scale_get_property;
+  gobject_class->finalize = gst_ladder_scale_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_METHOD,
+      g_param_spec_enum ("method", "Method", "Resampler method to use",
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, DEFAULT_PROP_METHOD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use per output", 0, G_MAXUINT,
+          DEFAULT_PROP_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (element_class,
+      "Video ladder scaler", "Filter/Converter/Video/Scaler",
+      "Resizes video to multiple output sizes", "GStreamer maintainers");
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+
+  element_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_request_new_pad);
+  element_class->release_pad = GST_DEBUG_FUNCPTR (gst_ladder_scale_release_pad);
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_change_state);
+}
+
+static void
+gst_ladder_scale_init (GstLadderScale * self)
+{
+  self->sinkpad = gst_pad_new_from_static_template (&sink_template, "sink");
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_chain));
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_sink_event));
+  gst_pad_set_query_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_sink_query));
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+
+  self->pad_indexes = g_hash_table_new (NULL, NULL);
+  self->method = DEFAULT_PROP_METHOD;
+  self->n_threads = DEFAULT_PROP_N_THREADS;
+  gst_video_info_init (&self->in_info);
+}
+
+static void
+gst_ladder_scale_finalize (GObject * object)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (object);
+
+  g_list_free (self->srcpads);
+  g_hash_table_unref (self->pad_indexes);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+gst_ladder_scale_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (self);
+      self->method = g_value_get_enum (value);
+      self->caps_cookie++;
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      self->n_threads = g_value_get_uint (value);
+      self->caps_cookie++;
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_ladder_scale_get_property (GObject * object, guint prop_id, GValue * value,
+    GParamSpec * pspec)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (self);
+      g_value_set_enum (value, self->method);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint (value, self->n_threads);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* returns a copy of @caps without the size related fields, the outputs
+ * can have any size but keep all the other properties of the input */
+static GstCaps *
+gst_ladder_scale_caps_remove_size (GstCaps * caps)
+{
+  GstCaps *res;
+  gint i, n;
+
+  res = gst_caps_copy (caps);
+  n = gst_caps_get_size (res);
+  for (i = 0; i < n; i++) {
+    GstStructure *s = gst_caps_get_structure (res, i);
+
+    gst_structure_remove_fields (s, "width", "height", "pixel-aspect-ratio",
+        NULL);
+  }
+  return res;
+}
+
+static gboolean
+forward_sticky_events (GstPad * pad, GstEvent ** event, gpointer user_data)
+{
+  GstPad *srcpad = GST_PAD_CAST (user_data);
+
+  /* the caps of the source pads are negotiated separately */
+  if (GST_EVENT_TYPE (*event) != GST_EVENT_CAPS)
+    gst_pad_store_sticky_event (srcpad, *event);
+
+  return TRUE;
+}
+
+static GstPad *
+gst_ladder_scale_request_new_pad (GstElement * element, GstPadTemplate * templ,
+    const gchar * name_templ, const GstCaps * caps)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (element);
+  GstPad *srcpad;
+  gchar *name;
+  guint index = 0;
+
+  GST_OBJECT_LOCK (self);
+  if (name_templ && sscanf (name_templ, "src_%u", &index) == 1) {
+    if (g_hash_table_contains (self->pad_indexes, GUINT_TO_POINTER (index)))
+      goto not_unique;
+    if (index >= self->next_pad_id)
+      self->next_pad_id = index + 1;
+  } else {
+    index = self->next_pad_id;
+    while (g_hash_table_contains (self->pad_indexes, GUINT_TO_POINTER (index)))
+      index++;
+    self->next_pad_id = index + 1;
+  }
+  g_hash_table_insert (self->pad_indexes, GUINT_TO_POINTER (index), NULL);
+  GST_OBJECT_UNLOCK (self);
+
+  name = g_strdup_printf ("src_%u", index);
+  srcpad = GST_PAD_CAST (g_object_new (GST_TYPE_LADDER_SCALE_PAD,
+          "name", name, "direction", GST_PAD_TEMPLATE_DIRECTION (templ),
+          "template", templ, NULL));
+  GST_LADDER_SCALE_PAD (srcpad)->index = index;
+  g_free (name);
+
+  gst_pad_set_query_function (srcpad,
+      GST_DEBUG_FUNCPTR (gst_ladder_scale_src_query));
+
+  if (GST_STATE (self) >= GST_STATE_PAUSED
+      || GST_STATE_PENDING (self) >= GST_STATE_PAUSED) {
+    gst_pad_set_active (srcpad, TRUE);
+    gst_pad_sticky_events_foreach (self->sinkpad, forward_sticky_events,
+        srcpad);
+  }
+
+  GST_OBJECT_LOCK (self);
+  self->srcpads = g_list_append (self->srcpads, srcpad);
+  GST_OBJECT_UNLOCK (self);
+
+  gst_element_add_pad (element, srcpad);
+
+  return srcpad;
+
+not_unique:
+  {
+    GST_OBJECT_UNLOCK (self);
+    GST_ERROR_OBJECT (self, "pad name %s is not unique", name_templ);
+    return NULL;
+  }
+}
+
+static void
+gst_ladder_scale_release_pad (GstElement * element, GstPad * pad)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (element);
+
+  GST_OBJECT_LOCK (self);
+  self->srcpads = g_list_remove (self->srcpads, pad);
+  g_hash_table_remove (self->pad_indexes,
+      GUINT_TO_POINTER (GST_LADDER_SCALE_PAD (pad)->index));
+  GST_OBJECT_UNLOCK (self);
+
+  gst_pad_set_active (pad, FALSE);
+  gst_element_remove_pad (element, pad);
+}
+
+static void
+fixate_dimension (GstStructure * s, const gchar * field, gint target)
+{
+  if (gst_structure_has_field (s, field))
+    gst_structure_fixate_field_nearest_int (s, field, target);
+  else
+    gst_structure_set (s, field, G_TYPE_INT, target, NULL);
+}
+
+/* fixates the output size in @s, keeping the display aspect ratio of the
+ * input when downstream leaves one of the dimensions open */
+static void
+gst_ladder_scale_fixate_size (GstLadderScale * self, GstStructure * s)
+{
+  GstVideoInfo *in_info = &self->in_info;
+  gint par_n, par_d, w, h;
+
+  if (gst_structure_has_field (s, "pixel-aspect-ratio"))
+    gst_structure_fixate_field_nearest_fraction (s, "pixel-aspect-ratio",
+        in_info->par_n, in_info->par_d);
+  else
+    gst_structure_set (s, "pixel-aspect-ratio", GST_TYPE_FRACTION,
+        in_info->par_n, in_info->par_d, NULL);
+  gst_structure_get_fraction (s, "pixel-aspect-ratio", &par_n, &par_d);
+
+  /*         in_h   in_par_d   par_n
+   * h = w * ---- * -------- * -----
+   *         in_w   in_par_n   par_d
+   */
+  if (gst_structure_get_int (s, "width", &w)) {
+    h = gst_util_uint64_scale_int_round (w,
+        in_info->height * in_info->par_d * par_n,
+        in_info->width * in_info->par_n * par_d);
+    fixate_dimension (s, "height", MAX (h, 1));
+  } else if (gst_structure_get_int (s, "height", &h)) {
+    w = gst_util_uint64_scale_int_round (h,
+        in_info->width * in_info->par_n * par_d,
+        in_info->height * in_info->par_d * par_n);
+    fixate_dimension (s, "width", MAX (w, 1));
+  } else {
+    fixate_dimension (s, "width", in_info->width);
+    gst_structure_get_int (s, "width", &w);
+    h = gst_util_uint64_scale_int_round (w,
+        in_info->height * in_info->par_d * par_n,
+        in_info->width * in_info->par_n * par_d);
+    fixate_dimension (s, "height", MAX (h, 1));
+  }
+}
+
+static gboolean
+gst_ladder_scale_setup_pool (GstLadderScale * self, GstLadderScalePad * pad,
+    GstCaps * caps)
+{
+  GstQuery *query;
+  GstBufferPool *pool = NULL;
+  GstStructure *config;
+  guint size = 0, min = 0, max = 0;
+
+  query = gst_query_new_allocation (caps, TRUE);
+  if (!gst_pad_peer_query (GST_PAD_CAST (pad), query))
+    GST_DEBUG_OBJECT (pad, "allocation query failed");
+
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
+  if (pool == NULL)
+    pool = gst_video_buffer_pool_new ();
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps,
+      MAX (size, pad->info.size), min, max);
+  if (gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL))
+    gst_buffer_pool_config_add_option (config,
+        GST_BUFFER_POOL_OPTION_VIDEO_META);
+  gst_query_unref (query);
+
+  if (!gst_buffer_pool_set_config (pool, config)
+      || !gst_buffer_pool_set_active (pool, TRUE)) {
+    gst_object_unref (pool);
+    return FALSE;
+  }
+  pad->pool = pool;
+
+  return TRUE;
+}
+
+static gboolean
+gst_ladder_scale_negotiate_pad (GstLadderScale * self, GstLadderScalePad * pad)
+{
+  GstCaps *incaps, *templ, *caps, *peercaps;
+
+  gst_ladder_scale_pad_reset (pad);
+
+  /* negotiated again when it gets linked */
+  if (!gst_pad_is_linked (GST_PAD_CAST (pad)))
+    return FALSE;
+
+  incaps = gst_video_info_to_caps (&self->in_info);
+  templ = gst_ladder_scale_caps_remove_size (incaps);
+  gst_caps_unref (incaps);
+
+  peercaps = gst_pad_peer_query_caps (GST_PAD_CAST (pad), templ);
+  caps = gst_caps_intersect (peercaps, templ);
+  gst_caps_unref (peercaps);
+  gst_caps_unref (templ);
+
+  if (gst_caps_is_empty (caps))
+    goto no_caps;
+
+  caps = gst_caps_truncate (caps);
+  caps = gst_caps_make_writable (caps);
+  gst_ladder_scale_fixate_size (self, gst_caps_get_structure (caps, 0));
+  caps = gst_caps_fixate (caps);
+
+  if (!gst_video_info_from_caps (&pad->info, caps))
+    goto invalid_caps;
+
+  GST_DEBUG_OBJECT (pad, "negotiated %" GST_PTR_FORMAT, caps);
+
+  if (!gst_pad_push_event (GST_PAD_CAST (pad), gst_event_new_caps (caps)))
+    goto caps_refused;
+
+  if (!gst_ladder_scale_setup_pool (self, pad, caps))
+    goto no_pool;
+
+  gst_caps_unref (caps);
+  pad->negotiated = TRUE;
+
+  return TRUE;
+
+  /* ERRORS */
+no_caps:
+  {
+    GST_DEBUG_OBJECT (pad, "no output caps possible");
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+invalid_caps:
+  {
+    GST_WARNING_OBJECT (pad, "invalid caps %" GST_PTR_FORMAT, caps);
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+caps_refused:
+  {
+    GST_DEBUG_OBJECT (pad, "caps %" GST_PTR_FORMAT " refused", caps);
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+no_pool:
+  {
+    GST_WARNING_OBJECT (pad, "failed to set up a buffer pool");
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+}
+
+static gint
+compare_pad_size (GstLadderScalePad * a, GstLadderScalePad * b)
+{
+  gint64 size_a, size_b;
+
+  size_a = a->negotiated ? (gint64) a->info.width * a->info.height : 0;
+  size_b = b->negotiated ? (gint64) b->info.width * b->info.height : 0;
+
+  if (size_a > size_b)
+    return -1;
+  if (size_a < size_b)
+    return 1;
+  return 0;
+}
+
+/* decides where each output is scaled from. @pads is sorted from the
+ * biggest to the smallest output, each output is scaled from the smallest
+ * bigger output that is at least twice as big in both dimensions so that
+ * the filter still has enough input, or from the input frame otherwise. */
+static void
+gst_ladder_scale_plan (GstLadderScale * self, GList * pads)
+{
+  GList *l, *m;
+
+  for (l = pads; l; l = l->next) {
+    GstLadderScalePad *pad = l->data;
+
+    pad->source = NULL;
+    if (!pad->negotiated)
+      continue;
+
+    for (m = pads; m != l; m = m->next) {
+      GstLadderScalePad *other = m->data;
+
+      if (other->negotiated
+          && other->info.width >= 2 * pad->info.width
+          && other->info.height >= 2 * pad->info.height)
+        pad->source = other;
+    }
+    GST_LOG_OBJECT (pad, "scaling %dx%d from %" GST_PTR_FORMAT,
+        pad->info.width, pad->info.height, pad->source);
+  }
+}
+
+static gboolean
+gst_ladder_scale_ensure_converter (GstLadderScale * self,
+    GstLadderScalePad * pad, const GstVideoInfo * in_info)
+{
+  GstStructure *options;
+
+  if (pad->convert && gst_video_info_is_equal (&pad->convert_info, in_info))
+    return TRUE;
+
+  if (pad->convert)
+    gst_video_converter_free (pad->convert);
+
+  GST_OBJECT_LOCK (self);
+  options = gst_structure_new ("ladderscale",
+      GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+      GST_TYPE_VIDEO_RESAMPLER_METHOD, self->method,
+      GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE,
+      GST_VIDEO_MATRIX_MODE_NONE, GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+      GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+      GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
+      GST_VIDEO_CHROMA_MODE_NONE,
+      GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, self->n_threads, NULL);
+  GST_OBJECT_UNLOCK (self);
+
+  pad->convert = gst_video_converter_new_cached ((GstVideoInfo *) in_info,
+      &pad->info, options);
+  pad->convert_info = *in_info;
+
+  return pad->convert != NULL;
+}
+
+static GstFlowReturn
+gst_ladder_scale_scale_pad (GstLadderScale * self, GstLadderScalePad * pad,
+    GstVideoFrame * in_frame)
+{
+  GstVideoFrame *src_frame = in_frame;
+  GstFlowReturn ret;
+
+  pad->outbuf = NULL;
+  pad->mapped = FALSE;
+
+  if (!pad->negotiated)
+    return gst_pad_is_linked (GST_PAD_CAST (pad)) ?
+        GST_FLOW_NOT_NEGOTIATED : GST_FLOW_NOT_LINKED;
+
+  /* fall back to the input frame when the bigger output failed */
+  if (pad->source && pad->source->mapped)
+    src_frame = &pad->source->frame;
+
+  if (!gst_ladder_scale_ensure_converter (self, pad, &src_frame->info))
+    return GST_FLOW_NOT_NEGOTIATED;
+
+  ret = gst_buffer_pool_acquire_buffer (pad->pool, &pad->outbuf, NULL);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  /* map for reading as well, smaller outputs can be scaled from this one */
+  if (!gst_video_frame_map (&pad->frame, &pad->info, pad->outbuf,
+          GST_MAP_READWRITE)) {
+    gst_buffer_unref (pad->outbuf);
+    pad->outbuf = NULL;
+    return GST_FLOW_ERROR;
+  }
+  pad->mapped = TRUE;
+
+  gst_video_converter_frame (pad->convert, src_frame, &pad->frame);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_ladder_scale_combine_flows (GList * pads)
+{
+  gboolean all_not_linked = TRUE, all_eos = TRUE;
+  GList *l;
+
+  for (l = pads; l; l = l->next) {
+    GstLadderScalePad *pad = l->data;
+
+    if (pad->ret == GST_FLOW_FLUSHING || pad->ret <= GST_FLOW_NOT_NEGOTIATED)
+      return pad->ret;
+    if (pad->ret != GST_FLOW_NOT_LINKED)
+      all_not_linked = FALSE;
+    if (pad->ret != GST_FLOW_EOS)
+      all_eos = FALSE;
+  }
+
+  if (all_not_linked)
+    return GST_FLOW_NOT_LINKED;
+  if (all_eos)
+    return GST_FLOW_EOS;
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_ladder_scale_chain (GstPad * sinkpad, GstObject * parent,
+    GstBuffer * buffer)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (parent);
+  GstVideoFrame in_frame;
+  GstFlowReturn ret;
+  guint caps_cookie;
+  GList *pads, *l;
+
+  if (!self->have_info)
+    goto not_negotiated;
+
+  GST_OBJECT_LOCK (self);
+  pads = g_list_copy_deep (self->srcpads, (GCopyFunc) gst_object_ref, NULL);
+  caps_cookie = self->caps_cookie;
+  GST_OBJECT_UNLOCK (self);
+
+  for (l = pads; l; l = l->next) {
+    GstLadderScalePad *pad = l->data;
+
+    if (gst_pad_check_reconfigure (GST_PAD_CAST (pad))
+        || pad->caps_cookie != caps_cookie) {
+      pad->caps_cookie = caps_cookie;
+      gst_ladder_scale_negotiate_pad (self, pad);
+    }
+  }
+
+  pads = g_list_sort (pads, (GCompareFunc) compare_pad_size);
+  gst_ladder_scale_plan (self, pads);
+
+  if (!gst_video_frame_map (&in_frame, &self->in_info, buffer, GST_MAP_READ))
+    goto invalid_buffer;
+
+  for (l = pads; l; l = l->next) {
+    GstLadderScalePad *pad = l->data;
+
+    pad->ret = gst_ladder_scale_scale_pad (self, pad, &in_frame);
+  }
+  gst_video_frame_unmap (&in_frame);
+
+  /* everything is scaled, unmap and push the outputs */
+  for (l = pads; l; l = l->next) {
+    GstLadderScalePad *pad = l->data;
+
+    if (pad->mapped) {
+      gst_video_frame_unmap (&pad->frame);
+      pad->mapped = FALSE;
+    }
+    if (pad->outbuf == NULL)
+      continue;
+
+    gst_buffer_copy_into (pad->outbuf, buffer,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+    pad->ret = gst_pad_push (GST_PAD_CAST (pad), pad->outbuf);
+    pad->outbuf = NULL;
+  }
+
+  ret = gst_ladder_scale_combine_flows (pads);
+
+  g_list_free_full (pads, gst_object_unref);
+  gst_buffer_unref (buffer);
+
+  return ret;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("No input format negotiated"));
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+invalid_buffer:
+  {
+    GST_ELEMENT_ERROR (self, CORE, FAILED, (NULL),
+        ("Failed to map the input buffer"));
+    g_list_free_full (pads, gst_object_unref);
+    gst_buffer_unref (buffer);
+    return GST_FLOW_ERROR;
+  }
+}
+
+static gboolean
+gst_ladder_scale_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (parent);
+  gboolean res;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+
+      gst_event_parse_caps (event, &caps);
+      res = gst_video_info_from_caps (&self->in_info, caps);
+      if (res) {
+        self->have_info = TRUE;
+        /* renegotiate all the outputs with the next buffer */
+        GST_OBJECT_LOCK (self);
+        self->caps_cookie++;
+        GST_OBJECT_UNLOCK (self);
+      }
+      gst_event_unref (event);
+      break;
+    }
+    default:
+      res = gst_pad_event_default (pad, parent, event);
+      break;
+  }
+
+  return res;
+}
+
+static gboolean
+gst_ladder_scale_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (parent);
+  gboolean res;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+      GList *pads, *l;
+
+      gst_query_parse_caps (query, &filter);
+
+      GST_OBJECT_LOCK (self);
+      pads = g_list_copy_deep (self->srcpads, (GCopyFunc) gst_object_ref,
+          NULL);
+      GST_OBJECT_UNLOCK (self);
+
+      /* any size is fine but the other fields must be accepted by all
+       * the outputs */
+      caps = gst_pad_get_pad_template_caps (pad);
+      for (l = pads; l; l = l->next) {
+        GstCaps *peercaps, *tmp;
+
+        peercaps = gst_pad_peer_query_caps (GST_PAD_CAST (l->data), NULL);
+        tmp = gst_ladder_scale_caps_remove_size (peercaps);
+        gst_caps_unref (peercaps);
+        peercaps = gst_caps_intersect (caps, tmp);
+        gst_caps_unref (tmp);
+        gst_caps_unref (caps);
+        caps = peercaps;
+      }
+      g_list_free_full (pads, gst_object_unref);
+
+      if (filter) {
+        GstCaps *tmp;
+
+        tmp = gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = tmp;
+      }
+
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      res = TRUE;
+      break;
+    }
+    case GST_QUERY_ALLOCATION:
+      /* the outputs have other sizes, nothing to propose */
+      res = FALSE;
+      break;
+    default:
+      res = gst_pad_query_default (pad, parent, query);
+      break;
+  }
+
+  return res;
+}
+
+static gboolean
+gst_ladder_scale_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (parent);
+  gboolean res;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps, *peercaps, *templ;
+
+      gst_query_parse_caps (query, &filter);
+
+      peercaps = gst_pad_peer_query_caps (self->sinkpad, NULL);
+      caps = gst_ladder_scale_caps_remove_size (peercaps);
+      gst_caps_unref (peercaps);
+
+      templ = gst_pad_get_pad_template_caps (pad);
+      peercaps = gst_caps_intersect (templ, caps);
+      gst_caps_unref (templ);
+      gst_caps_unref (caps);
+      caps = peercaps;
+
+      if (filter) {
+        GstCaps *tmp;
+
+        tmp = gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = tmp;
+      }
+
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      res = TRUE;
+      break;
+    }
+    default:
+      res = gst_pad_query_default (pad, parent, query);
+      break;
+  }
+
+  return res;
+}
+
+static GstStateChangeReturn
+gst_ladder_scale_change_state (GstElement * element, GstStateChange transition)
+{
+  GstLadderScale *self = GST_LADDER_SCALE (element);
+  GstStateChangeReturn ret;
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+    {
+      GList *pads, *l;
+
+      /* deactivating the pools can block, don't do it under the lock */
+      GST_OBJECT_LOCK (self);
+      pads = g_list_copy_deep (self->srcpads, (GCopyFunc) gst_object_ref,
+          NULL);
+      self->have_info = FALSE;
+      self->caps_cookie++;
+      GST_OBJECT_UNLOCK (self);
+
+      for (l = pads; l; l = l->next)
+        gst_ladder_scale_pad_reset (l->data);
+      g_list_free_full (pads, gst_object_unref);
+      gst_video_info_init (&self->in_info);
+      break;
+    }
+    default:
+      break;
+  }
+
+  return ret;
+}
@@ -0,0 +1,75 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_LADDER_SCALE_H__
+#define __GST_LADDER_SCALE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LADDER_SCALE \
+  (gst_ladder_scale_get_type())
+#define GST_LADDER_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_LADDER_SCALE,GstLadderScale))
+#define GST_LADDER_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_LADDER_SCALE,GstLadderScaleClass))
+#define GST_IS_LADDER_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_LADDER_SCALE))
+#define GST_IS_LADDER_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_LADDER_SCALE))
+#define GST_LADDER_SCALE_CAST(obj)       ((GstLadderScale *)(obj))
+
+typedef struct _GstLadderScale GstLadderScale;
+typedef struct _GstLadderScaleClass GstLadderScaleClass;
+
+/**
+ * GstLadderScale:
+ *
+ * Opaque data structure
+ */
+struct _GstLadderScale {
+  GstElement element;
+
+  GstPad *sinkpad;
+
+  /* protected by the object lock */
+  GList *srcpads;
+  GHashTable *pad_indexes;
+  guint next_pad_id;
+  guint caps_cookie;
+
+  /* properties */
+  GstVideoResamplerMethod method;
+  guint n_threads;
+
+  /* streaming thread */
+  GstVideoInfo in_info;
+  gboolean have_info;
+};
+
+struct _GstLadderScaleClass {
+  GstElementClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_ladder_scale_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_LADDER_SCALE_H__ */
@@ -0,0 +1,335 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-videoconvertscale
+ * @title: videoconvertscale
+ * @see_also: videoconvert, videoscale
+ *
+ * This element converts the video format and resizes video frames in one
+ * go. It does the same as videoconvert ! videoscale but only needs a single
+ * pass over the frame and no intermediate frame, the format and size are
+ * negotiated together.
+ *
+ * It has all the properties of videoscale.
+ *
+ * ## Example pipelines
+ * |[
+ * gst-launch-1.0 -v videotestsrc ! video/x-raw,format=YUY2 ! videoconvertscale ! video/x-raw,format=RGBx,width=320,height=240 ! autovideosink
+ * ]|
+ *  Convert a YUY2 test pattern to a small RGBx picture.
+ *
+ * Since: 1.16
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstvideoconvertscale.h"
+
+#define GST_CAT_DEFAULT video_convert_scale_debug
+GST_DEBUG_CATEGORY_STATIC (video_convert_scale_debug);
+
+static GstCaps *gst_video_convert_scale_transform_caps (GstBaseTransform *
+    trans, GstPadDirection direction, GstCaps * caps, GstCaps * filter);
+static GstCaps *gst_video_convert_scale_fixate_caps (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, GstCaps * othercaps);
+
+#define gst_video_convert_scale_parent_class parent_class
+G_DEFINE_TYPE (GstVideoConvertScale, gst_video_convert_scale,
+    GST_TYPE_VIDEO_SCALE);
+
+static void
+gst_video_convert_scale_class_init (GstVideoConvertScaleClass * klass)
+{
+  GstElementClass *element_class = (GstElementClass *) klass;
+  GstBaseTransformClass *trans_class = (GstBaseTransformClass *) klass;
+
+  GST_DEBUG_CATEGORY_INIT (video_convert_scale_debug, "videoconvertscale", 0,
+      "videoconvertscale element");
+
+  gst_element_class_set_static_metadata (element_class,
+      "Video converter and scaler", "Filter/Converter/Video/Scaler",
+      "Converts video from one colorspace to another and resizes it",
+      "GStreamer maintainers");
+
+  trans_class->transform_caps =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_transform_caps);
+  trans_class->fixate_caps =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_fixate_caps);
+}
+
+static void
+gst_video_convert_scale_init (GstVideoConvertScale * self)
+{
+}
+
+/* The size is handled by videoscale, on top of that the format info can be
+ * changed for system memory caps like videoconvert does */
+static GstCaps *
+gst_video_convert_scale_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter)
+{
+  GstCaps *scaled, *ret;
+  gint i, n;
+
+  scaled = GST_BASE_TRANSFORM_CLASS (parent_class)->transform_caps (trans,
+      direction, caps, NULL);
+
+  ret = gst_caps_new_empty ();
+  n = gst_caps_get_size (scaled);
+  for (i = 0; i < n; i++) {
+    GstStructure *st = gst_caps_get_structure (scaled, i);
+    GstCapsFeatures *f = gst_caps_get_features (scaled, i);
+
+    if (i > 0 && gst_caps_is_subset_structure_full (ret, st, f))
+      continue;
+
+    st = gst_structure_copy (st);
+    if (!gst_caps_features_is_any (f)
+        && gst_caps_features_is_equal (f,
+            GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY))
+      gst_structure_remove_fields (st, "format", "colorimetry", "chroma-site",
+          NULL);
+
+    gst_caps_append_structure_full (ret, st, gst_caps_features_copy (f));
+  }
+  gst_caps_unref (scaled);
+
+  if (filter) {
+    GstCaps *intersection;
+
+    intersection =
+        gst_caps_intersect_full (filter, ret, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref (ret);
+    ret = intersection;
+  }
+
+  GST_DEBUG_OBJECT (trans, "transformed %" GST_PTR_FORMAT " into %"
+      GST_PTR_FORMAT, caps, ret);
+
+  return ret;
+}
+
+/* Same scoring as videoconvert: how much would be lost when converting from
+ * the input to this format */
+#define SCORE_FORMAT_CHANGE       1
+#define SCORE_DEPTH_CHANGE        1
+#define SCORE_ALPHA_CHANGE        1
+#define SCORE_CHROMA_W_CHANGE     1
+#define SCORE_CHROMA_H_CHANGE     1
+#define SCORE_PALETTE_CHANGE      1
+
+#define SCORE_COLORSPACE_LOSS     2     /* RGB <-> YUV */
+#define SCORE_DEPTH_LOSS          4     /* change bit depth */
+#define SCORE_ALPHA_LOSS          8     /* lose the alpha channel */
+#define SCORE_CHROMA_W_LOSS      16     /* vertical subsample */
+#define SCORE_CHROMA_H_LOSS      32     /* horizontal subsample */
+#define SCORE_PALETTE_LOSS       64     /* convert to palette format */
+#define SCORE_COLOR_LOSS        128     /* convert to GRAY */
+
+#define COLORSPACE_MASK (GST_VIDEO_FORMAT_FLAG_YUV | \
+                         GST_VIDEO_FORMAT_FLAG_RGB | GST_VIDEO_FORMAT_FLAG_GRAY)
+#define ALPHA_MASK      (GST_VIDEO_FORMAT_FLAG_ALPHA)
+#define PALETTE_MASK    (GST_VIDEO_FORMAT_FLAG_PALETTE)
+
+static void
+score_value (GstBaseTransform * base, const GstVideoFormatInfo * in_info,
+    const GValue * val, gint * min_loss, const GstVideoFormatInfo ** out_info)
+{
+  const gchar *fname;
+  const GstVideoFormatInfo *t_info;
+  GstVideoFormatFlags in_flags, t_flags;
+  gint loss;
+
+  fname = g_value_get_string (val);
+  t_info = gst_video_format_get_info (gst_video_format_from_string (fname));
+  if (!t_info)
+    return;
+
+  /* accept input format immediately without loss */
+  if (in_info == t_info) {
+    *min_loss = 0;
+    *out_info = t_info;
+    return;
+  }
+
+  loss = SCORE_FORMAT_CHANGE;
+
+  in_flags = GST_VIDEO_FORMAT_INFO_FLAGS (in_info);
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_LE;
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_COMPLEX;
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_UNPACK;
+
+  t_flags = GST_VIDEO_FORMAT_INFO_FLAGS (t_info);
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_LE;
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_COMPLEX;
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_UNPACK;
+
+  if ((t_flags & PALETTE_MASK) != (in_flags & PALETTE_MASK)) {
+    loss += SCORE_PALETTE_CHANGE;
+    if (t_flags & PALETTE_MASK)
+      loss += SCORE_PALETTE_LOSS;
+  }
+
+  if ((t_flags & COLORSPACE_MASK) != (in_flags & COLORSPACE_MASK)) {
+    loss += SCORE_COLORSPACE_LOSS;
+    if (t_flags & GST_VIDEO_FORMAT_FLAG_GRAY)
+      loss += SCORE_COLOR_LOSS;
+  }
+
+  if ((t_flags & ALPHA_MASK) != (in_flags & ALPHA_MASK)) {
+    loss += SCORE_ALPHA_CHANGE;
+    if (in_flags & ALPHA_MASK)
+      loss += SCORE_ALPHA_LOSS;
+  }
+
+  if ((in_info->h_sub[1]) != (t_info->h_sub[1])) {
+    loss += SCORE_CHROMA_H_CHANGE;
+    if ((in_info->h_sub[1]) < (t_info->h_sub[1]))
+      loss += SCORE_CHROMA_H_LOSS;
+  }
+  if ((in_info->w_sub[1]) != (t_info->w_sub[1])) {
+    loss += SCORE_CHROMA_W_CHANGE;
+    if ((in_info->w_sub[1]) < (t_info->w_sub[1]))
+      loss += SCORE_CHROMA_W_LOSS;
+  }
+
+  if ((in_info->bits) != (t_info->bits)) {
+    loss += SCORE_DEPTH_CHANGE;
+    if ((in_info->bits) > (t_info->bits))
+      loss += SCORE_DEPTH_LOSS;
+  }
+
+  GST_DEBUG_OBJECT (base, "score %s -> %s = %d",
+      GST_VIDEO_FORMAT_INFO_NAME (in_info),
+      GST_VIDEO_FORMAT_INFO_NAME (t_info), loss);
+
+  if (loss < *min_loss) {
+    GST_DEBUG_OBJECT (base, "found new best %d", loss);
+    *out_info = t_info;
+    *min_loss = loss;
+  }
+}
+
+static void
+gst_video_convert_scale_fixate_format (GstBaseTransform * base,
+    GstCaps * caps, GstCaps * result)
+{
+  GstStructure *ins, *outs;
+  const gchar *in_format;
+  const GstVideoFormatInfo *in_info, *out_info = NULL;
+  gint min_loss = G_MAXINT;
+  guint i, capslen;
+
+  ins = gst_caps_get_structure (caps, 0);
+  in_format = gst_structure_get_string (ins, "format");
+  if (!in_format)
+    return;
+
+  in_info =
+      gst_video_format_get_info (gst_video_format_from_string (in_format));
+  if (!in_info)
+    return;
+
+  outs = gst_caps_get_structure (result, 0);
+
+  capslen = gst_caps_get_size (result);
+  for (i = 0; i < capslen; i++) {
+    GstStructure *tests;
+    const GValue *format;
+
+    tests = gst_caps_get_structure (result, i);
+    format = gst_structure_get_value (tests, "format");
+    /* should not happen */
+    if (format == NULL)
+      continue;
+
+    if (GST_VALUE_HOLDS_LIST (format)) {
+      gint j, len;
+
+      len = gst_value_list_get_size (format);
+      for (j = 0; j < len; j++) {
+        const GValue *val;
+
+        val = gst_value_list_get_value (format, j);
+        if (G_VALUE_HOLDS_STRING (val)) {
+          score_value (base, in_info, val, &min_loss, &out_info);
+          if (min_loss == 0)
+            break;
+        }
+      }
+    } else if (G_VALUE_HOLDS_STRING (format)) {
+      score_value (base, in_info, format, &min_loss, &out_info);
+    }
+  }
+  if (out_info)
+    gst_structure_set (outs, "format", G_TYPE_STRING,
+        GST_VIDEO_FORMAT_INFO_NAME (out_info), NULL);
+}
+
+/* keep @field of the input when the output allows it, like videoconvert does
+ * by intersecting with the input caps. Without it the output would get the
+ * defaults for its size and need a conversion */
+static void
+gst_video_convert_scale_fixate_field (GstStructure * ins, GstStructure * outs,
+    const gchar * field)
+{
+  const GValue *in_val, *out_val;
+
+  in_val = gst_structure_get_value (ins, field);
+  if (in_val == NULL)
+    return;
+
+  out_val = gst_structure_get_value (outs, field);
+  if (out_val == NULL || gst_value_can_intersect (in_val, out_val))
+    gst_structure_set_value (outs, field, in_val);
+}
+
+static GstCaps *
+gst_video_convert_scale_fixate_caps (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, GstCaps * othercaps)
+{
+  GST_DEBUG_OBJECT (base, "trying to fixate othercaps %" GST_PTR_FORMAT
+      " based on caps %" GST_PTR_FORMAT, othercaps, caps);
+
+  /* pick the format with the least loss first, then let videoscale pick the
+   * size for it */
+  othercaps = gst_caps_make_writable (othercaps);
+  gst_video_convert_scale_fixate_format (base, caps, othercaps);
+
+  othercaps = GST_BASE_TRANSFORM_CLASS (parent_class)->fixate_caps (base,
+      direction, caps, othercaps);
+
+  othercaps = gst_caps_make_writable (othercaps);
+  if (!gst_caps_is_empty (othercaps)) {
+    GstStructure *ins = gst_caps_get_structure (caps, 0);
+    GstStructure *outs = gst_caps_get_structure (othercaps, 0);
+
+    gst_video_convert_scale_fixate_field (ins, outs, "colorimetry");
+    gst_video_convert_scale_fixate_field (ins, outs, "chroma-site");
+  }
+
+  /* fixate remaining fields */
+  othercaps = gst_caps_fixate (othercaps);
+
+  GST_DEBUG_OBJECT (base, "fixated to %" GST_PTR_FORMAT, othercaps);
+
+  return othercaps;
+}
@@ -79,6 +79,8 @@
 #include <gst/video/gstvideopool.h>
 
 #include "gstvideoscale.h"
+#include "gstladderscale.h"
+#include "gstvideoconvertscale.h"
 
 #define GST_CAT_DEFAULT video_scale_debug
 GST_DEBUG_CATEGORY_STATIC (video_scale_debug);
@@ -493,6 +495,7 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
 {
   GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
   gint from_dar_n, from_dar_d, to_dar_n, to_dar_d;
+  gboolean same_format;
 
   if (!gst_util_fraction_multiply (in_info->width,
           in_info->height, in_info->par_n, in_info->par_d, &from_dar_n,
@@ -532,7 +535,14 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
     }
   }
 
-  if (in_info->width == out_info->width && in_info->height == out_info->height
+  same_format = GST_VIDEO_INFO_FORMAT (in_info) ==
+      GST_VIDEO_INFO_FORMAT (out_info)
+      && gst_video_colorimetry_is_equal (&in_info->colorimetry,
+      &out_info->colorimetry)
+      && in_info->chroma_site == out_info->chroma_site;
+
+  if (same_format && in_info->width == out_info->width
+      && in_info->height == out_info->height
       && videoscale->borders_w == 0 && videoscale->borders_h == 0) {
     gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (filter), TRUE);
   } else {
@@ -622,14 +632,21 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
         out_info->width - videoscale->borders_w,
         GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT,
         out_info->height - videoscale->borders_h,
-        GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE,
-        GST_VIDEO_MATRIX_MODE_NONE, GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
-        GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
-        GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
-        GST_VIDEO_CHROMA_MODE_NONE,
         GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, videoscale->n_threads,
         NULL);
 
+    /* only scaling, don't touch the colors. When the format changes too
+     * (videoconvertscale) the converter does the full conversion in the same
+     * pass */
+    if (same_format) {
+      gst_structure_set (options,
+          GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE,
+          GST_VIDEO_MATRIX_MODE_NONE, GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+          GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
+          GST_VIDEO_CHROMA_MODE_NONE, NULL);
+    }
+
     if (videoscale->gamma_decode) {
       gst_structure_set (options,
           GST_VIDEO_CONVERTER_OPT_GAMMA_MODE, GST_TYPE_VIDEO_GAMMA_MODE,
@@ -638,7 +655,8 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
 
     if (videoscale->convert)
       gst_video_converter_free (videoscale->convert);
-    videoscale->convert = gst_video_converter_new (in_info, out_info, options);
+    videoscale->convert =
+        gst_video_converter_new_cached (in_info, out_info, options);
   }
 
   GST_DEBUG_OBJECT (videoscale, "from=%dx%d (par=%d/%d dar=%d/%d), size %"
@@ -1154,6 +1172,14 @@ plugin_init (GstPlugin * plugin)
           GST_TYPE_VIDEO_SCALE))
     return FALSE;
 
+  if (!gst_element_register (plugin, "ladderscale", GST_RANK_NONE,
+          GST_TYPE_LADDER_SCALE))
+    return FALSE;
+
+  if (!gst_element_register (plugin, "videoconvertscale", GST_RANK_NONE,
+          GST_TYPE_VIDEO_CONVERT_SCALE))
+    return FALSE;
+
   GST_DEBUG_CATEGORY_INIT (video_scale_debug, "videoscale", 0,
       "videoscale element");
   GST_DEBUG_CATEGORY_GET (CAT_PERFORMANCE, "GST_PERFORMANCE");
@@ -0,0 +1,571 @@
+/* GStreamer unit tests for decodebin3
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/base/gstpushsrc.h>
+
+static GType gst_test_codec_src_get_type (void);
+static GType gst_test_codec_dec_get_type (void);
+static GType gst_other_codec_dec_get_type (void);
+
+/* Every test codec source feeds its own decodebin3 input with a single
+ * video stream of caps "video/x-test-codec, codec=<codec>" */
+typedef struct
+{
+  GstElement *pipeline;
+  GstElement *dbin;
+  GstStreamCollection *collection;
+  GList *held_pads;
+} TestPipeline;
+
+static gboolean
+stream_has_codec (GstStream * stream, const gchar * codec)
+{
+  GstCaps *caps = gst_stream_get_caps (stream);
+  gboolean ret = FALSE;
+
+  if (caps) {
+    ret = !g_strcmp0 (gst_structure_get_string (gst_caps_get_structure (caps,
+                0), "codec"), codec);
+    gst_caps_unref (caps);
+  }
+
+  return ret;
+}
+
+/* only selects the stream of the first source initially */
+static gint
+select_stream_cb (GstElement * dbin, GstStreamCollection * collection,
+    GstStream * stream, const gchar * codec)
+{
+  return stream_has_codec (stream, codec) ? 1 : 0;
+}
+
+static void
+pad_added_cb (GstElement * dbin, GstPad * pad, GstBin * pipeline)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "sync", FALSE, NULL);
+  gst_bin_add (pipeline, sink);
+  gst_element_sync_state_with_parent (sink);
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  fail_unless_equals_int (gst_pad_link (pad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+}
+
+static GstPadProbeReturn
+hold_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  return GST_PAD_PROBE_OK;
+}
+
+/* Waits for a collection with @n_streams streams and stores it */
+static void
+wait_for_collection (TestPipeline * p, guint n_streams)
+{
+  GstBus *bus = gst_element_get_bus (p->pipeline);
+
+  gst_object_replace ((GstObject **) & p->collection, NULL);
+  while (p->collection == NULL) {
+    GstMessage *msg = gst_bus_timed_pop_filtered (bus, 10 * GST_SECOND,
+        GST_MESSAGE_STREAM_COLLECTION | GST_MESSAGE_ERROR);
+    GstStreamCollection *collection = NULL;
+
+    fail_unless (msg != NULL, "no collection with %u streams", n_streams);
+    fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_STREAM_COLLECTION);
+    gst_message_parse_stream_collection (msg, &collection);
+    if (gst_stream_collection_get_size (collection) == n_streams)
+      p->collection = gst_object_ref (collection);
+    gst_object_unref (collection);
+    gst_message_unref (msg);
+  }
+  gst_object_unref (bus);
+}
+
+/* Plays one source per codec into decodebin3 and waits until the stream
+ * collection contains all of them. Only the stream of the first codec is
+ * selected: the other sources are held back until it is */
+static void
+setup_pipeline (TestPipeline * p, const gchar ** codecs, guint n_codecs,
+    guint max_pooled_decoders, gboolean drop_unselected)
+{
+  guint i;
+
+  gst_element_register (NULL, "testcodecdec", GST_RANK_PRIMARY,
+      gst_test_codec_dec_get_type ());
+
+  p->pipeline = gst_pipeline_new (NULL);
+  p->dbin = gst_element_factory_make ("decodebin3", NULL);
+  fail_unless (p->dbin != NULL);
+  p->collection = NULL;
+  p->held_pads = NULL;
+  g_object_set (p->dbin, "max-pooled-decoders", max_pooled_decoders,
+      "drop-unselected", drop_unselected, NULL);
+  gst_bin_add (GST_BIN (p->pipeline), p->dbin);
+  g_signal_connect (p->dbin, "select-stream", G_CALLBACK (select_stream_cb),
+      (gpointer) codecs[0]);
+  g_signal_connect (p->dbin, "pad-added", G_CALLBACK (pad_added_cb),
+      p->pipeline);
+
+  for (i = 0; i < n_codecs; i++) {
+    GstElement *src = g_object_new (gst_test_codec_src_get_type (), NULL);
+    GstPad *srcpad, *sinkpad;
+
+    g_object_set_data (G_OBJECT (src), "codec", (gpointer) codecs[i]);
+    gst_bin_add (GST_BIN (p->pipeline), src);
+    srcpad = gst_element_get_static_pad (src, "src");
+    if (i == 0) {
+      sinkpad = gst_element_get_static_pad (p->dbin, "sink");
+    } else {
+      sinkpad = gst_element_get_request_pad (p->dbin, "sink_%u");
+      g_object_set_data (G_OBJECT (srcpad), "probe-id",
+          GUINT_TO_POINTER (gst_pad_add_probe (srcpad,
+                  GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM,
+                  (GstPadProbeCallback) hold_probe, NULL, NULL)));
+      p->held_pads = g_list_prepend (p->held_pads, gst_object_ref (srcpad));
+    }
+    fail_unless_equals_int (gst_pad_link (srcpad, sinkpad), GST_PAD_LINK_OK);
+    gst_object_unref (srcpad);
+    gst_object_unref (sinkpad);
+  }
+
+  fail_unless (gst_element_set_state (p->pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+
+  wait_for_collection (p, 1);
+  while (p->held_pads) {
+    GstPad *pad = p->held_pads->data;
+
+    gst_pad_remove_probe (pad,
+        GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (pad), "probe-id")));
+    gst_object_unref (pad);
+    p->held_pads = g_list_delete_link (p->held_pads, p->held_pads);
+  }
+  wait_for_collection (p, n_codecs);
+}
+
+static void
+cleanup_pipeline (TestPipeline * p)
+{
+  fail_unless_equals_int (gst_element_set_state (p->pipeline, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (p->collection);
+  gst_object_unref (p->pipeline);
+}
+
+static guint64
+get_stat (TestPipeline * p, const gchar * field)
+{
+  GstStructure *stats = NULL;
+  const GValue *v;
+  guint64 value;
+
+  g_object_get (p->dbin, "stats", &stats, NULL);
+  fail_unless (stats != NULL);
+  v = gst_structure_get_value (stats, field);
+  fail_unless (v != NULL, "no %s", field);
+  if (G_VALUE_HOLDS_UINT (v))
+    value = g_value_get_uint (v);
+  else
+    value = g_value_get_uint64 (v);
+  gst_structure_free (stats);
+
+  return value;
+}
+
+/* Waits up to 10 seconds for the @field statistic to reach @value */
+static void
+wait_for_stat (TestPipeline * p, const gchar * field, guint64 value)
+{
+  guint i;
+
+  for (i = 0; i < 1000 && get_stat (p, field) < value; i++)
+    g_usleep (10 * G_TIME_SPAN_MILLISECOND);
+  fail_unless (get_stat (p, field) >= value, "%s is %" G_GUINT64_FORMAT
+      " instead of %" G_GUINT64_FORMAT, field, get_stat (p, field), value);
+}
+
+/* Selects the stream of @codec only */
+static void
+select_codec (TestPipeline * p, const gchar * codec)
+{
+  GList *streams = NULL;
+  guint i;
+
+  for (i = 0; i < gst_stream_collection_get_size (p->collection); i++) {
+    GstStream *stream = gst_stream_collection_get_stream (p->collection, i);
+
+    if (stream_has_codec (stream, codec))
+      streams = g_list_append (streams,
+          (gchar *) gst_stream_get_stream_id (stream));
+  }
+  fail_unless (streams != NULL);
+
+  fail_unless (gst_element_send_event (p->dbin,
+          gst_event_new_select_streams (streams)));
+  g_list_free (streams);
+}
+
+GST_START_TEST (test_drop_unselected)
+{
+  const gchar *codecs[] = { "a", "b" };
+  TestPipeline p;
+
+  setup_pipeline (&p, codecs, G_N_ELEMENTS (codecs), 0, TRUE);
+
+  /* the "b" stream is not selected, its buffers never reach a decoder */
+  wait_for_stat (&p, "decoders-created", 1);
+  wait_for_stat (&p, "dropped-buffers", 1);
+  fail_unless_equals_uint64 (get_stat (&p, "decoders-created"), 1);
+
+  cleanup_pipeline (&p);
+}
+
+GST_END_TEST;
+
+/* Switching back to a stream must reuse its pooled decoder */
+GST_START_TEST (test_decoder_pool_reuse)
+{
+  const gchar *codecs[] = { "a", "b" };
+  TestPipeline p;
+
+  setup_pipeline (&p, codecs, G_N_ELEMENTS (codecs), 2, FALSE);
+  wait_for_stat (&p, "decoders-created", 1);
+
+  /* the "a" decoder does not accept "b", it is pooled */
+  select_codec (&p, "b");
+  wait_for_stat (&p, "decoders-created", 2);
+  fail_unless_equals_uint64 (get_stat (&p, "pooled-decoders"), 1);
+
+  /* the "a" decoder is taken out of the pool, the "b" one goes in */
+  select_codec (&p, "a");
+  wait_for_stat (&p, "decoders-reused", 1);
+  fail_unless_equals_uint64 (get_stat (&p, "decoders-created"), 2);
+  fail_unless_equals_uint64 (get_stat (&p, "pooled-decoders"), 1);
+
+  cleanup_pipeline (&p);
+}
+
+GST_END_TEST;
+
+/* The pool never holds more than "max-pooled-decoders" decoders, the least
+ * recently pooled ones are discarded */
+GST_START_TEST (test_decoder_pool_trim)
+{
+  const gchar *codecs[] = { "a", "b", "c" };
+  TestPipeline p;
+
+  setup_pipeline (&p, codecs, G_N_ELEMENTS (codecs), 1, FALSE);
+  wait_for_stat (&p, "decoders-created", 1);
+
+  select_codec (&p, "b");
+  wait_for_stat (&p, "decoders-created", 2);
+  fail_unless_equals_uint64 (get_stat (&p, "pooled-decoders"), 1);
+
+  /* pooling the "b" decoder discards the "a" one */
+  select_codec (&p, "c");
+  wait_for_stat (&p, "decoders-created", 3);
+  fail_unless_equals_uint64 (get_stat (&p, "pooled-decoders"), 1);
+
+  select_codec (&p, "a");
+  wait_for_stat (&p, "decoders-created", 4);
+  fail_unless_equals_uint64 (get_stat (&p, "decoders-reused"), 0);
+  fail_unless_equals_uint64 (get_stat (&p, "pooled-decoders"), 1);
+
+  cleanup_pipeline (&p);
+}
+
+GST_END_TEST;
+
+static gboolean
+has_decoder_of_type (TestPipeline * p, GType type)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean found = FALSE;
+
+  it = gst_bin_iterate_elements (GST_BIN (p->dbin));
+  while (!found && gst_iterator_next (it, &item) == GST_ITERATOR_OK) {
+    found = G_OBJECT_TYPE (g_value_get_object (&item)) == type;
+    g_value_reset (&item);
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return found;
+}
+
+/* A decoder registered after the factory lookups were cached must be
+ * picked up by the next lookup */
+GST_START_TEST (test_factory_cache_invalidation)
+{
+  const gchar *codecs[] = { "a" };
+  TestPipeline p;
+  guint64 invalidations;
+
+  setup_pipeline (&p, codecs, G_N_ELEMENTS (codecs), 0, FALSE);
+  wait_for_stat (&p, "decoders-created", 1);
+  fail_unless (has_decoder_of_type (&p, gst_test_codec_dec_get_type ()));
+  invalidations = get_stat (&p, "factory-cache-invalidations");
+  fail_unless (get_stat (&p, "factory-cache-misses") > 0);
+  cleanup_pipeline (&p);
+
+  fail_unless (gst_element_register (NULL, "othercodecdec",
+          GST_RANK_PRIMARY + 1, gst_other_codec_dec_get_type ()));
+
+  setup_pipeline (&p, codecs, G_N_ELEMENTS (codecs), 0, FALSE);
+  wait_for_stat (&p, "decoders-created", 1);
+  fail_unless (has_decoder_of_type (&p, gst_other_codec_dec_get_type ()));
+  fail_unless (get_stat (&p, "factory-cache-invalidations") > invalidations);
+  cleanup_pipeline (&p);
+}
+
+GST_END_TEST;
+
+/*** test codec source ***/
+
+typedef struct
+{
+  GstPushSrc parent;
+
+  guint n_buffers;
+} GstTestCodecSrc;
+
+typedef GstPushSrcClass GstTestCodecSrcClass;
+
+G_DEFINE_TYPE (GstTestCodecSrc, gst_test_codec_src, GST_TYPE_PUSH_SRC);
+
+static GstFlowReturn
+gst_test_codec_src_create (GstPushSrc * src, GstBuffer ** p_buf)
+{
+  GstTestCodecSrc *self = (GstTestCodecSrc *) src;
+  GstBuffer *buf;
+
+  /* 10 times faster than real time */
+  g_usleep (G_TIME_SPAN_MILLISECOND);
+
+  buf = gst_buffer_new_and_alloc (16);
+  gst_buffer_memset (buf, 0, 0, 16);
+  GST_BUFFER_PTS (buf) = self->n_buffers++ * 10 * GST_MSECOND;
+  GST_BUFFER_DURATION (buf) = 10 * GST_MSECOND;
+
+  *p_buf = buf;
+  return GST_FLOW_OK;
+}
+
+static GstCaps *
+gst_test_codec_src_get_caps (GstBaseSrc * src, GstCaps * filter)
+{
+  const gchar *codec = g_object_get_data (G_OBJECT (src), "codec");
+
+  return gst_caps_new_simple ("video/x-test-codec", "codec", G_TYPE_STRING,
+      codec ? codec : "none", NULL);
+}
+
+static void
+gst_test_codec_src_class_init (GstTestCodecSrcClass * klass)
+{
+  GstPushSrcClass *pushsrc_class = GST_PUSH_SRC_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+  static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src",
+      GST_PAD_SRC, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("video/x-test-codec")
+      );
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &src_templ);
+  gst_element_class_set_metadata (element_class,
+      "Test Codec Src", "Source/Video", "yep", "me");
+
+  pushsrc_class->create = gst_test_codec_src_create;
+  basesrc_class->get_caps = gst_test_codec_src_get_caps;
+}
+
+static void
+gst_test_codec_src_init (GstTestCodecSrc * src)
+{
+  gst_base_src_set_format (GST_BASE_SRC (src), GST_FORMAT_TIME);
+}
+
+/*** test codec decoder ***/
+
+/* Decodes a single codec: once it got caps, it only accepts caps with the
+ * same codec, also after going back to READY */
+typedef struct
+{
+  GstElement parent;
+
+  GstPad *srcpad;
+  gchar *codec;                 /* protected by the object lock */
+} GstTestCodecDec;
+
+typedef GstElementClass GstTestCodecDecClass;
+
+G_DEFINE_TYPE (GstTestCodecDec, gst_test_codec_dec, GST_TYPE_ELEMENT);
+
+static gboolean
+gst_test_codec_dec_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstTestCodecDec *self = (GstTestCodecDec *) parent;
+  GstCaps *caps;
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_CAPS) {
+    gst_event_parse_caps (event, &caps);
+    GST_OBJECT_LOCK (self);
+    g_free (self->codec);
+    self->codec = g_strdup (gst_structure_get_string
+        (gst_caps_get_structure (caps, 0), "codec"));
+    GST_OBJECT_UNLOCK (self);
+    gst_event_unref (event);
+
+    caps = gst_caps_new_empty_simple ("video/x-raw");
+    gst_pad_set_caps (self->srcpad, caps);
+    gst_caps_unref (caps);
+    return TRUE;
+  }
+
+  return gst_pad_push_event (self->srcpad, event);
+}
+
+static gboolean
+gst_test_codec_dec_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstTestCodecDec *self = (GstTestCodecDec *) parent;
+
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ACCEPT_CAPS) {
+    GstCaps *caps, *templ;
+    gboolean result;
+
+    gst_query_parse_accept_caps (query, &caps);
+    templ = gst_pad_get_pad_template_caps (pad);
+    result = gst_caps_can_intersect (caps, templ);
+    gst_caps_unref (templ);
+
+    GST_OBJECT_LOCK (self);
+    if (result && self->codec)
+      result = !g_strcmp0 (gst_structure_get_string
+          (gst_caps_get_structure (caps, 0), "codec"), self->codec);
+    GST_OBJECT_UNLOCK (self);
+
+    gst_query_set_accept_caps_result (query, result);
+    return TRUE;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+static GstFlowReturn
+gst_test_codec_dec_sink_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buf)
+{
+  GstTestCodecDec *self = (GstTestCodecDec *) parent;
+
+  return gst_pad_push (self->srcpad, buf);
+}
+
+static void
+gst_test_codec_dec_finalize (GObject * object)
+{
+  GstTestCodecDec *self = (GstTestCodecDec *) object;
+
+  g_free (self->codec);
+
+  G_OBJECT_CLASS (gst_test_codec_dec_parent_class)->finalize (object);
+}
+
+static void
+gst_test_codec_dec_class_init (GstTestCodecDecClass * klass)
+{
+  static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
+      GST_PAD_SINK, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("video/x-test-codec"));
+  static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src",
+      GST_PAD_SRC, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("video/x-raw"));
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  G_OBJECT_CLASS (klass)->finalize = gst_test_codec_dec_finalize;
+
+  gst_element_class_add_static_pad_template (element_class, &sink_templ);
+  gst_element_class_add_static_pad_template (element_class, &src_templ);
+  gst_element_class_set_metadata (element_class,
+      "Test Codec Decoder", "Codec/Decoder/Video", "yep", "me");
+}
+
+static void
+gst_test_codec_dec_init (GstTestCodecDec * self)
+{
+  GstPad *pad;
+
+  pad =
+      gst_pad_new_from_template (gst_element_class_get_pad_template
+      (GST_ELEMENT_GET_CLASS (self), "sink"), "sink");
+  gst_pad_set_event_function (pad, gst_test_codec_dec_sink_event);
+  gst_pad_set_query_function (pad, gst_test_codec_dec_sink_query);
+  gst_pad_set_chain_function (pad, gst_test_codec_dec_sink_chain);
+  gst_element_add_pad (GST_ELEMENT (self), pad);
+
+  self->srcpad =
+      gst_pad_new_from_template (gst_element_class_get_pad_template
+      (GST_ELEMENT_GET_CLASS (self), "src"), "src");
+  gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
+}
+
+/* the same decoder, registered as another factory */
+typedef GstTestCodecDec GstOtherCodecDec;
+typedef GstTestCodecDecClass GstOtherCodecDecClass;
+
+G_DEFINE_TYPE (GstOtherCodecDec, gst_other_codec_dec,
+    gst_test_codec_dec_get_type ());
+
+static void
+gst_other_codec_dec_class_init (GstOtherCodecDecClass * klass)
+{
+}
+
+static void
+gst_other_codec_dec_init (GstOtherCodecDec * self)
+{
+}
+
+static Suite *
+decodebin3_suite (void)
+{
+  Suite *s = suite_create ("decodebin3");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_set_timeout (tc_chain, 30);
+  tcase_add_test (tc_chain, test_drop_unselected);
+  tcase_add_test (tc_chain, test_decoder_pool_reuse);
+  tcase_add_test (tc_chain, test_decoder_pool_trim);
+  tcase_add_test (tc_chain, test_factory_cache_invalidation);
+
+  return s;
+}
+
+GST_CHECK_MAIN (decodebin3);
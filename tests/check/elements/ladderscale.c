@@ -0,0 +1,250 @@
+/* GStreamer
+ *
+ * unit test for ladderscale
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/video/video.h>
+
+#define NUM_BUFFERS 5
+
+static void
+handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    guint * count)
+{
+  *count += 1;
+}
+
+static void
+check_output (GstElement * pipeline, const gchar * name, guint count,
+    gint width, gint height)
+{
+  GstElement *sink;
+  GstVideoInfo info;
+  GstCaps *caps;
+  GstPad *pad;
+
+  fail_unless_equals_int (count, NUM_BUFFERS);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  fail_unless (sink != NULL);
+  pad = gst_element_get_static_pad (sink, "sink");
+  caps = gst_pad_get_current_caps (pad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&info),
+      GST_VIDEO_FORMAT_I420);
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), width);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), height);
+  gst_caps_unref (caps);
+  gst_object_unref (pad);
+  gst_object_unref (sink);
+}
+
+GST_START_TEST (test_ladder_outputs)
+{
+  GstElement *pipeline;
+  GstElement *sink;
+  GstMessage *msg;
+  guint counts[3] = { 0, };
+  guint i;
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=I420,width=320,height=240,pixel-aspect-ratio=1/1 ! "
+      "ladderscale name=l "
+      "l. ! video/x-raw,width=240,height=180 ! queue ! "
+      "fakesink name=s0 signal-handoffs=true "
+      "l. ! video/x-raw,width=120,height=90 ! queue ! "
+      "fakesink name=s1 signal-handoffs=true "
+      "l. ! video/x-raw,width=80 ! queue ! "
+      "fakesink name=s2 signal-handoffs=true", NULL);
+  fail_unless (pipeline != NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (counts); i++) {
+    gchar *name = g_strdup_printf ("s%u", i);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    g_signal_connect (sink, "handoff", G_CALLBACK (handoff_cb), &counts[i]);
+    gst_object_unref (sink);
+    g_free (name);
+  }
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  /* 120x90 is scaled from 240x180, the others from the input, the height
+   * of the last output follows the aspect ratio of the input */
+  check_output (pipeline, "s0", counts[0], 240, 180);
+  check_output (pipeline, "s1", counts[1], 120, 90);
+  check_output (pipeline, "s2", counts[2], 80, 60);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_ladder_cascade_matches_direct)
+{
+  GstElement *pipeline;
+  GstElement *sink;
+  GstSample *samples[2];
+  GstMessage *msg;
+  GstMapInfo map1, map2;
+  guint i;
+
+  /* the same output size once next to a bigger output it can be scaled
+   * from and once only from the input, both need to look alike */
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=1 "
+      "pattern=gradient ! video/x-raw,format=I420,width=320,height=240 ! "
+      "tee name=t "
+      "t. ! queue ! ladderscale name=l1 "
+      "l1. ! video/x-raw,width=160,height=120 ! queue ! fakesink "
+      "l1. ! video/x-raw,width=80,height=60 ! queue ! "
+      "fakesink name=s0 enable-last-sample=true "
+      "t. ! queue ! ladderscale name=l2 "
+      "l2. ! video/x-raw,width=80,height=60 ! "
+      "fakesink name=s1 enable-last-sample=true", NULL);
+  fail_unless (pipeline != NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  for (i = 0; i < 2; i++) {
+    gchar *name = g_strdup_printf ("s%u", i);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    g_object_get (sink, "last-sample", &samples[i], NULL);
+    fail_unless (samples[i] != NULL);
+    gst_object_unref (sink);
+    g_free (name);
+  }
+
+  gst_buffer_map (gst_sample_get_buffer (samples[0]), &map1, GST_MAP_READ);
+  gst_buffer_map (gst_sample_get_buffer (samples[1]), &map2, GST_MAP_READ);
+  fail_unless_equals_int (map1.size, map2.size);
+  for (i = 0; i < map1.size; i++)
+    fail_unless (ABS (map1.data[i] - map2.data[i]) <= 6,
+        "byte %u differs too much: %u != %u", i, map1.data[i], map2.data[i]);
+  gst_buffer_unmap (gst_sample_get_buffer (samples[1]), &map2);
+  gst_buffer_unmap (gst_sample_get_buffer (samples[0]), &map1);
+
+  gst_sample_unref (samples[0]);
+  gst_sample_unref (samples[1]);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_request_release_pads)
+{
+  GstElement *ladder;
+  GstPad *pad1, *pad2;
+
+  ladder = gst_element_factory_make ("ladderscale", NULL);
+  fail_unless (ladder != NULL);
+
+  pad1 = gst_element_get_request_pad (ladder, "src_%u");
+  pad2 = gst_element_get_request_pad (ladder, "src_%u");
+  fail_unless (pad1 != NULL && pad2 != NULL);
+  fail_unless_equals_string (GST_PAD_NAME (pad1), "src_0");
+  fail_unless_equals_string (GST_PAD_NAME (pad2), "src_1");
+
+  gst_element_release_request_pad (ladder, pad1);
+  gst_object_unref (pad1);
+  gst_element_release_request_pad (ladder, pad2);
+  gst_object_unref (pad2);
+
+  fail_unless_equals_int (GST_ELEMENT (ladder)->numsrcpads, 0);
+
+  gst_object_unref (ladder);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_request_pad_names)
+{
+  GstElement *ladder;
+  GstPad *pad1, *pad2, *pad3;
+
+  ladder = gst_element_factory_make ("ladderscale", NULL);
+  fail_unless (ladder != NULL);
+
+  pad1 = gst_element_get_request_pad (ladder, "src_1");
+  fail_unless (pad1 != NULL);
+  fail_unless_equals_string (GST_PAD_NAME (pad1), "src_1");
+
+  /* names must be unique */
+  fail_unless (gst_element_get_request_pad (ladder, "src_1") == NULL);
+
+  /* automatic names continue after the highest requested one and don't
+   * collide with explicitly requested ones */
+  pad2 = gst_element_get_request_pad (ladder, "src_%u");
+  fail_unless (pad2 != NULL);
+  fail_unless_equals_string (GST_PAD_NAME (pad2), "src_2");
+  pad3 = gst_element_get_request_pad (ladder, "src_0");
+  fail_unless (pad3 != NULL);
+  fail_unless_equals_string (GST_PAD_NAME (pad3), "src_0");
+
+  /* a released name can be requested again */
+  gst_element_release_request_pad (ladder, pad1);
+  gst_object_unref (pad1);
+  pad1 = gst_element_get_request_pad (ladder, "src_1");
+  fail_unless (pad1 != NULL);
+
+  gst_element_release_request_pad (ladder, pad1);
+  gst_object_unref (pad1);
+  gst_element_release_request_pad (ladder, pad2);
+  gst_object_unref (pad2);
+  gst_element_release_request_pad (ladder, pad3);
+  gst_object_unref (pad3);
+
+  gst_object_unref (ladder);
+}
+
+GST_END_TEST;
+
+static Suite *
+ladderscale_suite (void)
+{
+  Suite *s = suite_create ("ladderscale");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_ladder_outputs);
+  tcase_add_test (tc_chain, test_ladder_cascade_matches_direct);
+  tcase_add_test (tc_chain, test_request_release_pads);
+  tcase_add_test (tc_chain, test_request_pad_names);
+
+  return s;
+}
+
+GST_CHECK_MAIN (ladderscale);
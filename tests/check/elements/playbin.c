@@ -28,11 +28,13 @@
 
 #include <gst/check/gstcheck.h>
 #include <gst/base/gstpushsrc.h>
+#include <gst/base/gstbasesink.h>
 
 #ifndef GST_DISABLE_REGISTRY
 
 static GType gst_red_video_src_get_type (void);
 static GType gst_codec_src_get_type (void);
+static GType gst_test_video_sink_get_type (void);
 
 GST_START_TEST (test_uri)
 {
@@ -605,6 +607,308 @@ GST_START_TEST (test_element_setup)
 
 GST_END_TEST;
 
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  GPtrArray *milestones;
+  guint n_sources;
+  guint n_about_to_finish;
+} MilestoneData;
+
+static GstBusSyncReply
+milestone_sync_handler (GstBus * bus, GstMessage * msg, MilestoneData * data)
+{
+  const GstStructure *s = gst_message_get_structure (msg);
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ELEMENT
+      && gst_structure_has_name (s, "playback-milestone")) {
+    g_mutex_lock (&data->lock);
+    g_ptr_array_add (data->milestones,
+        g_strdup (gst_structure_get_string (s, "milestone")));
+    g_cond_broadcast (&data->cond);
+    g_mutex_unlock (&data->lock);
+  }
+
+  return GST_BUS_PASS;
+}
+
+/* index of the @nth (from 0) @milestone or -1, called with the lock */
+static gint
+find_milestone (MilestoneData * data, const gchar * milestone, guint nth)
+{
+  guint i;
+
+  for (i = 0; i < data->milestones->len; i++) {
+    if (!strcmp (g_ptr_array_index (data->milestones, i), milestone)
+        && nth-- == 0)
+      return i;
+  }
+  return -1;
+}
+
+/* holds back the data of the n-th source until its source-opened milestone
+ * was posted, so the milestones are posted in a deterministic order */
+static GstPadProbeReturn
+hold_source_probe (GstPad * pad, GstPadProbeInfo * info, MilestoneData * data)
+{
+  guint nth = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (pad), "nth"));
+
+  g_mutex_lock (&data->lock);
+  while (find_milestone (data, "source-opened", nth) == -1)
+    g_cond_wait (&data->cond, &data->lock);
+  g_mutex_unlock (&data->lock);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static void
+milestone_source_setup (GstElement * playbin, GstElement * source,
+    MilestoneData * data)
+{
+  GstPad *pad = gst_element_get_static_pad (source, "src");
+
+  g_object_set (source, "num-buffers", 3, NULL);
+  g_object_set_data (G_OBJECT (pad), "nth",
+      GUINT_TO_POINTER (data->n_sources++));
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+      (GstPadProbeCallback) hold_source_probe, data, NULL);
+  gst_object_unref (pad);
+}
+
+static void
+milestone_about_to_finish (GstElement * playbin, MilestoneData * data)
+{
+  if (data->n_about_to_finish++ == 0)
+    g_object_set (playbin, "uri", "redvideo://", NULL);
+}
+
+static GstElement *
+setup_milestone_playbin (MilestoneData * data)
+{
+  GstElement *playbin, *videosink;
+  GstBus *bus;
+
+  if (!gst_registry_check_feature_version (gst_registry_get (), "redvideosrc",
+          GST_VERSION_MAJOR, GST_VERSION_MINOR, 0)) {
+    fail_unless (gst_element_register (NULL, "redvideosrc", GST_RANK_PRIMARY,
+            gst_red_video_src_get_type ()));
+  }
+
+  g_mutex_init (&data->lock);
+  g_cond_init (&data->cond);
+  data->milestones = g_ptr_array_new_with_free_func (g_free);
+  data->n_sources = 0;
+  data->n_about_to_finish = 0;
+
+  playbin = gst_element_factory_make ("playbin", NULL);
+  g_object_set (playbin, "uri", "redvideo://", NULL);
+  videosink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (videosink, "sync", FALSE, NULL);
+  g_object_set (playbin, "video-sink", videosink, NULL);
+
+  g_signal_connect (playbin, "source-setup",
+      G_CALLBACK (milestone_source_setup), data);
+  g_signal_connect (playbin, "about-to-finish",
+      G_CALLBACK (milestone_about_to_finish), data);
+
+  bus = gst_element_get_bus (playbin);
+  gst_bus_set_sync_handler (bus, (GstBusSyncHandler) milestone_sync_handler,
+      data, NULL);
+  gst_object_unref (bus);
+
+  return playbin;
+}
+
+static void
+cleanup_milestone_playbin (GstElement * playbin, MilestoneData * data)
+{
+  fail_unless_equals_int (gst_element_set_state (playbin, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (playbin);
+
+  g_ptr_array_unref (data->milestones);
+  g_cond_clear (&data->cond);
+  g_mutex_clear (&data->lock);
+}
+
+GST_START_TEST (test_playback_milestones)
+{
+  MilestoneData data;
+  GstElement *playbin;
+  gint opened, first_buffer, preroll;
+
+  playbin = setup_milestone_playbin (&data);
+
+  fail_unless_equals_int (gst_element_set_state (playbin, GST_STATE_PAUSED),
+      GST_STATE_CHANGE_ASYNC);
+  fail_unless_equals_int (gst_element_get_state (playbin, NULL, NULL,
+          GST_CLOCK_TIME_NONE), GST_STATE_CHANGE_SUCCESS);
+
+  g_mutex_lock (&data.lock);
+  opened = find_milestone (&data, "source-opened", 0);
+  first_buffer = find_milestone (&data, "first-buffer-at-sink", 0);
+  preroll = find_milestone (&data, "preroll", 0);
+  g_mutex_unlock (&data.lock);
+
+  fail_unless (opened >= 0);
+  fail_unless (first_buffer > opened);
+  fail_unless (preroll > first_buffer);
+
+  cleanup_milestone_playbin (playbin, &data);
+}
+
+GST_END_TEST;
+
+/* first-buffer-at-sink must be posted again after a gapless switch */
+GST_START_TEST (test_playback_milestones_gapless)
+{
+  MilestoneData data;
+  GstElement *playbin;
+  GstMessage *msg;
+  GstBus *bus;
+  gint opened, first_buffer;
+
+  playbin = setup_milestone_playbin (&data);
+
+  fail_unless (gst_element_set_state (playbin, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (playbin);
+  msg = gst_bus_timed_pop_filtered (bus, 10 * GST_SECOND,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless (msg != NULL);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  fail_unless (data.n_about_to_finish > 0);
+  fail_unless_equals_int (data.n_sources, 2);
+
+  g_mutex_lock (&data.lock);
+  opened = find_milestone (&data, "source-opened", 1);
+  first_buffer = find_milestone (&data, "first-buffer-at-sink", 1);
+  fail_unless (find_milestone (&data, "first-buffer-at-sink", 2) == -1);
+  g_mutex_unlock (&data.lock);
+
+  fail_unless (opened >= 0);
+  fail_unless (first_buffer > opened);
+
+  cleanup_milestone_playbin (playbin, &data);
+}
+
+GST_END_TEST;
+
+/* holds back the data of the source until the sinks for fast-start-caps
+ * were prepared, so the chains can only be built after that */
+static GstPadProbeReturn
+hold_until_sinks_prepared (GstPad * pad, GstPadProbeInfo * info,
+    MilestoneData * data)
+{
+  g_mutex_lock (&data->lock);
+  while (find_milestone (data, "sinks-prepared", 0) == -1)
+    g_cond_wait (&data->cond, &data->lock);
+  g_mutex_unlock (&data->lock);
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static void
+fast_start_source_setup (GstElement * playbin, GstElement * source,
+    MilestoneData * data)
+{
+  GstPad *pad = gst_element_get_static_pad (source, "src");
+
+  data->n_sources++;
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_DATA_DOWNSTREAM,
+      (GstPadProbeCallback) hold_until_sinks_prepared, data, NULL);
+  gst_object_unref (pad);
+}
+
+/* playbin3 must prepare the default video sink for fast-start-caps and
+ * use it once the video chain is built */
+GST_START_TEST (test_playbin3_fast_start_caps)
+{
+  MilestoneData data;
+  GstElement *playbin, *prepared_sink = NULL, *sink = NULL;
+  GstPluginFeature *feature;
+  GstCaps *caps;
+  GstBus *bus;
+  gint setup, prepared, preroll;
+
+  if (!gst_registry_check_feature_version (gst_registry_get (), "redvideosrc",
+          GST_VERSION_MAJOR, GST_VERSION_MINOR, 0)) {
+    fail_unless (gst_element_register (NULL, "redvideosrc", GST_RANK_PRIMARY,
+            gst_red_video_src_get_type ()));
+  }
+  /* only the elements of core and -base are available to the tests */
+  feature = gst_registry_lookup_feature (gst_registry_get (), "autovideosink");
+  if (feature == NULL) {
+    fail_unless (gst_element_register (NULL, "autovideosink", GST_RANK_NONE,
+            gst_test_video_sink_get_type ()));
+  } else {
+    gst_object_unref (feature);
+  }
+
+  g_mutex_init (&data.lock);
+  g_cond_init (&data.cond);
+  data.milestones = g_ptr_array_new_with_free_func (g_free);
+  data.n_sources = 0;
+  data.n_about_to_finish = 0;
+
+  playbin = gst_element_factory_make ("playbin3", NULL);
+  fail_unless (playbin != NULL);
+  caps = gst_caps_new_empty_simple ("video/x-raw");
+  g_object_set (playbin, "uri", "redvideo://", "fast-start-caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  g_signal_connect (playbin, "source-setup",
+      G_CALLBACK (fast_start_source_setup), &data);
+  bus = gst_element_get_bus (playbin);
+  gst_bus_set_sync_handler (bus, (GstBusSyncHandler) milestone_sync_handler,
+      &data, NULL);
+  gst_object_unref (bus);
+
+  fail_unless_equals_int (gst_element_set_state (playbin, GST_STATE_PAUSED),
+      GST_STATE_CHANGE_ASYNC);
+
+  /* no chain exists yet, the video sink is the prepared one */
+  g_mutex_lock (&data.lock);
+  while (find_milestone (&data, "sinks-prepared", 0) == -1)
+    g_cond_wait (&data.cond, &data.lock);
+  g_mutex_unlock (&data.lock);
+  g_object_get (playbin, "video-sink", &prepared_sink, NULL);
+  fail_unless (prepared_sink != NULL);
+
+  fail_unless_equals_int (gst_element_get_state (playbin, NULL, NULL,
+          GST_CLOCK_TIME_NONE), GST_STATE_CHANGE_SUCCESS);
+
+  g_object_get (playbin, "video-sink", &sink, NULL);
+  fail_unless (sink == prepared_sink);
+  gst_object_unref (sink);
+  gst_object_unref (prepared_sink);
+  fail_unless_equals_int (data.n_sources, 1);
+
+  g_mutex_lock (&data.lock);
+  setup = find_milestone (&data, "source-setup", 0);
+  prepared = find_milestone (&data, "sinks-prepared", 0);
+  preroll = find_milestone (&data, "preroll", 0);
+  fail_unless (find_milestone (&data, "stream-collection", 0) >= 0);
+  fail_unless (find_milestone (&data, "first-decoded-pad", 0) >= 0);
+  fail_unless (find_milestone (&data, "source-setup", 1) == -1);
+  fail_unless (find_milestone (&data, "sinks-prepared", 1) == -1);
+  fail_unless (find_milestone (&data, "first-decoded-pad", 1) == -1);
+  g_mutex_unlock (&data.lock);
+
+  fail_unless (setup >= 0);
+  fail_unless (prepared >= 0);
+  fail_unless (preroll > prepared);
+
+  cleanup_milestone_playbin (playbin, &data);
+}
+
+GST_END_TEST;
+
 /*** redvideo:// source ***/
 
 static GstURIType
@@ -815,6 +1119,31 @@ gst_codec_src_init (GstCodecSrc * src)
 {
 }
 
+/*** autovideosink replacement ***/
+
+typedef GstBaseSink GstTestVideoSink;
+typedef GstBaseSinkClass GstTestVideoSinkClass;
+
+G_DEFINE_TYPE (GstTestVideoSink, gst_test_video_sink, GST_TYPE_BASE_SINK);
+
+static void
+gst_test_video_sink_class_init (GstTestVideoSinkClass * klass)
+{
+  static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
+      GST_PAD_SINK, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS_ANY);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &sink_templ);
+  gst_element_class_set_metadata (element_class,
+      "Test Video Sink", "Sink/Video", "yep", "me");
+}
+
+static void
+gst_test_video_sink_init (GstTestVideoSink * sink)
+{
+}
+
 #if 0
 GST_START_TEST (test_appsink_twice)
 {
@@ -902,6 +1231,9 @@ playbin_suite (void)
   tcase_add_test (tc_chain, test_refcount);
   tcase_add_test (tc_chain, test_source_setup);
   tcase_add_test (tc_chain, test_element_setup);
+  tcase_add_test (tc_chain, test_playback_milestones);
+  tcase_add_test (tc_chain, test_playback_milestones_gapless);
+  tcase_add_test (tc_chain, test_playbin3_fast_start_caps);
 
 #if 0
   {
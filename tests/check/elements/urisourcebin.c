@@ -0,0 +1,289 @@
+/* GStreamer unit tests for urisourcebin
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <gst/check/gstcheck.h>
+#include <gst/base/gstpushsrc.h>
+
+#ifndef GST_DISABLE_REGISTRY
+
+static GType gst_throttle_src_get_type (void);
+
+/* the throttle:// source delivers THROTTLE_BUFFER_SIZE bytes every
+ * THROTTLE_INTERVAL, 100000 bytes/s */
+#define THROTTLE_BUFFER_SIZE 1000
+#define THROTTLE_INTERVAL    (10 * G_TIME_SPAN_MILLISECOND)
+#define THROTTLE_RATE        (THROTTLE_BUFFER_SIZE * G_USEC_PER_SEC / \
+    THROTTLE_INTERVAL)
+
+/* bitrate in bits/s put into the tags of the throttle:// stream */
+static guint throttle_bitrate;
+
+static void
+pad_added_cb (GstElement * urisrc, GstPad * pad, GstElement * sink)
+{
+  GstPad *sinkpad = gst_element_get_static_pad (sink, "sink");
+
+  fail_unless (gst_pad_link (pad, sinkpad) == GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+}
+
+static GstElement *
+find_queue2 (GstElement * urisrc)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GstElement *queue = NULL;
+
+  it = gst_bin_iterate_elements (GST_BIN (urisrc));
+  while (queue == NULL && gst_iterator_next (it, &item) == GST_ITERATOR_OK) {
+    GstElement *element = g_value_get_object (&item);
+    GstElementFactory *factory = gst_element_get_factory (element);
+
+    if (factory && !strcmp (GST_OBJECT_NAME (factory), "queue2"))
+      queue = gst_object_ref (element);
+    g_value_reset (&item);
+  }
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return queue;
+}
+
+/* plays throttle:// with adaptive buffering and returns the high watermark
+ * the buffering queue ends up with */
+static gdouble
+run_adaptive_buffering (guint bitrate)
+{
+  GstElement *pipeline, *urisrc, *sink, *queue = NULL;
+  gdouble high = 0.6, low = 0.0;
+  guint i;
+
+  fail_unless (gst_element_register (NULL, "throttlesrc", GST_RANK_PRIMARY,
+          gst_throttle_src_get_type ()));
+  throttle_bitrate = bitrate;
+
+  pipeline = gst_pipeline_new (NULL);
+  urisrc = gst_element_factory_make ("urisourcebin", NULL);
+  fail_unless (urisrc != NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  fail_unless (sink != NULL);
+  g_object_set (sink, "sync", FALSE, NULL);
+  g_object_set (urisrc, "uri", "throttle://", "adaptive-buffering", TRUE,
+      NULL);
+  gst_bin_add_many (GST_BIN (pipeline), urisrc, sink, NULL);
+  g_signal_connect (urisrc, "pad-added", G_CALLBACK (pad_added_cb), sink);
+
+  fail_unless (gst_element_set_state (pipeline, GST_STATE_PLAYING) !=
+      GST_STATE_CHANGE_FAILURE);
+
+  /* the rate needs a couple of measurement windows before the watermarks
+   * are adapted, give up after 10 seconds */
+  for (i = 0; i < 200; i++) {
+    if (queue == NULL)
+      queue = find_queue2 (urisrc);
+    if (queue != NULL) {
+      g_object_get (queue, "high-watermark", &high, "low-watermark", &low,
+          NULL);
+      if (fabs (high - 0.6) > 0.02)
+        break;
+    }
+    g_usleep (50 * G_TIME_SPAN_MILLISECOND);
+  }
+  fail_unless (queue != NULL);
+  fail_unless (fabs (low - 0.01) < 1e-6, "low watermark %f", low);
+
+  gst_object_unref (queue);
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (pipeline);
+
+  return high;
+}
+
+GST_START_TEST (test_adaptive_buffering_slow_link)
+{
+  gdouble high;
+
+  /* the stream plays 8 times faster than it downloads, most of the queue
+   * must be filled before playback can start */
+  high = run_adaptive_buffering (THROTTLE_RATE * 8 * 8);
+  fail_unless (high > 0.7, "high watermark %f", high);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_adaptive_buffering_fast_link)
+{
+  gdouble high;
+
+  /* the stream downloads 4 times faster than it plays, playback can start
+   * right away */
+  high = run_adaptive_buffering (THROTTLE_RATE * 8 / 4);
+  fail_unless (high < 0.2, "high watermark %f", high);
+}
+
+GST_END_TEST;
+
+/*** throttle:// source ***/
+
+static GstURIType
+gst_throttle_src_uri_get_type (GType type)
+{
+  return GST_URI_SRC;
+}
+
+static const gchar *const *
+gst_throttle_src_uri_get_protocols (GType type)
+{
+  static const gchar *protocols[] = { "throttle", NULL };
+
+  return protocols;
+}
+
+static gchar *
+gst_throttle_src_uri_get_uri (GstURIHandler * handler)
+{
+  return g_strdup ("throttle://");
+}
+
+static gboolean
+gst_throttle_src_uri_set_uri (GstURIHandler * handler, const gchar * uri,
+    GError ** error)
+{
+  return (uri != NULL && g_str_has_prefix (uri, "throttle:"));
+}
+
+static void
+gst_throttle_src_uri_handler_init (gpointer g_iface, gpointer iface_data)
+{
+  GstURIHandlerInterface *iface = (GstURIHandlerInterface *) g_iface;
+
+  iface->get_type = gst_throttle_src_uri_get_type;
+  iface->get_protocols = gst_throttle_src_uri_get_protocols;
+  iface->get_uri = gst_throttle_src_uri_get_uri;
+  iface->set_uri = gst_throttle_src_uri_set_uri;
+}
+
+static void
+gst_throttle_src_init_type (GType type)
+{
+  static const GInterfaceInfo uri_hdlr_info = {
+    gst_throttle_src_uri_handler_init, NULL, NULL
+  };
+
+  g_type_add_interface_static (type, GST_TYPE_URI_HANDLER, &uri_hdlr_info);
+}
+
+typedef struct
+{
+  GstPushSrc parent;
+
+  guint n_buffers;
+} GstThrottleSrc;
+
+typedef GstPushSrcClass GstThrottleSrcClass;
+
+G_DEFINE_TYPE_WITH_CODE (GstThrottleSrc, gst_throttle_src,
+    GST_TYPE_PUSH_SRC, gst_throttle_src_init_type (g_define_type_id));
+
+static GstFlowReturn
+gst_throttle_src_create (GstPushSrc * src, GstBuffer ** p_buf)
+{
+  GstThrottleSrc *self = (GstThrottleSrc *) src;
+  GstBuffer *buf;
+
+  /* send the tags after the first buffer, the segment is out then */
+  if (self->n_buffers++ == 1)
+    gst_pad_push_event (GST_BASE_SRC_PAD (src),
+        gst_event_new_tag (gst_tag_list_new (GST_TAG_BITRATE,
+                throttle_bitrate, NULL)));
+
+  g_usleep (THROTTLE_INTERVAL);
+
+  buf = gst_buffer_new_and_alloc (THROTTLE_BUFFER_SIZE);
+  gst_buffer_memset (buf, 0, 0, THROTTLE_BUFFER_SIZE);
+
+  *p_buf = buf;
+  return GST_FLOW_OK;
+}
+
+static gboolean
+gst_throttle_src_query (GstBaseSrc * src, GstQuery * query)
+{
+  /* make urisourcebin treat this like a network stream */
+  if (GST_QUERY_TYPE (query) == GST_QUERY_SCHEDULING) {
+    gst_query_set_scheduling (query, GST_SCHEDULING_FLAG_SEQUENTIAL |
+        GST_SCHEDULING_FLAG_BANDWIDTH_LIMITED, 1, -1, 0);
+    gst_query_add_scheduling_mode (query, GST_PAD_MODE_PUSH);
+    return TRUE;
+  }
+
+  return GST_BASE_SRC_CLASS (gst_throttle_src_parent_class)->query (src,
+      query);
+}
+
+static void
+gst_throttle_src_class_init (GstThrottleSrcClass * klass)
+{
+  GstPushSrcClass *pushsrc_class = GST_PUSH_SRC_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+  static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src",
+      GST_PAD_SRC, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("application/x-throttle")
+      );
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (element_class, &src_templ);
+  gst_element_class_set_metadata (element_class,
+      "Throttle Src", "Source", "yep", "me");
+
+  pushsrc_class->create = gst_throttle_src_create;
+  basesrc_class->query = gst_throttle_src_query;
+}
+
+static void
+gst_throttle_src_init (GstThrottleSrc * src)
+{
+}
+
+#endif /* GST_DISABLE_REGISTRY */
+
+static Suite *
+urisourcebin_suite (void)
+{
+  Suite *s = suite_create ("urisourcebin");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+
+#ifndef GST_DISABLE_REGISTRY
+  tcase_set_timeout (tc_chain, 30);
+  tcase_add_test (tc_chain, test_adaptive_buffering_slow_link);
+  tcase_add_test (tc_chain, test_adaptive_buffering_fast_link);
+#endif
+
+  return s;
+}
+
+GST_CHECK_MAIN (urisourcebin);
@@ -0,0 +1,227 @@
+/* GStreamer
+ *
+ * unit test for videoconvertscale
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+#include <gst/video/video.h>
+#include <gst/base/gstbasetransform.h>
+
+static GstSample *
+run_pipeline (const gchar * in_caps, const gchar * out_caps)
+{
+  GstElement *pipeline, *sink;
+  GstSample *sample = NULL;
+  GstMessage *msg;
+  gchar *desc;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=1 pattern=gradient ! "
+      "%s ! videoconvertscale ! %s ! fakesink name=sink "
+      "enable-last-sample=true", in_caps, out_caps);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_object_get (sink, "last-sample", &sample, NULL);
+  fail_unless (sample != NULL);
+  gst_object_unref (sink);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return sample;
+}
+
+GST_START_TEST (test_convert_and_scale)
+{
+  GstSample *sample;
+  GstVideoInfo info;
+
+  sample = run_pipeline ("video/x-raw,format=I420,width=320,height=240",
+      "video/x-raw,format=RGBx,width=160,height=120");
+
+  fail_unless (gst_video_info_from_caps (&info,
+          gst_sample_get_caps (sample)));
+  fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&info),
+      GST_VIDEO_FORMAT_RGBx);
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), 160);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), 120);
+  fail_unless_equals_int (gst_buffer_get_size (gst_sample_get_buffer
+          (sample)), GST_VIDEO_INFO_SIZE (&info));
+
+  gst_sample_unref (sample);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_keep_format)
+{
+  GstSample *sample;
+  GstVideoInfo info;
+
+  /* without a format downstream the input format is kept */
+  sample = run_pipeline ("video/x-raw,format=Y42B,width=320,height=240",
+      "video/x-raw,width=64,height=48");
+
+  fail_unless (gst_video_info_from_caps (&info,
+          gst_sample_get_caps (sample)));
+  fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&info),
+      GST_VIDEO_FORMAT_Y42B);
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), 64);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), 48);
+
+  gst_sample_unref (sample);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_matches_separate_elements)
+{
+  GstElement *pipeline, *sink;
+  GstSample *samples[2];
+  GstMessage *msg;
+  GstMapInfo map1, map2;
+  guint i;
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=1 "
+      "pattern=gradient ! video/x-raw,format=AYUV,width=320,height=240 ! "
+      "tee name=t "
+      "t. ! queue ! videoconvertscale ! "
+      "video/x-raw,format=AYUV,width=160,height=120 ! "
+      "fakesink name=s0 enable-last-sample=true "
+      "t. ! queue ! videoscale ! video/x-raw,width=160,height=120 ! "
+      "fakesink name=s1 enable-last-sample=true", NULL);
+  fail_unless (pipeline != NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  for (i = 0; i < 2; i++) {
+    gchar *name = g_strdup_printf ("s%u", i);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    g_object_get (sink, "last-sample", &samples[i], NULL);
+    fail_unless (samples[i] != NULL);
+    gst_object_unref (sink);
+    g_free (name);
+  }
+
+  /* without a format change both must produce the same output */
+  gst_buffer_map (gst_sample_get_buffer (samples[0]), &map1, GST_MAP_READ);
+  gst_buffer_map (gst_sample_get_buffer (samples[1]), &map2, GST_MAP_READ);
+  fail_unless_equals_int (map1.size, map2.size);
+  fail_unless (memcmp (map1.data, map2.data, map1.size) == 0);
+  gst_buffer_unmap (gst_sample_get_buffer (samples[1]), &map2);
+  gst_buffer_unmap (gst_sample_get_buffer (samples[0]), &map1);
+
+  gst_sample_unref (samples[0]);
+  gst_sample_unref (samples[1]);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_keep_colorimetry)
+{
+  const struct
+  {
+    const gchar *caps;
+    const gchar *colorimetry;
+  } tests[] = {
+    /* the defaults for these sizes are bt709 and bt2020 */
+    {
+    "video/x-raw,format=I420,width=1920,height=1080,colorimetry=bt601",
+          "bt601"}, {
+    "video/x-raw,format=I420,width=3840,height=2160,colorimetry=bt709",
+          "bt709"}
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (tests); i++) {
+    GstElement *pipeline, *convertscale, *sink;
+    GstPad *pad;
+    GstCaps *caps;
+    GstVideoInfo info;
+    gchar *desc;
+
+    desc = g_strdup_printf ("videotestsrc num-buffers=1 ! %s ! "
+        "videoconvertscale name=cs ! fakesink name=sink", tests[i].caps);
+    pipeline = gst_parse_launch (desc, NULL);
+    g_free (desc);
+    fail_unless (pipeline != NULL);
+
+    fail_unless (gst_element_set_state (pipeline,
+            GST_STATE_PAUSED) != GST_STATE_CHANGE_FAILURE);
+    fail_unless_equals_int (gst_element_get_state (pipeline, NULL, NULL,
+            GST_CLOCK_TIME_NONE), GST_STATE_CHANGE_SUCCESS);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+    pad = gst_element_get_static_pad (sink, "sink");
+    caps = gst_pad_get_current_caps (pad);
+    fail_unless (caps != NULL);
+    fail_unless (gst_video_info_from_caps (&info, caps));
+    fail_unless (gst_video_colorimetry_matches (&info.colorimetry,
+            tests[i].colorimetry), "got %" GST_PTR_FORMAT, caps);
+    gst_caps_unref (caps);
+    gst_object_unref (pad);
+    gst_object_unref (sink);
+
+    /* nothing to convert, the frames must be passed through */
+    convertscale = gst_bin_get_by_name (GST_BIN (pipeline), "cs");
+    fail_unless (gst_base_transform_is_passthrough (GST_BASE_TRANSFORM
+            (convertscale)));
+    gst_object_unref (convertscale);
+
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+videoconvertscale_suite (void)
+{
+  Suite *s = suite_create ("videoconvertscale");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_convert_and_scale);
+  tcase_add_test (tc_chain, test_keep_format);
+  tcase_add_test (tc_chain, test_matches_separate_elements);
+  tcase_add_test (tc_chain, test_keep_colorimetry);
+
+  return s;
+}
+
+GST_CHECK_MAIN (videoconvertscale);
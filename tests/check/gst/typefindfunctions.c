@@ -349,6 +349,138 @@ GST_START_TEST (test_eac3)
 
 GST_END_TEST;
 
+/* Offsets of the first start code in the start code tests: every alignment
+ * to the 3 byte steps of the start code scanner, and straddling the end of
+ * the first 4096 byte chunk that is scanned */
+static const guint start_code_offsets[] =
+    { 0, 1, 2, 3, 4, 5, 4093, 4094, 4095, 4096 };
+
+static void
+append_filler (GByteArray * a, guint len)
+{
+  guint pos = a->len;
+
+  /* no zero bytes, so no start codes, and not valid UTF-8 either */
+  g_byte_array_set_size (a, pos + len);
+  memset (a->data + pos, 0x80, len);
+}
+
+/* Writes @n_units units starting with a 00 00 01 start code and the
+ * @header_len bytes of their header from @headers, after @prefix filler
+ * bytes. The payload of the units has varying lengths so the start codes
+ * end up at all kinds of offsets. The last unit has @suffix payload bytes,
+ * so its start code is right at the end of the data */
+static GByteArray *
+make_start_code_stream (const guint8 * headers, guint n_units,
+    guint header_len, guint prefix, guint suffix)
+{
+  static const guint8 start_code[] = { 0x00, 0x00, 0x01 };
+  GByteArray *a = g_byte_array_new ();
+  guint i;
+
+  append_filler (a, prefix);
+  for (i = 0; i < n_units; i++) {
+    g_byte_array_append (a, start_code, sizeof (start_code));
+    g_byte_array_append (a, headers + i * header_len, header_len);
+    append_filler (a, i + 1 < n_units ? 8 + i % 5 : suffix);
+  }
+
+  return a;
+}
+
+static void
+check_start_code_stream (GByteArray * a, const gchar * type,
+    GstTypeFindProbability expected)
+{
+  GstTypeFindProbability prob;
+  GstCaps *caps;
+
+  caps = typefind_data (a->data, a->len, &prob);
+  fail_unless (caps != NULL);
+  fail_unless_equals_string (gst_structure_get_name (gst_caps_get_structure
+          (caps, 0)), type);
+  fail_unless_equals_int (prob, expected);
+  gst_caps_unref (caps);
+  g_byte_array_unref (a);
+}
+
+GST_START_TEST (test_h264_start_codes)
+{
+  /* SPS, PPS, IDR and 7 non-IDR slices: 10 good NALs */
+  const guint8 nals[] = { 0x67, 0x68, 0x65, 0x41, 0x41, 0x41, 0x41, 0x41,
+    0x41, 0x41
+  };
+  guint i, suffix;
+
+  for (i = 0; i < G_N_ELEMENTS (start_code_offsets); i++) {
+    for (suffix = 0; suffix < 3; suffix++) {
+      check_start_code_stream (make_start_code_stream (nals,
+              G_N_ELEMENTS (nals), 1, start_code_offsets[i], suffix),
+          "video/x-h264", GST_TYPE_FIND_LIKELY);
+
+      /* with only SPS and PPS, it's still possibly H.264 */
+      if (start_code_offsets[i] < 6)
+        check_start_code_stream (make_start_code_stream (nals, 2, 1,
+                start_code_offsets[i], suffix), "video/x-h264",
+            GST_TYPE_FIND_POSSIBLE);
+    }
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_h265_start_codes)
+{
+  /* VPS, SPS, PPS, IDR and 6 trailing pictures: 10 good NALs */
+  const guint8 nals[] = { 0x40, 0x01, 0x42, 0x01, 0x44, 0x01, 0x26, 0x01,
+    0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01
+  };
+  guint i, suffix;
+
+  for (i = 0; i < G_N_ELEMENTS (start_code_offsets); i++) {
+    for (suffix = 0; suffix < 3; suffix++) {
+      check_start_code_stream (make_start_code_stream (nals,
+              G_N_ELEMENTS (nals) / 2, 2, start_code_offsets[i], suffix),
+          "video/x-h265", GST_TYPE_FIND_LIKELY);
+
+      /* with only VPS and SPS, it's still possibly H.265 */
+      if (start_code_offsets[i] < 6)
+        check_start_code_stream (make_start_code_stream (nals, 2, 2,
+                start_code_offsets[i], suffix), "video/x-h265",
+            GST_TYPE_FIND_POSSIBLE);
+    }
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_mpeg_video_start_codes)
+{
+  /* sequence and GOP header, then 6 pictures with one slice each */
+  const guint8 headers[] = { 0xb3, 0xb8, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x01, 0x00, 0x01
+  };
+  guint i, suffix;
+
+  for (i = 0; i < G_N_ELEMENTS (start_code_offsets); i++) {
+    /* the typefinder looks at one byte after the start codes */
+    for (suffix = 1; suffix < 4; suffix++) {
+      check_start_code_stream (make_start_code_stream (headers,
+              G_N_ELEMENTS (headers), 1, start_code_offsets[i], suffix),
+          "video/mpeg", GST_TYPE_FIND_NEARLY_CERTAIN - 1);
+
+      /* 3 pictures are not enough, it matters whether the sequence
+       * header was at the start */
+      check_start_code_stream (make_start_code_stream (headers, 8, 1,
+              start_code_offsets[i], suffix), "video/mpeg",
+          start_code_offsets[i] == 0 ? GST_TYPE_FIND_LIKELY - 10 :
+          GST_TYPE_FIND_LIKELY - 20);
+    }
+  }
+}
+
+GST_END_TEST;
+
 #define TEST_RANDOM_DATA_SIZE (4*1024)
 
 /* typefind random data, to make sure all typefinders are called */
@@ -491,6 +623,9 @@ typefindfunctions_suite (void)
   tcase_add_test (tc_chain, test_mpegts);
   tcase_add_test (tc_chain, test_ac3);
   tcase_add_test (tc_chain, test_eac3);
+  tcase_add_test (tc_chain, test_h264_start_codes);
+  tcase_add_test (tc_chain, test_h265_start_codes);
+  tcase_add_test (tc_chain, test_mpeg_video_start_codes);
   tcase_add_test (tc_chain, test_random_data);
   tcase_add_test (tc_chain, test_hls_m3u8);
   tcase_add_test (tc_chain, test_manifest_typefinding);
@@ -203,6 +203,222 @@ GST_START_TEST (test_disco_sync_reuse_timeout)
 
 GST_END_TEST;
 
+static void
+async_parallel_discovered_cb (GstDiscoverer * dc, GstDiscovererInfo * info,
+    GError * err, GHashTable * seen)
+{
+  const gchar *uri = gst_discoverer_info_get_uri (info);
+
+  GST_INFO ("discovered '%s', result %d", uri,
+      gst_discoverer_info_get_result (info));
+  fail_unless (uri != NULL);
+  /* every URI is reported exactly once */
+  fail_unless (g_hash_table_add (seen, g_strdup (uri)));
+}
+
+static void
+async_parallel_finished_cb (GstDiscoverer * dc, GMainLoop * loop)
+{
+  g_main_loop_quit (loop);
+}
+
+GST_START_TEST (test_disco_async_parallel)
+{
+  const gchar *files[] =
+      { "theora-vorbis.ogg", "test.mp3", "test.mkv", "partialframe.mjpeg" };
+  GError *err = NULL;
+  GstDiscoverer *dc;
+  GMainLoop *loop;
+  GHashTable *seen;
+  guint max_concurrency;
+  gchar *uri, *path;
+  gint i;
+
+  dc = gst_discoverer_new (5 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  fail_unless (err == NULL);
+
+  g_object_set (dc, "max-concurrency", 3, NULL);
+  g_object_get (dc, "max-concurrency", &max_concurrency, NULL);
+  fail_unless_equals_int (max_concurrency, 3);
+
+  loop = g_main_loop_new (NULL, FALSE);
+  seen = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  g_signal_connect (dc, "discovered",
+      G_CALLBACK (async_parallel_discovered_cb), seen);
+  g_signal_connect (dc, "finished",
+      G_CALLBACK (async_parallel_finished_cb), loop);
+
+  /* more URIs than workers, some of them added before starting */
+  for (i = 0; i < G_N_ELEMENTS (files); ++i) {
+    path = g_build_filename (GST_TEST_FILES_PATH, files[i], NULL);
+    uri = gst_filename_to_uri (path, &err);
+    g_free (path);
+    fail_unless (err == NULL);
+
+    fail_unless (gst_discoverer_discover_uri_async (dc, uri));
+    g_free (uri);
+
+    if (i == 1)
+      gst_discoverer_start (dc);
+  }
+
+  g_main_loop_run (loop);
+
+  fail_unless_equals_int (g_hash_table_size (seen), G_N_ELEMENTS (files));
+
+  gst_discoverer_stop (dc);
+  g_hash_table_unref (seen);
+  g_main_loop_unref (loop);
+  g_object_unref (dc);
+}
+
+GST_END_TEST;
+
+static void
+check_cache_stats (GstDiscoverer * dc, guint64 expected_hits,
+    guint64 expected_misses)
+{
+  GstStructure *stats;
+  guint64 hits, misses;
+
+  stats = gst_discoverer_get_cache_stats (dc);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "hits", &hits));
+  fail_unless (gst_structure_get_uint64 (stats, "misses", &misses));
+  fail_unless_equals_uint64 (hits, expected_hits);
+  fail_unless_equals_uint64 (misses, expected_misses);
+  gst_structure_free (stats);
+}
+
+GST_START_TEST (test_disco_cache)
+{
+  GError *err = NULL;
+  GstDiscoverer *dc;
+  GstDiscovererInfo *info, *cached;
+  GList *audio_streams;
+  gchar *uri, *path, *cache_file;
+  gint fd;
+
+  if (!have_theora || !have_ogg)
+    return;
+
+  fd = g_file_open_tmp ("discoverer-cache-XXXXXX", &cache_file, &err);
+  fail_unless (fd >= 0);
+  g_close (fd, NULL);
+
+  path = g_build_filename (GST_TEST_FILES_PATH, "theora-vorbis.ogg", NULL);
+  uri = gst_filename_to_uri (path, &err);
+  g_free (path);
+  fail_unless (err == NULL);
+
+  dc = gst_discoverer_new (5 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  fail_unless (gst_discoverer_get_cache_stats (dc) == NULL);
+  g_object_set (dc, "cache-file", cache_file, NULL);
+
+  info = gst_discoverer_discover_uri (dc, uri, &err);
+  fail_unless (info != NULL);
+  fail_unless_equals_int (gst_discoverer_info_get_result (info),
+      GST_DISCOVERER_OK);
+  check_cache_stats (dc, 0, 1);
+
+  cached = gst_discoverer_discover_uri (dc, uri, &err);
+  fail_unless (cached != NULL);
+  check_cache_stats (dc, 1, 1);
+  gst_discoverer_info_unref (cached);
+
+  /* the cache is written when the discoverer goes away and picked up by
+   * the next one */
+  g_object_unref (dc);
+
+  dc = gst_discoverer_new (5 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  g_object_set (dc, "cache-file", cache_file, NULL);
+
+  cached = gst_discoverer_discover_uri (dc, uri, &err);
+  fail_unless (cached != NULL);
+  check_cache_stats (dc, 1, 0);
+
+  fail_unless_equals_int (gst_discoverer_info_get_result (cached),
+      GST_DISCOVERER_OK);
+  fail_unless_equals_string (gst_discoverer_info_get_uri (cached), uri);
+  fail_unless_equals_uint64 (gst_discoverer_info_get_duration (cached),
+      gst_discoverer_info_get_duration (info));
+  audio_streams = gst_discoverer_info_get_audio_streams (cached);
+  fail_unless_equals_int (g_list_length (audio_streams), 1);
+  gst_discoverer_stream_info_list_free (audio_streams);
+
+  gst_discoverer_info_unref (cached);
+  gst_discoverer_info_unref (info);
+  g_object_unref (dc);
+
+  g_unlink (cache_file);
+  g_free (cache_file);
+  g_free (uri);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_disco_parse_only)
+{
+  GError *err = NULL;
+  GstDiscoverer *dc;
+  GstDiscovererInfo *info;
+  GstDiscovererAudioInfo *ainfo;
+  GstDiscovererVideoInfo *vinfo;
+  GList *streams;
+  GstCaps *caps;
+  gchar *uri, *path;
+
+  if (!have_ogg)
+    return;
+
+  path = g_build_filename (GST_TEST_FILES_PATH, "theora-vorbis.ogg", NULL);
+  uri = gst_filename_to_uri (path, &err);
+  g_free (path);
+  fail_unless (err == NULL);
+
+  dc = gst_discoverer_new (5 * GST_SECOND, &err);
+  fail_unless (dc != NULL);
+  g_object_set (dc, "parse-only", TRUE, NULL);
+
+  /* oggdemux provides complete caps, so no decoders are needed */
+  info = gst_discoverer_discover_uri (dc, uri, &err);
+  fail_unless (info != NULL);
+  fail_unless_equals_int (gst_discoverer_info_get_result (info),
+      GST_DISCOVERER_OK);
+  fail_unless (gst_discoverer_info_get_duration (info) > 0);
+
+  streams = gst_discoverer_info_get_audio_streams (info);
+  fail_unless_equals_int (g_list_length (streams), 1);
+  ainfo = streams->data;
+  fail_unless (gst_discoverer_audio_info_get_channels (ainfo) > 0);
+  fail_unless (gst_discoverer_audio_info_get_sample_rate (ainfo) > 0);
+  caps = gst_discoverer_stream_info_get_caps (streams->data);
+  fail_unless (gst_structure_has_name (gst_caps_get_structure (caps, 0),
+          "audio/x-vorbis"));
+  gst_caps_unref (caps);
+  gst_discoverer_stream_info_list_free (streams);
+
+  streams = gst_discoverer_info_get_video_streams (info);
+  fail_unless_equals_int (g_list_length (streams), 1);
+  vinfo = streams->data;
+  fail_unless (gst_discoverer_video_info_get_width (vinfo) > 0);
+  fail_unless (gst_discoverer_video_info_get_height (vinfo) > 0);
+  caps = gst_discoverer_stream_info_get_caps (streams->data);
+  fail_unless (gst_structure_has_name (gst_caps_get_structure (caps, 0),
+          "video/x-theora"));
+  gst_caps_unref (caps);
+  gst_discoverer_stream_info_list_free (streams);
+
+  gst_discoverer_info_unref (info);
+  g_object_unref (dc);
+  g_free (uri);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_disco_missing_plugins)
 {
   const gchar *files[] = { "test.mkv", "test.mp3", "partialframe.mjpeg" };
@@ -263,6 +479,9 @@ discoverer_suite (void)
   tcase_add_test (tc_chain, test_disco_sync_reuse_mp3);
   tcase_add_test (tc_chain, test_disco_sync_reuse_timeout);
   tcase_add_test (tc_chain, test_disco_missing_plugins);
+  tcase_add_test (tc_chain, test_disco_async_parallel);
+  tcase_add_test (tc_chain, test_disco_cache);
+  tcase_add_test (tc_chain, test_disco_parse_only);
   tcase_add_test (tc_chain, test_disco_serializing);
   return s;
 }
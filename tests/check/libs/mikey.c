@@ -203,6 +203,219 @@ GST_START_TEST (create_payloads)
 }
 
 GST_END_TEST
+static const guint8 test_key[] = {
+  0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80,
+  0x90, 0xa0, 0xb0, 0xc0, 0xd0, 0xe0, 0xf0, 0x10
+};
+
+static const guint8 test_salt[] = {
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+  0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e
+};
+
+static const guint8 test_rand[] = {
+  0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+  0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf
+};
+
+static GBytes *
+create_psk_message (void)
+{
+  GstMIKEYMessage *msg;
+  GstMIKEYPayload *payload, *kp;
+  GBytes *bytes;
+
+  msg = gst_mikey_message_new ();
+  gst_mikey_message_set_info (msg, 1, GST_MIKEY_TYPE_PSK_INIT, FALSE,
+      GST_MIKEY_PRF_MIKEY_1, 0x12345678, GST_MIKEY_MAP_TYPE_SRTP);
+  gst_mikey_message_add_cs_srtp (msg, 0, 0x11223344, 5);
+  gst_mikey_message_add_t_now_ntp_utc (msg);
+  gst_mikey_message_add_rand (msg, sizeof (test_rand), test_rand);
+
+  payload = gst_mikey_payload_new (GST_MIKEY_PT_KEMAC);
+  gst_mikey_payload_kemac_set (payload, GST_MIKEY_ENC_NULL,
+      GST_MIKEY_MAC_NULL);
+  kp = gst_mikey_payload_new (GST_MIKEY_PT_KEY_DATA);
+  gst_mikey_payload_key_data_set_key (kp, GST_MIKEY_KD_TEK,
+      sizeof (test_key), test_key);
+  gst_mikey_payload_key_data_set_salt (kp, sizeof (test_salt), test_salt);
+  gst_mikey_payload_kemac_add_sub (payload, kp);
+  gst_mikey_message_add_payload (msg, payload);
+
+  bytes = gst_mikey_message_to_bytes (msg, NULL, NULL);
+  gst_mikey_message_unref (msg);
+
+  return bytes;
+}
+
+GST_START_TEST (message_view)
+{
+  GstMIKEYMessageView *view;
+  GBytes *bytes;
+  const guint8 *data, *pdata, *key, *salt, *rand;
+  gsize size, psize;
+  guint8 version, rand_len;
+  GstMIKEYType type;
+  GstMIKEYPRFFunc prf_func;
+  GstMIKEYPayloadType ptype;
+  GstMIKEYKeyDataType key_type;
+  GstMIKEYMapSRTP map;
+  guint32 CSB_id;
+  guint16 key_len, salt_len;
+
+  bytes = create_psk_message ();
+  data = g_bytes_get_data (bytes, &size);
+
+  view = gst_mikey_message_view_new ();
+  fail_unless (gst_mikey_message_view_parse (view, data, size));
+
+  gst_mikey_message_view_get_info (view, &version, &type, NULL, &prf_func,
+      &CSB_id, NULL);
+  fail_unless_equals_int (version, 1);
+  fail_unless_equals_int (type, GST_MIKEY_TYPE_PSK_INIT);
+  fail_unless_equals_int (prf_func, GST_MIKEY_PRF_MIKEY_1);
+  fail_unless_equals_int (CSB_id, 0x12345678);
+
+  fail_unless_equals_int (gst_mikey_message_view_get_n_cs (view), 1);
+  fail_unless (gst_mikey_message_view_get_cs_srtp (view, 0, &map));
+  fail_unless_equals_int (map.ssrc, 0x11223344);
+  fail_unless_equals_int (map.roc, 5);
+  fail_if (gst_mikey_message_view_get_cs_srtp (view, 1, &map));
+
+  fail_unless_equals_int (gst_mikey_message_view_get_n_payloads (view), 3);
+  fail_unless (gst_mikey_message_view_get_payload (view, 0, &ptype, &pdata,
+          &psize));
+  fail_unless_equals_int (ptype, GST_MIKEY_PT_T);
+  fail_unless_equals_int (psize, 10);
+  fail_unless (pdata > data && pdata + psize <= data + size);
+  fail_unless (gst_mikey_message_view_get_payload (view, 2, &ptype, NULL,
+          NULL));
+  fail_unless_equals_int (ptype, GST_MIKEY_PT_KEMAC);
+
+  fail_unless (gst_mikey_message_view_get_rand (view, &rand, &rand_len));
+  fail_unless_equals_int (rand_len, sizeof (test_rand));
+  fail_unless (memcmp (rand, test_rand, rand_len) == 0);
+
+  /* the key data points into the original message */
+  fail_unless_equals_int (gst_mikey_message_view_get_n_key_data (view), 1);
+  fail_unless (gst_mikey_message_view_get_key_data (view, 0, &key_type, &key,
+          &key_len, &salt, &salt_len));
+  fail_unless_equals_int (key_type, GST_MIKEY_KD_TEK);
+  fail_unless_equals_int (key_len, sizeof (test_key));
+  fail_unless (memcmp (key, test_key, key_len) == 0);
+  fail_unless (key > data && key + key_len <= data + size);
+  fail_unless_equals_int (salt_len, sizeof (test_salt));
+  fail_unless (memcmp (salt, test_salt, salt_len) == 0);
+
+  /* truncated messages fail and reset the view */
+  fail_if (gst_mikey_message_view_parse (view, data, size - 1));
+  fail_unless_equals_int (gst_mikey_message_view_get_n_key_data (view), 0);
+
+  gst_mikey_message_view_free (view);
+  g_bytes_unref (bytes);
+}
+
+GST_END_TEST
+GST_START_TEST (key_derivation)
+{
+  GstMIKEYKeyDerivation *kd;
+  guint8 master[40], out[30];
+  guint i;
+  /* computed with an independent implementation of the RFC 3830 PRF */
+  const guint8 tek[] = {
+    0x2a, 0x26, 0x6c, 0x6b, 0x08, 0xa2, 0x41, 0x4f, 0x29, 0x23,
+    0xb9, 0xca, 0x4d, 0x62, 0xf1, 0x16, 0xea, 0x7d, 0x9e, 0xfa,
+    0xfb, 0x4a, 0xae, 0xb7, 0x2c, 0xc5, 0x97, 0x77, 0x83, 0x4f
+  };
+  const guint8 salt[] = {
+    0xc1, 0x9b, 0xd3, 0x0c, 0x0f, 0x75, 0x6d, 0xf5, 0xcb, 0x26,
+    0xcb, 0x34, 0x36, 0x39
+  };
+
+  for (i = 0; i < sizeof (master); i++)
+    master[i] = i;
+
+  /* a 320 bits key is split in two chunks */
+  kd = gst_mikey_key_derivation_new (GST_MIKEY_PRF_MIKEY_1, master,
+      sizeof (master));
+  fail_unless (kd != NULL);
+  fail_unless (gst_mikey_key_derivation_derive (kd, GST_MIKEY_KEY_USAGE_TEK,
+          1, 0x12345678, test_rand, sizeof (test_rand), out, sizeof (tek)));
+  fail_unless (memcmp (out, tek, sizeof (tek)) == 0);
+  gst_mikey_key_derivation_free (kd);
+
+  kd = gst_mikey_key_derivation_new (GST_MIKEY_PRF_MIKEY_1, master, 16);
+  fail_unless (gst_mikey_key_derivation_derive (kd,
+          GST_MIKEY_KEY_USAGE_TEK_SALT, 1, 0x12345678, test_rand,
+          sizeof (test_rand), out, sizeof (salt)));
+  fail_unless (memcmp (out, salt, sizeof (salt)) == 0);
+  gst_mikey_key_derivation_free (kd);
+}
+
+GST_END_TEST
+#define BENCHMARK_ITERATIONS 5000
+GST_START_TEST (parse_derive_benchmark)
+{
+  GstMIKEYMessageView *view;
+  GstMIKEYKeyDerivation *kd;
+  GstClockTime start, copy_time, view_time, new_kd_time, reuse_kd_time;
+  GBytes *bytes;
+  const guint8 *data;
+  guint8 out[30];
+  gsize size;
+  guint i;
+
+  bytes = create_psk_message ();
+  data = g_bytes_get_data (bytes, &size);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    GstMIKEYMessage *msg;
+
+    msg = gst_mikey_message_new_from_data (data, size, NULL, NULL);
+    fail_unless (msg != NULL);
+    gst_mikey_message_unref (msg);
+  }
+  copy_time = gst_util_get_timestamp () - start;
+
+  view = gst_mikey_message_view_new ();
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+    fail_unless (gst_mikey_message_view_parse (view, data, size));
+  view_time = gst_util_get_timestamp () - start;
+  gst_mikey_message_view_free (view);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    kd = gst_mikey_key_derivation_new (GST_MIKEY_PRF_MIKEY_1, test_key,
+        sizeof (test_key));
+    gst_mikey_key_derivation_derive (kd, GST_MIKEY_KEY_USAGE_TEK, 0, i,
+        test_rand, sizeof (test_rand), out, sizeof (out));
+    gst_mikey_key_derivation_free (kd);
+  }
+  new_kd_time = gst_util_get_timestamp () - start;
+
+  kd = gst_mikey_key_derivation_new (GST_MIKEY_PRF_MIKEY_1, test_key,
+      sizeof (test_key));
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+    gst_mikey_key_derivation_derive (kd, GST_MIKEY_KEY_USAGE_TEK, 0, i,
+        test_rand, sizeof (test_rand), out, sizeof (out));
+  reuse_kd_time = gst_util_get_timestamp () - start;
+  gst_mikey_key_derivation_free (kd);
+
+  GST_INFO ("%u messages: copy parse %" GST_TIME_FORMAT ", view parse %"
+      GST_TIME_FORMAT, BENCHMARK_ITERATIONS, GST_TIME_ARGS (copy_time),
+      GST_TIME_ARGS (view_time));
+  GST_INFO ("%u keys: new context %" GST_TIME_FORMAT ", reused context %"
+      GST_TIME_FORMAT, BENCHMARK_ITERATIONS, GST_TIME_ARGS (new_kd_time),
+      GST_TIME_ARGS (reuse_kd_time));
+
+  g_bytes_unref (bytes);
+}
+
+GST_END_TEST
+#undef BENCHMARK_ITERATIONS
 /*
  * End of test cases
  */
@@ -215,6 +428,9 @@ mikey_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, create_common);
   tcase_add_test (tc_chain, create_payloads);
+  tcase_add_test (tc_chain, message_view);
+  tcase_add_test (tc_chain, key_derivation);
+  tcase_add_test (tc_chain, parse_derive_benchmark);
 
   return s;
 }
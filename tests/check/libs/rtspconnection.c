@@ -664,6 +664,284 @@ GST_START_TEST (test_rtspconnection_send_receive_check_headers)
 
 GST_END_TEST;
 
+static const gchar parser_msgs[] =
+    "\r\nGET_PARAMETER rtsp://example.com/media RTSP/1.0\r\n"
+    "CSeq: 3\r\n"
+    "Session:  12345678;timeout=60\r\n"
+    "Accept: text/parameters,\r\n application/sdp\r\n"
+    "X-Custom-Header: foo\r\n"
+    "Content-Length: 4\r\n\r\n"
+    "bodyRTSP/1.0 200 OK\r\n"
+    "CSeq: 4\r\n\r\n" "$\001\000\003abc";
+
+GST_START_TEST (test_rtspconnection_parser)
+{
+  GstRTSPParser *parser;
+  GstRTSPMethod method;
+  GstRTSPStatusCode code;
+  GstRTSPVersion version;
+  GstRTSPMessage *msg;
+  const gchar *uri, *reason, *header_val;
+  const guint8 *body;
+  gchar *msg_val;
+  guint body_len;
+  guint8 channel;
+  gsize i, len;
+
+  parser = gst_rtsp_parser_new ();
+
+  /* feed the first message byte by byte to exercise all the partial states */
+  len = sizeof (parser_msgs);
+  for (i = 0; i < len; i++) {
+    gst_rtsp_parser_feed (parser, (const guint8 *) &parser_msgs[i], 1);
+    if (gst_rtsp_parser_parse (parser) == GST_RTSP_OK)
+      break;
+  }
+  fail_unless (i < len);
+  /* and the remaining messages in one go */
+  gst_rtsp_parser_feed (parser, (const guint8 *) &parser_msgs[i + 1],
+      len - i - 1);
+
+  /* request */
+  fail_unless_equals_int (gst_rtsp_parser_get_msg_type (parser),
+      GST_RTSP_MESSAGE_REQUEST);
+  fail_unless (gst_rtsp_parser_parse_request (parser, &method, &uri,
+          &version) == GST_RTSP_OK);
+  fail_unless_equals_int (method, GST_RTSP_GET_PARAMETER);
+  fail_unless_equals_string (uri, "rtsp://example.com/media");
+  fail_unless_equals_int (version, GST_RTSP_VERSION_1_0);
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_CSEQ,
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "3");
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_SESSION,
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "12345678;timeout=60");
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_ACCEPT,
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "text/parameters, application/sdp");
+  fail_unless (gst_rtsp_parser_get_header_by_name (parser, "x-custom-header",
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "foo");
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_RANGE,
+          &header_val, 0) == GST_RTSP_ENOTIMPL);
+  fail_unless (gst_rtsp_parser_get_body (parser, &body,
+          &body_len) == GST_RTSP_OK);
+  fail_unless_equals_int (body_len, 4);
+  fail_unless (memcmp (body, "body", 4) == 0);
+
+  /* materialize it, this splits the values like gst_rtsp_connection_receive */
+  fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_parser_get_message (parser, msg) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_REQUEST);
+  fail_unless (gst_rtsp_message_get_header (msg, GST_RTSP_HDR_ACCEPT,
+          &msg_val, 1) == GST_RTSP_OK);
+  fail_unless_equals_string (msg_val, "application/sdp");
+  fail_unless (gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SESSION,
+          &msg_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (msg_val, "12345678");
+  fail_unless (gst_rtsp_message_get_header_by_name (msg, "X-Custom-Header",
+          &msg_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (msg_val, "foo");
+  fail_unless (gst_rtsp_message_get_body (msg, (guint8 **) & msg_val,
+          &body_len) == GST_RTSP_OK);
+  /* like RTSPConnection, an extra byte is added for the trailing '\0' */
+  fail_unless_equals_int (body_len, 5);
+  fail_unless_equals_string (msg_val, "body");
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  fail_unless (gst_rtsp_parser_parse (parser) == GST_RTSP_OK);
+  fail_unless_equals_int (gst_rtsp_parser_get_msg_type (parser),
+      GST_RTSP_MESSAGE_RESPONSE);
+  fail_unless (gst_rtsp_parser_parse_response (parser, &code, &reason,
+          &version) == GST_RTSP_OK);
+  fail_unless_equals_int (code, GST_RTSP_STS_OK);
+  fail_unless_equals_string (reason, "OK");
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_CSEQ,
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "4");
+  fail_unless (gst_rtsp_parser_get_body (parser, &body,
+          &body_len) == GST_RTSP_OK);
+  fail_unless_equals_int (body_len, 0);
+
+  fail_unless (gst_rtsp_parser_parse (parser) == GST_RTSP_OK);
+  fail_unless_equals_int (gst_rtsp_parser_get_msg_type (parser),
+      GST_RTSP_MESSAGE_DATA);
+  fail_unless (gst_rtsp_parser_parse_data (parser, &channel) == GST_RTSP_OK);
+  fail_unless_equals_int (channel, 1);
+  fail_unless (gst_rtsp_parser_get_body (parser, &body,
+          &body_len) == GST_RTSP_OK);
+  fail_unless_equals_int (body_len, 3);
+  fail_unless (memcmp (body, "abc", 3) == 0);
+
+  /* only the trailing '\0' is left, that is not a complete message */
+  fail_unless (gst_rtsp_parser_parse (parser) == GST_RTSP_EINTR);
+  fail_unless_equals_int (gst_rtsp_parser_get_msg_type (parser),
+      GST_RTSP_MESSAGE_INVALID);
+
+  gst_rtsp_parser_free (parser);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspconnection_receive_parser)
+{
+  GSocketConnection *input_conn = NULL;
+  GSocketConnection *output_conn = NULL;
+  GSocket *input_sock;
+  GSocket *output_sock;
+  GstRTSPConnection *rtsp_output_conn;
+  GstRTSPConnection *rtsp_input_conn;
+  GstRTSPParser *parser;
+  GstRTSPMessage *msg;
+  GstRTSPMethod method;
+  const gchar *uri, *header_val;
+  const guint8 *body;
+  guint body_len;
+  guint8 channel;
+  gchar data[] = "data message";
+
+  create_connection (&input_conn, &output_conn);
+  input_sock = g_socket_connection_get_socket (input_conn);
+  fail_unless (input_sock != NULL);
+  output_sock = g_socket_connection_get_socket (output_conn);
+  fail_unless (output_sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (input_sock, "127.0.0.1",
+          4444, NULL, &rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_input_conn != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (output_sock, "127.0.0.1",
+          4444, NULL, &rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_output_conn != NULL);
+
+  /* send a request and a data message back to back */
+  fail_unless (gst_rtsp_message_new_request (&msg, GST_RTSP_SETUP,
+          "rtsp://example.com/") == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_add_header (msg, GST_RTSP_HDR_BLOCKSIZE,
+          "1024") == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_send (rtsp_output_conn, msg,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  fail_unless (gst_rtsp_message_new_data (&msg, 2) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_set_body (msg, (guint8 *) data,
+          sizeof (data)) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_send (rtsp_output_conn, msg,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  parser = gst_rtsp_parser_new ();
+
+  fail_unless (gst_rtsp_connection_receive_parser (rtsp_input_conn, parser,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_parser_parse_request (parser, &method, &uri,
+          NULL) == GST_RTSP_OK);
+  fail_unless_equals_int (method, GST_RTSP_SETUP);
+  fail_unless_equals_string (uri, "rtsp://example.com/");
+  fail_unless (gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_BLOCKSIZE,
+          &header_val, 0) == GST_RTSP_OK);
+  fail_unless_equals_string (header_val, "1024");
+
+  fail_unless (gst_rtsp_connection_receive_parser (rtsp_input_conn, parser,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_parser_parse_data (parser, &channel) == GST_RTSP_OK);
+  fail_unless_equals_int (channel, 2);
+  fail_unless (gst_rtsp_parser_get_body (parser, &body,
+          &body_len) == GST_RTSP_OK);
+  fail_unless_equals_int (body_len, sizeof (data));
+  fail_unless_equals_string ((const gchar *) body, data);
+
+  gst_rtsp_parser_free (parser);
+
+  fail_unless (gst_rtsp_connection_close (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_close (rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_output_conn) == GST_RTSP_OK);
+
+  g_object_unref (input_conn);
+  g_object_unref (output_conn);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspconnection_receive_parser_tunnel)
+{
+  GstRTSPConnection *rtsp_conn1 = NULL;
+  GstRTSPConnection *rtsp_conn2 = NULL;
+  GSocketConnection *client_get = NULL;
+  GSocketConnection *server_get = NULL;
+  GSocketConnection *client_post = NULL;
+  GSocketConnection *server_post = NULL;
+  GSocket *server_sock;
+  GOutputStream *ostream;
+  GstRTSPParser *parser, *post_parser;
+  GstRTSPMethod method;
+  const gchar *uri;
+  const gchar *request = "OPTIONS rtsp://example.com/ RTSP/1.0\r\n"
+      "CSeq: 1\r\n\r\n";
+  gchar *encoded;
+  gsize size = 0;
+
+  /* set up the tunnel with the GET and POST channels */
+  create_connection (&client_get, &server_get);
+  server_sock = g_socket_connection_get_socket (server_get);
+  fail_unless (server_sock != NULL);
+  fail_unless (gst_rtsp_connection_create_from_socket (server_sock,
+          "127.0.0.1", 4444, NULL, &rtsp_conn1) == GST_RTSP_OK);
+
+  ostream = g_io_stream_get_output_stream (G_IO_STREAM (client_get));
+  fail_unless (g_output_stream_write_all (ostream, get_msg,
+          strlen (get_msg), &size, NULL, NULL));
+
+  parser = gst_rtsp_parser_new ();
+  fail_unless (gst_rtsp_connection_receive_parser (rtsp_conn1, parser,
+          NULL) == GST_RTSP_ETGET);
+
+  create_connection (&client_post, &server_post);
+  server_sock = g_socket_connection_get_socket (server_post);
+  fail_unless (server_sock != NULL);
+  fail_unless (gst_rtsp_connection_create_from_socket (server_sock,
+          "127.0.0.1", 4444, NULL, &rtsp_conn2) == GST_RTSP_OK);
+
+  ostream = g_io_stream_get_output_stream (G_IO_STREAM (client_post));
+  fail_unless (g_output_stream_write_all (ostream, post_msg,
+          strlen (post_msg), &size, NULL, NULL));
+
+  post_parser = gst_rtsp_parser_new ();
+  fail_unless (gst_rtsp_connection_receive_parser (rtsp_conn2, post_parser,
+          NULL) == GST_RTSP_ETPOST);
+  gst_rtsp_parser_free (post_parser);
+
+  fail_unless (gst_rtsp_connection_do_tunnel (rtsp_conn1, rtsp_conn2) ==
+      GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn2) == GST_RTSP_OK);
+
+  /* a request much shorter than a read must be returned without waiting
+   * for more data */
+  encoded = g_base64_encode ((const guchar *) request, strlen (request));
+  fail_unless (g_output_stream_write_all (ostream, encoded,
+          strlen (encoded), &size, NULL, NULL));
+  g_free (encoded);
+
+  fail_unless (gst_rtsp_connection_receive_parser (rtsp_conn1, parser,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_parser_parse_request (parser, &method, &uri,
+          NULL) == GST_RTSP_OK);
+  fail_unless_equals_int (method, GST_RTSP_OPTIONS);
+  fail_unless_equals_string (uri, "rtsp://example.com/");
+
+  gst_rtsp_parser_free (parser);
+
+  fail_unless (gst_rtsp_connection_close (rtsp_conn1) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn1) == GST_RTSP_OK);
+  g_object_unref (client_get);
+  g_object_unref (server_get);
+  g_object_unref (client_post);
+  g_object_unref (server_post);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtspconnection_connect)
 {
   ServiceData *data;
@@ -840,6 +1118,256 @@ GST_START_TEST (test_rtspconnection_backlog)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtspconnection_send_messages)
+{
+  GSocketConnection *input_conn = NULL;
+  GSocketConnection *output_conn = NULL;
+  GSocket *input_sock;
+  GSocket *output_sock;
+  GstRTSPConnection *rtsp_output_conn;
+  GstRTSPConnection *rtsp_input_conn;
+  GstRTSPWatch *watch;
+  GstRTSPMessage messages[3] = { {0}, {0}, {0} };
+  GstRTSPMessage *msg;
+  gchar body[] = "interleaved";
+  guint8 *recv_body;
+  guint recv_body_len;
+  guint8 channel;
+  guint id = 1;
+  gint i, round;
+
+  create_connection (&input_conn, &output_conn);
+  input_sock = g_socket_connection_get_socket (input_conn);
+  fail_unless (input_sock != NULL);
+  output_sock = g_socket_connection_get_socket (output_conn);
+  fail_unless (output_sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (input_sock, "127.0.0.1",
+          4444, NULL, &rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_input_conn != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (output_sock, "127.0.0.1",
+          4444, NULL, &rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_output_conn != NULL);
+
+  watch = gst_rtsp_watch_new (rtsp_output_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  g_source_unref ((GSource *) watch);
+
+  fail_unless (gst_rtsp_message_init_data (&messages[0], 0) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_set_body (&messages[0], (guint8 *) body,
+          sizeof (body)) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_init_data (&messages[1], 1) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_set_body (&messages[1], (guint8 *) body,
+          sizeof (body)) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_init_response (&messages[2], GST_RTSP_STS_OK,
+          NULL, NULL) == GST_RTSP_OK);
+
+  /* first through the watch, then synchronously on the connection */
+  for (round = 0; round < 2; round++) {
+    if (round == 0) {
+      fail_unless (gst_rtsp_watch_send_messages (watch, messages, 3,
+              &id) == GST_RTSP_OK);
+      /* small enough to be sent immediately */
+      fail_unless_equals_int (id, 0);
+    } else {
+      fail_unless (gst_rtsp_connection_send_messages (rtsp_output_conn,
+              messages, 3, NULL) == GST_RTSP_OK);
+    }
+
+    for (i = 0; i < 2; i++) {
+      fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+      fail_unless (gst_rtsp_connection_receive (rtsp_input_conn, msg,
+              NULL) == GST_RTSP_OK);
+      fail_unless (gst_rtsp_message_parse_data (msg, &channel) == GST_RTSP_OK);
+      fail_unless_equals_int (channel, i);
+      fail_unless (gst_rtsp_message_get_body (msg, &recv_body,
+              &recv_body_len) == GST_RTSP_OK);
+      /* RTSPConnection adds an extra byte for the trailing '\0' */
+      fail_unless_equals_int (recv_body_len, sizeof (body) + 1);
+      fail_unless_equals_string ((gchar *) recv_body, body);
+      fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+    }
+
+    fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_connection_receive (rtsp_input_conn, msg,
+            NULL) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_RESPONSE);
+    fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+  }
+
+  for (i = 0; i < 3; i++)
+    gst_rtsp_message_unset (&messages[i]);
+
+  g_source_destroy ((GSource *) watch);
+  fail_unless (gst_rtsp_connection_close (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_close (rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_output_conn) == GST_RTSP_OK);
+
+  g_object_unref (input_conn);
+  g_object_unref (output_conn);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspconnection_send_messages_backlog)
+{
+  GSocketConnection *conn1 = NULL;
+  GSocketConnection *conn2 = NULL;
+  GSocket *sock;
+  GstRTSPConnection *rtsp_conn = NULL;
+  GstRTSPWatch *watch;
+  GstRTSPMessage messages[2] = { {0}, {0} };
+  GInputStream *istream;
+  GstRTSPResult res = GST_RTSP_OK;
+  guint8 *body;
+  guint8 recv[4096];
+  guint num_queued = 0;
+  guint i;
+
+  create_connection (&conn1, &conn2);
+  sock = g_socket_connection_get_socket (conn1);
+  fail_unless (sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (sock, "127.0.0.1",
+          4444, NULL, &rtsp_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_conn != NULL);
+
+  watch = gst_rtsp_watch_new (rtsp_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  g_source_unref ((GSource *) watch);
+
+  /* room for two batches of two messages, but not for a third one */
+  gst_rtsp_watch_set_send_backlog (watch, 0, 5);
+
+  body = g_malloc0 (4096);
+  for (i = 0; i < 2; i++) {
+    fail_unless (gst_rtsp_message_init_data (&messages[i], i) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_set_body (&messages[i], body,
+            4096) == GST_RTSP_OK);
+  }
+
+  /* send batches until the tcp window is full and they get queued, the
+   * whole batch must be refused once it does not fit in the backlog */
+  message_sent_count = 0;
+  while (res == GST_RTSP_OK) {
+    guint id = 0;
+
+    res = gst_rtsp_watch_send_messages (watch, messages, 2, &id);
+    if (id > 0)
+      num_queued += 2;
+  }
+  fail_unless (res == GST_RTSP_ENOMEM);
+  fail_unless_equals_int (num_queued, 4);
+
+  /* drain the socket until both queued batches got sent */
+  istream = g_io_stream_get_input_stream (G_IO_STREAM (conn2));
+  fail_unless (istream != NULL);
+  while (message_sent_count < 2) {
+    fail_unless (g_input_stream_read (istream, recv, sizeof (recv), NULL,
+            NULL) > 0);
+    g_main_context_iteration (NULL, FALSE);
+  }
+
+  /* the backlog is empty again and takes a new batch */
+  fail_unless (gst_rtsp_watch_send_messages (watch, messages, 2,
+          NULL) == GST_RTSP_OK);
+
+  for (i = 0; i < 2; i++)
+    gst_rtsp_message_unset (&messages[i]);
+  g_free (body);
+
+  g_source_destroy ((GSource *) watch);
+  fail_unless (gst_rtsp_connection_close (rtsp_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn) == GST_RTSP_OK);
+  g_object_unref (conn1);
+  g_object_unref (conn2);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspconnection_wait_backlog)
+{
+  GSocketConnection *conn1 = NULL;
+  GSocketConnection *conn2 = NULL;
+  GSocket *sock;
+  GstRTSPConnection *rtsp_conn = NULL;
+  GstRTSPWatch *watch;
+  GstRTSPMessage messages[2] = { {0}, {0} };
+  GInputStream *istream;
+  GstRTSPResult res = GST_RTSP_OK;
+  GTimeVal timeout = { 0, 100000 };
+  guint8 *body;
+  guint8 recv[4096];
+  guint id = 0;
+  guint i;
+
+  create_connection (&conn1, &conn2);
+  sock = g_socket_connection_get_socket (conn1);
+  fail_unless (sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (sock, "127.0.0.1",
+          4444, NULL, &rtsp_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_conn != NULL);
+
+  watch = gst_rtsp_watch_new (rtsp_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  g_source_unref ((GSource *) watch);
+
+  /* room for three messages, a second batch of two does not fit */
+  gst_rtsp_watch_set_send_backlog (watch, 0, 3);
+
+  body = g_malloc0 (4096);
+  for (i = 0; i < 2; i++) {
+    fail_unless (gst_rtsp_message_init_data (&messages[i], i) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_set_body (&messages[i], body,
+            4096) == GST_RTSP_OK);
+  }
+
+  /* send batches until the tcp window is full and one gets queued */
+  message_sent_count = 0;
+  while (id == 0) {
+    res = gst_rtsp_watch_send_messages (watch, messages, 2, &id);
+    fail_unless (res == GST_RTSP_OK);
+  }
+
+  /* the backlog is not full but the next batch does not fit, waiting for
+   * room must block until the queued batch got sent */
+  fail_unless (gst_rtsp_watch_send_messages (watch, messages, 2,
+          NULL) == GST_RTSP_ENOMEM);
+  fail_unless (gst_rtsp_watch_wait_backlog (watch,
+          &timeout) == GST_RTSP_ETIMEOUT);
+
+  istream = g_io_stream_get_input_stream (G_IO_STREAM (conn2));
+  fail_unless (istream != NULL);
+  while (message_sent_count < 1) {
+    fail_unless (g_input_stream_read (istream, recv, sizeof (recv), NULL,
+            NULL) > 0);
+    g_main_context_iteration (NULL, FALSE);
+  }
+
+  fail_unless (gst_rtsp_watch_wait_backlog (watch,
+          &timeout) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_watch_send_messages (watch, messages, 2,
+          NULL) == GST_RTSP_OK);
+
+  for (i = 0; i < 2; i++)
+    gst_rtsp_message_unset (&messages[i]);
+  g_free (body);
+
+  g_source_destroy ((GSource *) watch);
+  fail_unless (gst_rtsp_connection_close (rtsp_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_conn) == GST_RTSP_OK);
+  g_object_unref (conn1);
+  g_object_unref (conn2);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtspconnection_ip)
 {
   GstRTSPConnection *conn = NULL;
@@ -871,9 +1399,15 @@ rtspconnection_suite (void)
   tcase_add_test (tc_chain, test_rtspconnection_tunnel_setup_post_first);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive_check_headers);
+  tcase_add_test (tc_chain, test_rtspconnection_parser);
+  tcase_add_test (tc_chain, test_rtspconnection_receive_parser);
+  tcase_add_test (tc_chain, test_rtspconnection_receive_parser_tunnel);
   tcase_add_test (tc_chain, test_rtspconnection_connect);
   tcase_add_test (tc_chain, test_rtspconnection_poll);
   tcase_add_test (tc_chain, test_rtspconnection_backlog);
+  tcase_add_test (tc_chain, test_rtspconnection_send_messages);
+  tcase_add_test (tc_chain, test_rtspconnection_send_messages_backlog);
+  tcase_add_test (tc_chain, test_rtspconnection_wait_backlog);
   tcase_add_test (tc_chain, test_rtspconnection_ip);
 
   return s;
@@ -569,6 +569,199 @@ GST_START_TEST (caps_from_media_really_const)
 }
 
 GST_END_TEST
+GST_START_TEST (append_text)
+{
+  GstSDPMessage *message;
+  GString *str;
+  gchar *serialized;
+  const gchar *multicast = "v=0\r\n"
+      "o=- 123456 0 IN IP4 127.0.0.1\r\n"
+      "s=-\r\n"
+      "c=IN IP4 224.1.2.3/127/2\r\n"
+      "b=AS:1000\r\n"
+      "t=0 0\r\n"
+      "k=clear:secret\r\n"
+      "m=audio 5000/2 RTP/AVP 0\r\n"
+      "c=IN IP6 ff15::1/3\r\n" "c=IN IP4 10.0.0.1\r\n" "a=recvonly\r\n";
+
+  str = g_string_sized_new (1024);
+
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) sdp, -1, message);
+  fail_unless_equals_int (gst_sdp_message_append_text (message, str),
+      GST_SDP_OK);
+  fail_unless_equals_string (str->str, sdp);
+  gst_sdp_message_free (message);
+
+  /* reusing the string only keeps the new message */
+  g_string_truncate (str, 0);
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) multicast, -1, message);
+  fail_unless_equals_int (gst_sdp_message_medias_len (message), 1);
+  fail_unless_equals_int (gst_sdp_media_connections_len
+      (gst_sdp_message_get_media (message, 0)), 2);
+  fail_unless_equals_int (gst_sdp_message_append_text (message, str),
+      GST_SDP_OK);
+  fail_unless_equals_string (str->str, multicast);
+  serialized = gst_sdp_message_as_text (message);
+  fail_unless_equals_string (serialized, multicast);
+  g_free (serialized);
+  gst_sdp_message_free (message);
+
+  g_string_free (str, TRUE);
+}
+
+GST_END_TEST
+static guint64
+get_cache_stat (const gchar * field)
+{
+  GstStructure *stats;
+  guint64 val = 0;
+  guint size;
+
+  stats = gst_sdp_media_cache_get_stats ();
+  if (!gst_structure_get_uint64 (stats, field, &val) &&
+      gst_structure_get_uint (stats, field, &size))
+    val = size;
+  gst_structure_free (stats);
+
+  return val;
+}
+
+GST_START_TEST (caps_media_cache)
+{
+  GstSDPMessage *message;
+  const GstSDPMedia *media1, *media2;
+  GstSDPMedia media_uncached = { NULL, }, media_cached = { NULL, };
+  GstCaps *caps, *caps_cached, *caps_cached2, *caps_equal;
+  gchar *text_uncached, *text_cached, *caps_str;
+
+  gst_sdp_media_cache_clear ();
+  gst_sdp_media_cache_set_max_size (1);
+
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) sdp_rtcp_fb, -1, message);
+  media1 = gst_sdp_message_get_media (message, 0);
+
+  caps = gst_sdp_media_get_caps_from_media (media1, 100);
+  caps_cached = gst_sdp_media_get_caps_from_media_cached (media1, 100);
+  fail_unless (gst_caps_is_strictly_equal (caps, caps_cached));
+  caps_cached2 = gst_sdp_media_get_caps_from_media_cached (media1, 100);
+  fail_unless (caps_cached == caps_cached2);
+  gst_caps_unref (caps_cached2);
+  fail_unless_equals_int (get_cache_stat ("caps-hits"), 1);
+  fail_unless_equals_int (get_cache_stat ("caps-misses"), 1);
+
+  /* another payload type evicts the first one */
+  caps_cached2 = gst_sdp_media_get_caps_from_media_cached (media1, 101);
+  fail_unless (caps_cached2 != NULL);
+  fail_unless (caps_cached != caps_cached2);
+  gst_caps_unref (caps_cached2);
+  fail_unless_equals_int (get_cache_stat ("caps-size"), 1);
+  fail_unless_equals_int (get_cache_stat ("caps-evictions"), 1);
+
+  /* the same attributes in another media hit the cache */
+  gst_sdp_message_free (message);
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) sdp_rtcp_fb, -1, message);
+  media2 = gst_sdp_message_get_media (message, 0);
+  caps_cached2 = gst_sdp_media_get_caps_from_media_cached (media2, 101);
+  fail_unless_equals_int (get_cache_stat ("caps-hits"), 2);
+  gst_caps_unref (caps_cached2);
+
+  /* reverse mapping */
+  gst_sdp_media_init (&media_uncached);
+  gst_sdp_media_set_media_from_caps (caps, &media_uncached);
+  text_uncached = gst_sdp_media_as_text (&media_uncached);
+
+  gst_sdp_media_init (&media_cached);
+  gst_sdp_media_set_media_from_caps_cached (caps_cached, &media_cached);
+  gst_sdp_media_uninit (&media_cached);
+  gst_sdp_media_init (&media_cached);
+  gst_sdp_media_set_media_from_caps_cached (caps_cached, &media_cached);
+  text_cached = gst_sdp_media_as_text (&media_cached);
+  fail_unless_equals_string (text_uncached, text_cached);
+  fail_unless_equals_int (get_cache_stat ("media-hits"), 1);
+  fail_unless_equals_int (get_cache_stat ("media-misses"), 1);
+  g_free (text_cached);
+
+  /* separately built equal caps hit the cache too, and the cache keeps no
+   * reference to them */
+  caps_str = gst_caps_to_string (caps_cached);
+  caps_equal = gst_caps_from_string (caps_str);
+  g_free (caps_str);
+  gst_sdp_media_uninit (&media_cached);
+  gst_sdp_media_init (&media_cached);
+  gst_sdp_media_set_media_from_caps_cached (caps_equal, &media_cached);
+  text_cached = gst_sdp_media_as_text (&media_cached);
+  fail_unless_equals_string (text_uncached, text_cached);
+  fail_unless_equals_int (get_cache_stat ("media-hits"), 2);
+  fail_unless_equals_int (get_cache_stat ("media-misses"), 1);
+  fail_unless (gst_caps_is_writable (caps_equal));
+  gst_caps_unref (caps_equal);
+
+  g_free (text_uncached);
+  g_free (text_cached);
+  gst_sdp_media_uninit (&media_uncached);
+  gst_sdp_media_uninit (&media_cached);
+
+  /* disabling the cache drops all entries */
+  gst_sdp_media_cache_set_max_size (0);
+  fail_unless_equals_int (get_cache_stat ("caps-size"), 0);
+  fail_unless_equals_int (get_cache_stat ("media-size"), 0);
+
+  gst_caps_unref (caps);
+  gst_caps_unref (caps_cached);
+  gst_sdp_message_free (message);
+
+  gst_sdp_media_cache_clear ();
+  gst_sdp_media_cache_set_max_size (64);
+}
+
+GST_END_TEST
+#define BENCHMARK_ITERATIONS 2000
+GST_START_TEST (parse_serialize_benchmark)
+{
+  GstSDPMessage message = { 0, };
+  GstClockTime start, parse_time = 0, text_time = 0, append_time = 0;
+  GString *str;
+  guint size, i;
+
+  size = strlen (sdp_rtcp_fb);
+  str = g_string_sized_new (1024);
+
+  for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    gchar *text;
+
+    gst_sdp_message_init (&message);
+
+    start = gst_util_get_timestamp ();
+    gst_sdp_message_parse_buffer ((guint8 *) sdp_rtcp_fb, size, &message);
+    parse_time += gst_util_get_timestamp () - start;
+
+    start = gst_util_get_timestamp ();
+    text = gst_sdp_message_as_text (&message);
+    text_time += gst_util_get_timestamp () - start;
+
+    start = gst_util_get_timestamp ();
+    g_string_truncate (str, 0);
+    gst_sdp_message_append_text (&message, str);
+    append_time += gst_util_get_timestamp () - start;
+
+    fail_unless_equals_string (text, str->str);
+    g_free (text);
+  }
+  gst_sdp_message_uninit (&message);
+  g_string_free (str, TRUE);
+
+  GST_INFO ("%u iterations: parse %" GST_TIME_FORMAT ", as_text %"
+      GST_TIME_FORMAT ", append_text %" GST_TIME_FORMAT,
+      BENCHMARK_ITERATIONS, GST_TIME_ARGS (parse_time),
+      GST_TIME_ARGS (text_time), GST_TIME_ARGS (append_time));
+}
+
+GST_END_TEST
+#undef BENCHMARK_ITERATIONS
 /*
  * End of test cases
  */
@@ -590,6 +783,9 @@ sdp_suite (void)
   tcase_add_test (tc_chain, caps_from_media_rtcp_fb_all);
   tcase_add_test (tc_chain, media_from_caps_rtcp_fb_pt_100);
   tcase_add_test (tc_chain, media_from_caps_rtcp_fb_pt_101);
+  tcase_add_test (tc_chain, append_text);
+  tcase_add_test (tc_chain, caps_media_cache);
+  tcase_add_test (tc_chain, parse_serialize_benchmark);
 
   return s;
 }
@@ -1182,6 +1182,136 @@ GST_START_TEST (test_convert_frame_async)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_sample_converter)
+{
+  GstVideoSampleConverter *converter;
+  GstVideoInfo vinfo, out_info;
+  GstCaps *from_caps, *to_caps;
+  GstBuffer *from_buffer;
+  GstSample *from_sample, *to_sample;
+  GstVideoFrame frame;
+  GError *error = NULL;
+  GstClockTime start;
+  gint i, j;
+  GstMapInfo map;
+  guint8 *y;
+
+  gst_debug_set_threshold_for_name ("default", GST_LEVEL_NONE);
+
+  from_buffer = gst_buffer_new_and_alloc (640 * 480 * 4);
+
+  gst_buffer_map (from_buffer, &map, GST_MAP_WRITE);
+  for (i = 0; i < 640 * 480; i++) {
+    map.data[4 * i + 0] = 0;    /* x */
+    map.data[4 * i + 1] = 255;  /* R */
+    map.data[4 * i + 2] = 0;    /* G */
+    map.data[4 * i + 3] = 0;    /* B */
+  }
+  gst_buffer_unmap (from_buffer, &map);
+
+  gst_video_info_init (&vinfo);
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_xRGB, 640,
+          480));
+  vinfo.fps_n = 25;
+  vinfo.fps_d = 1;
+  vinfo.par_n = 1;
+  vinfo.par_d = 1;
+  from_caps = gst_video_info_to_caps (&vinfo);
+
+  from_sample = gst_sample_new (from_buffer, from_caps, NULL, NULL);
+  gst_buffer_unref (from_buffer);
+  gst_caps_unref (from_caps);
+
+  converter = gst_video_sample_converter_new ();
+
+  /* errors are reported on every call */
+  to_caps =
+      gst_caps_from_string
+      ("something/that, does=(string)not, exist=(boolean)FALSE");
+  for (i = 0; i < 2; i++) {
+    to_sample = gst_video_sample_converter_convert (converter, from_sample,
+        to_caps, GST_CLOCK_TIME_NONE, &error);
+    fail_if (to_sample != NULL);
+    fail_unless (error != NULL);
+    g_clear_error (&error);
+  }
+  gst_caps_unref (to_caps);
+
+  /* raw to fixed raw caps, with black borders to keep the DAR */
+  fail_unless (gst_video_info_set_format (&vinfo, GST_VIDEO_FORMAT_I420, 240,
+          320));
+  vinfo.fps_n = 25;
+  vinfo.fps_d = 1;
+  vinfo.par_n = 1;
+  vinfo.par_d = 2;
+  to_caps = gst_video_info_to_caps (&vinfo);
+
+  for (i = 0; i < 2; i++) {
+    to_sample = gst_video_sample_converter_convert (converter, from_sample,
+        to_caps, GST_CLOCK_TIME_NONE, &error);
+    fail_unless (to_sample != NULL);
+    fail_unless (error == NULL);
+
+    fail_unless (gst_video_info_from_caps (&out_info,
+            gst_sample_get_caps (to_sample)));
+    fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&out_info), 240);
+    fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&out_info), 320);
+
+    fail_unless (gst_video_frame_map (&frame, &out_info,
+            gst_sample_get_buffer (to_sample), GST_MAP_READ));
+    y = GST_VIDEO_FRAME_COMP_DATA (&frame, GST_VIDEO_COMP_Y);
+    j = GST_VIDEO_FRAME_COMP_STRIDE (&frame, GST_VIDEO_COMP_Y);
+    fail_unless_equals_int (y[0], 16);
+    fail_unless (y[160 * j] > 70 && y[160 * j] < 90);
+    gst_video_frame_unmap (&frame);
+
+    gst_sample_unref (to_sample);
+  }
+  gst_caps_unref (to_caps);
+
+  /* caps that need negotiation use a conversion pipeline */
+  to_caps = gst_caps_from_string ("video/x-raw, format=(string)RGB");
+  for (i = 0; i < 2; i++) {
+    to_sample = gst_video_sample_converter_convert (converter, from_sample,
+        to_caps, GST_CLOCK_TIME_NONE, &error);
+    fail_unless (to_sample != NULL);
+    fail_unless (error == NULL);
+
+    fail_unless (gst_video_info_from_caps (&out_info,
+            gst_sample_get_caps (to_sample)));
+    fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&out_info),
+        GST_VIDEO_FORMAT_RGB);
+    fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&out_info), 640);
+    fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&out_info), 480);
+
+    gst_sample_unref (to_sample);
+  }
+  gst_caps_unref (to_caps);
+
+  /* not-negotiated in the conversion pipeline is reported instead of
+   * waiting for a sample that never comes */
+  to_caps = gst_caps_from_string ("video/x-raw, format=(string)ENCODED");
+  to_sample = gst_video_sample_converter_convert (converter, from_sample,
+      to_caps, GST_CLOCK_TIME_NONE, &error);
+  fail_if (to_sample != NULL);
+  fail_unless (error != NULL);
+  g_clear_error (&error);
+
+  start = gst_util_get_timestamp ();
+  to_sample = gst_video_sample_converter_convert (converter, from_sample,
+      to_caps, 30 * GST_SECOND, &error);
+  fail_if (to_sample != NULL);
+  fail_unless (error != NULL);
+  fail_unless (gst_util_get_timestamp () - start < 30 * GST_SECOND);
+  g_clear_error (&error);
+  gst_caps_unref (to_caps);
+
+  gst_video_sample_converter_free (converter);
+  gst_sample_unref (from_sample);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_size_from_caps)
 {
   GstVideoInfo vinfo;
@@ -2326,6 +2456,152 @@ GST_END_TEST;
 #undef HEIGHT
 #undef TIME
 
+static guint
+chroma_get (gpointer line, gint bits, gint i)
+{
+  return bits == 8 ? ((guint8 *) line)[i] : ((guint16 *) line)[i];
+}
+
+static void
+chroma_set (gpointer line, gint bits, gint i, guint v)
+{
+  if (bits == 8)
+    ((guint8 *) line)[i] = v;
+  else
+    ((guint16 *) line)[i] = v;
+}
+
+/* scalar reference filters on the U and V components of AYUV lines */
+static void
+chroma_ref_up_v4 (gpointer lines[], gint bits, gint width)
+{
+  gint i, c;
+
+  for (i = 0; i < width; i++) {
+    for (c = 2; c < 4; c++) {
+      guint a = chroma_get (lines[0], bits, 4 * i + c);
+      guint b = chroma_get (lines[2], bits, 4 * i + c);
+
+      chroma_set (lines[0], bits, 4 * i + c, (7 * a + b + 4) >> 3);
+      chroma_set (lines[1], bits, 4 * i + c, (5 * a + 3 * b + 4) >> 3);
+      chroma_set (lines[2], bits, 4 * i + c, (3 * a + 5 * b + 4) >> 3);
+      chroma_set (lines[3], bits, 4 * i + c, (a + 7 * b + 4) >> 3);
+    }
+  }
+}
+
+static void
+chroma_ref_up_vi2 (gpointer lines[], gint bits, gint width)
+{
+  gint i, c;
+
+  for (i = 0; i < width; i++) {
+    for (c = 2; c < 4; c++) {
+      guint a = chroma_get (lines[0], bits, 4 * i + c);
+      guint b = chroma_get (lines[1], bits, 4 * i + c);
+      guint d = chroma_get (lines[2], bits, 4 * i + c);
+      guint e = chroma_get (lines[3], bits, 4 * i + c);
+
+      chroma_set (lines[0], bits, 4 * i + c, (5 * a + 3 * d + 4) >> 3);
+      chroma_set (lines[1], bits, 4 * i + c, (7 * b + e + 4) >> 3);
+      chroma_set (lines[2], bits, 4 * i + c, (a + 7 * d + 4) >> 3);
+      chroma_set (lines[3], bits, 4 * i + c, (3 * b + 5 * e + 4) >> 3);
+    }
+  }
+}
+
+static void
+chroma_ref_down_h2_cs (gpointer lines[], gint bits, gint width)
+{
+  gint i, c;
+
+  for (c = 2; c < 4 && width >= 2; c++) {
+    guint a = chroma_get (lines[0], bits, c);
+    guint b = chroma_get (lines[0], bits, 4 + c);
+
+    chroma_set (lines[0], bits, c, (3 * a + b + 2) >> 2);
+    for (i = 2; i < width; i += 2) {
+      a = chroma_get (lines[0], bits, 4 * (i - 1) + c);
+      b = chroma_get (lines[0], bits, 4 * i + c);
+      if (i < width - 2) {
+        guint d = chroma_get (lines[0], bits, 4 * (i + 1) + c);
+
+        chroma_set (lines[0], bits, 4 * i + c, (a + 2 * b + d + 2) >> 2);
+      } else {
+        chroma_set (lines[0], bits, 4 * i + c, (a + 3 * b + 2) >> 2);
+      }
+    }
+  }
+}
+
+GST_START_TEST (test_video_chroma_resample_exact)
+{
+  static const struct
+  {
+    GstVideoChromaSite site;
+    GstVideoChromaFlags flags;
+    gint h_factor, v_factor;
+    guint n_lines;
+    void (*ref) (gpointer lines[], gint bits, gint width);
+  } cases[] = {
+    {GST_VIDEO_CHROMA_SITE_NONE, GST_VIDEO_CHROMA_FLAG_NONE, 0, 2, 4,
+        chroma_ref_up_v4},
+    {GST_VIDEO_CHROMA_SITE_NONE, GST_VIDEO_CHROMA_FLAG_INTERLACED, 0, 1, 4,
+        chroma_ref_up_vi2},
+    {GST_VIDEO_CHROMA_SITE_H_COSITED, GST_VIDEO_CHROMA_FLAG_NONE, -1, 0, 1,
+        chroma_ref_down_h2_cs},
+  };
+  static const gint widths[] = { 1, 2, 3, 4, 5, 7, 8, 31, 320, 333 };
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_AYUV64
+  };
+  GRand *rand = g_rand_new_with_seed (42);
+  guint c, f, w, l, i;
+
+  for (c = 0; c < G_N_ELEMENTS (cases); c++) {
+    for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+      GstVideoChromaResample *resample;
+      gint bits = formats[f] == GST_VIDEO_FORMAT_AYUV ? 8 : 16;
+      guint n_lines;
+      gint offset;
+
+      resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
+          cases[c].site, cases[c].flags, formats[f], cases[c].h_factor,
+          cases[c].v_factor);
+      fail_unless (resample != NULL);
+      gst_video_chroma_resample_get_info (resample, &n_lines, &offset);
+      fail_unless_equals_int (n_lines, cases[c].n_lines);
+
+      for (w = 0; w < G_N_ELEMENTS (widths); w++) {
+        gsize size = widths[w] * 4 * bits / 8;
+        gpointer lines[4], ref[4];
+
+        for (l = 0; l < n_lines; l++) {
+          lines[l] = g_malloc (size);
+          for (i = 0; i < size; i++)
+            ((guint8 *) lines[l])[i] = g_rand_int (rand);
+          ref[l] = g_memdup (lines[l], size);
+        }
+
+        gst_video_chroma_resample (resample, lines, widths[w]);
+        cases[c].ref (ref, bits, widths[w]);
+
+        for (l = 0; l < n_lines; l++) {
+          fail_unless (memcmp (lines[l], ref[l], size) == 0,
+              "case %u, %d bits, width %d, line %u differs", c, bits,
+              widths[w], l);
+          g_free (lines[l]);
+          g_free (ref[l]);
+        }
+      }
+      gst_video_chroma_resample_free (resample);
+    }
+  }
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_scaler)
 {
   GstVideoScaler *scale;
@@ -2341,6 +2617,78 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+/* the horizontal n-tap scaler works in blocks of 256 output pixels, check
+ * that lines around and over the block size scale the same as when every
+ * pixel is scaled on its own, also with a non-zero destination offset */
+GST_START_TEST (test_video_scaler_h_ntap_blocks)
+{
+  const guint out_sizes[] = { 255, 256, 257, 513 };
+  const GstVideoFormat formats[] = { GST_VIDEO_FORMAT_GRAY8,
+    GST_VIDEO_FORMAT_RGB, GST_VIDEO_FORMAT_ARGB
+  };
+  const guint n_elems[] = { 1, 3, 4 };
+  const struct
+  {
+    GstVideoResamplerMethod method;
+    guint n_taps;
+  } methods[] = {
+    {
+    GST_VIDEO_RESAMPLER_METHOD_CUBIC, 4}, {
+    GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 6}
+  };
+  GRand *rand = g_rand_new_with_seed (0);
+  guint i, j, k, l;
+
+  for (i = 0; i < G_N_ELEMENTS (methods); i++) {
+    for (j = 0; j < G_N_ELEMENTS (out_sizes); j++) {
+      guint out_size = out_sizes[j];
+      guint in_size = out_size * 3 / 2;
+      GstVideoScaler *scale;
+
+      scale = gst_video_scaler_new (methods[i].method,
+          GST_VIDEO_SCALER_FLAG_NONE, methods[i].n_taps, in_size, out_size,
+          NULL);
+      fail_unless (scale != NULL);
+
+      for (k = 0; k < G_N_ELEMENTS (formats); k++) {
+        guint n = n_elems[k];
+        guint8 *src, *line, *ref, *part;
+
+        src = g_malloc (in_size * n);
+        for (l = 0; l < in_size * n; l++)
+          src[l] = g_rand_int_range (rand, 0, 256);
+        line = g_malloc0 (out_size * n);
+        ref = g_malloc0 (out_size * n);
+        part = g_malloc0 (out_size * n);
+
+        gst_video_scaler_horizontal (scale, formats[k], src, line, 0,
+            out_size);
+        for (l = 0; l < out_size; l++)
+          gst_video_scaler_horizontal (scale, formats[k], src, ref, l, 1);
+        fail_unless (memcmp (line, ref, out_size * n) == 0,
+            "%s %u->%u differs from pixel by pixel scaling",
+            gst_video_format_to_string (formats[k]), in_size, out_size);
+
+        gst_video_scaler_horizontal (scale, formats[k], src, part, 3,
+            out_size - 3);
+        fail_unless (memcmp (part + 3 * n, ref + 3 * n,
+                (out_size - 3) * n) == 0,
+            "%s %u->%u differs with destination offset 3",
+            gst_video_format_to_string (formats[k]), in_size, out_size);
+
+        g_free (src);
+        g_free (line);
+        g_free (ref);
+        g_free (part);
+      }
+      gst_video_scaler_free (scale);
+    }
+  }
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.01
@@ -2595,6 +2943,343 @@ GST_START_TEST (test_video_convert)
 
 GST_END_TEST;
 
+static const GstVideoFormat alpha_formats[] = {
+  GST_VIDEO_FORMAT_ARGB, GST_VIDEO_FORMAT_BGRA, GST_VIDEO_FORMAT_ABGR,
+  GST_VIDEO_FORMAT_RGBA, GST_VIDEO_FORMAT_AYUV
+};
+
+static void
+convert_alpha_frame (GstVideoFormat format, GstVideoAlphaMode mode,
+    gdouble value)
+{
+  GstVideoInfo info;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  GstVideoConverter *convert;
+  guint8 *in, *out;
+  gint x, y, c, a_off, in_stride, out_stride;
+  guint alpha;
+
+  fail_unless (gst_video_info_set_format (&info, format, 67, 31));
+  a_off = GST_VIDEO_INFO_COMP_POFFSET (&info, GST_VIDEO_COMP_A);
+  alpha = 255 * value;
+
+  inbuffer = gst_buffer_new_and_alloc (info.size);
+  outbuffer = gst_buffer_new_and_alloc (info.size);
+  gst_video_frame_map (&inframe, &info, inbuffer, GST_MAP_READWRITE);
+  gst_video_frame_map (&outframe, &info, outbuffer, GST_MAP_WRITE);
+
+  in = GST_VIDEO_FRAME_PLANE_DATA (&inframe, 0);
+  in_stride = GST_VIDEO_FRAME_PLANE_STRIDE (&inframe, 0);
+  for (y = 0; y < 31; y++)
+    for (x = 0; x < 67 * 4; x++)
+      in[y * in_stride + x] = x * 3 + y * 5;
+
+  convert = gst_video_converter_new (&info, &info,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_ALPHA_MODE, GST_TYPE_VIDEO_ALPHA_MODE, mode,
+          GST_VIDEO_CONVERTER_OPT_ALPHA_VALUE, G_TYPE_DOUBLE, value, NULL));
+  gst_video_converter_frame (convert, &inframe, &outframe);
+  gst_video_converter_free (convert);
+
+  out = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0);
+  out_stride = GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0);
+  for (y = 0; y < 31; y++) {
+    for (x = 0; x < 67; x++) {
+      for (c = 0; c < 4; c++) {
+        guint8 v = in[y * in_stride + x * 4 + c];
+        guint8 expected;
+
+        if (c != a_off)
+          expected = v;
+        else if (mode == GST_VIDEO_ALPHA_MODE_MULT)
+          expected = (v * alpha + 127) / 255;
+        else
+          expected = alpha;
+
+        fail_unless_equals_int (out[y * out_stride + x * 4 + c], expected);
+      }
+    }
+  }
+
+  gst_video_frame_unmap (&outframe);
+  gst_buffer_unref (outbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_START_TEST (test_video_convert_alpha)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (alpha_formats); i++) {
+    GST_DEBUG ("checking %s",
+        gst_video_format_to_string (alpha_formats[i]));
+
+    convert_alpha_frame (alpha_formats[i], GST_VIDEO_ALPHA_MODE_SET, 0.5);
+    convert_alpha_frame (alpha_formats[i], GST_VIDEO_ALPHA_MODE_MULT, 0.5);
+    convert_alpha_frame (alpha_formats[i], GST_VIDEO_ALPHA_MODE_MULT, 0.0);
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_convert_fill_border)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  GstVideoConverter *convert;
+  gint x, y, c, stride;
+  guint8 *out;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (alpha_formats); i++) {
+    GstVideoFormat format = alpha_formats[i];
+    guint8 border[4];
+
+    GST_DEBUG ("checking %s", gst_video_format_to_string (format));
+
+    fail_unless (gst_video_info_set_format (&ininfo, format, 32, 16));
+    fail_unless (gst_video_info_set_format (&outinfo, format, 64, 48));
+
+    inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+    gst_buffer_memset (inbuffer, 0, 0x80, -1);
+    outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+    gst_buffer_memset (outbuffer, 0, 0x00, -1);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+    gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_READWRITE);
+
+    convert = gst_video_converter_new (&ininfo, &outinfo,
+        gst_structure_new ("options",
+            GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, 10,
+            GST_VIDEO_CONVERTER_OPT_DEST_Y, G_TYPE_INT, 7,
+            GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT, 32,
+            GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT, 16,
+            GST_VIDEO_CONVERTER_OPT_BORDER_ARGB, G_TYPE_UINT, 0xff203040,
+            NULL));
+    gst_video_converter_frame (convert, &inframe, &outframe);
+    gst_video_converter_free (convert);
+
+    out = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0);
+    stride = GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0);
+
+    if (GST_VIDEO_INFO_IS_RGB (&outinfo)) {
+      border[GST_VIDEO_INFO_COMP_POFFSET (&outinfo, GST_VIDEO_COMP_A)] = 0xff;
+      border[GST_VIDEO_INFO_COMP_POFFSET (&outinfo, GST_VIDEO_COMP_R)] = 0x20;
+      border[GST_VIDEO_INFO_COMP_POFFSET (&outinfo, GST_VIDEO_COMP_G)] = 0x30;
+      border[GST_VIDEO_INFO_COMP_POFFSET (&outinfo, GST_VIDEO_COMP_B)] = 0x40;
+    } else {
+      /* only check that all of the border has the same color */
+      memcpy (border, out, 4);
+      fail_unless_equals_int (border[0], 0xff);
+    }
+
+    for (y = 0; y < 48; y++) {
+      for (x = 0; x < 64; x++) {
+        gboolean inside = x >= 10 && x < 42 && y >= 7 && y < 23;
+
+        for (c = 0; c < 4; c++) {
+          guint8 v = out[y * stride + x * 4 + c];
+
+          if (inside)
+            fail_unless_equals_int (v, 0x80);
+          else
+            fail_unless_equals_int (v, border[c]);
+        }
+      }
+    }
+
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+}
+
+GST_END_TEST;
+
+static void
+get_converter_cache_stats (guint64 * hits, guint64 * misses, guint * entries)
+{
+  GstStructure *stats;
+
+  stats = gst_video_converter_get_cache_stats ();
+  fail_unless (gst_structure_get_uint64 (stats, "hits", hits));
+  fail_unless (gst_structure_get_uint64 (stats, "misses", misses));
+  fail_unless (gst_structure_get_uint (stats, "entries", entries));
+  gst_structure_free (stats);
+}
+
+GST_START_TEST (test_video_converter_cache)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoConverter *convert1, *convert2;
+  guint64 hits, misses, hits2, misses2;
+  guint entries, entries2;
+
+  fail_unless (gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 320,
+          240));
+  fail_unless (gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_BGRx, 160,
+          120));
+
+  get_converter_cache_stats (&hits, &misses, &entries);
+  convert1 = gst_video_converter_new_cached (&ininfo, &outinfo,
+      gst_structure_new ("options", GST_VIDEO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, 1, NULL));
+  fail_unless (convert1 != NULL);
+  get_converter_cache_stats (&hits2, &misses2, &entries2);
+  fail_unless_equals_uint64 (hits2, hits);
+  fail_unless_equals_uint64 (misses2, misses + 1);
+
+  /* freeing keeps it around for the next user with the same config */
+  gst_video_converter_free (convert1);
+  get_converter_cache_stats (&hits, &misses, &entries);
+  fail_unless_equals_int (entries, entries2 + 1);
+
+  convert2 = gst_video_converter_new_cached (&ininfo, &outinfo,
+      gst_structure_new ("other-name", GST_VIDEO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, 1, NULL));
+  fail_unless (convert2 == convert1);
+  get_converter_cache_stats (&hits2, &misses2, &entries2);
+  fail_unless_equals_uint64 (hits2, hits + 1);
+  fail_unless_equals_int (entries2, entries - 1);
+
+  /* a different config needs a new converter */
+  convert1 = gst_video_converter_new_cached (&ininfo, &outinfo,
+      gst_structure_new ("options", GST_VIDEO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, 2, NULL));
+  fail_unless (convert1 != convert2);
+  get_converter_cache_stats (&hits, &misses, &entries);
+  fail_unless_equals_uint64 (misses, misses2 + 1);
+  gst_video_converter_free (convert1);
+
+  /* the config no longer matches how it was created, don't reuse */
+  gst_video_converter_set_config (convert2,
+      gst_structure_new ("options", GST_VIDEO_CONVERTER_OPT_ALPHA_VALUE,
+          G_TYPE_DOUBLE, 0.5, NULL));
+  get_converter_cache_stats (&hits, &misses, &entries);
+  gst_video_converter_free (convert2);
+  get_converter_cache_stats (&hits2, &misses2, &entries2);
+  fail_unless_equals_int (entries2, entries);
+
+  /* shrinking the cache frees everything */
+  gst_video_converter_set_cache_size (0);
+  get_converter_cache_stats (&hits, &misses, &entries);
+  fail_unless_equals_int (entries, 0);
+
+  convert1 = gst_video_converter_new_cached (&ininfo, &outinfo, NULL);
+  gst_video_converter_free (convert1);
+  get_converter_cache_stats (&hits, &misses, &entries);
+  fail_unless_equals_int (entries, 0);
+
+  gst_video_converter_set_cache_size (32 * 1024 * 1024);
+}
+
+GST_END_TEST;
+
+static GstVideoConverter *
+gamma_remap_converter (GstVideoInfo * ininfo, GstVideoInfo * outinfo,
+    guint n_threads)
+{
+  return gst_video_converter_new (ininfo, outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_GAMMA_MODE, GST_TYPE_VIDEO_GAMMA_MODE,
+          GST_VIDEO_GAMMA_MODE_REMAP, GST_VIDEO_CONVERTER_OPT_THREADS,
+          G_TYPE_UINT, n_threads, NULL));
+}
+
+static void
+check_gamma_remap_frame (GstVideoFrame * inframe, GstVideoFrame * outframe)
+{
+  guint8 *in;
+  guint16 *out;
+  gint x, y, c, in_stride, out_stride;
+
+  in = GST_VIDEO_FRAME_PLANE_DATA (inframe, 0);
+  in_stride = GST_VIDEO_FRAME_PLANE_STRIDE (inframe, 0);
+  out = GST_VIDEO_FRAME_PLANE_DATA (outframe, 0);
+  out_stride = GST_VIDEO_FRAME_PLANE_STRIDE (outframe, 0) / 2;
+
+  for (y = 0; y < 16; y++) {
+    for (x = 0; x < 64; x++) {
+      for (c = 0; c < 4; c++) {
+        guint8 v = in[y * in_stride + x * 4 + c];
+        gint expected;
+
+        /* alpha is only expanded, the colors are made linear */
+        if (c == 0)
+          expected = v * 257;
+        else
+          expected = lrint (gst_video_color_transfer_decode
+              (GST_VIDEO_TRANSFER_SRGB, v / 255.0) * 65535.0);
+
+        fail_unless (ABS (out[y * out_stride + x * 4 + c] - expected) <= 1,
+            "component %d of %u: %u != %d", c, v,
+            out[y * out_stride + x * 4 + c], expected);
+      }
+    }
+  }
+}
+
+GST_START_TEST (test_video_convert_gamma_remap)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe;
+  GstBuffer *inbuffer, *outbuffer;
+  GstVideoConverter *convert1, *convert2;
+  gint x, y, c, stride;
+  guint8 *in;
+
+  fail_unless (gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_ARGB, 64,
+          16));
+  fail_unless (gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_ARGB64,
+          64, 16));
+  ininfo.colorimetry.transfer = GST_VIDEO_TRANSFER_SRGB;
+  outinfo.colorimetry.transfer = GST_VIDEO_TRANSFER_GAMMA10;
+
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READWRITE);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_READWRITE);
+
+  /* every value appears in every component */
+  in = GST_VIDEO_FRAME_PLANE_DATA (&inframe, 0);
+  stride = GST_VIDEO_FRAME_PLANE_STRIDE (&inframe, 0);
+  for (y = 0; y < 16; y++)
+    for (x = 0; x < 64; x++)
+      for (c = 0; c < 4; c++)
+        in[y * stride + x * 4 + c] = x * 4 + ((c + y) & 3);
+
+  /* the gamma tables are shared between the converters and all their
+   * threads, they must stay valid until the last one is freed */
+  convert1 = gamma_remap_converter (&ininfo, &outinfo, 1);
+  convert2 = gamma_remap_converter (&ininfo, &outinfo, 2);
+
+  gst_video_converter_frame (convert1, &inframe, &outframe);
+  check_gamma_remap_frame (&inframe, &outframe);
+  gst_video_converter_free (convert1);
+
+  memset (GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0), 0, outinfo.size);
+  gst_video_converter_frame (convert2, &inframe, &outframe);
+  check_gamma_remap_frame (&inframe, &outframe);
+  gst_video_converter_free (convert2);
+
+  /* and are created again when needed after that */
+  convert1 = gamma_remap_converter (&ininfo, &outinfo, 1);
+  memset (GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0), 0, outinfo.size);
+  gst_video_converter_frame (convert1, &inframe, &outframe);
+  check_gamma_remap_frame (&inframe, &outframe);
+  gst_video_converter_free (convert1);
+
+  gst_video_frame_unmap (&outframe);
+  gst_buffer_unref (outbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_transfer)
 {
   gint i, j;
@@ -2896,6 +3581,214 @@ GST_START_TEST (test_overlay_composition_over_transparency)
 
 GST_END_TEST;
 
+static void
+get_scale_cache_stats (guint64 * hits, guint64 * misses, guint64 * size)
+{
+  GstStructure *stats;
+
+  stats = gst_video_overlay_composition_get_scale_cache_stats ();
+  fail_unless (gst_structure_get_uint64 (stats, "hits", hits));
+  fail_unless (gst_structure_get_uint64 (stats, "misses", misses));
+  fail_unless (gst_structure_get_uint64 (stats, "size", size));
+  gst_structure_free (stats);
+}
+
+GST_START_TEST (test_overlay_composition_scale_cache)
+{
+  GstVideoOverlayComposition *comp1, *comp2;
+  GstVideoOverlayRectangle *rect1, *rect2;
+  GstVideoFrame video_frame;
+  GstBuffer *pix1, *pix2;
+  GstVideoInfo vinfo;
+  guint64 hits, misses, size, hits2, misses2, size2;
+
+  pix1 = gst_buffer_new_and_alloc (VIDEO_WIDTH * VIDEO_HEIGHT * 4);
+  gst_buffer_memset (pix1, 0, 0, gst_buffer_get_size (pix1));
+  gst_video_info_init (&vinfo);
+  fail_unless (gst_video_info_set_format (&vinfo,
+          GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, VIDEO_WIDTH, VIDEO_HEIGHT));
+  gst_video_frame_map (&video_frame, &vinfo, pix1, GST_MAP_READWRITE);
+  gst_buffer_unref (pix1);
+
+  pix2 = gst_buffer_new_and_alloc (50 * 50 * 4);
+  gst_buffer_memset (pix2, 0, 0x80, gst_buffer_get_size (pix2));
+  gst_buffer_add_video_meta (pix2, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 50, 50);
+  rect1 = gst_video_overlay_rectangle_new_raw (pix2, 10, 10, 100, 100,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  gst_buffer_unref (pix2);
+  comp1 = gst_video_overlay_composition_new (rect1);
+
+  /* first blend scales, the second one uses the cached pixels */
+  get_scale_cache_stats (&hits, &misses, &size);
+  fail_unless (gst_video_overlay_composition_blend (comp1, &video_frame));
+  get_scale_cache_stats (&hits2, &misses2, &size2);
+  fail_unless_equals_uint64 (hits2, hits);
+  fail_unless_equals_uint64 (misses2, misses + 1);
+  fail_unless (size2 >= size + 100 * 100 * 4);
+
+  fail_unless (gst_video_overlay_composition_blend (comp1, &video_frame));
+  get_scale_cache_stats (&hits, &misses, &size);
+  fail_unless_equals_uint64 (hits, hits2 + 1);
+  fail_unless_equals_uint64 (misses, misses2);
+
+  /* copies share the pixels and the cached scaled pixels */
+  comp2 = gst_video_overlay_composition_copy (comp1);
+  fail_unless (gst_video_overlay_composition_blend (comp2, &video_frame));
+  get_scale_cache_stats (&hits2, &misses2, &size2);
+  fail_unless_equals_uint64 (hits2, hits + 1);
+  fail_unless_equals_uint64 (misses2, misses);
+
+  /* a different render size needs scaling again */
+  comp2 = gst_video_overlay_composition_make_writable (comp2);
+  rect2 = gst_video_overlay_composition_get_rectangle (comp2, 0);
+  gst_video_overlay_rectangle_set_render_rectangle (rect2, 10, 10, 80, 80);
+  fail_unless (gst_video_overlay_composition_blend (comp2, &video_frame));
+  get_scale_cache_stats (&hits, &misses, &size);
+  fail_unless_equals_uint64 (hits, hits2);
+  fail_unless_equals_uint64 (misses, misses2 + 1);
+
+  /* shrinking the cache evicts everything */
+  gst_video_overlay_composition_set_scale_cache_size (0);
+  get_scale_cache_stats (&hits, &misses, &size);
+  fail_unless_equals_uint64 (size, 0);
+  fail_unless (gst_video_overlay_composition_blend (comp1, &video_frame));
+  get_scale_cache_stats (&hits2, &misses2, &size2);
+  fail_unless_equals_uint64 (misses2, misses + 1);
+  fail_unless_equals_uint64 (size2, 0);
+  gst_video_overlay_composition_set_scale_cache_size (32 * 1024 * 1024);
+
+  gst_video_overlay_composition_unref (comp2);
+  gst_video_overlay_composition_unref (comp1);
+  gst_video_overlay_rectangle_unref (rect1);
+  gst_video_frame_unmap (&video_frame);
+}
+
+GST_END_TEST;
+
+static void
+fill_blend_test_frame (GstVideoFrame * frame)
+{
+  guint c, i, j;
+
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (frame); c++) {
+    guint8 *data = GST_VIDEO_FRAME_COMP_DATA (frame, c);
+
+    for (i = 0; i < GST_VIDEO_FRAME_COMP_HEIGHT (frame, c); i++)
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_WIDTH (frame, c); j++)
+        data[i * GST_VIDEO_FRAME_COMP_STRIDE (frame, c) +
+            j * GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c)] = c * 50 + i * 3 + j;
+  }
+}
+
+static void
+compare_blend_test_frames (GstVideoFrame * frame1, GstVideoFrame * frame2)
+{
+  guint c, i, j;
+
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (frame1); c++) {
+    guint8 *data1 = GST_VIDEO_FRAME_COMP_DATA (frame1, c);
+    guint8 *data2 = GST_VIDEO_FRAME_COMP_DATA (frame2, c);
+
+    for (i = 0; i < GST_VIDEO_FRAME_COMP_HEIGHT (frame1, c); i++)
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_WIDTH (frame1, c); j++)
+        fail_unless_equals_int (data1[i *
+                GST_VIDEO_FRAME_COMP_STRIDE (frame1, c) +
+                j * GST_VIDEO_FRAME_COMP_PSTRIDE (frame1, c)],
+            data2[i * GST_VIDEO_FRAME_COMP_STRIDE (frame2, c) +
+                j * GST_VIDEO_FRAME_COMP_PSTRIDE (frame2, c)]);
+  }
+}
+
+static void
+blend_test_composition (GstVideoOverlayComposition * comp,
+    GstVideoInfo * rect_info, GstBuffer * pixels, GstVideoFormat format,
+    GstVideoFormat generic_format)
+{
+  GstVideoFrame frame, generic_frame, rect_frame;
+  GstVideoInfo info, generic_info;
+  GstBuffer *buf, *generic_buf;
+
+  /* the direct code for I420 and NV12, which skips the transparent parts of
+   * the overlay, gives the same result as the generic code for YV12 and
+   * NV21 blending the whole overlay */
+  gst_video_info_set_format (&info, format, 640, 480);
+  buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&info));
+  gst_video_frame_map (&frame, &info, buf, GST_MAP_READWRITE);
+  fill_blend_test_frame (&frame);
+  fail_unless (gst_video_overlay_composition_blend (comp, &frame));
+
+  gst_video_info_set_format (&generic_info, generic_format, 640, 480);
+  generic_buf = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&generic_info));
+  gst_video_frame_map (&generic_frame, &generic_info, generic_buf,
+      GST_MAP_READWRITE);
+  fill_blend_test_frame (&generic_frame);
+  gst_video_frame_map (&rect_frame, rect_info, pixels, GST_MAP_READ);
+  fail_unless (gst_video_blend (&generic_frame, &rect_frame, 13, 7, 1.0));
+  gst_video_frame_unmap (&rect_frame);
+
+  compare_blend_test_frames (&frame, &generic_frame);
+
+  gst_video_frame_unmap (&generic_frame);
+  gst_video_frame_unmap (&frame);
+  gst_buffer_unref (generic_buf);
+  gst_buffer_unref (buf);
+}
+
+GST_START_TEST (test_overlay_composition_blend_420)
+{
+  GstVideoOverlayComposition *comp;
+  GstVideoOverlayRectangle *rect;
+  GstVideoFrame rect_frame;
+  GstVideoInfo vinfo;
+  GstBuffer *pix;
+  guint8 *data;
+  gint i, j, a, r, g, b;
+
+  /* big enough to be blended by several threads, with transparent borders */
+  pix = gst_buffer_new_and_alloc (400 * 400 * 4);
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 400, 400);
+  gst_video_info_set_format (&vinfo, GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB,
+      400, 400);
+  gst_video_frame_map (&rect_frame, &vinfo, pix, GST_MAP_WRITE);
+  data = GST_VIDEO_FRAME_PLANE_DATA (&rect_frame, 0);
+  a = GST_VIDEO_FRAME_COMP_POFFSET (&rect_frame, GST_VIDEO_COMP_A);
+  r = GST_VIDEO_FRAME_COMP_POFFSET (&rect_frame, GST_VIDEO_COMP_R);
+  g = GST_VIDEO_FRAME_COMP_POFFSET (&rect_frame, GST_VIDEO_COMP_G);
+  b = GST_VIDEO_FRAME_COMP_POFFSET (&rect_frame, GST_VIDEO_COMP_B);
+  for (i = 0; i < 400; i++) {
+    for (j = 0; j < 400; j++) {
+      guint8 *p = data + i * GST_VIDEO_FRAME_PLANE_STRIDE (&rect_frame, 0) +
+          j * 4;
+
+      if (i < 30 || i >= 370 || j < 50 || j >= 350 || (i > 100 && i < 120))
+        p[a] = 0;
+      else
+        p[a] = i + j;
+      p[r] = j;
+      p[g] = i;
+      p[b] = i ^ j;
+    }
+  }
+  gst_video_frame_unmap (&rect_frame);
+
+  rect = gst_video_overlay_rectangle_new_raw (pix, 13, 7, 400, 400,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  comp = gst_video_overlay_composition_new (rect);
+
+  blend_test_composition (comp, &vinfo, pix, GST_VIDEO_FORMAT_I420,
+      GST_VIDEO_FORMAT_YV12);
+  blend_test_composition (comp, &vinfo, pix, GST_VIDEO_FORMAT_NV12,
+      GST_VIDEO_FORMAT_NV21);
+
+  gst_video_overlay_composition_unref (comp);
+  gst_video_overlay_rectangle_unref (rect);
+  gst_buffer_unref (pix);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 video_suite (void)
@@ -2920,6 +3813,7 @@ video_suite (void)
   tcase_add_test (tc_chain, test_events);
   tcase_add_test (tc_chain, test_convert_frame);
   tcase_add_test (tc_chain, test_convert_frame_async);
+  tcase_add_test (tc_chain, test_video_sample_converter);
   tcase_add_test (tc_chain, test_video_size_from_caps);
   tcase_add_test (tc_chain, test_interlace_mode);
   tcase_add_test (tc_chain, test_overlay_composition);
@@ -2927,14 +3821,22 @@ video_suite (void)
   tcase_add_test (tc_chain, test_overlay_composition_global_alpha);
   tcase_add_test (tc_chain, test_video_pack_unpack2);
   tcase_add_test (tc_chain, test_video_chroma);
+  tcase_add_test (tc_chain, test_video_chroma_resample_exact);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_h_ntap_blocks);
   tcase_add_test (tc_chain, test_video_color_convert);
   tcase_add_test (tc_chain, test_video_size_convert);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_alpha);
+  tcase_add_test (tc_chain, test_video_convert_fill_border);
+  tcase_add_test (tc_chain, test_video_converter_cache);
+  tcase_add_test (tc_chain, test_video_convert_gamma_remap);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);
   tcase_add_test (tc_chain, test_overlay_composition_over_transparency);
+  tcase_add_test (tc_chain, test_overlay_composition_scale_cache);
+  tcase_add_test (tc_chain, test_overlay_composition_blend_420);
 
   return s;
 }
@@ -0,0 +1,123 @@
+/* GStreamer video sample conversion benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the time it takes to make thumbnails of the same video frame
+ * with gst_video_convert_sample(), which builds a new pipeline every time,
+ * and with a GstVideoSampleConverter, which keeps the conversion set up. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define NUM_CONVERSIONS 200
+
+static GstSample *
+make_sample (void)
+{
+  GstVideoInfo info;
+  GstBuffer *buf;
+  GstCaps *caps;
+  GstSample *sample;
+
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 1280, 720);
+  info.fps_n = 25;
+  info.fps_d = 1;
+  caps = gst_video_info_to_caps (&info);
+
+  buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&info), NULL);
+  gst_buffer_memset (buf, 0, 0x80, GST_VIDEO_INFO_SIZE (&info));
+
+  sample = gst_sample_new (buf, caps, NULL, NULL);
+  gst_buffer_unref (buf);
+  gst_caps_unref (caps);
+
+  return sample;
+}
+
+static GstClockTime
+run_conversions (GstVideoSampleConverter * converter, GstSample * sample,
+    GstCaps * to_caps)
+{
+  GstClockTime start;
+  guint i;
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_CONVERSIONS; i++) {
+    GstSample *result;
+    GError *err = NULL;
+
+    if (converter)
+      result = gst_video_sample_converter_convert (converter, sample,
+          to_caps, GST_CLOCK_TIME_NONE, &err);
+    else
+      result = gst_video_convert_sample (sample, to_caps,
+          GST_CLOCK_TIME_NONE, &err);
+
+    if (result == NULL) {
+      g_printerr ("Conversion failed: %s\n", err ? err->message : "unknown");
+      g_clear_error (&err);
+      return GST_CLOCK_TIME_NONE;
+    }
+    gst_sample_unref (result);
+  }
+
+  return (gst_util_get_timestamp () - start) / NUM_CONVERSIONS;
+}
+
+int
+main (int argc, char **argv)
+{
+  GstVideoSampleConverter *converter;
+  GstSample *sample;
+  const gchar *targets[] = {
+    /* fixed raw caps, converted directly */
+    "video/x-raw, format=(string)RGB, width=(int)160, height=(int)90, "
+        "pixel-aspect-ratio=(fraction)1/1",
+    /* caps negotiated by a conversion pipeline */
+    "video/x-raw, format=(string)RGB, width=(int)160",
+  };
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  sample = make_sample ();
+
+  for (i = 0; i < G_N_ELEMENTS (targets); i++) {
+    GstCaps *to_caps = gst_caps_from_string (targets[i]);
+    GstClockTime fresh, reused;
+
+    converter = gst_video_sample_converter_new ();
+    fresh = run_conversions (NULL, sample, to_caps);
+    reused = run_conversions (converter, sample, to_caps);
+    gst_video_sample_converter_free (converter);
+
+    g_print ("%s\n", targets[i]);
+    g_print ("  %-24s %" GST_TIME_FORMAT " per conversion\n",
+        "gst_video_convert_sample", GST_TIME_ARGS (fresh));
+    g_print ("  %-24s %" GST_TIME_FORMAT " per conversion\n",
+        "GstVideoSampleConverter", GST_TIME_ARGS (reused));
+
+    gst_caps_unref (to_caps);
+  }
+
+  gst_sample_unref (sample);
+
+  return 0;
+}
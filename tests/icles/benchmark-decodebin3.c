@@ -0,0 +1,198 @@
+/* GStreamer decodebin3 startup benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the time it takes decodebin3 to output the first video buffer
+ * of a file with many audio tracks, with and without the drop-unselected
+ * property. A file can be given on the command line, otherwise one with a
+ * video and NUM_AUDIO_TRACKS audio tracks is encoded into the temporary
+ * directory first. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+
+#define NUM_ITERATIONS 10
+#define NUM_AUDIO_TRACKS 16
+
+static gboolean
+generate_file (const gchar * location)
+{
+  GstElement *pipeline;
+  GstMessage *msg;
+  GError *err = NULL;
+  GString *str;
+  gboolean ret;
+  guint i;
+
+  str = g_string_new (NULL);
+  g_string_append_printf (str, "oggmux name=mux ! filesink location=\"%s\" "
+      "videotestsrc num-buffers=100 ! theoraenc ! mux.", location);
+  for (i = 0; i < NUM_AUDIO_TRACKS; i++)
+    g_string_append (str,
+        " audiotestsrc num-buffers=100 ! vorbisenc ! queue ! mux.");
+
+  pipeline = gst_parse_launch (str->str, &err);
+  g_string_free (str, TRUE);
+  if (err != NULL) {
+    g_printerr ("Could not generate %s: %s\n", location, err->message);
+    g_clear_error (&err);
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  ret = (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+static GstPadProbeReturn
+first_buffer_probe (GstPad * pad, GstPadProbeInfo * info, GstElement * sink)
+{
+  gst_element_post_message (sink,
+      gst_message_new_application (GST_OBJECT_CAST (sink),
+          gst_structure_new_empty ("first-video-buffer")));
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+static void
+pad_added_cb (GstElement * decodebin, GstPad * pad, GstElement * pipeline)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+  gchar *name;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "sync", FALSE, NULL);
+  gst_bin_add (GST_BIN (pipeline), sink);
+  gst_element_sync_state_with_parent (sink);
+
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  name = gst_pad_get_name (pad);
+  if (g_str_has_prefix (name, "video"))
+    gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER,
+        (GstPadProbeCallback) first_buffer_probe, sink, NULL);
+  g_free (name);
+
+  gst_pad_link (pad, sinkpad);
+  gst_object_unref (sinkpad);
+}
+
+static GstClockTime
+run_decodebin3 (const gchar * filename, gboolean drop_unselected,
+    guint64 * dropped)
+{
+  GstClockTime total = 0;
+  guint i;
+
+  *dropped = 0;
+
+  for (i = 0; i < NUM_ITERATIONS; i++) {
+    GstElement *pipeline, *src, *decodebin;
+    GstStructure *stats = NULL;
+    GstMessage *msg;
+    GstClockTime start;
+    guint64 n = 0;
+
+    pipeline = gst_pipeline_new (NULL);
+    src = gst_element_factory_make ("filesrc", NULL);
+    decodebin = gst_element_factory_make ("decodebin3", NULL);
+    if (decodebin == NULL) {
+      g_printerr ("decodebin3 is not available\n");
+      gst_object_unref (pipeline);
+      return GST_CLOCK_TIME_NONE;
+    }
+    g_object_set (src, "location", filename, NULL);
+    g_object_set (decodebin, "drop-unselected", drop_unselected, NULL);
+    gst_bin_add_many (GST_BIN (pipeline), src, decodebin, NULL);
+    gst_element_link (src, decodebin);
+    g_signal_connect (decodebin, "pad-added", G_CALLBACK (pad_added_cb),
+        pipeline);
+
+    start = gst_util_get_timestamp ();
+    gst_element_set_state (pipeline, GST_STATE_PLAYING);
+    msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+        GST_CLOCK_TIME_NONE,
+        GST_MESSAGE_APPLICATION | GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+    total += gst_util_get_timestamp () - start;
+
+    if (GST_MESSAGE_TYPE (msg) != GST_MESSAGE_APPLICATION)
+      g_printerr ("No video buffer was output\n");
+    gst_message_unref (msg);
+
+    g_object_get (decodebin, "stats", &stats, NULL);
+    if (stats && gst_structure_get_uint64 (stats, "dropped-buffers", &n))
+      *dropped += n;
+    if (stats)
+      gst_structure_free (stats);
+
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+  }
+
+  *dropped /= NUM_ITERATIONS;
+
+  return total / NUM_ITERATIONS;
+}
+
+int
+main (int argc, char **argv)
+{
+  GstClockTime normal, dropping;
+  gchar *filename;
+  gboolean remove_file = FALSE;
+  guint64 dropped;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1) {
+    filename = g_strdup (argv[1]);
+  } else {
+    filename = g_build_filename (g_get_tmp_dir (),
+        "benchmark-decodebin3.ogg", NULL);
+    if (!generate_file (filename)) {
+      g_free (filename);
+      return 1;
+    }
+    remove_file = TRUE;
+  }
+
+  normal = run_decodebin3 (filename, FALSE, &dropped);
+  g_print ("%-24s first video buffer after %" GST_TIME_FORMAT "\n",
+      "default", GST_TIME_ARGS (normal));
+
+  dropping = run_decodebin3 (filename, TRUE, &dropped);
+  g_print ("%-24s first video buffer after %" GST_TIME_FORMAT
+      " (%" G_GUINT64_FORMAT " buffers dropped)\n", "drop-unselected",
+      GST_TIME_ARGS (dropping), dropped);
+
+  if (remove_file)
+    g_unlink (filename);
+  g_free (filename);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+/* GStreamer discoverer benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Compares the time it takes to discover files with and without the
+ * parse-only mode of GstDiscoverer. Files can be given on the command line,
+ * otherwise a few are encoded into the temporary directory first. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <gst/pbutils/pbutils.h>
+
+#define NUM_ITERATIONS 20
+
+/* file name and pipeline to encode it with */
+static const gchar *generated[][2] = {
+  {"benchmark-discoverer.wav", "audiotestsrc num-buffers=200 ! wavenc"},
+  {"benchmark-discoverer-vorbis.ogg",
+      "audiotestsrc num-buffers=200 ! vorbisenc ! oggmux"},
+  {"benchmark-discoverer-theora.ogg",
+      "videotestsrc num-buffers=50 ! theoraenc ! oggmux"}
+};
+
+static gboolean
+generate_file (const gchar * description, const gchar * location)
+{
+  GstElement *pipeline;
+  GstMessage *msg;
+  GError *err = NULL;
+  gchar *str;
+  gboolean ret;
+
+  str = g_strdup_printf ("%s ! filesink location=\"%s\"", description,
+      location);
+  pipeline = gst_parse_launch (str, &err);
+  g_free (str);
+  if (err != NULL) {
+    g_printerr ("Skipping %s: %s\n", location, err->message);
+    g_clear_error (&err);
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  ret = (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+static GstClockTime
+run_discoverer (const gchar * uri, gboolean parse_only)
+{
+  GstDiscoverer *dc;
+  GstDiscovererInfo *info;
+  GstClockTime start;
+  guint i;
+
+  dc = gst_discoverer_new (10 * GST_SECOND, NULL);
+  g_object_set (dc, "parse-only", parse_only, NULL);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_ITERATIONS; i++) {
+    info = gst_discoverer_discover_uri (dc, uri, NULL);
+    if (info)
+      gst_discoverer_info_unref (info);
+  }
+
+  g_object_unref (dc);
+
+  return (gst_util_get_timestamp () - start) / NUM_ITERATIONS;
+}
+
+int
+main (int argc, char **argv)
+{
+  GPtrArray *files;
+  gboolean remove_files = FALSE;
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  files = g_ptr_array_new_with_free_func (g_free);
+
+  if (argc > 1) {
+    for (i = 1; i < (guint) argc; i++)
+      g_ptr_array_add (files, g_strdup (argv[i]));
+  } else {
+    for (i = 0; i < G_N_ELEMENTS (generated); i++) {
+      gchar *location;
+
+      location = g_build_filename (g_get_tmp_dir (), generated[i][0], NULL);
+      if (generate_file (generated[i][1], location))
+        g_ptr_array_add (files, location);
+      else
+        g_free (location);
+    }
+    remove_files = TRUE;
+  }
+
+  g_print ("%-40s %16s %16s\n", "file", "full", "parse-only");
+
+  for (i = 0; i < files->len; i++) {
+    const gchar *filename = g_ptr_array_index (files, i);
+    GstClockTime full, parse_only;
+    gchar *uri;
+
+    uri = gst_filename_to_uri (filename, NULL);
+    if (uri == NULL)
+      continue;
+
+    full = run_discoverer (uri, FALSE);
+    parse_only = run_discoverer (uri, TRUE);
+
+    g_print ("%-40s %" GST_TIME_FORMAT " %" GST_TIME_FORMAT "\n",
+        filename, GST_TIME_ARGS (full), GST_TIME_ARGS (parse_only));
+
+    g_free (uri);
+    if (remove_files)
+      g_unlink (filename);
+  }
+
+  g_ptr_array_unref (files);
+
+  return 0;
+}
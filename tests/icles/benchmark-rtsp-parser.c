@@ -0,0 +1,109 @@
+/* GStreamer RTSP parser benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/rtsp/rtsp.h>
+
+#define NUM_MESSAGES 1000000
+#define CHUNK_SIZE 4096
+
+/* a typical keep-alive as sent by clients every few seconds */
+static const gchar keep_alive[] =
+    "GET_PARAMETER rtsp://192.168.1.100:8554/live/stream RTSP/1.0\r\n"
+    "CSeq: 1234\r\n"
+    "User-Agent: LibVLC/3.0.8 (LIVE555 Streaming Media v2016.11.28)\r\n"
+    "Session: 8A6B3D2F1E7C9A04\r\n" "Content-Length: 0\r\n\r\n";
+
+static GByteArray *
+make_stream (void)
+{
+  GByteArray *stream;
+  guint i;
+
+  stream = g_byte_array_sized_new (NUM_MESSAGES * (sizeof (keep_alive) - 1));
+  for (i = 0; i < NUM_MESSAGES; i++)
+    g_byte_array_append (stream, (const guint8 *) keep_alive,
+        sizeof (keep_alive) - 1);
+
+  return stream;
+}
+
+/* feed @stream in chunks like a socket read would and parse all messages,
+ * optionally creating a GstRTSPMessage for each of them */
+static void
+run (const gchar * name, GByteArray * stream, gboolean materialize)
+{
+  GstRTSPParser *parser;
+  GstRTSPMessage msg = { 0 };
+  gint64 start, end;
+  guint offset = 0, count = 0;
+
+  parser = gst_rtsp_parser_new ();
+
+  start = g_get_monotonic_time ();
+  while (offset < stream->len) {
+    guint len = MIN (CHUNK_SIZE, stream->len - offset);
+
+    gst_rtsp_parser_feed (parser, &stream->data[offset], len);
+    offset += len;
+
+    while (gst_rtsp_parser_parse (parser) == GST_RTSP_OK) {
+      const gchar *session;
+
+      /* what a server does with a keep-alive */
+      gst_rtsp_parser_get_header (parser, GST_RTSP_HDR_SESSION, &session, 0);
+
+      if (materialize) {
+        gst_rtsp_parser_get_message (parser, &msg);
+        gst_rtsp_message_unset (&msg);
+      }
+      count++;
+    }
+  }
+  end = g_get_monotonic_time ();
+
+  g_assert_cmpuint (count, ==, NUM_MESSAGES);
+
+  g_print ("%-12s: %u messages in %.3f s, %.0f messages/s, %.1f MB/s\n",
+      name, count, (end - start) / (gdouble) G_USEC_PER_SEC,
+      count * (gdouble) G_USEC_PER_SEC / (end - start),
+      stream->len / (gdouble) (end - start));
+
+  gst_rtsp_parser_free (parser);
+}
+
+int
+main (int argc, char **argv)
+{
+  GByteArray *stream;
+
+  gst_init (&argc, &argv);
+
+  stream = make_stream ();
+
+  run ("lazy", stream, FALSE);
+  run ("materialized", stream, TRUE);
+
+  g_byte_array_unref (stream);
+
+  return 0;
+}
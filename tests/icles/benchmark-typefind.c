@@ -0,0 +1,181 @@
+/* GStreamer typefinding benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the time it takes to typefind the start of each file given on the
+ * command line. Without arguments a small synthetic corpus is used, which
+ * mostly exercises the typefinders that scan for MPEG start codes. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/base/base.h>
+
+#define NUM_ITERATIONS 100
+#define MAX_PROBE_SIZE (256 * 1024)
+
+typedef struct
+{
+  gchar *name;
+  GstBuffer *buf;
+} CorpusEntry;
+
+static GstBuffer *
+make_noise (guint size, gboolean with_zeros)
+{
+  GRand *rand = g_rand_new_with_seed (size);
+  guint8 *data = g_malloc (size);
+  guint i;
+
+  for (i = 0; i < size; i++) {
+    data[i] = g_rand_int_range (rand, 0, 256);
+    /* avoid accidental start codes in the noise */
+    if (!with_zeros && data[i] < 2)
+      data[i] = 2;
+  }
+  g_rand_free (rand);
+
+  return gst_buffer_new_wrapped (data, size);
+}
+
+/* H.264 byte-stream: SPS/PPS/IDR followed by non-IDR slices with random
+ * payloads between the start codes */
+static GstBuffer *
+make_h264 (guint size)
+{
+  static const guint8 sps[] = { 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0xc0,
+    0x1e, 0xd9, 0x00, 0xa0, 0x47, 0xfe, 0xc8
+  };
+  static const guint8 pps[] = { 0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x3c,
+    0x80
+  };
+  GstBuffer *noise;
+  GstMapInfo map;
+  guint8 *data;
+  guint offset, n = 0;
+
+  noise = make_noise (size, FALSE);
+  gst_buffer_map (noise, &map, GST_MAP_READ);
+
+  data = g_malloc (size);
+  memcpy (data, map.data, size);
+  gst_buffer_unmap (noise, &map);
+  gst_buffer_unref (noise);
+
+  memcpy (data, sps, sizeof (sps));
+  memcpy (data + sizeof (sps), pps, sizeof (pps));
+  offset = sizeof (sps) + sizeof (pps);
+
+  while (offset + 6 < size) {
+    data[offset] = 0x00;
+    data[offset + 1] = 0x00;
+    data[offset + 2] = 0x01;
+    data[offset + 3] = (n++ == 0) ? 0x65 : 0x41;
+    data[offset + 4] = 0x88;
+    offset += 1500;
+  }
+
+  return gst_buffer_new_wrapped (data, size);
+}
+
+static void
+add_entry (GArray * corpus, const gchar * name, GstBuffer * buf)
+{
+  CorpusEntry entry;
+
+  entry.name = g_strdup (name);
+  entry.buf = buf;
+  g_array_append_val (corpus, entry);
+}
+
+static gboolean
+add_file (GArray * corpus, const gchar * filename)
+{
+  GError *err = NULL;
+  gchar *contents;
+  gsize len, size;
+
+  if (!g_file_get_contents (filename, &contents, &len, &err)) {
+    g_printerr ("Could not read %s: %s\n", filename, err->message);
+    g_clear_error (&err);
+    return FALSE;
+  }
+
+  size = MIN (len, MAX_PROBE_SIZE);
+
+  add_entry (corpus, filename,
+      gst_buffer_new_wrapped_full (0, contents, len, 0, size, contents,
+          g_free));
+  return TRUE;
+}
+
+int
+main (int argc, char **argv)
+{
+  GArray *corpus;
+  GstClockTime total = 0;
+  guint i, j;
+
+  gst_init (&argc, &argv);
+
+  corpus = g_array_new (FALSE, FALSE, sizeof (CorpusEntry));
+
+  if (argc > 1) {
+    for (i = 1; i < (guint) argc; i++)
+      add_file (corpus, argv[i]);
+  } else {
+    add_entry (corpus, "noise", make_noise (64 * 1024, TRUE));
+    add_entry (corpus, "noise-without-zeros", make_noise (64 * 1024, FALSE));
+    add_entry (corpus, "h264", make_h264 (64 * 1024));
+  }
+
+  for (i = 0; i < corpus->len; i++) {
+    CorpusEntry *entry = &g_array_index (corpus, CorpusEntry, i);
+    GstTypeFindProbability prob = GST_TYPE_FIND_NONE;
+    GstCaps *caps = NULL;
+    GstClockTime start, elapsed;
+    gchar *caps_str;
+
+    start = gst_util_get_timestamp ();
+    for (j = 0; j < NUM_ITERATIONS; j++) {
+      gst_caps_replace (&caps, NULL);
+      caps = gst_type_find_helper_for_buffer (NULL, entry->buf, &prob);
+    }
+    elapsed = (gst_util_get_timestamp () - start) / NUM_ITERATIONS;
+    total += elapsed;
+
+    caps_str = caps ? gst_caps_to_string (caps) : g_strdup ("(none)");
+    g_print ("%-24s %8" G_GSIZE_FORMAT " bytes  %" GST_TIME_FORMAT
+        "  prob %3d  %s\n", entry->name, gst_buffer_get_size (entry->buf),
+        GST_TIME_ARGS (elapsed), prob, caps_str);
+    g_free (caps_str);
+
+    if (caps)
+      gst_caps_unref (caps);
+    gst_buffer_unref (entry->buf);
+    g_free (entry->name);
+  }
+
+  g_print ("%u inputs, %" GST_TIME_FORMAT " per typefind on average\n",
+      corpus->len, GST_TIME_ARGS (corpus->len ? total / corpus->len : 0));
+
+  g_array_free (corpus, TRUE);
+
+  return 0;
+}
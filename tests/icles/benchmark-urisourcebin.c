@@ -0,0 +1,477 @@
+/* GStreamer urisourcebin buffering benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Plays a file through urisourcebin from a throttled stand-in for a network
+ * source and measures the time until playback starts and the number of
+ * times playback had to rebuffer, with the static buffering watermarks and
+ * with adaptive-buffering. The throughput of the source is a multiple of
+ * the bitrate of the file and varies randomly around that value.
+ *
+ * A file can be given on the command line, otherwise a short video file is
+ * encoded into the temporary directory first. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <gst/base/gstbasesrc.h>
+
+#define CHUNK_SIZE 4096
+#define MAX_RUN_TIME (30 * GST_SECOND)
+
+/* throughput of the source relative to the bitrate of the file */
+static const gdouble speeds[] = { 0.9, 1.2, 2.0, 8.0 };
+
+/* +- variation of the throughput per chunk */
+#define JITTER 0.5
+
+/*** throttle:// source ***/
+
+typedef struct
+{
+  GstBaseSrc parent;
+
+  gchar *location;
+  GMappedFile *file;
+  gsize offset;
+  gboolean sent_tags;
+} ThrottleSrc;
+
+typedef GstBaseSrcClass ThrottleSrcClass;
+
+static GType throttle_src_get_type (void);
+
+/* configuration of all throttle sources */
+static guint64 throttle_rate;   /* bytes/s */
+static guint throttle_bitrate;  /* of the file, in bits/s */
+
+static GstURIType
+throttle_src_uri_get_type (GType type)
+{
+  return GST_URI_SRC;
+}
+
+static const gchar *const *
+throttle_src_uri_get_protocols (GType type)
+{
+  static const gchar *protocols[] = { "throttle", NULL };
+
+  return protocols;
+}
+
+static gchar *
+throttle_src_uri_get_uri (GstURIHandler * handler)
+{
+  ThrottleSrc *src = (ThrottleSrc *) handler;
+
+  return g_strdup_printf ("throttle://%s", src->location);
+}
+
+static gboolean
+throttle_src_uri_set_uri (GstURIHandler * handler, const gchar * uri,
+    GError ** error)
+{
+  ThrottleSrc *src = (ThrottleSrc *) handler;
+
+  if (!g_str_has_prefix (uri, "throttle://"))
+    return FALSE;
+
+  g_free (src->location);
+  src->location = g_strdup (uri + strlen ("throttle://"));
+
+  return TRUE;
+}
+
+static void
+throttle_src_uri_handler_init (gpointer g_iface, gpointer iface_data)
+{
+  GstURIHandlerInterface *iface = (GstURIHandlerInterface *) g_iface;
+
+  iface->get_type = throttle_src_uri_get_type;
+  iface->get_protocols = throttle_src_uri_get_protocols;
+  iface->get_uri = throttle_src_uri_get_uri;
+  iface->set_uri = throttle_src_uri_set_uri;
+}
+
+static void
+throttle_src_init_type (GType type)
+{
+  static const GInterfaceInfo uri_hdlr_info = {
+    throttle_src_uri_handler_init, NULL, NULL
+  };
+
+  g_type_add_interface_static (type, GST_TYPE_URI_HANDLER, &uri_hdlr_info);
+}
+
+G_DEFINE_TYPE_WITH_CODE (ThrottleSrc, throttle_src, GST_TYPE_BASE_SRC,
+    throttle_src_init_type (g_define_type_id));
+
+static GstStaticPadTemplate throttle_src_template =
+GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+static gboolean
+throttle_src_start (GstBaseSrc * basesrc)
+{
+  ThrottleSrc *src = (ThrottleSrc *) basesrc;
+
+  src->file = g_mapped_file_new (src->location, FALSE, NULL);
+  src->offset = 0;
+  src->sent_tags = FALSE;
+
+  return src->file != NULL;
+}
+
+static gboolean
+throttle_src_stop (GstBaseSrc * basesrc)
+{
+  ThrottleSrc *src = (ThrottleSrc *) basesrc;
+
+  if (src->file)
+    g_mapped_file_unref (src->file);
+  src->file = NULL;
+
+  return TRUE;
+}
+
+static gboolean
+throttle_src_get_size (GstBaseSrc * basesrc, guint64 * size)
+{
+  ThrottleSrc *src = (ThrottleSrc *) basesrc;
+
+  *size = g_mapped_file_get_length (src->file);
+
+  return TRUE;
+}
+
+static gboolean
+throttle_src_query (GstBaseSrc * basesrc, GstQuery * query)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_SCHEDULING) {
+    /* make urisourcebin treat us like a network source */
+    gst_query_set_scheduling (query, GST_SCHEDULING_FLAG_SEQUENTIAL |
+        GST_SCHEDULING_FLAG_BANDWIDTH_LIMITED, 1, -1, 0);
+    gst_query_add_scheduling_mode (query, GST_PAD_MODE_PUSH);
+    return TRUE;
+  }
+
+  return GST_BASE_SRC_CLASS (throttle_src_parent_class)->query (basesrc,
+      query);
+}
+
+static GstFlowReturn
+throttle_src_create (GstBaseSrc * basesrc, guint64 offset, guint length,
+    GstBuffer ** buf)
+{
+  ThrottleSrc *src = (ThrottleSrc *) basesrc;
+  gsize size = g_mapped_file_get_length (src->file);
+  gdouble factor;
+
+  if (src->offset >= size)
+    return GST_FLOW_EOS;
+
+  if (!src->sent_tags) {
+    /* like an icecast server announcing the bitrate */
+    gst_element_send_event (GST_ELEMENT_CAST (src),
+        gst_event_new_tag (gst_tag_list_new (GST_TAG_BITRATE,
+                throttle_bitrate, NULL)));
+    src->sent_tags = TRUE;
+  }
+
+  length = MIN (CHUNK_SIZE, size - src->offset);
+
+  factor = g_random_double_range (1.0 - JITTER, 1.0 + JITTER);
+  g_usleep (length * G_USEC_PER_SEC / (throttle_rate * factor));
+
+  *buf = gst_buffer_new_allocate (NULL, length, NULL);
+  gst_buffer_fill (*buf, 0, g_mapped_file_get_contents (src->file) +
+      src->offset, length);
+  GST_BUFFER_OFFSET (*buf) = src->offset;
+  src->offset += length;
+
+  return GST_FLOW_OK;
+}
+
+static void
+throttle_src_finalize (GObject * object)
+{
+  ThrottleSrc *src = (ThrottleSrc *) object;
+
+  g_free (src->location);
+
+  G_OBJECT_CLASS (throttle_src_parent_class)->finalize (object);
+}
+
+static void
+throttle_src_class_init (ThrottleSrcClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+
+  gobject_class->finalize = throttle_src_finalize;
+
+  gst_element_class_add_static_pad_template (element_class,
+      &throttle_src_template);
+  gst_element_class_set_static_metadata (element_class,
+      "Throttled file source", "Source/File",
+      "Reads a file at a limited rate", "GStreamer maintainers");
+
+  basesrc_class->start = throttle_src_start;
+  basesrc_class->stop = throttle_src_stop;
+  basesrc_class->get_size = throttle_src_get_size;
+  basesrc_class->query = throttle_src_query;
+  basesrc_class->create = throttle_src_create;
+}
+
+static void
+throttle_src_init (ThrottleSrc * src)
+{
+}
+
+/*** benchmark ***/
+
+static gboolean
+generate_file (const gchar * location)
+{
+  GstElement *pipeline;
+  GstMessage *msg;
+  GError *err = NULL;
+  gchar *desc;
+  gboolean ret;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=300 pattern=ball ! "
+      "video/x-raw,width=320,height=240,framerate=30/1 ! theoraenc ! "
+      "oggmux ! filesink location=\"%s\"", location);
+  pipeline = gst_parse_launch (desc, &err);
+  g_free (desc);
+  if (err != NULL) {
+    g_printerr ("Could not generate %s: %s\n", location, err->message);
+    g_clear_error (&err);
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  ret = (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+/* returns the bitrate of the file in bits/s, 0 on errors */
+static guint
+get_bitrate (const gchar * filename)
+{
+  GstElement *pipeline;
+  GstMessage *msg;
+  GStatBuf st;
+  gint64 duration = 0;
+  gchar *desc;
+
+  if (g_stat (filename, &st) != 0)
+    return 0;
+
+  desc = g_strdup_printf ("filesrc location=\"%s\" ! decodebin ! fakesink",
+      filename);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  if (pipeline == NULL)
+    return 0;
+
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline),
+      GST_CLOCK_TIME_NONE, GST_MESSAGE_ASYNC_DONE | GST_MESSAGE_ERROR);
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ASYNC_DONE)
+    gst_element_query_duration (pipeline, GST_FORMAT_TIME, &duration);
+  gst_message_unref (msg);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  if (duration <= 0)
+    return 0;
+
+  return gst_util_uint64_scale (st.st_size, 8 * GST_SECOND, duration);
+}
+
+static void
+decodebin_pad_added_cb (GstElement * decodebin, GstPad * pad,
+    GstElement * pipeline)
+{
+  GstElement *sink;
+  GstPad *sinkpad;
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (sink, "sync", TRUE, NULL);
+  gst_bin_add (GST_BIN (pipeline), sink);
+  gst_element_sync_state_with_parent (sink);
+
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  gst_pad_link (pad, sinkpad);
+  gst_object_unref (sinkpad);
+}
+
+static void
+source_pad_added_cb (GstElement * urisourcebin, GstPad * pad,
+    GstElement * pipeline)
+{
+  GstElement *decodebin;
+  GstPad *sinkpad;
+
+  decodebin = gst_element_factory_make ("decodebin", NULL);
+  g_signal_connect (decodebin, "pad-added",
+      G_CALLBACK (decodebin_pad_added_cb), pipeline);
+  gst_bin_add (GST_BIN (pipeline), decodebin);
+  gst_element_sync_state_with_parent (decodebin);
+
+  sinkpad = gst_element_get_static_pad (decodebin, "sink");
+  gst_pad_link (pad, sinkpad);
+  gst_object_unref (sinkpad);
+}
+
+/* plays @uri like an application handling buffering messages would and
+ * returns the time until playback started */
+static GstClockTime
+run_urisourcebin (const gchar * uri, gboolean adaptive, guint * rebuffers)
+{
+  GstElement *pipeline, *urisourcebin;
+  GstClockTime start, started = GST_CLOCK_TIME_NONE;
+  gboolean playing = FALSE, done = FALSE;
+  GstBus *bus;
+
+  *rebuffers = 0;
+
+  pipeline = gst_pipeline_new (NULL);
+  urisourcebin = gst_element_factory_make ("urisourcebin", NULL);
+  g_object_set (urisourcebin, "uri", uri, "adaptive-buffering", adaptive,
+      NULL);
+  g_signal_connect (urisourcebin, "pad-added",
+      G_CALLBACK (source_pad_added_cb), pipeline);
+  gst_bin_add (GST_BIN (pipeline), urisourcebin);
+
+  bus = gst_element_get_bus (pipeline);
+  start = gst_util_get_timestamp ();
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+
+  while (!done) {
+    GstMessage *msg;
+    gint percent;
+
+    msg = gst_bus_timed_pop_filtered (bus, 100 * GST_MSECOND,
+        GST_MESSAGE_BUFFERING | GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+
+    if (gst_util_get_timestamp () - start > MAX_RUN_TIME)
+      done = TRUE;
+    if (msg == NULL)
+      continue;
+
+    switch (GST_MESSAGE_TYPE (msg)) {
+      case GST_MESSAGE_BUFFERING:
+        gst_message_parse_buffering (msg, &percent);
+        if (percent < 100 && playing) {
+          gst_element_set_state (pipeline, GST_STATE_PAUSED);
+          playing = FALSE;
+          (*rebuffers)++;
+        } else if (percent == 100 && !playing) {
+          gst_element_set_state (pipeline, GST_STATE_PLAYING);
+          playing = TRUE;
+          if (started == GST_CLOCK_TIME_NONE)
+            started = gst_util_get_timestamp () - start;
+        }
+        break;
+      case GST_MESSAGE_ERROR:
+        g_printerr ("Error playing %s\n", uri);
+        /* fall through */
+      default:
+        done = TRUE;
+        break;
+    }
+    gst_message_unref (msg);
+  }
+
+  gst_object_unref (bus);
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return started;
+}
+
+int
+main (int argc, char **argv)
+{
+  GstClockTime normal, adaptive;
+  guint normal_rebuffers, adaptive_rebuffers, i;
+  gchar *filename, *uri;
+  gboolean remove_file = FALSE;
+
+  gst_init (&argc, &argv);
+
+  gst_element_register (NULL, "throttlesrc", GST_RANK_PRIMARY,
+      throttle_src_get_type ());
+
+  if (argc > 1) {
+    filename = g_strdup (argv[1]);
+  } else {
+    filename = g_build_filename (g_get_tmp_dir (),
+        "benchmark-urisourcebin.ogg", NULL);
+    if (!generate_file (filename)) {
+      g_free (filename);
+      return 1;
+    }
+    remove_file = TRUE;
+  }
+
+  throttle_bitrate = get_bitrate (filename);
+  if (throttle_bitrate == 0) {
+    g_printerr ("Could not get the bitrate of %s\n", filename);
+    if (remove_file)
+      g_unlink (filename);
+    g_free (filename);
+    return 1;
+  }
+  g_print ("file bitrate %u bits/s\n", throttle_bitrate);
+
+  uri = g_strdup_printf ("throttle://%s", filename);
+
+  for (i = 0; i < G_N_ELEMENTS (speeds); i++) {
+    throttle_rate = speeds[i] * throttle_bitrate / 8;
+
+    normal = run_urisourcebin (uri, FALSE, &normal_rebuffers);
+    adaptive = run_urisourcebin (uri, TRUE, &adaptive_rebuffers);
+
+    g_print ("throughput %.1fx bitrate:\n", speeds[i]);
+    g_print ("  %-20s playing after %" GST_TIME_FORMAT ", %u rebuffers\n",
+        "static", GST_TIME_ARGS (normal), normal_rebuffers);
+    g_print ("  %-20s playing after %" GST_TIME_FORMAT ", %u rebuffers\n",
+        "adaptive-buffering", GST_TIME_ARGS (adaptive), adaptive_rebuffers);
+  }
+
+  g_free (uri);
+  if (remove_file)
+    g_unlink (filename);
+  g_free (filename);
+
+  return 0;
+}
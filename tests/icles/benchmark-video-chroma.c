@@ -0,0 +1,136 @@
+/* GStreamer video chroma resampler benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of every horizontal and vertical chroma
+ * resampler variant, up and down by 2x and 4x, with and without cositing,
+ * progressive and interlaced, on 8 and 16 bit AYUV lines of a 1080p
+ * frame. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define WIDTH 1920
+#define HEIGHT 1080
+#define NUM_FRAMES 50
+
+typedef struct
+{
+  const gchar *name;
+  GstVideoChromaSite site;
+  GstVideoChromaFlags flags;
+} Site;
+
+static const Site sites[] = {
+  {"progressive", GST_VIDEO_CHROMA_SITE_NONE, GST_VIDEO_CHROMA_FLAG_NONE},
+  {"cosited", GST_VIDEO_CHROMA_SITE_COSITED, GST_VIDEO_CHROMA_FLAG_NONE},
+  {"interlaced", GST_VIDEO_CHROMA_SITE_NONE,
+      GST_VIDEO_CHROMA_FLAG_INTERLACED},
+  {"interlaced-cosited", GST_VIDEO_CHROMA_SITE_COSITED,
+      GST_VIDEO_CHROMA_FLAG_INTERLACED},
+};
+
+static GstClockTime
+run_resample (GstVideoFormat format, const Site * site, gint h_factor,
+    gint v_factor)
+{
+  GstVideoChromaResample *resample;
+  GstClockTime start, elapsed;
+  gpointer lines[8];
+  guint n_lines, i, j;
+  gint offset;
+  gsize stride;
+  guint8 *data;
+
+  resample = gst_video_chroma_resample_new (GST_VIDEO_CHROMA_METHOD_LINEAR,
+      site->site, site->flags, format, h_factor, v_factor);
+
+  gst_video_chroma_resample_get_info (resample, &n_lines, &offset);
+  g_assert (n_lines <= G_N_ELEMENTS (lines));
+
+  stride = WIDTH * (format == GST_VIDEO_FORMAT_AYUV64 ? 8 : 4);
+  data = g_malloc (stride * n_lines);
+  for (i = 0; i < stride * n_lines; i++)
+    data[i] = g_random_int ();
+  for (i = 0; i < n_lines; i++)
+    lines[i] = data + i * stride;
+
+  /* warm up */
+  gst_video_chroma_resample (resample, lines, WIDTH);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_FRAMES; i++) {
+    for (j = 0; j < HEIGHT; j += n_lines)
+      gst_video_chroma_resample (resample, lines, WIDTH);
+  }
+  elapsed = gst_util_get_timestamp () - start;
+
+  g_free (data);
+  gst_video_chroma_resample_free (resample);
+
+  return elapsed / NUM_FRAMES;
+}
+
+static void
+print_result (const gchar * dir, gint factor, GstClockTime t)
+{
+  g_print ("    %-4s %dx  %" GST_TIME_FORMAT " per frame, %8.1f Mpixels/s\n",
+      dir, 1 << factor, GST_TIME_ARGS (t),
+      (gdouble) WIDTH * HEIGHT * 1000.0 / MAX (t, 1));
+}
+
+int
+main (int argc, char **argv)
+{
+  const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_AYUV64
+  };
+  guint f, s;
+  gint factor;
+
+  gst_init (&argc, &argv);
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    for (s = 0; s < G_N_ELEMENTS (sites); s++) {
+      g_print ("%s %s %dx%d\n", gst_video_format_to_string (formats[f]),
+          sites[s].name, WIDTH, HEIGHT);
+
+      /* horizontal resampling does not depend on interlacing */
+      if (!(sites[s].flags & GST_VIDEO_CHROMA_FLAG_INTERLACED)) {
+        g_print ("  horizontal\n");
+        for (factor = 1; factor <= 2; factor++) {
+          print_result ("up", factor,
+              run_resample (formats[f], &sites[s], factor, 0));
+          print_result ("down", factor,
+              run_resample (formats[f], &sites[s], -factor, 0));
+        }
+      }
+      g_print ("  vertical\n");
+      for (factor = 1; factor <= 2; factor++) {
+        print_result ("up", factor,
+            run_resample (formats[f], &sites[s], 0, factor));
+        print_result ("down", factor,
+            run_resample (formats[f], &sites[s], 0, -factor));
+      }
+    }
+  }
+
+  return 0;
+}
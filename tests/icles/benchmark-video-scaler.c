@@ -0,0 +1,132 @@
+/* GStreamer video scaler benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the time it takes a GstVideoConverter to scale a 1080p frame
+ * down to the sizes of a typical adaptive streaming ladder, for the
+ * different resampler methods and with one and all available threads. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define NUM_FRAMES 50
+
+typedef struct
+{
+  const gchar *name;
+  GstVideoResamplerMethod method;
+  guint taps;
+} Method;
+
+static const Method methods[] = {
+  {"linear", GST_VIDEO_RESAMPLER_METHOD_LINEAR, 0},
+  {"lanczos-4", GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 4},
+  {"lanczos-6", GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 6},
+  {"lanczos-8", GST_VIDEO_RESAMPLER_METHOD_LANCZOS, 8},
+};
+
+static const gint sizes[][2] = {
+  {1280, 720},
+  {854, 480},
+  {640, 360},
+};
+
+static GstClockTime
+run_scale (GstVideoFormat format, gint width, gint height,
+    const Method * method, guint n_threads)
+{
+  GstVideoInfo in_info, out_info;
+  GstVideoConverter *convert;
+  GstVideoFrame in_frame, out_frame;
+  GstBuffer *in_buf, *out_buf;
+  GstClockTime start, elapsed;
+  guint i;
+
+  gst_video_info_set_format (&in_info, format, 1920, 1080);
+  gst_video_info_set_format (&out_info, format, width, height);
+
+  in_buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&in_info),
+      NULL);
+  gst_buffer_memset (in_buf, 0, 0x80, GST_VIDEO_INFO_SIZE (&in_info));
+  out_buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&out_info),
+      NULL);
+
+  convert = gst_video_converter_new (&in_info, &out_info,
+      gst_structure_new ("GstVideoConverter",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, method->method,
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_TAPS, G_TYPE_UINT, method->taps,
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+
+  gst_video_frame_map (&in_frame, &in_info, in_buf, GST_MAP_READ);
+  gst_video_frame_map (&out_frame, &out_info, out_buf, GST_MAP_WRITE);
+
+  /* warm up, this also builds the integer taps */
+  gst_video_converter_frame (convert, &in_frame, &out_frame);
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < NUM_FRAMES; i++)
+    gst_video_converter_frame (convert, &in_frame, &out_frame);
+  elapsed = gst_util_get_timestamp () - start;
+
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&in_frame);
+  gst_video_converter_free (convert);
+  gst_buffer_unref (out_buf);
+  gst_buffer_unref (in_buf);
+
+  return elapsed / NUM_FRAMES;
+}
+
+int
+main (int argc, char **argv)
+{
+  const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_ARGB
+  };
+  guint n_threads;
+  guint f, s, m;
+
+  gst_init (&argc, &argv);
+
+  n_threads = g_get_num_processors ();
+
+  for (f = 0; f < G_N_ELEMENTS (formats); f++) {
+    for (s = 0; s < G_N_ELEMENTS (sizes); s++) {
+      g_print ("%s 1920x1080 -> %dx%d\n",
+          gst_video_format_to_string (formats[f]), sizes[s][0], sizes[s][1]);
+
+      for (m = 0; m < G_N_ELEMENTS (methods); m++) {
+        GstClockTime single, multi;
+
+        single = run_scale (formats[f], sizes[s][0], sizes[s][1],
+            &methods[m], 1);
+        multi = run_scale (formats[f], sizes[s][0], sizes[s][1],
+            &methods[m], n_threads);
+
+        g_print ("  %-10s %" GST_TIME_FORMAT " per frame, %" GST_TIME_FORMAT
+            " with %u threads\n", methods[m].name, GST_TIME_ARGS (single),
+            GST_TIME_ARGS (multi), n_threads);
+      }
+    }
+  }
+
+  return 0;
+}
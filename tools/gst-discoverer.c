@@ -582,11 +582,14 @@ main (int argc, char **argv)
   GError *err = NULL;
   GstDiscoverer *dc;
   gint timeout = 10;
+  gint jobs = 1;
   GOptionEntry options[] = {
     {"async", 'a', 0, G_OPTION_ARG_NONE, &async,
         "Run asynchronously", NULL},
     {"timeout", 't', 0, G_OPTION_ARG_INT, &timeout,
         "Specify timeout (in seconds, default 10)", "T"},
+    {"jobs", 'j', 0, G_OPTION_ARG_INT, &jobs,
+        "Discover up to N URIs in parallel, implies --async (default 1)", "N"},
     /* {"elem", 'e', 0, G_OPTION_ARG_NONE, &elem_seek, */
     /*     "Seek on elements instead of pads", NULL}, */
     {"toc", 'c', 0, G_OPTION_ARG_NONE, &show_toc,
@@ -626,6 +629,11 @@ main (int argc, char **argv)
     exit (1);
   }
 
+  if (jobs > 1) {
+    g_object_set (dc, "max-concurrency", (guint) jobs, NULL);
+    async = TRUE;
+  }
+
   if (!async) {
     gint i;
     for (i = 1; i < argc; i++)
@@ -96,6 +96,11 @@ typedef struct
 
   /* configuration */
   gboolean gapless;
+  gboolean timing;
+
+  /* startup timing, see --timing */
+  GstClockTime start_time;
+  GstClockTime last_milestone_time;
 
   GstPlayTrickMode trick_mode;
   gdouble rate;
@@ -318,6 +323,33 @@ play_install_missing_plugins (GstPlay * play)
   return FALSE;
 }
 
+/* prints a "playback-milestone" message, relative to the time playback
+ * of the current uri was started and to the previous milestone */
+static void
+play_print_milestone (GstPlay * play, GstMessage * msg)
+{
+  const GstStructure *s = gst_message_get_structure (msg);
+  const gchar *milestone, *detail;
+  guint64 timestamp;
+
+  milestone = gst_structure_get_string (s, "milestone");
+  if (milestone == NULL
+      || !gst_structure_get_uint64 (s, "timestamp", &timestamp))
+    return;
+  detail = gst_structure_get_string (s, "detail");
+
+  if (timestamp < play->last_milestone_time)
+    timestamp = play->last_milestone_time;
+
+  g_print ("Timing: %" GST_TIME_FORMAT " (+%" GST_TIME_FORMAT ") %s: %s%s%s\n",
+      GST_TIME_ARGS (timestamp - play->start_time),
+      GST_TIME_ARGS (timestamp - play->last_milestone_time),
+      GST_MESSAGE_SRC_NAME (msg), milestone, detail ? " " : "",
+      detail ? detail : "");
+
+  play->last_milestone_time = timestamp;
+}
+
 static gboolean
 play_bus_msg (GstBus * bus, GstMessage * msg, gpointer user_data)
 {
@@ -449,6 +481,12 @@ play_bus_msg (GstBus * bus, GstMessage * msg, gpointer user_data)
     case GST_MESSAGE_ELEMENT:
     {
       GstNavigationMessageType mtype = gst_navigation_message_get_type (msg);
+
+      if (play->timing && gst_message_has_name (msg, "playback-milestone")) {
+        play_print_milestone (play, msg);
+        break;
+      }
+
       if (mtype == GST_NAVIGATION_MESSAGE_EVENT) {
         GstEvent *ev = NULL;
 
@@ -671,6 +709,8 @@ play_uri (GstPlay * play, const gchar * next_uri)
 
   g_object_set (play->playbin, "uri", next_uri, NULL);
 
+  play->start_time = play->last_milestone_time = gst_util_get_timestamp ();
+
   switch (gst_element_set_state (play->playbin, GST_STATE_PAUSED)) {
     case GST_STATE_CHANGE_FAILURE:
       /* ignore, we should get an error message posted on the bus */
@@ -1432,6 +1472,7 @@ main (int argc, char **argv)
   GOptionContext *ctx;
   gchar *playlist_file = NULL;
   gboolean use_playbin3 = FALSE;
+  gboolean timing = FALSE;
   GOptionEntry options[] = {
     {"verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose,
         N_("Output status information and property notifications"), NULL},
@@ -1461,6 +1502,8 @@ main (int argc, char **argv)
           N_("Use playbin3 pipeline")
           N_("(default varies depending on 'USE_PLAYBIN' env variable)"),
         NULL},
+    {"timing", 0, 0, G_OPTION_ARG_NONE, &timing,
+        N_("Print how long each step of the playback startup took"), NULL},
     {G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &filenames, NULL},
     {NULL}
   };
@@ -1575,6 +1618,8 @@ main (int argc, char **argv)
     return EXIT_FAILURE;
   }
 
+  play->timing = timing;
+
   if (interactive) {
     if (gst_play_kb_set_key_handler (keyboard_cb, play)) {
       g_print (_("Press 'k' to see a list of keyboard shortcuts.\n"));